@@ -0,0 +1,174 @@
+#!/usr/bin/env python
+
+# ===--- compile_time_driver.py ------------------------------------------===//
+#
+#  This source file is part of the Swift.org open source project
+#
+#  Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+#  Licensed under Apache License v2.0 with Runtime Library Exception
+#
+#  See https://swift.org/LICENSE.txt for license information
+#  See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+#
+# ===---------------------------------------------------------------------===//
+#
+# Compile-time counterpart of the runtime benchmark driver: expands the gyb
+# corpus in benchmark/compile-time, runs each source through the frontend one
+# pipeline phase at a time (parse, Sema, SILGen, SIL optimization, IRGen) with
+# -stats-output-dir, and hands the collected stats to
+# utils/process-stats-dir.py for baseline management and threshold-based
+# regression detection.  Typical use, from a checkout being bisected or
+# reviewed:
+#
+#   # On the baseline commit:
+#   compile_time_driver.py --swiftc /path/to/swiftc \
+#       --set-baseline compile-time-baseline.csv
+#
+#   # On the commit under test; exits non-zero per regressed stat:
+#   compile_time_driver.py --swiftc /path/to/swiftc \
+#       --compare-to-baseline compile-time-baseline.csv
+#
+# Each (source, phase) pair is compiled under its own module name, so stats
+# are tracked per corpus file and per phase; a Sema regression shows up on
+# the *_sema rows without touching the *_parse rows.
+
+from __future__ import print_function
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+BENCHMARK_DIR = os.path.dirname(SCRIPT_DIR)
+UTILS_DIR = os.path.join(os.path.dirname(BENCHMARK_DIR), 'utils')
+DEFAULT_CORPUS = os.path.join(BENCHMARK_DIR, 'compile-time')
+
+sys.path.append(UTILS_DIR)
+import gyb  # noqa (E402 module level import not at top of file)
+
+# Each phase runs the frontend up to (and including) one stage of the
+# pipeline, so the cost of a single phase is the delta between its row and
+# the preceding phase's row for the same source.
+PHASES = [
+    ('parse', ['-parse']),
+    ('sema', ['-typecheck']),
+    ('silgen', ['-emit-silgen']),
+    ('silopt', ['-emit-sil', '-O']),
+    ('irgen', ['-emit-ir', '-O']),
+]
+
+# Stats tracked per (source, phase): the frontend process timers, plus the
+# memory ceilings the frontend reports.
+SELECTED_STATS = [r'\.wall$', 'NumASTBytesAllocated', 'SILOptMallocUsage']
+
+
+def expand_corpus(args, tmpdir):
+    """Expand every gyb template in the corpus dir into tmpdir, returning a
+    list of (name, path) pairs."""
+    sources = []
+    for fname in sorted(os.listdir(args.corpus)):
+        (name, ext) = os.path.splitext(fname)
+        if ext != '.gyb':
+            continue
+        template = gyb.parse_template(os.path.join(args.corpus, fname))
+        outpath = os.path.join(tmpdir, name + '.swift')
+        with open(outpath, 'w') as f:
+            f.write(gyb.execute_template(template, '', N=args.scale))
+        sources.append((name, outpath))
+    if len(sources) == 0:
+        raise ValueError("no gyb templates found in " + args.corpus)
+    return sources
+
+
+def run_corpus(args, sources, stats_dir):
+    """Compile every source once per phase per sample, collecting stats for
+    all runs into stats_dir."""
+    for (name, path) in sources:
+        for (phase, flags) in PHASES:
+            command = ([args.swiftc, '-frontend'] + flags +
+                       ['-module-name', '%s_%s' % (name, phase),
+                        '-o', os.devnull,
+                        '-stats-output-dir', stats_dir,
+                        path])
+            for _ in range(args.num_samples):
+                if args.verbose:
+                    print("running: " + " ".join(command))
+                subprocess.check_call(command)
+
+
+def process_stats(args, stats_dir):
+    """Delegate baseline management and comparison to process-stats-dir.py;
+    its exit status (the number of regressed stats when comparing) becomes
+    ours."""
+    command = [sys.executable,
+               os.path.join(UTILS_DIR, 'process-stats-dir.py'),
+               '--group-by-module', '--merge-timers',
+               # Multiple samples of the same (source, phase) module merge to
+               # their (nonzero-)minimum, suppressing scheduling noise.
+               '--merge-by', 'min']
+    for s in SELECTED_STATS:
+        command += ['--select-stat', s]
+    if args.set_baseline is not None:
+        command += ['--set-csv-baseline', args.set_baseline]
+    else:
+        command += ['--compare-to-csv-baseline', args.compare_to_baseline,
+                    '--delta-pct-thresh', str(args.delta_pct_thresh),
+                    '--delta-usec-thresh', str(args.delta_usec_thresh)]
+        if args.markdown:
+            command.append('--markdown')
+    command.append(stats_dir)
+    if args.verbose:
+        print("running: " + " ".join(command))
+    return subprocess.call(command)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Track per-phase frontend compile time and memory "
+                    "for the compile-time benchmark corpus")
+    parser.add_argument('--swiftc', required=True,
+                        help="Path to the swiftc binary under test")
+    parser.add_argument('--corpus', default=DEFAULT_CORPUS,
+                        help="Directory of gyb corpus templates "
+                             "(default: benchmark/compile-time)")
+    parser.add_argument('--scale', type=int, default=100,
+                        help="Value of N the corpus templates are "
+                             "expanded with")
+    parser.add_argument('--num-samples', type=int, default=3,
+                        help="Frontend runs per (source, phase); the "
+                             "fastest sample is kept")
+    parser.add_argument('--delta-pct-thresh', type=float, default=1.0,
+                        help="Percentage change required to count as a "
+                             "regression")
+    parser.add_argument('--delta-usec-thresh', type=int, default=100000,
+                        help="Absolute time change (usec) also required "
+                             "for timers to count as a regression")
+    parser.add_argument('--markdown', action='store_true',
+                        help="Write the comparison as a markdown table")
+    parser.add_argument('--verbose', action='store_true',
+                        help="Report activity verbosely")
+    modes = parser.add_mutually_exclusive_group(required=True)
+    modes.add_argument('--set-baseline', type=str, default=None,
+                       metavar='BASELINE.csv',
+                       help="Record current stats as the CSV baseline")
+    modes.add_argument('--compare-to-baseline', type=str, default=None,
+                       metavar='BASELINE.csv',
+                       help="Compare current stats against a CSV baseline")
+    args = parser.parse_args()
+
+    tmpdir = tempfile.mkdtemp()
+    try:
+        stats_dir = os.path.join(tmpdir, 'stats')
+        os.makedirs(stats_dir)
+        sources = expand_corpus(args, tmpdir)
+        run_corpus(args, sources, stats_dir)
+        return process_stats(args, stats_dir)
+    finally:
+        shutil.rmtree(tmpdir)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -18,6 +18,41 @@ import Darwin
 
 import TestsUtils
 
+/// Hardware performance-counter readings for one measurement, normalized to
+/// a single iteration of the benchmark.
+struct PerfCounters {
+  var instructions: UInt64 = 0
+  var branchMisses: UInt64 = 0
+  var cacheMisses: UInt64 = 0
+
+  static func - (lhs: PerfCounters, rhs: PerfCounters) -> PerfCounters {
+    return PerfCounters(instructions: lhs.instructions - rhs.instructions,
+                        branchMisses: lhs.branchMisses - rhs.branchMisses,
+                        cacheMisses: lhs.cacheMisses - rhs.cacheMisses)
+  }
+
+  static func += (lhs: inout PerfCounters, rhs: PerfCounters) {
+    lhs.instructions += rhs.instructions
+    lhs.branchMisses += rhs.branchMisses
+    lhs.cacheMisses += rhs.cacheMisses
+  }
+
+  /// Divide every counter by the iteration count of the measured run.
+  func scaled(down divisor: UInt64) -> PerfCounters {
+    return PerfCounters(instructions: instructions / divisor,
+                        branchMisses: branchMisses / divisor,
+                        cacheMisses: cacheMisses / divisor)
+  }
+}
+
+/// Memory cost of one measurement: how much the process peak resident set
+/// grew during the run, and how many Swift heap objects were allocated,
+/// normalized to a single iteration of the benchmark.
+struct MemoryUsage {
+  var maxRSSDelta: UInt64 = 0
+  var allocations: UInt64 = 0
+}
+
 struct BenchResults {
   var delim: String  = ","
   var sampleCount: UInt64 = 0
@@ -27,9 +62,15 @@ struct BenchResults {
   var sd: UInt64 = 0
   var median: UInt64 = 0
 
+  /// Per-sample medians of the hardware counters, when collected.
+  var perfCounters: PerfCounters? = nil
+
+  /// Per-sample medians of the memory measurements, when collected.
+  var memoryUsage: MemoryUsage? = nil
+
   init() {}
 
-  init(delim: String, sampleCount: UInt64, min: UInt64, max: UInt64, mean: UInt64, sd: UInt64, median: UInt64) {
+  init(delim: String, sampleCount: UInt64, min: UInt64, max: UInt64, mean: UInt64, sd: UInt64, median: UInt64, perfCounters: PerfCounters? = nil, memoryUsage: MemoryUsage? = nil) {
     self.delim = delim
     self.sampleCount = sampleCount
     self.min = min
@@ -37,6 +78,8 @@ struct BenchResults {
     self.mean = mean
     self.sd = sd
     self.median = median
+    self.perfCounters = perfCounters
+    self.memoryUsage = memoryUsage
 
     // Sanity the bounds of our results
     precondition(self.min <= self.max, "min should always be <= max")
@@ -49,7 +92,16 @@ struct BenchResults {
 
 extension BenchResults : CustomStringConvertible {
   var description: String {
-     return "\(sampleCount)\(delim)\(min)\(delim)\(max)\(delim)\(mean)\(delim)\(sd)\(delim)\(median)"
+     var result = "\(sampleCount)\(delim)\(min)\(delim)\(max)\(delim)\(mean)\(delim)\(sd)\(delim)\(median)"
+     // Counter columns go after the time columns so that tools parsing the
+     // leading columns (convertToJSON.py) keep working unchanged.
+     if let pc = perfCounters {
+       result += "\(delim)\(pc.instructions)\(delim)\(pc.branchMisses)\(delim)\(pc.cacheMisses)"
+     }
+     if let mem = memoryUsage {
+       result += "\(delim)\(mem.maxRSSDelta)\(delim)\(mem.allocations)"
+     }
+     return result
   }
 }
 
@@ -130,6 +182,14 @@ struct TestConfig {
   /// like leaks that require a PID to run on the test harness.
   var afterRunSleep: Int?
 
+  /// Should the harness also sample hardware performance counters
+  /// (instructions retired, branch misses, LLC misses) for each benchmark?
+  var measurePerfCounters: Bool = false
+
+  /// Should the harness also track peak-memory growth and Swift heap
+  /// allocation counts for each benchmark?
+  var measureMemory: Bool = false
+
   /// The list of tests to run.
   var tests = [Test]()
 
@@ -137,7 +197,7 @@ struct TestConfig {
     let validOptions = [
       "--iter-scale", "--num-samples", "--num-iters",
       "--verbose", "--delim", "--list", "--sleep",
-      "--tags", "--skip-tags", "--help"
+      "--tags", "--skip-tags", "--perf-counters", "--memory", "--help"
     ]
     let maybeBenchArgs: Arguments? = parseArgs(validOptions)
     if maybeBenchArgs == nil {
@@ -219,6 +279,14 @@ struct TestConfig {
       afterRunSleep = v
     }
 
+    if let _ = benchArgs.optionalArgsMap["--perf-counters"] {
+      measurePerfCounters = true
+    }
+
+    if let _ = benchArgs.optionalArgsMap["--memory"] {
+      measureMemory = true
+    }
+
     if let _ = benchArgs.optionalArgsMap["--list"] {
       return .listTests
     }
@@ -325,17 +393,198 @@ class Timer {
 }
 #endif
 
+#if os(Linux)
+// Constants from <linux/perf_event.h>.
+fileprivate let PERF_TYPE_HARDWARE: UInt32 = 0
+fileprivate let PERF_COUNT_HW_INSTRUCTIONS: UInt64 = 1
+fileprivate let PERF_COUNT_HW_CACHE_MISSES: UInt64 = 3
+fileprivate let PERF_COUNT_HW_BRANCH_MISSES: UInt64 = 5
+
+/// The first published layout of perf_event_attr (PERF_ATTR_SIZE_VER0,
+/// 64 bytes); every later kernel still accepts it.
+fileprivate struct PerfEventAttr {
+  var type: UInt32 = 0
+  var size: UInt32 = 64
+  var config: UInt64 = 0
+  var samplePeriod: UInt64 = 0
+  var sampleType: UInt64 = 0
+  var readFormat: UInt64 = 0
+  var flags: UInt64 = 0
+  var wakeupEvents: UInt32 = 0
+  var bpType: UInt32 = 0
+  var bpAddr: UInt64 = 0
+}
+
+#if arch(x86_64)
+fileprivate let SYS_perf_event_open: CLong = 298
+#elseif arch(arm64)
+fileprivate let SYS_perf_event_open: CLong = 241
+#elseif arch(powerpc64) || arch(powerpc64le)
+fileprivate let SYS_perf_event_open: CLong = 319
+#elseif arch(s390x)
+fileprivate let SYS_perf_event_open: CLong = 331
+#else
+fileprivate let SYS_perf_event_open: CLong = -1
+#endif
+
+// Glibc does not import the variadic syscall(2) wrapper; bind the fixed-arity
+// form that perf_event_open needs.
+@_silgen_name("syscall")
+fileprivate func _syscall_perf_event_open(
+  _ number: CLong, _ attr: UnsafeMutableRawPointer, _ pid: pid_t,
+  _ cpu: CInt, _ groupFd: CInt, _ flags: CUnsignedLong) -> CLong
+
+/// Counts instructions retired, branch misses and LLC misses of the calling
+/// thread via perf_event_open(2).  The counters run from initialization on;
+/// callers take before/after snapshots with read() and subtract.
+class PerfCounterSampler {
+  // One fd per counter: instructions, branch misses, LLC misses.
+  private var fds: [CInt] = []
+
+  init?() {
+    if SYS_perf_event_open < 0 {
+      return nil
+    }
+    for config in [PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES,
+                   PERF_COUNT_HW_CACHE_MISSES] {
+      var attr = PerfEventAttr()
+      attr.type = PERF_TYPE_HARDWARE
+      attr.config = config
+      // Count user space only: exclude_kernel | exclude_hv.
+      attr.flags = 0x60
+      // pid 0, cpu -1: this process, on whichever CPU it runs.
+      let fd = withUnsafeMutablePointer(to: &attr) {
+        CInt(_syscall_perf_event_open(SYS_perf_event_open, $0, 0, -1, -1, 0))
+      }
+      if fd < 0 {
+        // Typically EACCES from kernel.perf_event_paranoid, or ENOENT when
+        // the machine has no PMU (e.g. some virtualized environments).
+        for opened in fds { close(opened) }
+        return nil
+      }
+      fds.append(fd)
+    }
+  }
+
+  deinit {
+    for fd in fds { close(fd) }
+  }
+
+  func read() -> PerfCounters {
+    var values = [UInt64](repeating: 0, count: fds.count)
+    for (i, fd) in fds.enumerated() {
+      var value: UInt64 = 0
+      _ = withUnsafeMutablePointer(to: &value) {
+        Glibc.read(fd, $0, MemoryLayout<UInt64>.size)
+      }
+      values[i] = value
+    }
+    return PerfCounters(instructions: values[0], branchMisses: values[1],
+                        cacheMisses: values[2])
+  }
+}
+#else
+/// Reading the PMU on Darwin requires the private kperf/kpc interfaces and
+/// root, so hardware counter collection is Linux-only for now.
+class PerfCounterSampler {
+  init?() { return nil }
+  func read() -> PerfCounters { return PerfCounters() }
+}
+#endif
+
+// The runtime routes every Swift heap-object allocation through the exported
+// _swift_allocObject function pointer (see the runtime's InstrumentsSupport.h),
+// which exists precisely so external tools can interpose it.  When --memory is
+// active we point it at a counting wrapper, which gives exact allocation
+// counts without a special runtime build (unlike the leak checker's tracking
+// hooks, which need SWIFT_RUNTIME_ENABLE_LEAK_CHECKER).
+typealias AllocObjectFn =
+  @convention(c) (UnsafeRawPointer?, Int, Int) -> UnsafeMutableRawPointer?
+
+/// Number of Swift heap objects allocated since the hook was installed.
+/// Benchmarks run single-threaded, so a plain counter suffices.
+var swiftAllocationCount: UInt64 = 0
+
+var originalAllocObject: AllocObjectFn? = nil
+
+func countingAllocObject(
+  _ metadata: UnsafeRawPointer?, _ requiredSize: Int,
+  _ requiredAlignmentMask: Int) -> UnsafeMutableRawPointer? {
+  swiftAllocationCount &+= 1
+  return originalAllocObject!(metadata, requiredSize, requiredAlignmentMask)
+}
+
+func installAllocCountingHook() -> Bool {
+#if os(Linux)
+  // On glibc, RTLD_DEFAULT is a null handle.
+  let handle: UnsafeMutableRawPointer? = nil
+#else
+  let handle = UnsafeMutableRawPointer(bitPattern: -2) // RTLD_DEFAULT
+#endif
+  // The hook is only reachable when the runtime exports it as a dynamic
+  // symbol; a statically linked stdlib may not.
+  guard let sym = dlsym(handle, "_swift_allocObject") else { return false }
+  let slot = sym.assumingMemoryBound(to: AllocObjectFn.self)
+  originalAllocObject = slot.pointee
+  slot.pointee = countingAllocObject
+  return true
+}
+
+/// Lazily interposes the counting hook the first time --memory needs it.
+let allocCountingHookInstalled: Bool = installAllocCountingHook()
+
+func currentMaxRSSBytes() -> UInt64 {
+  var u = rusage()
+  getrusage(RUSAGE_SELF, &u)
+#if os(Linux)
+  return UInt64(u.ru_maxrss) * 1024 // ru_maxrss is in kilobytes
+#else
+  return UInt64(u.ru_maxrss) // ru_maxrss is in bytes
+#endif
+}
+
 class SampleRunner {
   let timer = Timer()
+  let perf: PerfCounterSampler?
+  let trackMemory: Bool
+
+  /// The counter deltas seen during the most recent call to run(), valid
+  /// only when counter collection is enabled and available.
+  var lastSampleCounters = PerfCounters()
+
+  /// The memory measurements of the most recent call to run(), valid only
+  /// when memory tracking is enabled.
+  var lastSampleMemory = MemoryUsage()
+
+  init(measurePerfCounters: Bool = false, measureMemory: Bool = false) {
+    perf = measurePerfCounters ? PerfCounterSampler() : nil
+    trackMemory = measureMemory
+    if measureMemory {
+      // Force hook installation before the first measurement.
+      _ = allocCountingHookInstalled
+    }
+  }
+
   func run(_ name: String, fn: (Int) -> Void, num_iters: UInt) -> UInt64 {
     // Start the timer.
 #if SWIFT_RUNTIME_ENABLE_LEAK_CHECKER
     name.withCString { p in startTrackingObjects(p) }
 #endif
+    let start_counters = perf?.read()
+    let start_rss = trackMemory ? currentMaxRSSBytes() : 0
+    let start_allocs = swiftAllocationCount
     let start_ticks = timer.getTime()
     fn(Int(num_iters))
     // Stop the timer.
     let end_ticks = timer.getTime()
+    if trackMemory {
+      lastSampleMemory = MemoryUsage(
+        maxRSSDelta: currentMaxRSSBytes() - start_rss,
+        allocations: swiftAllocationCount &- start_allocs)
+    }
+    if let start = start_counters {
+      lastSampleCounters = perf!.read() - start
+    }
 #if SWIFT_RUNTIME_ENABLE_LEAK_CHECKER
     name.withCString { p in stopTrackingObjects(p) }
 #endif
@@ -363,7 +612,12 @@ func runBench(_ test: Test, _ c: TestConfig) -> BenchResults? {
     print("Running \(test.name) for \(c.numSamples) samples.")
   }
 
-  let sampler = SampleRunner()
+  let sampler = SampleRunner(measurePerfCounters: c.measurePerfCounters,
+                             measureMemory: c.measureMemory)
+  var counterSamples = [PerfCounters](
+    repeating: PerfCounters(), count: sampler.perf != nil ? c.numSamples : 0)
+  var memorySamples = [MemoryUsage](
+    repeating: MemoryUsage(), count: c.measureMemory ? c.numSamples : 0)
   for s in 0..<c.numSamples {
     test.setUpFunction?()
     let time_per_sample: UInt64 = 1_000_000_000 * UInt64(c.iterationScale)
@@ -404,6 +658,18 @@ func runBench(_ test: Test, _ c: TestConfig) -> BenchResults? {
     }
     // save result in microseconds or k-ticks
     samples[s] = elapsed_time / UInt64(scale) / 1000
+    if sampler.perf != nil {
+      // The counters cover the same run whose elapsed time we kept above;
+      // normalize them to one iteration like the time samples.
+      counterSamples[s] = sampler.lastSampleCounters.scaled(down: UInt64(scale))
+    }
+    if c.measureMemory {
+      // Allocation counts scale with the iteration count; peak-RSS growth
+      // does not, so it is kept as the raw per-sample delta.
+      var mem = sampler.lastSampleMemory
+      mem.allocations /= UInt64(scale)
+      memorySamples[s] = mem
+    }
     if c.verbose {
       print("    Sample \(s),\(samples[s])")
     }
@@ -412,10 +678,26 @@ func runBench(_ test: Test, _ c: TestConfig) -> BenchResults? {
 
   let (mean, sd) = internalMeanSD(samples)
 
+  var perfMedians: PerfCounters? = nil
+  if !counterSamples.isEmpty {
+    perfMedians = PerfCounters(
+      instructions: internalMedian(counterSamples.map { $0.instructions }),
+      branchMisses: internalMedian(counterSamples.map { $0.branchMisses }),
+      cacheMisses: internalMedian(counterSamples.map { $0.cacheMisses }))
+  }
+
+  var memoryMedians: MemoryUsage? = nil
+  if !memorySamples.isEmpty {
+    memoryMedians = MemoryUsage(
+      maxRSSDelta: internalMedian(memorySamples.map { $0.maxRSSDelta }),
+      allocations: internalMedian(memorySamples.map { $0.allocations }))
+  }
+
   // Return our benchmark results.
   return BenchResults(delim: c.delim, sampleCount: UInt64(samples.count),
                       min: samples.min()!, max: samples.max()!,
-                      mean: mean, sd: sd, median: internalMedian(samples))
+                      mean: mean, sd: sd, median: internalMedian(samples),
+                      perfCounters: perfMedians, memoryUsage: memoryMedians)
 }
 
 func printRunInfo(_ c: TestConfig) {
@@ -439,8 +721,26 @@ func printRunInfo(_ c: TestConfig) {
 }
 
 func runBenchmarks(_ c: TestConfig) {
+  var c = c
+  if c.measurePerfCounters && PerfCounterSampler() == nil {
+    print("Warning: hardware performance counters are unavailable; "
+          + "reporting time only.")
+    c.measurePerfCounters = false
+  }
+
   let units = "us"
-  print("#\(c.delim)TEST\(c.delim)SAMPLES\(c.delim)MIN(\(units))\(c.delim)MAX(\(units))\(c.delim)MEAN(\(units))\(c.delim)SD(\(units))\(c.delim)MEDIAN(\(units))")
+  var header = "#\(c.delim)TEST\(c.delim)SAMPLES\(c.delim)MIN(\(units))\(c.delim)MAX(\(units))\(c.delim)MEAN(\(units))\(c.delim)SD(\(units))\(c.delim)MEDIAN(\(units))"
+  if c.measurePerfCounters {
+    header += "\(c.delim)INSTS(med)\(c.delim)BRANCH_MISS(med)\(c.delim)LLC_MISS(med)"
+  }
+  if c.measureMemory {
+    if !allocCountingHookInstalled {
+      print("Warning: could not interpose the runtime allocation hook; "
+            + "ALLOCS will read as 0.")
+    }
+    header += "\(c.delim)MAX_RSS(med)\(c.delim)ALLOCS(med)"
+  }
+  print(header)
   var sumBenchResults = BenchResults()
   sumBenchResults.sampleCount = 0
 
@@ -457,6 +757,17 @@ func runBenchmarks(_ c: TestConfig) {
     sumBenchResults.max += results.max
     sumBenchResults.mean += results.mean
     sumBenchResults.sampleCount += 1
+    if let pc = results.perfCounters {
+      var sum = sumBenchResults.perfCounters ?? PerfCounters()
+      sum += pc
+      sumBenchResults.perfCounters = sum
+    }
+    if let mem = results.memoryUsage {
+      var sum = sumBenchResults.memoryUsage ?? MemoryUsage()
+      sum.maxRSSDelta += mem.maxRSSDelta
+      sum.allocations += mem.allocations
+      sumBenchResults.memoryUsage = sum
+    }
     // Don't accumulate SD and Median, as simple sum isn't valid for them.
     // TODO: Compute SD and Median for total results as well.
     // sumBenchResults.sd += results.sd
@@ -28,6 +28,7 @@
 #include "swift/Basic/Malloc.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/PointerIntPair.h"
@@ -35,6 +36,7 @@
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/Support/Allocator.h"
+#include "llvm/Support/Mutex.h"
 #include <functional>
 #include <memory>
 #include <utility>
@@ -260,6 +262,43 @@ public:
   /// Cache of remapped types (useful for diagnostics).
   llvm::StringMap<Type> RemappedTypes;
 
+  /// Memoized results of '#if' condition evaluation, keyed on the condition's
+  /// token spelling and holding (isActive, isVersionCondition) pairs. The
+  /// build configuration is fixed for the lifetime of an ASTContext, so
+  /// identical conditions always evaluate the same way.
+  llvm::StringMap<std::pair<bool, bool>> IfConfigConditionMemo;
+
+  /// Cache of minimized generic signatures, keyed by the unminimized "input"
+  /// signature formed from the raw generic parameters and requirements fed
+  /// to a GenericSignatureBuilder. Equivalent inputs always minimize to the
+  /// same signature, so rebuilding a previously seen shape becomes a lookup.
+  llvm::DenseMap<GenericSignature *, GenericSignature *>
+    MinimizedGenericSignatures;
+
+  /// Conformance lookups that are known to have failed, keyed on the
+  /// (nominal type, protocol) pair. Failed lookups are very common during
+  /// constraint solver exploration, and answering them here avoids walking
+  /// the per-nominal conformance tables. The set is cleared wholesale
+  /// whenever an extension or conformance is registered anywhere, since a
+  /// new extension of a superclass can introduce conformances for its
+  /// subclasses.
+  llvm::DenseSet<std::pair<const NominalTypeDecl *, const ProtocolDecl *>>
+    FailedConformanceLookups;
+
+  /// Memoized whole-symbol manglings of standalone types, keyed on the
+  /// type and the mangling operator that distinguishes the symbol kind
+  /// (empty for prefix-less type manglings). Mangling a standalone type is
+  /// deterministic, so the Nth mangling of the same generic application
+  /// becomes a lookup. IRGen and USR generation are the main beneficiaries.
+  llvm::DenseMap<std::pair<TypeBase *, llvm::StringRef>, std::string>
+    MangledTypeSymbols;
+
+  /// A monotonically increasing counter bumped whenever a declaration
+  /// subtree is mutated (members added, bodies or interface types set).
+  /// The AST verifier compares it against per-declaration mutation epochs
+  /// to re-verify only the subtrees that changed since its previous pass.
+  unsigned ASTMutationEpoch = 1;
+
   /// Optional table of counters to report, nullptr when not collecting.
   UnifiedStatsReporter *Stats = nullptr;
 
@@ -291,6 +330,42 @@ public:
   llvm::BumpPtrAllocator &
   getAllocator(AllocationArena arena = AllocationArena::Permanent) const;
 
+  /// \brief Retrieve the mutex guarding the bump-pointer allocators.
+  ///
+  /// Concurrent clients such as the sharded type uniquing tables run their
+  /// creation callbacks under independent shard locks, so the allocation a
+  /// callback performs needs its own guard. The mutex is a SmartMutex and
+  /// stays an uncontended no-op until LLVM's multithreaded mode is enabled.
+  llvm::sys::SmartMutex<true> &getAllocatorLock() const;
+
+  /// \brief Retrieve the allocator that holds memory local to the given
+  /// source file, creating it if necessary.
+  ///
+  /// Unlike the permanent arena, memory allocated here can be returned to
+  /// the system with \c releaseFileScopedMemory once the file's
+  /// type checking is complete. Anything placed in this allocator must
+  /// therefore be local to the file and safely reconstructible on demand;
+  /// the scope map is the canonical example.
+  llvm::BumpPtrAllocator &getFileScopedAllocator(const SourceFile *file) const;
+
+  /// \brief Add a cleanup function to be called when the given file's
+  /// file-scoped memory is released, or when the ASTContext is deallocated
+  /// if that never happens.
+  void addFileScopedCleanup(const SourceFile *file,
+                            std::function<void(void)> cleanup) const;
+
+  /// \brief Add a cleanup to run the given object's destructor when the given
+  /// file's file-scoped memory is released.
+  template<typename T>
+  void addFileScopedDestructorCleanup(const SourceFile *file,
+                                      T &object) const {
+    addFileScopedCleanup(file, [&object]{ object.~T(); });
+  }
+
+  /// \brief Run the cleanups for, and return to the system, all memory in
+  /// the given file's file-scoped allocator.
+  void releaseFileScopedMemory(const SourceFile *file);
+
   /// Allocate - Allocate memory from the ASTContext bump pointer.
   void *Allocate(unsigned long bytes, unsigned alignment,
                  AllocationArena arena = AllocationArena::Permanent) const {
@@ -299,7 +374,8 @@ public:
 
     if (LangOpts.UseMalloc)
       return AlignedAlloc(bytes, alignment);
-    
+
+    llvm::sys::SmartScopedLock<true> lock(getAllocatorLock());
     return getAllocator(arena).Allocate(bytes, alignment);
   }
 
@@ -767,6 +843,19 @@ public:
   InheritedProtocolConformance *
   getInheritedConformance(Type type, ProtocolConformance *inherited);
 
+  /// Retrieve a previously-recorded composition of substitution maps, that
+  /// is, the result of substituting the replacements of \p original through
+  /// \p applied. Returns \c None if the composition has not been computed.
+  Optional<SubstitutionMap>
+  getCachedSubstitutionMapComposition(SubstitutionMap original,
+                                      SubstitutionMap applied);
+
+  /// Record the result of composing \p original through \p applied, so
+  /// later requests for the same composition become a table lookup.
+  void recordSubstitutionMapComposition(SubstitutionMap original,
+                                        SubstitutionMap applied,
+                                        SubstitutionMap result);
+
   /// Record compiler-known protocol information in the AST.
   void recordKnownProtocols(ModuleDecl *Stdlib);
   
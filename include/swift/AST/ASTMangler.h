@@ -295,10 +295,7 @@ protected:
   
   void appendSymbolicReference(const DeclContext *context);
   
-  std::string mangleTypeWithoutPrefix(Type type) {
-    appendType(type);
-    return finalize();
-  }
+  std::string mangleTypeWithoutPrefix(Type type);
 };
 
 } // end namespace Mangle
@@ -16,6 +16,7 @@
 #include "swift/Basic/LLVM.h"
 #include "swift/Basic/UUID.h"
 #include "swift/AST/Identifier.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/Support/raw_ostream.h"
@@ -292,6 +293,22 @@ public:
   void printText(StringRef Text) override;
 };
 
+/// An AST printer that accumulates its output in a reusable in-memory
+/// buffer and forwards it to the underlying stream in large chunks,
+/// avoiding a stream write per token when batch-printing whole modules.
+class BufferedStreamPrinter : public StreamPrinter {
+  SmallString<0> Buffer;
+
+public:
+  explicit BufferedStreamPrinter(raw_ostream &OS) : StreamPrinter(OS) {}
+  ~BufferedStreamPrinter() { flush(); }
+
+  void printText(StringRef Text) override;
+
+  /// Write the buffered output to the underlying stream.
+  void flush();
+};
+
 /// AST stream printer that adds extra indentation to each line.
 class ExtraIndentStreamPrinter : public StreamPrinter {
   StringRef ExtraIndent;
@@ -184,6 +184,15 @@ class ASTScope {
       ///
       /// This accommodates the expansion of source files.
       mutable unsigned nextElement;
+
+      /// The most recent result of \c findInnermostEnclosingScope, used as
+      /// the starting point of the next search.
+      ///
+      /// Name lookups tend to cluster around nearby source locations, so
+      /// starting from the previous result usually finds the innermost scope
+      /// after climbing only a few parents instead of descending from the
+      /// root every time.
+      mutable const ASTScope *cachedInnermostScope;
     } sourceFile;
 
     /// A type declaration, for \c kind == ASTScopeKind::TypeDecl.
@@ -304,6 +313,11 @@ class ASTScope {
   /// Child scopes, sorted by source range.
   mutable SmallVector<ASTScope *, 4> storedChildren;
 
+  /// The declarations bound by this scope, computed and cached on the first
+  /// call to \c getLocalBindings(). The storage lives in the source file's
+  /// file-scoped arena, alongside the scope itself.
+  mutable Optional<ArrayRef<ValueDecl *>> cachedLocalBindings;
+
   /// Retrieve the active continuation.
   const ASTScope *getActiveContinuation() const;
 
@@ -333,6 +347,7 @@ class ASTScope {
       : ASTScope(ASTScopeKind::SourceFile, nullptr) {
     this->sourceFile.file = sourceFile;
     this->sourceFile.nextElement = nextElement;
+    this->sourceFile.cachedInnermostScope = nullptr;
   }
 
   /// Constructor that initializes a preexpanded node.
@@ -609,7 +624,11 @@ public:
   /// be found via qualified name lookup in a \c DeclContext, such as nominal
   /// type declarations or extensions thereof, or the source file itself. The
   /// client can perform such lookups using the result of \c getDeclContext().
-  SmallVector<ValueDecl *, 4> getLocalBindings() const;
+  ///
+  /// The result is memoized, so every lookup after the first that walks
+  /// through this scope pays a single pointer load rather than re-walking
+  /// the underlying AST node.
+  ArrayRef<ValueDecl *> getLocalBindings() const;
 
   /// Expand the entire scope map.
   ///
@@ -631,7 +650,7 @@ public:
 
   // Only allow allocation of scopes using the allocator of a particular source
   // file.
-  void *operator new(size_t bytes, const ASTContext &ctx,
+  void *operator new(size_t bytes, const SourceFile *file,
                      unsigned alignment = alignof(ASTScope));
   void *operator new(size_t Bytes, void *Mem) {
     assert(Mem);
@@ -54,6 +54,11 @@ public:
   bool isCached() const { return true; }
   Optional<AccessLevel> getCachedResult() const;
   void cacheResult(AccessLevel value) const;
+
+  // Persistent caching.
+  std::string getPersistentCacheKey(EvaluatorResultCache &cache) const;
+  static std::string serializeResult(AccessLevel value);
+  static Optional<AccessLevel> deserializeResult(llvm::StringRef value);
 };
 
 /// Request the setter AccessLevel of the given AbstractStorageDecl,
@@ -83,6 +88,11 @@ public:
   bool isCached() const { return true; }
   Optional<AccessLevel> getCachedResult() const;
   void cacheResult(AccessLevel value) const;
+
+  // Persistent caching.
+  std::string getPersistentCacheKey(EvaluatorResultCache &cache) const;
+  static std::string serializeResult(AccessLevel value);
+  static Optional<AccessLevel> deserializeResult(llvm::StringRef value);
 };
 
 /// Request the Default and Max AccessLevels of the given ExtensionDecl.
@@ -636,6 +636,14 @@ protected:
 private:
   llvm::PointerUnion<DeclContext *, ASTContext *> Context;
 
+  /// The AST mutation epoch of the last recorded mutation within this
+  /// declaration's subtree, or zero if no mutation has been recorded.
+  /// Maintained at module-scope granularity: \c markMutated() dirties the
+  /// top-level declaration enclosing the mutated one, and the AST verifier
+  /// uses it to re-verify only the subtrees that changed since its last
+  /// pass over the file.
+  unsigned MutationEpoch = 0;
+
   Decl(const Decl&) = delete;
   void operator=(const Decl&) = delete;
 
@@ -783,6 +791,19 @@ public:
   /// \brief Mark this declaration invalid.
   void setInvalid(bool isInvalid = true) { Bits.Decl.Invalid = isInvalid; }
 
+  /// \brief Record that this declaration (or something within it) has been
+  /// mutated, dirtying the enclosing module-scope declaration for the next
+  /// incremental AST verification pass.
+  void markMutated();
+
+  /// \brief The mutation epoch of the last recorded mutation within this
+  /// declaration's subtree, or zero if none has been recorded.
+  unsigned getMutationEpoch() const { return MutationEpoch; }
+
+  /// \brief Note that this declaration's subtree has been verified as of
+  /// the given mutation epoch.
+  void setMutationEpoch(unsigned epoch) { MutationEpoch = epoch; }
+
   /// \brief Determine whether this declaration was implicitly generated by the
   /// compiler (rather than explicitly written in source code).
   bool isImplicit() const { return Bits.Decl.Implicit; }
@@ -1993,6 +2014,7 @@ public:
 
   void setInit(unsigned i, Expr *E) {
     getMutablePatternList()[i].setInit(E);
+    markMutated();
   }
 
   Pattern *getPattern(unsigned i) const {
@@ -2095,7 +2117,10 @@ public:
       Body(Body) {}
 
   BraceStmt *getBody() const { return Body; }
-  void setBody(BraceStmt *b) { Body = b; }
+  void setBody(BraceStmt *b) {
+    Body = b;
+    markMutated();
+  }
 
   SourceLoc getStartLoc() const;
   SourceLoc getLoc() const { return getStartLoc(); }
@@ -5090,6 +5115,7 @@ public:
 
     Body = S;
     setBodyKind(NewBodyKind);
+    markMutated();
   }
 
   /// \brief Note that the body was skipped for this function.  Function body
@@ -5126,8 +5152,11 @@ public:
   /// This is kindof a hacky operation, but it avoids some unnecessary
   /// duplication of work.
   void setBodyTypeCheckedIfPresent() {
-    if (getBodyKind() == BodyKind::Parsed)
+    if (getBodyKind() == BodyKind::Parsed) {
       setBodyKind(BodyKind::TypeChecked);
+      // The body's expressions have been rewritten in place.
+      markMutated();
+    }
   }
 
   bool isBodyTypeChecked() const {
@@ -19,6 +19,7 @@
 #define SWIFT_AST_EVALUATOR_H
 
 #include "swift/AST/AnyRequest.h"
+#include "swift/AST/EvaluatorResultCache.h"
 #include "swift/Basic/AnyValue.h"
 #include "swift/Basic/CycleDiagnosticKind.h"
 #include "swift/Basic/Defer.h"
@@ -26,6 +27,9 @@
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/Support/PrettyStackTrace.h"
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -161,9 +165,24 @@ class Evaluator {
   std::vector<std::pair<uint8_t, ArrayRef<AbstractRequestFunction *>>>
     requestFunctionsByZone;
 
-  /// A vector containing all of the active evaluation requests, which
-  /// is treated as a stack and is used to detect cycles.
-  llvm::SetVector<AnyRequest> activeRequests;
+  /// Guards the request cache, the dependency graph, and the map of
+  /// per-thread active-request stacks.
+  ///
+  /// The lock is never held while a request function runs, so request
+  /// evaluation can recurse freely and independent request graphs can be
+  /// evaluated from multiple threads.
+  mutable std::mutex stateMutex;
+
+  /// The active evaluation requests for each thread, each treated as a stack
+  /// and used to detect cycles.
+  ///
+  /// Requests evaluated on one thread cannot form a cycle through requests
+  /// evaluated on another, so each thread tracks its own stack. This is a
+  /// std::map so that entries remain valid while other threads add their own.
+  std::map<uint64_t, llvm::SetVector<AnyRequest>> activeRequestsByThread;
+
+  /// Retrieve the active-request stack for the calling thread.
+  llvm::SetVector<AnyRequest> &getActiveRequests();
 
   /// A cache that stores the results of requests.
   llvm::DenseMap<AnyRequest, AnyValue> cache;
@@ -179,6 +198,11 @@ class Evaluator {
   /// so all clients must cope with cycles.
   llvm::DenseMap<AnyRequest, std::vector<AnyRequest>> dependencies;
 
+  /// Optional on-disk cache of request results that persists across
+  /// frontend invocations. Only requests that define the persistent-cache
+  /// hooks participate; see \c HasPersistentCache.
+  std::unique_ptr<EvaluatorResultCache> persistentCache;
+
   /// Retrieve the request function for the given zone and request IDs.
   AbstractRequestFunction *getAbstractRequestFunction(uint8_t zoneID,
                                                       uint8_t requestID) const;
@@ -201,6 +225,12 @@ public:
   /// statistics will be recorded.
   void setStatsReporter(UnifiedStatsReporter *stats) { this->stats = stats; }
 
+  /// Enable on-disk persistence of eligible request results in the cache
+  /// file at the given path.
+  void setPersistentCachePath(llvm::StringRef path) {
+    persistentCache.reset(new EvaluatorResultCache(path));
+  }
+
   /// Register the set of request functions for the given zone.
   ///
   /// These functions will be called to evaluate any requests within that
@@ -219,6 +249,7 @@ public:
     // Make sure we remove this from the set of active requests once we're
     // done.
     SWIFT_DEFER {
+      auto &activeRequests = getActiveRequests();
       assert(activeRequests.back() == request);
       activeRequests.pop_back();
     };
@@ -241,7 +272,10 @@ public:
   ///
   /// Note that this does not clear the caches of requests that use external
   /// caching.
-  void clearCache() { cache.clear(); }
+  void clearCache() {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    cache.clear();
+  }
 
 private:
   /// Diagnose a cycle detected in the evaluation of the given
@@ -278,12 +312,80 @@ private:
     return getResultUncached(request);
   }
 
+  /// Detects whether a request type participates in on-disk persistence.
+  /// Participating requests define the hooks:
+  /// \code
+  ///   std::string getPersistentCacheKey(EvaluatorResultCache &cache) const;
+  ///   static std::string serializeResult(OutputType value);
+  ///   static Optional<OutputType> deserializeResult(llvm::StringRef value);
+  /// \endcode
+  /// where \c getPersistentCacheKey returns an empty string for inputs whose
+  /// results cannot be identified stably across invocations.
+  template<typename Request, typename = void>
+  struct HasPersistentCache : public std::false_type {};
+
+  template<typename Request>
+  struct HasPersistentCache<Request,
+      decltype((void)&Request::getPersistentCacheKey)>
+    : public std::true_type {};
+
+  /// Look up a previously persisted result for the given request, if the
+  /// on-disk cache is enabled and has a valid entry.
+  template<typename Request,
+           typename std::enable_if<HasPersistentCache<Request>::value>::type
+             * = nullptr>
+  Optional<typename Request::OutputType>
+  getPersistedResult(const Request &request) {
+    if (!persistentCache)
+      return None;
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    auto key = request.getPersistentCacheKey(*persistentCache);
+    if (key.empty())
+      return None;
+    if (const auto *serialized = persistentCache->lookup(key))
+      return Request::deserializeResult(*serialized);
+    return None;
+  }
+
+  template<typename Request,
+           typename std::enable_if<!HasPersistentCache<Request>::value>::type
+             * = nullptr>
+  Optional<typename Request::OutputType>
+  getPersistedResult(const Request &) {
+    return None;
+  }
+
+  /// Persist the computed result for the given request, if the on-disk
+  /// cache is enabled.
+  template<typename Request,
+           typename std::enable_if<HasPersistentCache<Request>::value>::type
+             * = nullptr>
+  void persistResult(const Request &request,
+                     const typename Request::OutputType &result) {
+    if (!persistentCache)
+      return;
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    auto key = request.getPersistentCacheKey(*persistentCache);
+    if (!key.empty())
+      persistentCache->record(key, Request::serializeResult(result));
+  }
+
+  template<typename Request,
+           typename std::enable_if<!HasPersistentCache<Request>::value>::type
+             * = nullptr>
+  void persistResult(const Request &, const typename Request::OutputType &) {}
+
   /// Produce the result of the request without caching.
   template<typename Request>
   typename Request::OutputType getResultUncached(const Request &request) {
     // Clear out the dependencies on this request; we're going to recompute
     // them now anyway.
-    dependencies[request].clear();
+    {
+      std::lock_guard<std::mutex> lock(stateMutex);
+      dependencies[request].clear();
+    }
 
     PrettyStackTraceRequest<Request> prettyStackTrace(request);
 
@@ -303,11 +405,18 @@ private:
     if (auto cached = request.getCachedResult())
       return *cached;
 
+    // Consult the on-disk cache from a previous invocation, if any.
+    if (auto persisted = getPersistedResult(request)) {
+      request.cacheResult(*persisted);
+      return *persisted;
+    }
+
     // Compute the result.
     auto result = getResultUncached(request);
 
     // Cache the result.
     request.cacheResult(result);
+    persistResult(request, result);
 
     // Return it.
     return result;
@@ -322,15 +431,30 @@ private:
     AnyRequest anyRequest{request};
 
     // If we already have an entry for this request in the cache, return it.
-    auto known = cache.find(anyRequest);
-    if (known != cache.end()) {
-      return known->second.castTo<typename Request::OutputType>();
+    {
+      std::lock_guard<std::mutex> lock(stateMutex);
+      auto known = cache.find(anyRequest);
+      if (known != cache.end()) {
+        return known->second.castTo<typename Request::OutputType>();
+      }
     }
 
-    // Compute the result.
+    // Consult the on-disk cache from a previous invocation, if any.
+    if (auto persisted = getPersistedResult(request)) {
+      std::lock_guard<std::mutex> lock(stateMutex);
+      cache.insert({anyRequest, *persisted});
+      return *persisted;
+    }
+
+    // Compute the result. The lock is not held while the request function
+    // runs, so two threads can race to evaluate the same request; they
+    // compute the same immutable value, and the insertion below keeps
+    // whichever finished first.
     auto result = getResultUncached(request);
 
     // Cache the result.
+    persistResult(request, result);
+    std::lock_guard<std::mutex> lock(stateMutex);
     cache.insert({anyRequest, result});
     return result;
   }
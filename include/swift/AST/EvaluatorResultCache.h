@@ -0,0 +1,92 @@
+//===--- EvaluatorResultCache.h - Persistent Request Results ----*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the EvaluatorResultCache class, an on-disk store of
+//  request-evaluator results that persists across frontend invocations.
+//
+//===----------------------------------------------------------------------===//
+#ifndef SWIFT_AST_EVALUATOR_RESULT_CACHE_H
+#define SWIFT_AST_EVALUATOR_RESULT_CACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include <string>
+
+namespace swift {
+
+class Decl;
+
+/// An on-disk cache of request-evaluator results, so that a subsequent
+/// frontend invocation over unchanged source starts warm.
+///
+/// Entries are keyed by strings that requests derive from their inputs; a
+/// valid key must identify the input independently of the invocation (no
+/// pointers) and must incorporate a fingerprint of everything the result
+/// depends on. \c getKeyForDecl produces such a key for results that depend
+/// only on a declaration's own source file, folding in a content hash of
+/// that file so edits invalidate its entries.
+///
+/// The cache is loaded lazily on first lookup and written back when the
+/// cache object is destroyed, normally at the end of the frontend
+/// invocation. A missing or malformed cache file is treated as empty.
+class EvaluatorResultCache {
+  /// The path of the on-disk cache file.
+  std::string CachePath;
+
+  /// Whether the on-disk cache has been loaded.
+  bool Loaded = false;
+
+  /// Whether entries have been added since loading.
+  bool Dirty = false;
+
+  /// The cached entries, keyed by request-derived key strings.
+  llvm::StringMap<std::string> Entries;
+
+  /// Memoized content hashes of source buffers, keyed by buffer ID.
+  llvm::DenseMap<unsigned, uint64_t> BufferHashes;
+
+  /// Load the on-disk cache if it has not been loaded yet.
+  void load();
+
+  /// Write the cache back to disk if any entries were added.
+  void save();
+
+public:
+  explicit EvaluatorResultCache(llvm::StringRef cachePath)
+    : CachePath(cachePath) {}
+
+  ~EvaluatorResultCache() {
+    save();
+  }
+
+  EvaluatorResultCache(const EvaluatorResultCache &) = delete;
+  EvaluatorResultCache &operator=(const EvaluatorResultCache &) = delete;
+
+  /// Form a cache key for a request result that depends only on the given
+  /// declaration's own source file, tagged with the name of the request.
+  ///
+  /// \returns the key, or an empty string if the declaration cannot be
+  /// identified stably across invocations (e.g. it is implicit).
+  std::string getKeyForDecl(llvm::StringRef requestTag, const Decl *decl);
+
+  /// Look up the serialized result for the given key, or null if there is
+  /// no entry.
+  const std::string *lookup(llvm::StringRef key);
+
+  /// Record the serialized result for the given key.
+  void record(llvm::StringRef key, llvm::StringRef value);
+};
+
+} // end namespace swift
+
+#endif // SWIFT_AST_EVALUATOR_RESULT_CACHE_H
@@ -822,6 +822,11 @@ private:
   /// May be -1, to indicate no association with a buffer.
   int BufferID;
 
+  /// Whether this source file is a primary input of the current frontend
+  /// job, and so is type-checked in full rather than on demand. In
+  /// whole-module compilations every file is primary.
+  bool IsPrimary = false;
+
   /// The list of protocol conformances that were "used" within this
   /// source file.
   llvm::SetVector<NormalProtocolConformance *> UsedConformances;
@@ -893,6 +898,11 @@ public:
   /// forwarded on to IRGen.
   ASTStage_t ASTStage = Parsing;
 
+  /// The AST mutation epoch as of the most recent AST verification pass
+  /// over this file, or zero if the file has never been verified. A zero
+  /// value forces the verifier's full (non-incremental) walk.
+  unsigned LastVerifiedEpoch = 0;
+
   SourceFile(ModuleDecl &M, SourceFileKind K, Optional<unsigned> bufferID,
              ImplicitModuleImportKind ModImpKind, bool KeepParsedTokens = false,
              bool KeepSyntaxTree = false);
@@ -981,6 +991,12 @@ public:
 
   void createReferencedNameTracker();
 
+  /// Whether this source file is a primary input of the current frontend
+  /// job. Non-primary files are only validated as far as the primaries
+  /// demand.
+  bool isPrimary() const { return IsPrimary; }
+  void setIsPrimary() { IsPrimary = true; }
+
   /// \brief The buffer ID for the file that was imported, or None if there
   /// is no associated buffer.
   Optional<unsigned> getBufferID() const {
@@ -996,6 +1012,15 @@ public:
   /// Retrieve the scope that describes this source file.
   ASTScope &getScope();
 
+  /// Release the memory used by this file's scope map, returning it to the
+  /// system.
+  ///
+  /// The scope map is a pure function of the file's AST, so a later call to
+  /// \c getScope() will simply rebuild it; this is useful once the file has
+  /// been fully type checked and the scope map is unlikely to be needed
+  /// again.
+  void clearScope();
+
   void dump() const;
   void dump(raw_ostream &os) const;
 
@@ -55,6 +55,32 @@ struct TypeTransformContext {
   bool isPrintingSynthesizedExtension() const;
 };
 
+/// Memoizes the rendered text of types across a batch printing session,
+/// such as printing a whole module interface, so a type that occurs many
+/// times is formatted once and replayed as plain text afterwards.
+///
+/// Printers toggle a handful of rendering-relevant options per declaration
+/// while walking a module, so entries are keyed on that state along with
+/// the type itself to keep a shared table correct across those variations.
+class TypeStringMemoizer {
+  /// The type, the base type of any active transform context, and a
+  /// bitmask of the rendering-relevant flags from the options in effect.
+  using Key = std::pair<TypeBase *, std::pair<TypeBase *, unsigned>>;
+  llvm::DenseMap<Key, std::string> RenderedTypes;
+
+  static Key getKey(TypeBase *type, const PrintOptions &options);
+
+public:
+  /// Retrieve the memoized rendering of \p type under \p options, if any.
+  const std::string *lookup(TypeBase *type,
+                            const PrintOptions &options) const;
+
+  /// Record the rendering of \p type under \p options, returning the
+  /// stored text.
+  const std::string &record(TypeBase *type, const PrintOptions &options,
+                            std::string text);
+};
+
 class BracketOptions {
   Decl* Target;
   bool OpenExtension;
@@ -331,6 +357,11 @@ struct PrintOptions {
   /// \brief Print types with alternative names from their canonical names.
   llvm::DenseMap<CanType, Identifier> *AlternativeTypeNames = nullptr;
 
+  /// \brief If non-null, memoizes the rendered text of types printed with
+  /// these options. The replayed text bypasses the per-reference
+  /// ASTPrinter callbacks, so this must stay null for annotating printers.
+  TypeStringMemoizer *TypeMemoizer = nullptr;
+
   /// \brief The module in which the printer is used. Determines if the module
   /// name should be printed when printing a type.
   ModuleDecl *CurrentModule = nullptr;
@@ -47,6 +47,13 @@ public:
   /// above but the interactions between all the flags are tricky.
   bool MergePartialModules = false;
 
+  /// Skip SILGen for function bodies that would neither be serialized into
+  /// the swiftmodule nor inlined into a serialized body. Only sound for
+  /// compilations whose sole product is a module, which discard such bodies
+  /// anyway; diagnostics the mandatory passes would produce for the skipped
+  /// bodies are lost.
+  bool SkipNonInlinableFunctionBodies = false;
+
   /// Remove all runtime assertions during optimizations.
   bool RemoveRuntimeAsserts = false;
 
@@ -94,6 +94,66 @@ public:
   }
   void pushNewStorageSlow(std::size_t needed);
 
+  /// An owning handle to heap storage detached from a stack, allowing
+  /// clients to pool a stack's allocation across stack lifetimes instead
+  /// of re-growing it from the inline buffer every time.
+  class RecycledStorage {
+    friend class DiverseStackBase;
+    char *Allocation = nullptr;
+    std::size_t Capacity = 0;
+
+  public:
+    RecycledStorage() = default;
+    RecycledStorage(RecycledStorage &&other)
+        : Allocation(other.Allocation), Capacity(other.Capacity) {
+      other.Allocation = nullptr;
+      other.Capacity = 0;
+    }
+    RecycledStorage &operator=(RecycledStorage &&other) {
+      delete[] Allocation;
+      Allocation = other.Allocation;
+      Capacity = other.Capacity;
+      other.Allocation = nullptr;
+      other.Capacity = 0;
+      return *this;
+    }
+    RecycledStorage(const RecycledStorage &) = delete;
+    RecycledStorage &operator=(const RecycledStorage &) = delete;
+    ~RecycledStorage() { delete[] Allocation; }
+
+    explicit operator bool() const { return Allocation != nullptr; }
+    std::size_t getCapacity() const { return Capacity; }
+  };
+
+  /// If the stack is empty and owns a heap allocation, detach the
+  /// allocation and return it so that a later stack can adopt it.
+  /// Otherwise return an empty handle.  The stack stays valid either way;
+  /// after its storage is recycled it is back to zero capacity.
+  RecycledStorage recycleStorage() {
+    checkValid();
+    RecycledStorage result;
+    if (Begin != End || isAllocatedInline())
+      return result;
+    result.Allocation = Allocated;
+    result.Capacity = static_cast<std::size_t>(End - Allocated);
+    Begin = End = Allocated = reinterpret_cast<char *>(this + 1);
+    assert(isAllocatedInline());
+    return result;
+  }
+
+  /// Adopt storage previously recycled from another stack.  The stack must
+  /// be empty and must not have grown its own heap allocation yet.
+  void adoptRecycledStorage(RecycledStorage &&storage) {
+    assert(Begin == End && "adopting storage into a non-empty stack");
+    assert(isAllocatedInline() && "stack already grew its own storage");
+    if (!storage.Allocation)
+      return;
+    Allocated = storage.Allocation;
+    Begin = End = Allocated + storage.Capacity;
+    storage.Allocation = nullptr;
+    storage.Capacity = 0;
+  }
+
   /// A stable iterator is the equivalent of an index into the stack.
   /// It's an iterator that stays stable across modification of the
   /// stack.
@@ -242,6 +302,9 @@ public:
   using DiverseStackBase::stable_iterator;
   using DiverseStackBase::stable_begin;
   using DiverseStackBase::stable_end;
+  using DiverseStackBase::RecycledStorage;
+  using DiverseStackBase::recycleStorage;
+  using DiverseStackBase::adoptRecycledStorage;
 
   class const_iterator;
   class iterator {
@@ -173,6 +173,10 @@ namespace swift {
     CycleDiagnosticKind EvaluatorCycleDiagnostics =
         CycleDiagnosticKind::NoDiagnose;
 
+    /// If non-empty, the path of a file in which eligible request-evaluator
+    /// results are persisted across frontend invocations.
+    std::string EvaluatorResultCachePath;
+
     /// \brief The upper bound, in bytes, of temporary data that can be
     /// allocated by the constraint solver.
     unsigned SolverMemoryThreshold = 512 * 1024 * 1024;
@@ -186,6 +190,12 @@ namespace swift {
     /// Disable the shrink phase of the expression type checker.
     bool SolverDisableShrink = false;
 
+    /// If non-empty, a build-local directory in which the constraint solver
+    /// persists the overload choices of solved expressions across
+    /// invocations, keyed by expression contents. The recorded choices are
+    /// only used to order disjunction exploration.
+    std::string SolverSolutionCachePath;
+
     /// The maximum depth to which to test decl circularity.
     unsigned MaxCircularityDepth = 500;
 
@@ -211,7 +221,7 @@ namespace swift {
     bool EnableDeserializationRecovery = true;
 
     /// Should we use \c ASTScope-based resolution for unqualified name lookup?
-    bool EnableASTScopeLookup = false;
+    bool EnableASTScopeLookup = true;
 
     /// Whether to use the import as member inference system
     ///
@@ -39,8 +39,11 @@
 #include "swift/Basic/type_traits.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/PointerIntPair.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
+#include <cstring>
 #include <iterator>
 
 namespace swift {
@@ -195,6 +198,44 @@ private:
     return split;
   }
 
+  /// Return the length of the common prefix of the two keys.
+  ///
+  /// For byte-sized key elements this compares a word at a time and locates
+  /// the first mismatch in the xor of the two words, rather than comparing
+  /// element by element.  Every step of a lookup compares the node's local
+  /// key (up to InlineKeyCapacity bytes) against the lookup key, so this is
+  /// the hottest loop of the map.  Byte-sized elements are assumed to
+  /// compare as their object representation, which holds for the char and
+  /// unsigned char keys this map is used with.
+  static size_t commonPrefixLength(KeyType a, KeyType b) {
+    size_t len = std::min(a.size(), b.size());
+    if (sizeof(KeyElementType) == 1) {
+      size_t i = 0;
+      while (i != len) {
+        size_t chunk = std::min(len - i, sizeof(uint64_t));
+        uint64_t lhs = 0, rhs = 0;
+        memcpy(&lhs, a.data() + i, chunk);
+        memcpy(&rhs, b.data() + i, chunk);
+        if (uint64_t diff = lhs ^ rhs) {
+          // The index of the first mismatching byte is the number of zero
+          // bytes below it in the difference: trailing on little-endian
+          // hosts, leading on big-endian ones.
+          unsigned bits = llvm::sys::IsBigEndianHost
+                              ? llvm::countLeadingZeros(diff)
+                              : llvm::countTrailingZeros(diff);
+          return i + bits / 8;
+        }
+        i += chunk;
+      }
+      return len;
+    }
+    for (size_t i = 0; i != len; ++i) {
+      if (a[i] != b[i])
+        return i;
+    }
+    return len;
+  }
+
   /// Try to find a node corresponding to a prefix of the given key.
   ///
   /// If 'remainingLookupKey' is non-null, the returned node will correspond
@@ -217,10 +258,7 @@ private:
 
       // Compare the lookup key with the stored key in the node.
       size_t len = std::min(curKey.size(), lookupKey.size());
-      size_t i = 0;
-      for (; i != len; ++i) {
-         if (lookupKey[i] != curKey[i]) break;
-      }
+      size_t i = commonPrefixLength(lookupKey, curKey);
 
       // If we didn't reach the end of the common length, then we have two
       // basic cases:
@@ -14,10 +14,13 @@
 #define SWIFT_BASIC_SOURCEMANAGER_H
 
 #include "swift/Basic/SourceLoc.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/SourceMgr.h"
 #include <map>
+#include <vector>
 
 namespace swift {
 
@@ -42,6 +45,12 @@ class SourceManager {
   std::map<const char *, VirtualFile> VirtualFiles;
   mutable std::pair<const char *, const VirtualFile*> CachedVFile = {nullptr, nullptr};
 
+  /// Per-buffer index of the byte offsets at which each line starts, used to
+  /// answer line/column queries by binary search instead of rescanning the
+  /// buffer. Built on first use, or primed by the Lexer while the buffer is
+  /// hot in cache anyway.
+  mutable llvm::DenseMap<unsigned, std::vector<unsigned>> LineStartOffsets;
+
 public:
   llvm::SourceMgr &getLLVMSourceMgr() {
     return LLVMSourceMgr;
@@ -183,9 +192,9 @@ public:
   getLineAndColumn(SourceLoc Loc, unsigned BufferID = 0) const {
     assert(Loc.isValid());
     int LineOffset = getLineOffset(Loc);
-    int l, c;
-    std::tie(l, c) = LLVMSourceMgr.getLineAndColumn(Loc.Value, BufferID);
-    assert(LineOffset+l > 0 && "bogus line offset");
+    unsigned l, c;
+    std::tie(l, c) = getLineAndColumnRaw(Loc, BufferID);
+    assert(LineOffset+int(l) > 0 && "bogus line offset");
     return { LineOffset + l, c };
   }
 
@@ -196,9 +205,20 @@ public:
   /// This does not respect #line directives.
   unsigned getLineNumber(SourceLoc Loc, unsigned BufferID = 0) const {
     assert(Loc.isValid());
-    return LLVMSourceMgr.FindLineNumber(Loc.Value, BufferID);
+    return getLineAndColumnRaw(Loc, BufferID).first;
   }
 
+  /// Returns the line and column represented by the given source location
+  /// without taking #line directives into account.
+  ///
+  /// If \p BufferID is provided, \p Loc must come from that source buffer.
+  std::pair<unsigned, unsigned>
+  getLineAndColumnRaw(SourceLoc Loc, unsigned BufferID = 0) const;
+
+  /// Returns the byte offset at which each line of the given buffer begins,
+  /// computing and caching the index on first use.
+  ArrayRef<unsigned> getLineStartOffsets(unsigned BufferID) const;
+
   StringRef getEntireTextForBuffer(unsigned BufferID) const;
 
   StringRef extractText(CharSourceRange Range,
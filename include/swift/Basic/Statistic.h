@@ -104,6 +104,18 @@ public:
     const TraceFormatter *Formatter;
   };
 
+  // Sampled tracing is the continuously-affordable subset of the full event
+  // trace, for toolchains that want telemetry from every compilation: every
+  // stats event bumps a counter, every SampleEventPeriod-th event is
+  // additionally timestamped into a fixed-size ring buffer, and the ring is
+  // flushed at process exit or from the crash handler. Activated with
+  // -sample-stats-events.
+  struct EventSampler {
+    uint64_t EventCount = 0;
+    size_t NextSlot = 0;
+    std::vector<FrontendStatsEvent> Ring;
+  };
+
   // We only write fine-grained trace entries when the user passed
   // -trace-stats-events, but we recycle the same FrontendStatsTracers to give
   // us some free recursion-save phase timings whenever -trace-stats-dir is
@@ -123,6 +135,9 @@ private:
   int currentProcessExitStatus;
   SmallString<128> StatsFilename;
   SmallString<128> TraceFilename;
+  SmallString<128> TimelineFilename;
+  SmallString<128> TimersFilename;
+  SmallString<128> SampleFilename;
   SmallString<128> ProfileDirname;
   llvm::TimeRecord StartedTime;
 
@@ -136,6 +151,14 @@ private:
   Optional<AlwaysOnFrontendCounters> LastTracedFrontendCounters;
   Optional<std::vector<FrontendStatsEvent>> FrontendStatsEvents;
 
+  // When -trace-stats-events is active we keep, besides the per-counter event
+  // trace above, one record per FrontendStatsTracer entry and exit; on exit
+  // these are written out as a chrome://tracing-compatible JSON timeline so a
+  // slow frontend job can be opened directly in a flame-graph viewer. The
+  // counter fields of the reused FrontendStatsEvent are unused here.
+  Optional<std::vector<FrontendStatsEvent>> TimelineEvents;
+  Optional<EventSampler> Sampler;
+
   // These are unique_ptr so we can use incomplete types here.
   std::unique_ptr<RecursionSafeTimers> RecursiveTimers;
   std::unique_ptr<StatsProfilers> EventProfilers;
@@ -151,7 +174,8 @@ private:
                        clang::SourceManager *CSM,
                        bool TraceEvents,
                        bool ProfileEvents,
-                       bool ProfileEntities);
+                       bool ProfileEntities,
+                       bool SampleEvents);
 public:
   UnifiedStatsReporter(StringRef ProgramName,
                        StringRef ModuleName,
@@ -164,13 +188,19 @@ public:
                        clang::SourceManager *CSM=nullptr,
                        bool TraceEvents=false,
                        bool ProfileEvents=false,
-                       bool ProfileEntities=false);
+                       bool ProfileEntities=false,
+                       bool SampleEvents=false);
   ~UnifiedStatsReporter();
 
   AlwaysOnDriverCounters &getDriverCounters();
   AlwaysOnFrontendCounters &getFrontendCounters();
   void noteCurrentProcessExitStatus(int);
   void saveAnyFrontendStatsEvents(FrontendStatsTracer const &T, bool IsEntry);
+
+  /// Write out (and clear) the sampled-event ring buffer, if sampling is
+  /// active. Called from the destructor on normal exit, and from the crash
+  /// handler so an in-flight sample trace survives compiler crashes.
+  void flushSampledTrace();
 };
 
 // This is a non-nested type just to make it less work to write at call sites.
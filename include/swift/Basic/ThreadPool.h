@@ -0,0 +1,145 @@
+//===--- ThreadPool.h - In-process work-stealing thread pool ----*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// A shared executor for in-frontend parallelism.  Unlike sys::TaskQueue,
+// which launches subprocesses, ThreadPool runs closures on a fixed set of
+// worker threads inside the current process.
+//
+// Each worker owns a set of deques, one per priority class.  Tasks enqueued
+// from a worker go onto that worker's own deque and are popped LIFO for
+// locality; idle workers steal FIFO from other workers' deques.  Priorities
+// are advisory: a worker always prefers higher-priority work, but tasks of
+// different priorities may still run concurrently on different workers.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_BASIC_THREADPOOL_H
+#define SWIFT_BASIC_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace swift {
+
+class ThreadPool {
+public:
+  /// Relative scheduling priority of a task.  Lower values are scheduled
+  /// first when a worker picks its next task.
+  enum class Priority : uint8_t {
+    High = 0,
+    Default,
+    Low,
+  };
+
+  /// A handle for waiting on the completion of a related set of tasks.
+  ///
+  /// A group may be reused: once wait() returns, new tasks can be enqueued
+  /// against it.  The group must outlive all tasks enqueued against it.
+  class TaskGroup {
+    friend class ThreadPool;
+
+    std::mutex Mtx;
+    std::condition_variable AllDone;
+    size_t PendingTasks = 0;
+
+    void taskEnqueued();
+    void taskFinished();
+
+  public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    /// Block until every task enqueued against this group has finished,
+    /// including tasks those tasks enqueue.  Call this from outside the
+    /// pool, not from a task running on it: the waiting thread does not
+    /// help execute tasks, so waiting on a worker can deadlock the pool.
+    void wait();
+  };
+
+  /// Create a pool with \p NumThreads workers; 0 means
+  /// getDefaultNumThreads().
+  explicit ThreadPool(unsigned NumThreads = 0);
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /// Runs all tasks that have been enqueued, including tasks they enqueue in
+  /// turn, then joins the worker threads.  Shutdown is deterministic: no
+  /// enqueued task is dropped.
+  ~ThreadPool();
+
+  unsigned getNumThreads() const { return (unsigned)Workers.size(); }
+
+  /// Enqueue a task.  Tasks enqueued from within a task running on this pool
+  /// go onto the current worker's own deque.
+  void async(std::function<void()> Fn,
+             Priority Prio = Priority::Default);
+
+  /// Enqueue a task against a group, so that TaskGroup::wait can be used to
+  /// wait for its completion.
+  void async(TaskGroup &Group, std::function<void()> Fn,
+             Priority Prio = Priority::Default);
+
+  /// The number of workers a default-sized pool gets: the value of the
+  /// SWIFT_THREAD_POOL_SIZE environment variable if set, otherwise the
+  /// number of hardware threads.  Always at least 1.
+  static unsigned getDefaultNumThreads();
+
+private:
+  static const unsigned NumPriorities = 3;
+
+  struct Task {
+    std::function<void()> Fn;
+    TaskGroup *Group;
+  };
+
+  /// One worker's deques, guarded by the worker's own mutex so that
+  /// stealing only contends with the owner, not with the whole pool.
+  struct Worker {
+    std::mutex Mtx;
+    std::deque<Task> Queues[NumPriorities];
+  };
+
+  std::vector<std::unique_ptr<Worker>> Workers;
+  std::vector<std::thread> Threads;
+
+  /// Guards sleeping and the shutdown flag; the queues themselves are
+  /// guarded per-worker.
+  std::mutex SleepMtx;
+  std::condition_variable WorkAvailable;
+  bool ShuttingDown = false;
+
+  /// Number of tasks enqueued but not yet dequeued, used as the sleep/wake
+  /// predicate so enqueues cannot be lost between a failed scan and going
+  /// to sleep.
+  std::atomic<size_t> QueuedTasks;
+
+  /// Round-robin cursor for distributing tasks enqueued from outside the
+  /// pool.
+  std::atomic<unsigned> NextWorker;
+
+  void enqueue(Task &&T, Priority Prio);
+  bool scanForTask(unsigned Index, Task &T);
+  void workerLoop(unsigned Index);
+};
+
+} // end namespace swift
+
+#endif // SWIFT_BASIC_THREADPOOL_H
@@ -20,6 +20,14 @@
 namespace swift {
   /// A convenience class for declaring a timer that's part of the Swift
   /// compilation timers group.
+  ///
+  /// Shared timers nest: every live SharedTimer is a region on a
+  /// thread-local stack, and elapsed time is charged to the full path of
+  /// open regions ("Type checking / Semantic analysis;ClangImporter") rather
+  /// than only the innermost name, so the aggregated report shows where
+  /// inside a phase the time actually went.  The flat llvm::NamedRegionTimer
+  /// group is still maintained for the familiar -debug-time-compilation
+  /// output.
   class SharedTimer {
     enum class State {
       Initial,
@@ -32,10 +40,20 @@ namespace swift {
 
   public:
     explicit SharedTimer(StringRef name) {
-      if (CompilationTimersEnabled == State::Enabled)
+      if (CompilationTimersEnabled == State::Enabled) {
         Timer.emplace(name, name, "swift", "Swift compilation");
-      else
+        beginRegion(name);
+      } else {
         CompilationTimersEnabled = State::Skipped;
+      }
+    }
+
+    SharedTimer(const SharedTimer &) = delete;
+    SharedTimer &operator=(const SharedTimer &) = delete;
+
+    ~SharedTimer() {
+      if (Timer)
+        endRegion();
     }
 
     /// Must be called before any SharedTimers have been created.
@@ -44,6 +62,25 @@ namespace swift {
              "a timer has already been created");
       CompilationTimersEnabled = State::Enabled;
     }
+
+    /// True if any nested region times have been aggregated yet.
+    static bool hasHierarchicalTimes();
+
+    /// Print wall-clock self-times aggregated by the path of nested regions,
+    /// one "Region;Nested;... <microseconds>" line per path, in flamegraph
+    /// input format.  UnifiedStatsReporter writes this report into the stats
+    /// output directory on exit.
+    static void printHierarchicalTimes(raw_ostream &OS);
+
+  private:
+    /// Push a named region onto this thread's stack of open regions,
+    /// charging the time since the last region boundary to the enclosing
+    /// path.
+    static void beginRegion(StringRef name);
+
+    /// Charge the time since the last region boundary to the current path
+    /// and pop the innermost region.
+    static void endRegion();
   };
 } // end namespace swift
 
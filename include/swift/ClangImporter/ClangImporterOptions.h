@@ -94,6 +94,15 @@ public:
   /// and this is not set, clang will rebuild the module.
   bool DisableModulesValidateSystemHeaders = false;
 
+  /// When set, validate a module's inputs at most once per build session:
+  /// once a module has been validated or built during the session defined by
+  /// \c BuildSessionFilePath, later jobs skip the per-header stat calls.
+  bool ValidateModulesOnce = false;
+
+  /// The path to a file whose modification time defines the current build
+  /// session when \c ValidateModulesOnce is set.
+  std::string BuildSessionFilePath;
+
   /// When set, don't look for or load adapter modules.
   bool DisableAdapterModules = false;
 
@@ -118,6 +127,7 @@ public:
     Code = hash_combine(Code, InferImportAsMember);
     Code = hash_combine(Code, DisableSwiftBridgeAttr);
     Code = hash_combine(Code, DisableModulesValidateSystemHeaders);
+    Code = hash_combine(Code, ValidateModulesOnce);
     Code = hash_combine(Code, DisableAdapterModules);
     return Code;
   }
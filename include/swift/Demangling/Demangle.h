@@ -127,6 +127,7 @@ enum class Directness {
 
 class NodeFactory;
 class Context;
+class SymbolDemanglingCache;
 
 class Node {
 public:
@@ -302,6 +303,10 @@ class Demangler;
 class Context {
   Demangler *D;
 
+  /// An optional cache of printed symbol demanglings, see
+  /// setSymbolDemanglingCacheSize().
+  SymbolDemanglingCache *Cache = nullptr;
+
   friend class Node;
 
 public:
@@ -309,6 +314,18 @@ public:
 
   ~Context();
 
+  /// Sets the capacity of the symbol demangling cache.
+  ///
+  /// When enabled, demangleSymbolAsString() remembers the printed form of the
+  /// \p MaxEntries most recently demangled symbols and answers repeated
+  /// requests for the same symbol (with the same options) without demangling
+  /// it again. Only the printed strings are cached; node trees are not,
+  /// because their memory is recycled by clear().
+  ///
+  /// The cache is disabled by default. Passing 0 disables it again and frees
+  /// its memory.
+  void setSymbolDemanglingCacheSize(size_t MaxEntries);
+
   /// Demangle the given symbol and return the parse tree.
   ///
   /// \param MangledName The mangled symbol string, which start a mangling
@@ -498,11 +515,33 @@ std::string mangleNodeOld(const NodePointer &root);
 std::string nodeToString(NodePointer Root,
                          const DemangleOptions &Options = DemangleOptions());
 
+/// \brief Transform the node structure to a string, reusing the storage of
+/// \p Out for the result.
+///
+/// The previous contents of \p Out are replaced. Its capacity is carried
+/// through the printer and back, so printing many symbols into the same
+/// string stops allocating once it has grown to the size of the largest
+/// demangling.
+///
+/// \param Root A pointer to a parse tree generated by the demangler.
+/// \param Out The string the demangled name is written into.
+/// \param Options An object encapsulating options to use to perform this demangling.
+///
+void nodeToString(NodePointer Root, std::string &Out,
+                  const DemangleOptions &Options = DemangleOptions());
+
 /// A class for printing to a std::string.
 class DemanglerPrinter {
 public:
   DemanglerPrinter() = default;
 
+  /// Creates a printer which writes into the storage of \p Storage,
+  /// discarding its contents but reusing its capacity.
+  explicit DemanglerPrinter(std::string &&Storage)
+      : Stream(std::move(Storage)) {
+    Stream.clear();
+  }
+
   DemanglerPrinter &operator<<(llvm::StringRef Value) & {
     Stream.append(Value.data(), Value.size());
     return *this;
@@ -304,6 +304,10 @@ protected:
   
   std::function<NodePointer (int32_t, const void *)> SymbolicReferenceResolver;
 
+  /// Whether the string currently being demangled contained symbolic
+  /// references.
+  bool EncounteredSymbolicReferences = false;
+
   bool nextIf(StringRef str) {
     if (!Text.substr(Pos).startswith(str)) return false;
     Pos += str.size();
@@ -487,6 +491,15 @@ public:
                   std::function<NodePointer (int32_t, const void*)> resolver) {
     SymbolicReferenceResolver = resolver;
   }
+
+  /// True if the most recently demangled string contained symbolic
+  /// references.
+  ///
+  /// A compiler-produced mangling without symbolic references is already in
+  /// canonical form, so remangling its parse tree reproduces the original
+  /// bytes; callers which only remangle to normalize such strings can use
+  /// the input directly instead.
+  bool hasSymbolicReferences() const { return EncounteredSymbolicReferences; }
   
   /// Demangle the given symbol and return the parse tree.
   ///
@@ -15,6 +15,7 @@
 
 #include "llvm/ADT/StringRef.h"
 #include "swift/Demangling/Punycode.h"
+#include <cstdint>
 
 namespace swift {
 namespace Mangle {
@@ -76,8 +77,26 @@ struct SubstitutionWord {
 
   /// The length of the word.
   size_t length;
+
+  /// The fingerprint of the word's text (see wordFingerprint).  Cached so
+  /// that candidate lookup can reject non-matching words without re-reading
+  /// the mangling buffer.
+  uint64_t fingerprint;
 };
 
+/// Returns a value identifying the content of a substitution word.
+///
+/// Equal strings always map to equal fingerprints, so a fingerprint mismatch
+/// rules a candidate out immediately; a fingerprint match still has to be
+/// verified by comparing the strings.
+inline uint64_t wordFingerprint(StringRef Word) {
+  uint64_t FP = Word.size();
+  size_t NumSampled = Word.size() < 8 ? Word.size() : 8;
+  for (size_t i = 0; i != NumSampled; ++i)
+    FP = FP * 33 + (unsigned char)Word[i];
+  return FP;
+}
+
 /// Helper struct which represents a word substitution.
 struct WordReplacement {
   /// The position in the identifier where the word is substituted.
@@ -138,12 +157,15 @@ void mangleIdentifier(Mangler &M, StringRef ident) {
       assert(Pos > wordStartPos);
       size_t wordLen = Pos - wordStartPos;
       StringRef Word = ident.substr(wordStartPos, wordLen);
+      uint64_t WordFP = wordFingerprint(Word);
 
       // Helper function to lookup the Word in a string.
       auto lookupWord = [&] (StringRef Str,
                              size_t FromWordIdx, size_t ToWordIdx) -> int {
         for (size_t Idx = FromWordIdx; Idx < ToWordIdx; ++Idx) {
           const SubstitutionWord &w = M.Words[Idx];
+          if (w.fingerprint != WordFP)
+            continue;
           StringRef existingWord =  Str.substr(w.start, w.length);
           if (Word == existingWord)
             return (int)Idx;
@@ -166,7 +188,7 @@ void mangleIdentifier(Mangler &M, StringRef ident) {
         // Note: at this time the word's start position is relative to the
         // begin of the identifier. We must update it afterwards so that it is
         // relative to the begin of the whole mangled Buffer.
-        M.Words.push_back({wordStartPos, wordLen});
+        M.Words.push_back({wordStartPos, wordLen, WordFP});
       }
       wordStartPos = NotInsideWord;
     }
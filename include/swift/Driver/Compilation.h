@@ -147,6 +147,12 @@ private:
   /// If unknown, this will be some time in the past.
   llvm::sys::TimePoint<> LastBuildTime = llvm::sys::TimePoint<>::min();
 
+  /// The union of external dependencies recorded by the previous build, if
+  /// its compilation record carried one. Lets a null build verify that no
+  /// depended-upon module changed without parsing any swiftdeps files; None
+  /// if the record predates the list or could not be read.
+  Optional<std::vector<std::string>> LastBuildExternalDependencies;
+
   /// Indicates whether this Compilation should continue execution of subtasks
   /// even if they returned an error status.
   bool ContinueBuildingAfterErrors = false;
@@ -339,6 +345,14 @@ public:
     return LastBuildTime;
   }
 
+  const Optional<std::vector<std::string>> &
+  getLastBuildExternalDependencies() const {
+    return LastBuildExternalDependencies;
+  }
+  void setLastBuildExternalDependencies(std::vector<std::string> deps) {
+    LastBuildExternalDependencies = std::move(deps);
+  }
+
   Optional<unsigned> getBatchCount() const {
     return BatchCount;
   }
@@ -180,6 +180,10 @@ public:
   /// entity.
   bool ProfileEntities = false;
 
+  /// Keep a sampled trace of stats events in StatsOutputDir; cheap enough to
+  /// leave on for every compilation.
+  bool SampleEvents = false;
+
   /// If true, serialization encodes an extra lookup table for use in module-
   /// merging when emitting partial modules (the per-file modules in a non-WMO
   /// build).
@@ -211,6 +215,12 @@ public:
   /// by the Clang importer as part of semantic analysis.
   bool SerializeBridgingHeader = false;
 
+  /// If set, function bodies are only brace-matched during parsing and
+  /// recorded as skipped, producing an outline AST that is sufficient for
+  /// name binding, indexing and dependency scanning but cannot be fully
+  /// type checked or lowered.
+  bool SkipFunctionBodies = false;
+
   /// Indicates whether or not the frontend should print statistics upon
   /// termination.
   bool PrintStats = false;
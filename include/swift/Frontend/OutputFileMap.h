@@ -30,6 +30,19 @@ namespace swift {
 
 using TypeToPathMap = llvm::DenseMap<file_types::ID, std::string>;
 
+/// A two-level map from input paths to output types to output paths, read
+/// from the build system's output file map.
+///
+/// Parsing is deliberately split so the large, generated map is only read
+/// once per build: the driver parses the user-provided map a single time (see
+/// Driver::buildOutputFileMap) and derives per-job output maps from it. Each
+/// frontend process is then handed only the entries for its own primary
+/// inputs, written as a small map to a temporary file and passed via
+/// -supplementary-output-file-map (see FilelistInfo::WhichFiles::
+/// SupplementaryOutput on the driver side and SupplementaryOutputPathsComputer
+/// ::readSupplementaryOutputFileMap in the frontend). No frontend ever
+/// re-parses the full map, so growth in the map's size costs each frontend
+/// only its own share.
 class OutputFileMap {
 private:
   llvm::StringMap<TypeToPathMap> InputToOutputsMap;
@@ -35,6 +35,18 @@ public:
                                               SourceRange BodyRange) = 0;
 };
 
+/// \brief Callbacks for clients that never need function bodies, such as
+/// indexing and dependency scanning. Bodies are brace-matched and recorded
+/// as skipped without ever being parsed.
+class SkipFunctionBodiesCallbacks : public DelayedParsingCallbacks {
+  bool shouldDelayFunctionBodyParsing(Parser &TheParser,
+                                      AbstractFunctionDecl *AFD,
+                                      const DeclAttributes &Attrs,
+                                      SourceRange BodyRange) override {
+    return false;
+  }
+};
+
 class AlwaysDelayedCallbacks : public DelayedParsingCallbacks {
   bool shouldDelayFunctionBodyParsing(Parser &TheParser,
                                       AbstractFunctionDecl *AFD,
@@ -183,6 +183,17 @@ private:
                      std::pair<const FieldDescriptor *, const ReflectionInfo *>>
                      FieldTypeInfoCache;
 
+  /// Cache for decodeMangledType, keyed by the mangled text. Decoded
+  /// typerefs live as long as the builder, so the cached pointers stay
+  /// valid.
+  std::unordered_map<std::string, const TypeRef *> DecodedTypeCache;
+
+  /// The number of entries of ReflectionInfos whose field sections have
+  /// already been indexed into FieldTypeInfoCache. Sections past this point
+  /// are only indexed when a lookup misses the cache, so looking up one type
+  /// does not decode the field descriptors of every registered image.
+  size_t NumIndexedReflectionInfos = 0;
+
   TypeConverter TC;
   MetadataSourceBuilder MSB;
 
@@ -367,6 +378,13 @@ public:
 
   TypeConverter &getTypeConverter() { return TC; }
 
+  /// Demangle and decode a mangled type name into a typeref.
+  ///
+  /// Decoded typerefs are memoized by their mangled text, so the same type
+  /// reference — which recurs constantly across the field records of
+  /// related types — is only decoded once per builder.
+  const TypeRef *decodeMangledType(llvm::StringRef MangledName);
+
   const TypeRef *
   lookupTypeWitness(const std::string &MangledTypeName,
                     const std::string &Member,
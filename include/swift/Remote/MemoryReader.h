@@ -21,11 +21,13 @@
 #include "swift/Remote/RemoteAddress.h"
 #include "swift/SwiftRemoteMirror/MemoryReaderInterface.h"
 
+#include <algorithm>
 #include <cstring>
 #include <functional>
 #include <memory>
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace swift {
 namespace remote {
@@ -92,11 +94,69 @@ public:
     auto Ptr = readBytes(address, size);
     if (!Ptr)
       return false;
-    
+
     memcpy(dest, Ptr.get(), size);
     return true;
   }
-          
+
+  /// A contiguous range of remote memory to be filled in by readRanges.
+  struct ReadRange {
+    RemoteAddress Address;
+    uint64_t Size;
+    uint8_t *Dest;
+
+    ReadRange(RemoteAddress address, uint64_t size, uint8_t *dest)
+      : Address(address), Size(size), Dest(dest) {}
+  };
+
+  /// Attempts to read several independent ranges from the remote process.
+  ///
+  /// The default implementation coalesces adjacent and overlapping ranges
+  /// and issues one readBytes call per coalesced extent. Transports for
+  /// which every read is a round trip (such as a debugserver connection)
+  /// should override this to service the whole batch with one request.
+  ///
+  /// Returns false if any of the reads failed; the contents of the
+  /// destination buffers are unspecified in that case.
+  virtual bool readRanges(std::vector<ReadRange> &ranges) {
+    if (ranges.empty())
+      return true;
+
+    std::vector<const ReadRange *> sorted;
+    sorted.reserve(ranges.size());
+    for (auto &range : ranges)
+      sorted.push_back(&range);
+    std::sort(sorted.begin(), sorted.end(),
+              [](const ReadRange *lhs, const ReadRange *rhs) {
+      return lhs->Address.getAddressData() < rhs->Address.getAddressData();
+    });
+
+    size_t i = 0;
+    while (i < sorted.size()) {
+      // Grow the extent while the next range starts within it.
+      uint64_t begin = sorted[i]->Address.getAddressData();
+      uint64_t end = begin + sorted[i]->Size;
+      size_t e = i + 1;
+      while (e < sorted.size() &&
+             sorted[e]->Address.getAddressData() <= end) {
+        end = std::max(end, sorted[e]->Address.getAddressData()
+                              + sorted[e]->Size);
+        ++e;
+      }
+
+      auto buffer = readBytes(RemoteAddress(begin), end - begin);
+      if (!buffer)
+        return false;
+      for (; i < e; ++i) {
+        auto offset = sorted[i]->Address.getAddressData() - begin;
+        memcpy(sorted[i]->Dest,
+               reinterpret_cast<const uint8_t *>(buffer.get()) + offset,
+               sorted[i]->Size);
+      }
+    }
+    return true;
+  }
+
   virtual ~MemoryReader() = default;
 };
 
@@ -19,6 +19,7 @@
 
 #include "swift/Runtime/Metadata.h"
 #include "swift/Remote/MemoryReader.h"
+#include "swift/Remote/ReadAheadMemoryReader.h"
 #include "swift/Demangling/Demangler.h"
 #include "swift/Demangling/TypeDecoder.h"
 #include "swift/Basic/Range.h"
@@ -180,6 +181,15 @@ public:
 
   std::shared_ptr<MemoryReader> Reader;
 
+private:
+  /// The reader passed to the constructor, when Reader is a read-ahead
+  /// cache wrapped around it.
+  std::shared_ptr<MemoryReader> UnderlyingReader;
+
+  /// Reader, as a read-ahead cache, when one is installed.
+  std::shared_ptr<ReadAheadMemoryReader> ReadAheadReader;
+
+public:
   template <class... T>
   MetadataReader(std::shared_ptr<MemoryReader> reader, T &&... args)
     : Builder(std::forward<T>(args)...),
@@ -190,11 +200,34 @@ public:
   MetadataReader(const MetadataReader &other) = delete;
   MetadataReader &operator=(const MetadataReader &other) = delete;
 
+  /// Interpose a read-ahead cache between this reader and its memory
+  /// reader, so that clusters of small reads cost one underlying request
+  /// per \p blockSize block instead of one request each. A \p blockSize of
+  /// zero removes the cache; it must otherwise be a power of two.
+  ///
+  /// The cache assumes the remote process is stopped; clear() discards any
+  /// cached memory along with the metadata caches.
+  void setReadAheadCache(uint64_t blockSize, size_t maxBlocks = 64) {
+    if (!UnderlyingReader)
+      UnderlyingReader = Reader;
+    if (blockSize == 0) {
+      Reader = UnderlyingReader;
+      UnderlyingReader = nullptr;
+      ReadAheadReader = nullptr;
+      return;
+    }
+    ReadAheadReader = std::make_shared<ReadAheadMemoryReader>(
+        UnderlyingReader, blockSize, maxBlocks);
+    Reader = ReadAheadReader;
+  }
+
   /// Clear all of the caches in this reader.
   void clear() {
     TypeCache.clear();
     MetadataCache.clear();
     ContextDescriptorCache.clear();
+    if (ReadAheadReader)
+      ReadAheadReader->clearCache();
   }
 
   /// Given a demangle tree, attempt to turn it into a type.
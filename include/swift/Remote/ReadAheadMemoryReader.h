@@ -0,0 +1,146 @@
+//===--- ReadAheadMemoryReader.h - Cached access to remote memory -*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file declares a MemoryReader which wraps another reader and fetches
+//  fixed-size blocks ahead of need, so that chains of small reads into the
+//  same region of the remote process cost one underlying request instead of
+//  one per read.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_REMOTE_READAHEADMEMORYREADER_H
+#define SWIFT_REMOTE_READAHEADMEMORYREADER_H
+
+#include "swift/Remote/MemoryReader.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace swift {
+namespace remote {
+
+/// A MemoryReader which serves small reads from cached, block-aligned
+/// fetches against an underlying reader.
+///
+/// Metadata walks are chains of dependent pointer chases which cannot be
+/// batched, but they are strongly clustered: the fields of a metadata record
+/// and its neighboring records land in the same few blocks. Over a
+/// round-trip-bound transport such as a debugserver connection, fetching a
+/// whole block at a time collapses those chains into a handful of requests.
+///
+/// The cache assumes the inspected region of the remote process is not
+/// mutated while it is in use; call clearCache() after the remote process
+/// has been allowed to run.
+class ReadAheadMemoryReader final : public MemoryReader {
+  std::shared_ptr<MemoryReader> Inner;
+
+  /// The size of each cached block; always a power of two.
+  uint64_t BlockSize;
+
+  /// The maximum number of blocks kept alive at once.
+  size_t MaxBlocks;
+
+  struct Block {
+    uint64_t BaseAddress;
+    std::unique_ptr<uint8_t[]> Bytes;
+  };
+
+  /// All cached blocks, in most-recently-used order.
+  std::list<Block> Blocks;
+
+  std::unordered_map<uint64_t, std::list<Block>::iterator> BlockMap;
+
+  /// Returns the cached block containing \p baseAddress, fetching it from
+  /// the underlying reader if necessary, or nullptr if the fetch failed.
+  const Block *getBlock(uint64_t baseAddress) {
+    auto found = BlockMap.find(baseAddress);
+    if (found != BlockMap.end()) {
+      Blocks.splice(Blocks.begin(), Blocks, found->second);
+      return &*found->second;
+    }
+
+    std::unique_ptr<uint8_t[]> bytes(new uint8_t[BlockSize]);
+    if (!Inner->readBytes(RemoteAddress(baseAddress), bytes.get(), BlockSize))
+      return nullptr;
+
+    if (Blocks.size() >= MaxBlocks) {
+      BlockMap.erase(Blocks.back().BaseAddress);
+      Blocks.pop_back();
+    }
+    Blocks.push_front(Block{baseAddress, std::move(bytes)});
+    BlockMap.emplace(baseAddress, Blocks.begin());
+    return &Blocks.front();
+  }
+
+public:
+  ReadAheadMemoryReader(std::shared_ptr<MemoryReader> inner,
+                        uint64_t blockSize, size_t maxBlocks)
+      : Inner(std::move(inner)), BlockSize(blockSize), MaxBlocks(maxBlocks) {
+    assert(blockSize > 0 && (blockSize & (blockSize - 1)) == 0 &&
+           "block size must be a power of two");
+    assert(maxBlocks > 0);
+  }
+
+  /// Discard all cached blocks, e.g. because the remote process has been
+  /// allowed to run.
+  void clearCache() {
+    Blocks.clear();
+    BlockMap.clear();
+  }
+
+  bool queryDataLayout(DataLayoutQueryType type, void *inBuffer,
+                       void *outBuffer) override {
+    return Inner->queryDataLayout(type, inBuffer, outBuffer);
+  }
+
+  RemoteAddress getSymbolAddress(const std::string &name) override {
+    return Inner->getSymbolAddress(name);
+  }
+
+  bool readString(RemoteAddress address, std::string &dest) override {
+    return Inner->readString(address, dest);
+  }
+
+  bool readBytes(RemoteAddress address, uint8_t *dest,
+                 uint64_t size) override {
+    // Serve large reads directly; they would only churn the cache.
+    if (size > BlockSize)
+      return Inner->readBytes(address, dest, size);
+
+    uint64_t addr = address.getAddressData();
+    while (size > 0) {
+      uint64_t base = addr & ~(BlockSize - 1);
+      auto *block = getBlock(base);
+      // The block may extend past the readable region even though the
+      // requested range does not; retry the exact request.
+      if (!block)
+        return Inner->readBytes(RemoteAddress(addr), dest, size);
+
+      uint64_t offset = addr - base;
+      uint64_t chunk = std::min(size, BlockSize - offset);
+      memcpy(dest, block->Bytes.get() + offset, chunk);
+      addr += chunk;
+      dest += chunk;
+      size -= chunk;
+    }
+    return true;
+  }
+};
+
+} // end namespace remote
+} // end namespace swift
+
+#endif // SWIFT_REMOTE_READAHEADMEMORYREADER_H
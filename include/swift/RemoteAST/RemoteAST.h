@@ -211,6 +211,16 @@ public:
   /// Given a heap object, resolve its heap metadata.
   Result<remote::RemoteAddress>
   getHeapMetadataForObject(remote::RemoteAddress address);
+
+  /// Discard everything this context has cached about the remote process,
+  /// including resolved type metadata and member offsets.
+  ///
+  /// Call this whenever the remote process has been allowed to run, since
+  /// images may have been loaded or unloaded in the meantime. Reusing a
+  /// context across stops and clearing it on resume keeps repeated queries
+  /// for the same types — the common case when stepping — from re-reading
+  /// the remote process every time.
+  void clearCaches();
 };
 
 } // end namespace remoteAST
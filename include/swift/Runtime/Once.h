@@ -18,7 +18,6 @@
 #define SWIFT_RUNTIME_ONCE_H
 
 #include "swift/Runtime/HeapObject.h"
-#include <mutex>
 
 namespace swift {
 
@@ -27,15 +26,16 @@ namespace swift {
 // On OS X and iOS, swift_once_t matches dispatch_once_t.
 typedef long swift_once_t;
 
-#elif defined(__CYGWIN__)
-
-// On Cygwin, std::once_flag can not be used because it is larger than the
-// platform word.
-typedef uintptr_t swift_once_t;
 #else
 
-// On other platforms swift_once_t is std::once_flag
-typedef std::once_flag swift_once_t;
+// On other platforms, swift_once_t is a platform word.  The runtime keeps
+// it zero until initialization is complete and then stores all-ones with
+// release ordering, so the compiler can emit a barrier-free inline check
+// that skips the call entirely once initialization is done.  See
+// SwiftTargetInfo.OnceDonePredicateValue.  (Cygwin uses the word-sized
+// predicate too, but its legacy implementation does not expose the "done"
+// state, so the compiler does not emit the inline check there.)
+typedef uintptr_t swift_once_t;
 
 #endif
 
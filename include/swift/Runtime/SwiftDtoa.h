@@ -98,6 +98,24 @@ int swift_decompose_double(double d,
 // In all cases, it returns the number of ASCII characters actually
 // written, or zero if the buffer was too small.
 size_t swift_format_double(double, char *dest, size_t length);
+
+// Format an array of doubles as a packed sequence of ASCII strings.
+//
+// Each value is formatted with `swift_format_double` semantics and
+// written into `dest` immediately after the previous string's
+// terminating zero byte.  If `offsets` is non-null, it must have room
+// for `count` entries and receives the offset of each string within
+// `dest`.
+//
+// Returns the number of values successfully formatted.  Formatting
+// stops early if the remaining buffer cannot hold the next string, so a
+// return value less than `count` means `dest` was too small.
+//
+// Bulk serializers should prefer this over calling
+// `swift_format_double` in a loop: the call overhead is amortized and
+// the digit-generation working set stays hot across values.
+size_t swift_format_double_batch(const double *values, size_t count,
+                                 char *dest, size_t length, size_t *offsets);
 #endif
 
 #if SWIFT_DTOA_FLOAT_SUPPORT
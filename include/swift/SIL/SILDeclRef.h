@@ -59,6 +59,15 @@ enum class MethodDispatch {
 /// Get the method dispatch mechanism for a method.
 MethodDispatch getMethodDispatch(AbstractFunctionDecl *method);
 
+/// True if a class method known to use class_method dispatch can
+/// nevertheless be referenced statically in module \p M, because the
+/// method has no overriding implementations and, given the access level
+/// of the method and the compilation mode, none can exist elsewhere.
+///
+/// This is the AST-only subset of the optimizer's effectively-final
+/// reasoning; it does not look at the class hierarchy.
+bool isEffectivelyFinalMethod(SILDeclRef method, SILModule &M);
+
 /// True if calling the given method or property should use ObjC dispatch.
 bool requiresForeignEntryPoint(ValueDecl *vd);
 
@@ -142,6 +142,21 @@ private:
   /// Allocator that manages the memory of all the pieces of the SILModule.
   mutable llvm::BumpPtrAllocator BPA;
 
+  /// Free lists of recycled instruction memory, bucketed by power-of-two
+  /// size class; see allocateInst(). Passes like SimplifyCFG and SILCombine
+  /// create and delete instructions constantly, and recycling their memory
+  /// keeps the footprint of long pass pipelines from growing monotonically.
+  ///
+  /// This needs to be declared before \p functions so that instructions
+  /// deleted while the function lists are destroyed are returned to the
+  /// free lists before the destructor below releases them.
+  struct InstructionFreeLists {
+    enum { NumSizeClasses = 8 };
+    void *Heads[NumSizeClasses] = {};
+    ~InstructionFreeLists();
+  };
+  mutable InstructionFreeLists instFreeLists;
+
   /// The swift Module associated with this SILModule.
   ModuleDecl *TheSwiftModule;
 
@@ -508,6 +523,19 @@ public:
   /// succeeded, false otherwise.
   bool loadFunction(SILFunction *F);
 
+  /// Attempt to deserialize a function with the mangled name \p Name from one
+  /// of the imported modules, including its body. Referenced functions are
+  /// linked like for any other deserialized definition.
+  ///
+  /// \return null if none of the imported modules contains such a function.
+  SILFunction *loadFunction(StringRef Name);
+
+  /// Hint that the functions with the given mangled names will be needed
+  /// soon; attempts to deserialize their bodies in one batched pass per
+  /// imported module. Unknown names are ignored, and referenced functions
+  /// are not linked.
+  void preloadFunctions(ArrayRef<StringRef> Names);
+
   /// Attempt to link the SILFunction. Returns true if linking succeeded, false
   /// otherwise.
   ///
@@ -19,6 +19,7 @@
 namespace swift {
 class DominanceAnalysis;
 class SILBasicBlock;
+class CondBranchInst;
 
 /// Cache a set of basic blocks that have been determined to be cold or hot.
 ///
@@ -42,9 +43,16 @@ class ColdBlockInfo {
   };
 
   enum {
-    RecursionDepthLimit = 3
+    RecursionDepthLimit = 3,
+
+    /// The minimum factor by which the taken-count of one edge of a profiled
+    /// cond_br must exceed the taken-count of the other edge to consider the
+    /// rarely taken edge cold.
+    ColdEdgeCountFactor = 50
   };
 
+  static BranchHint getProfileHint(const CondBranchInst *CBI);
+
   BranchHint getBranchHint(SILValue Cond, int recursionDepth);
 
   bool isSlowPath(const SILBasicBlock *FromBB, const SILBasicBlock *ToBB,
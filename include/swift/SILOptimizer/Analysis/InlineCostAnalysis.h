@@ -0,0 +1,65 @@
+//===--- InlineCostAnalysis.h -----------------------------------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+//  This analysis caches the per-callee cost summaries which the performance
+//  inliner uses to make its inlining decisions: a ShortestPathAnalysis of the
+//  callee, computed with the assumption that calls inside the callee have a
+//  constant length. Because that assumption makes the summary independent of
+//  any particular caller, it can be shared by all call sites of a function
+//  and survives across inliner runs until the function itself changes.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_SILOPTIMIZER_ANALYSIS_INLINECOSTANALYSIS_H
+#define SWIFT_SILOPTIMIZER_ANALYSIS_INLINECOSTANALYSIS_H
+
+#include "swift/SILOptimizer/Analysis/Analysis.h"
+#include "swift/SILOptimizer/Utils/PerformanceInlinerUtils.h"
+
+namespace swift {
+
+class DominanceAnalysis;
+class SILLoopAnalysis;
+
+/// Caches the caller-independent ShortestPathAnalysis summary of each
+/// function for the performance inliner.
+class InlineCostAnalysis : public FunctionAnalysisBase<ShortestPathAnalysis> {
+  DominanceAnalysis *DA;
+  SILLoopAnalysis *LA;
+
+public:
+  InlineCostAnalysis(SILModule *)
+      : FunctionAnalysisBase<ShortestPathAnalysis>(
+            SILAnalysisKind::InlineCost),
+        DA(nullptr), LA(nullptr) {}
+
+  InlineCostAnalysis(const InlineCostAnalysis &) = delete;
+  InlineCostAnalysis &operator=(const InlineCostAnalysis &) = delete;
+
+  static bool classof(const SILAnalysis *S) {
+    return S->getKind() == SILAnalysisKind::InlineCost;
+  }
+
+  virtual void initialize(SILPassManager *PM) override;
+
+  virtual ShortestPathAnalysis *newFunctionAnalysis(SILFunction *F) override;
+
+  virtual bool shouldInvalidate(SILAnalysis::InvalidationKind K) override {
+    // The summary depends on the instructions and on the CFG of the
+    // function.
+    return K & (InvalidationKind::Branches | InvalidationKind::Instructions);
+  }
+};
+
+} // end namespace swift
+
+#endif
@@ -28,7 +28,9 @@
 namespace swift {
 
 /// Limit the size of the rc identity cache. We keep a cache per function.
-constexpr unsigned MaxRCIdentityCacheSize = 64;
+/// The ARC passes query the same values over and over again, so make the
+/// cache large enough that hot functions don't keep throwing it away.
+constexpr unsigned MaxRCIdentityCacheSize = 1024;
 
 class DominanceAnalysis;
 
@@ -80,8 +82,10 @@ public:
   }
 
 private:
-  SILValue getRCIdentityRootInner(SILValue V, unsigned RecursionDepth);
-  SILValue stripRCIdentityPreservingOps(SILValue V, unsigned RecursionDepth);
+  SILValue getRCIdentityRootInner(SILValue V, unsigned RecursionDepth,
+                                  llvm::SmallVectorImpl<SILValue> *Chain);
+  SILValue stripRCIdentityPreservingOps(SILValue V, unsigned RecursionDepth,
+                                        llvm::SmallVectorImpl<SILValue> *Chain);
   SILValue stripRCIdentityPreservingArgs(SILValue V, unsigned RecursionDepth);
   SILValue stripOneRCIdentityIncomingValue(SILArgument *Arg, SILValue V);
   bool findDominatingNonPayloadedEdge(SILBasicBlock *IncomingEdgeBB,
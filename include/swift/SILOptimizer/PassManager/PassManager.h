@@ -15,6 +15,7 @@
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/ErrorHandling.h"
@@ -66,6 +67,16 @@ class SILPassManager {
   /// The worklist of functions to be processed by function passes.
   std::vector<WorklistEntry> FunctionWorklist;
 
+  /// The bottom-up order of all functions, used to seed the function pass
+  /// worklist. Computing it walks the call graph of the whole module, which
+  /// is noticeable on very large modules, so it is cached across pipeline
+  /// segments and only recomputed when a pass changed the call graph.
+  std::vector<SILFunction *> BottomUpFunctionOrderCache;
+
+  /// True if the cached bottom-up function order no longer reflects the
+  /// module's call graph and has to be recomputed.
+  bool FunctionOrderIsStale = true;
+
   // Name of the current optimization stage for diagnostics.
   std::string StageName;
 
@@ -90,6 +101,17 @@ class SILPassManager {
   /// Set to true when a pass invalidates an analysis.
   bool CurrentPassHasInvalidated = false;
 
+  /// The functions the currently running pass reported as changed through
+  /// the per-function invalidation notifications. After a module pass,
+  /// only these need to be re-verified.
+  llvm::SmallSetVector<SILFunction *, 8> CurrentPassChangedFunctions;
+
+  /// Set to true when the currently running pass performs a wholesale
+  /// invalidation (all analyses or the function tables), meaning the
+  /// per-function change set is not exhaustive and the whole module has
+  /// to be re-verified.
+  bool CurrentPassInvalidatedAll = false;
+
   /// True if we need to stop running passes and restart again on the
   /// same function.
   bool RestartPipeline = false;
@@ -150,6 +172,8 @@ public:
         AP->invalidate();
 
     CurrentPassHasInvalidated = true;
+    CurrentPassInvalidatedAll = true;
+    FunctionOrderIsStale = true;
 
     // Assume that all functions have changed. Clear all masks of all functions.
     CompletedPassesMap.clear();
@@ -173,6 +197,8 @@ public:
     for (auto AP : Analyses) {
       AP->notifyAddedOrModifiedFunction(F);
     }
+    CurrentPassChangedFunctions.insert(F);
+    FunctionOrderIsStale = true;
   }
 
   /// \brief Broadcast the invalidation of the function to all analysis.
@@ -182,8 +208,11 @@ public:
     for (auto AP : Analyses)
       if (!AP->isLocked())
         AP->invalidate(F, K);
-    
+
     CurrentPassHasInvalidated = true;
+    CurrentPassChangedFunctions.insert(F);
+    if (K & SILAnalysis::InvalidationKind::Calls)
+      FunctionOrderIsStale = true;
     // Any change let all passes run again.
     CompletedPassesMap[F].reset();
   }
@@ -197,6 +226,8 @@ public:
         AP->invalidateFunctionTables();
 
     CurrentPassHasInvalidated = true;
+    CurrentPassInvalidatedAll = true;
+    FunctionOrderIsStale = true;
 
     // Assume that all functions have changed. Clear all masks of all functions.
     CompletedPassesMap.clear();
@@ -210,6 +241,12 @@ public:
         AP->notifyWillDeleteFunction(F);
 
     CurrentPassHasInvalidated = true;
+    // The function is going away; the cached bottom-up order would retain a
+    // dangling reference to it.
+    FunctionOrderIsStale = true;
+    // The function is going away; make sure the post-pass verification
+    // does not try to visit it.
+    CurrentPassChangedFunctions.remove(F);
     // Any change let all passes run again.
     CompletedPassesMap[F].reset();
   }
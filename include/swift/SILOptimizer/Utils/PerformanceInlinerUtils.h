@@ -223,7 +223,10 @@ public:
     SingleLoopWeight = 4,
 
     /// Pretty large but small enough to add something without overflowing.
-    InitialDist = (1 << 29)
+    InitialDist = (1 << 29),
+
+    /// The assumed execution length of a function call.
+    DefaultApplyLength = 10
   };
 
   /// A weight for an inlining benefit.
@@ -390,6 +390,10 @@ private:
   std::unique_ptr<GroupNameTable> GroupNamesMap;
   std::unique_ptr<SerializedDeclCommentTable> DeclCommentTable;
 
+  /// Owns the decompressed blob that \c DeclCommentTable points into when the
+  /// comment table was serialized in compressed form.
+  SmallVector<char, 0> DecompressedCommentBlob;
+
   struct ModuleBits {
     /// The decl ID of the main class in this module file, if it has one.
     unsigned EntryPointDeclID : 31;
@@ -517,7 +521,7 @@ private:
   /// Read an on-disk decl hash table stored in
   /// \c comment_block::DeclCommentListLayout format.
   std::unique_ptr<SerializedDeclCommentTable>
-  readDeclCommentTable(ArrayRef<uint64_t> fields, StringRef blobData);
+  readDeclCommentTable(uint32_t tableOffset, StringRef blobData);
 
   std::unique_ptr<GroupNameTable>
   readGroupTable(ArrayRef<uint64_t> fields, StringRef blobData);
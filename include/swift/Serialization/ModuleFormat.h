@@ -55,7 +55,7 @@ const uint16_t VERSION_MAJOR = 0;
 /// describe what change you made. The content of this comment isn't important;
 /// it just ensures a conflict if two people change the module format.
 /// Don't worry about adhering to the 80-column limit for this line.
-const uint16_t VERSION_MINOR = 427; // Invalid conformances
+const uint16_t VERSION_MINOR = 430; // Compressed doc comment tables
 
 using DeclIDField = BCFixed<31>;
 
@@ -1640,9 +1640,12 @@ namespace index_block {
                 "not enough bits for all record kinds");
   using RecordIDField = BCFixed<RecordIDFieldWidth>;
 
+  // Stored as a blob of fixed-width little-endian entries rather than a
+  // bit-packed array so that readers widen the offsets with plain loads
+  // instead of re-decoding the whole table in every importing job.
   using OffsetsLayout = BCGenericRecordLayout<
     RecordIDField, // record ID
-    BCArray<BitOffsetField>
+    BCBlob         // array of 32-bit little-endian bit offsets
   >;
 
   using DeclListLayout = BCGenericRecordLayout<
@@ -1705,6 +1708,7 @@ namespace comment_block {
   enum RecordKind {
     DECL_COMMENTS = 1,
     GROUP_NAMES = 2,
+    COMPRESSED_DECL_COMMENTS = 3,
   };
 
   using DeclCommentListLayout = BCRecordLayout<
@@ -1713,6 +1717,15 @@ namespace comment_block {
     BCBlob         // map from Decl IDs to comments
   >;
 
+  /// Emitted in place of DECL_COMMENTS when zlib-compressing a large table
+  /// makes it smaller.
+  using CompressedDeclCommentListLayout = BCRecordLayout<
+    COMPRESSED_DECL_COMMENTS, // record ID
+    BCVBR<16>,     // table offset within the uncompressed blob
+    BCVBR<16>,     // size of the uncompressed blob
+    BCBlob         // compressed map from Decl IDs to comments
+  >;
+
   using GroupNamesLayout = BCRecordLayout<
     GROUP_NAMES,    // record ID
     BCBlob          // actual names
@@ -94,6 +94,12 @@ public:
   lookupSILFunction(StringRef Name, bool declarationOnly = false,
                     Optional<SILLinkage> linkage = None);
   bool hasSILFunction(StringRef Name, Optional<SILLinkage> linkage = None);
+
+  /// Deserialize the bodies of all named functions that can be found in the
+  /// loaded modules, batching the reads within each module. Unknown names
+  /// are ignored.
+  void preloadSILFunctions(ArrayRef<StringRef> Names);
+
   SILVTable *lookupVTable(Identifier Name);
   SILVTable *lookupVTable(const ClassDecl *C) {
     return lookupVTable(C->getName());
@@ -134,6 +134,29 @@ namespace swift {
                               bool TokenizeInterpolatedString = true,
                               ArrayRef<Token> SplitTokens = ArrayRef<Token>());
 
+  /// \brief Re-lex a buffer after a single edit, reusing tokens from a
+  /// previous tokenization of the pre-edit buffer.
+  ///
+  /// Only the region affected by the edit is re-lexed; unaffected tokens from
+  /// \p OldTokens are rebased onto the post-edit buffer and spliced around the
+  /// freshly lexed region. The result is identical to tokenizing
+  /// \p NewBufferID from scratch with comments returned as tokens and
+  /// interpolated string literals kept as single tokens. The offsets of
+  /// reused tokens can be fed to SyntaxParsingCache as reusable regions.
+  ///
+  /// \param OldTokens tokens lexed from \p OldBufferID, in source order.
+  /// \param EditStart byte offset in the pre-edit buffer where the edit began.
+  /// \param EditEnd byte offset in the pre-edit buffer where the edit ended.
+  /// \param ReplacementLength number of bytes that replaced the edited range.
+  std::vector<Token> relexTokensAfterEdit(const LangOptions &LangOpts,
+                                          const SourceManager &SM,
+                                          unsigned OldBufferID,
+                                          unsigned NewBufferID,
+                                          ArrayRef<Token> OldTokens,
+                                          unsigned EditStart, unsigned EditEnd,
+                                          unsigned ReplacementLength,
+                                          DiagnosticEngine *Diags = nullptr);
+
   /// Once parsing is complete, this walks the AST to resolve imports, record
   /// operators, and do other top-level validation.
   ///
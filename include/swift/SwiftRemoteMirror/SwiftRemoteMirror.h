@@ -72,6 +72,18 @@ void
 swift_reflection_addReflectionInfo(SwiftReflectionContextRef ContextRef,
                                    swift_reflection_info_t Info);
 
+/// Interpose a read-ahead cache between the context and its memory reader,
+/// so that clusters of small reads cost one underlying read per BlockSize
+/// bytes instead of one read each. BlockSize must be a power of two, or
+/// zero to remove the cache again.
+///
+/// The cache assumes the remote process is stopped while the context is in
+/// use.
+SWIFT_REMOTE_MIRROR_LINKAGE
+void
+swift_reflection_setReadAheadCache(SwiftReflectionContextRef ContextRef,
+                                   uint64_t BlockSize, uint64_t MaxBlocks);
+
 #if defined(__APPLE__) && defined(__MACH__)
 /// Add reflection information from a loaded Swift image.
 /// Returns true on success, false if the image's memory couldn't be read.
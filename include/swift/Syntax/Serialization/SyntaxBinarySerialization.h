@@ -0,0 +1,264 @@
+//===--- SyntaxBinarySerialization.h - Binary Syntax Serialization -*-C++-*===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// This file provides a compact binary serialization of RawSyntax trees as an
+// alternative to the JSON format in SyntaxSerialization.h. The format is
+// designed so that a serialized tree can be memory-mapped and decoded without
+// copying token or trivia text: deserialized nodes reference the input buffer
+// directly, so the buffer must outlive the tree.
+//
+// Layout ("SSBF" format, version 1):
+//
+//   file    := 'S' 'S' 'B' 'F' version:ULEB node
+//   node    := 0xFF                                     // null child
+//            | marker:u8 id:ULEB token | marker:u8 id:ULEB layout
+//   token   := tokKind:ULEB text trivia trivia          // marker bit 0 set
+//   layout  := kind:ULEB byteSize:ULEB count:ULEB node* // marker bit 0 clear
+//   trivia  := count:ULEB piece*
+//   piece   := kind:ULEB count:ULEB text
+//   text    := length:ULEB byte*
+//
+// The marker byte encodes whether the node is a token (bit 0) and whether it
+// is missing (bit 1). The byteSize field of a layout node covers its child
+// region, allowing a reader to skip an entire subtree without decoding it.
+// Enum values are encoded numerically, so the version must be bumped whenever
+// SyntaxKind, tok or TriviaKind change their numbering.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_SYNTAX_SERIALIZATION_SYNTAXBINARYSERIALIZATION_H
+#define SWIFT_SYNTAX_SERIALIZATION_SYNTAXBINARYSERIALIZATION_H
+
+#include "swift/Syntax/RawSyntax.h"
+#include "swift/Syntax/SyntaxNodes.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+namespace swift {
+namespace binary {
+
+/// The four-byte magic number introducing a binary serialized syntax tree.
+constexpr const char SyntaxBinaryMagic[4] = {'S', 'S', 'B', 'F'};
+
+/// The current version of the binary syntax format.
+constexpr uint64_t SyntaxBinaryVersion = 1;
+
+/// Serializes RawSyntax trees into the binary format described above.
+class SyntaxBinarySerializer {
+  llvm::raw_ostream &OS;
+
+  /// Memoized encoded sizes of shared nodes.
+  llvm::DenseMap<const syntax::RawSyntax *, uint64_t> SizeCache;
+
+  static uint64_t getTextSize(StringRef Text) {
+    return llvm::getULEB128Size(Text.size()) + Text.size();
+  }
+
+  static uint64_t getPieceSize(const syntax::TriviaPiece &Piece) {
+    return llvm::getULEB128Size(unsigned(Piece.getKind())) +
+           llvm::getULEB128Size(Piece.getCount()) +
+           getTextSize(Piece.getText());
+  }
+
+  static uint64_t getTriviaSize(ArrayRef<syntax::TriviaPiece> Pieces) {
+    uint64_t Size = llvm::getULEB128Size(Pieces.size());
+    for (auto &Piece : Pieces)
+      Size += getPieceSize(Piece);
+    return Size;
+  }
+
+  /// Return the number of bytes \p Node occupies in encoded form.
+  uint64_t getNodeSize(const syntax::RawSyntax *Node) {
+    if (!Node)
+      return 1;
+    auto Known = SizeCache.find(Node);
+    if (Known != SizeCache.end())
+      return Known->second;
+
+    uint64_t Size = 1 + llvm::getULEB128Size(Node->getId());
+    if (Node->isToken()) {
+      Size += llvm::getULEB128Size(unsigned(Node->getTokenKind()));
+      Size += getTextSize(Node->getTokenText());
+      Size += getTriviaSize(Node->getLeadingTrivia());
+      Size += getTriviaSize(Node->getTrailingTrivia());
+    } else {
+      uint64_t ChildrenSize = 0;
+      for (auto &Child : Node->getLayout())
+        ChildrenSize += getNodeSize(Child.get());
+      Size += llvm::getULEB128Size(unsigned(Node->getKind()));
+      Size += llvm::getULEB128Size(ChildrenSize);
+      Size += llvm::getULEB128Size(Node->getLayout().size());
+      Size += ChildrenSize;
+    }
+    SizeCache.insert({Node, Size});
+    return Size;
+  }
+
+  void writeVarint(uint64_t Value) { llvm::encodeULEB128(Value, OS); }
+
+  void writeText(StringRef Text) {
+    writeVarint(Text.size());
+    OS << Text;
+  }
+
+  void writeTrivia(ArrayRef<syntax::TriviaPiece> Pieces) {
+    writeVarint(Pieces.size());
+    for (auto &Piece : Pieces) {
+      writeVarint(unsigned(Piece.getKind()));
+      writeVarint(Piece.getCount());
+      writeText(Piece.getText());
+    }
+  }
+
+  void writeNode(const syntax::RawSyntax *Node) {
+    if (!Node) {
+      OS << char(0xFF);
+      return;
+    }
+    uint8_t Marker = (Node->isToken() ? 1 : 0) | (Node->isMissing() ? 2 : 0);
+    OS << char(Marker);
+    writeVarint(Node->getId());
+    if (Node->isToken()) {
+      writeVarint(unsigned(Node->getTokenKind()));
+      writeText(Node->getTokenText());
+      writeTrivia(Node->getLeadingTrivia());
+      writeTrivia(Node->getTrailingTrivia());
+    } else {
+      uint64_t ChildrenSize = 0;
+      for (auto &Child : Node->getLayout())
+        ChildrenSize += getNodeSize(Child.get());
+      writeVarint(unsigned(Node->getKind()));
+      writeVarint(ChildrenSize);
+      writeVarint(Node->getLayout().size());
+      for (auto &Child : Node->getLayout())
+        writeNode(Child.get());
+    }
+  }
+
+public:
+  SyntaxBinarySerializer(llvm::raw_ostream &OS) : OS(OS) {}
+
+  void serialize(const syntax::RawSyntax &Root) {
+    OS.write(SyntaxBinaryMagic, sizeof(SyntaxBinaryMagic));
+    writeVarint(SyntaxBinaryVersion);
+    writeNode(&Root);
+  }
+};
+
+/// Deserializes RawSyntax trees from the binary format. The deserializer does
+/// not copy token or trivia text out of the input buffer; the buffer must
+/// stay alive for as long as the returned tree is in use. This makes it safe
+/// and cheap to operate directly on a memory-mapped file.
+class SyntaxBinaryDeserializer {
+  const uint8_t *Cursor;
+  const uint8_t *End;
+  bool Malformed = false;
+
+  uint64_t readVarint() {
+    unsigned N = 0;
+    uint64_t Value = llvm::decodeULEB128(Cursor, &N, End);
+    if (N == 0 || Cursor + N > End) {
+      Malformed = true;
+      return 0;
+    }
+    Cursor += N;
+    return Value;
+  }
+
+  StringRef readText() {
+    uint64_t Length = readVarint();
+    if (Malformed || uint64_t(End - Cursor) < Length) {
+      Malformed = true;
+      return StringRef();
+    }
+    StringRef Text(reinterpret_cast<const char *>(Cursor), Length);
+    Cursor += Length;
+    return Text;
+  }
+
+  void readTrivia(std::vector<syntax::TriviaPiece> &Pieces) {
+    uint64_t Count = readVarint();
+    for (uint64_t I = 0; I < Count && !Malformed; ++I) {
+      auto Kind = syntax::TriviaKind(readVarint());
+      unsigned PieceCount = readVarint();
+      StringRef Text = readText();
+      if (Malformed)
+        return;
+      if (Text.empty())
+        Pieces.push_back(syntax::TriviaPiece::withCount(Kind, PieceCount));
+      else
+        Pieces.push_back(syntax::TriviaPiece::withText(Kind, Text));
+    }
+  }
+
+  RC<syntax::RawSyntax> readNode() {
+    if (Cursor == End) {
+      Malformed = true;
+      return nullptr;
+    }
+    uint8_t Marker = *Cursor++;
+    if (Marker == 0xFF)
+      return nullptr;
+    unsigned Id = readVarint();
+    auto Presence = (Marker & 2) ? syntax::SourcePresence::Missing
+                                 : syntax::SourcePresence::Present;
+    if (Marker & 1) {
+      auto TokKind = tok(readVarint());
+      StringRef Text = readText();
+      std::vector<syntax::TriviaPiece> Leading;
+      std::vector<syntax::TriviaPiece> Trailing;
+      readTrivia(Leading);
+      readTrivia(Trailing);
+      if (Malformed)
+        return nullptr;
+      return syntax::RawSyntax::make(TokKind, Text, Leading, Trailing,
+                                     Presence, /*Arena=*/nullptr, Id);
+    }
+
+    auto Kind = syntax::SyntaxKind(readVarint());
+    (void)readVarint(); // Byte size of the child region; used for skipping.
+    uint64_t NumChildren = readVarint();
+    std::vector<RC<syntax::RawSyntax>> Layout;
+    Layout.reserve(NumChildren);
+    for (uint64_t I = 0; I < NumChildren && !Malformed; ++I)
+      Layout.push_back(readNode());
+    if (Malformed)
+      return nullptr;
+    return syntax::RawSyntax::make(Kind, Layout, Presence, /*Arena=*/nullptr,
+                                   Id);
+  }
+
+public:
+  SyntaxBinaryDeserializer(llvm::MemoryBufferRef Buffer)
+      : Cursor(reinterpret_cast<const uint8_t *>(Buffer.getBufferStart())),
+        End(reinterpret_cast<const uint8_t *>(Buffer.getBufferEnd())) {}
+
+  llvm::Optional<syntax::SourceFileSyntax> getSourceFileSyntax() {
+    if (uint64_t(End - Cursor) < sizeof(SyntaxBinaryMagic) ||
+        memcmp(Cursor, SyntaxBinaryMagic, sizeof(SyntaxBinaryMagic)) != 0)
+      return llvm::None;
+    Cursor += sizeof(SyntaxBinaryMagic);
+    if (readVarint() != SyntaxBinaryVersion)
+      return llvm::None;
+    auto Raw = readNode();
+    if (!Raw || Malformed)
+      return llvm::None;
+    return syntax::make<syntax::SourceFileSyntax>(Raw);
+  }
+};
+
+} // namespace binary
+} // namespace swift
+
+#endif // SWIFT_SYNTAX_SERIALIZATION_SYNTAXBINARYSERIALIZATION_H
@@ -12,8 +12,12 @@
 #ifndef SWIFT_IRGEN_TBDGEN_H
 #define SWIFT_IRGEN_TBDGEN_H
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/StringSet.h"
+#include <string>
+#include <vector>
 
 namespace llvm {
 class raw_ostream;
@@ -34,12 +38,35 @@ struct TBDGenOptions {
   llvm::StringRef ModuleLinkName;
 };
 
+/// \brief A cache of each file's public symbols, allowing a frontend
+/// invocation that performs several TBD queries (e.g. emitting a TBD file and
+/// later validating the symbols against the IR) to walk each AST only once.
+///
+/// Entries are keyed by the file's interface hash, so a cached list is only
+/// reused while the file's interface is unchanged. The cache assumes the same
+/// TBDGenOptions across queries, as is the case within a single invocation.
+struct TBDSymbolCache {
+  struct FileSymbols {
+    /// The file's interface hash when the symbols were computed.
+    llvm::SmallString<32> InterfaceHash;
+    /// Whether the symbols were computed with whole-module linkage, which
+    /// affects the visibility of some entities.
+    bool IsWholeModule;
+    std::vector<std::string> Symbols;
+  };
+
+  llvm::DenseMap<FileUnit *, FileSymbols> PerFileSymbols;
+};
+
 void enumeratePublicSymbols(FileUnit *module, llvm::StringSet<> &symbols,
-                            TBDGenOptions &opts);
+                            TBDGenOptions &opts,
+                            TBDSymbolCache *cache = nullptr);
 void enumeratePublicSymbols(ModuleDecl *module, llvm::StringSet<> &symbols,
-                            TBDGenOptions &opts);
+                            TBDGenOptions &opts,
+                            TBDSymbolCache *cache = nullptr);
 
-void writeTBDFile(ModuleDecl *M, llvm::raw_ostream &os, TBDGenOptions &opts);
+void writeTBDFile(ModuleDecl *M, llvm::raw_ostream &os, TBDGenOptions &opts,
+                  TBDSymbolCache *cache = nullptr);
 
 } // end namespace swift
 
@@ -54,6 +54,7 @@
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Compiler.h"
+#include "llvm/Support/Mutex.h"
 #include <algorithm>
 #include <memory>
 
@@ -102,6 +103,79 @@ using AssociativityCacheType =
   llvm::DenseMap<std::pair<PrecedenceGroupDecl *, PrecedenceGroupDecl *>,
                  Associativity>;
 
+namespace {
+  /// A FoldingSet divided into independently-lockable shards, used for the
+  /// highest-traffic type uniquing tables so that concurrent canonicalization
+  /// contends on a shard rather than on one global table.
+  ///
+  /// The per-shard mutexes are SmartMutexes, which stay uncontended no-ops
+  /// until LLVM's multithreaded mode is enabled, so single-threaded
+  /// compilation does not pay for the locking.
+  ///
+  /// A shard's lock serializes only that shard. The creation callbacks
+  /// allocate from the shared ASTContext allocator, which takes its own
+  /// lock (see \c ASTContext::getAllocatorLock) so that misses in two
+  /// different shards do not race on the allocator.
+  template <typename NodeT, unsigned NumShards = 8>
+  class ShardedFoldingSet {
+    /// Each shard gets its own cache line so that locking one shard does
+    /// not ping-pong the others.
+    struct alignas(64) Shard {
+      llvm::sys::SmartMutex<true> Mutex;
+      llvm::FoldingSet<NodeT> Set;
+    };
+    Shard Shards[NumShards];
+
+  public:
+    /// Return the node with the given profile, calling \p create to build
+    /// it (while the shard's lock is held) if it is not already present.
+    template <typename CreateFn>
+    NodeT *findOrCreate(const llvm::FoldingSetNodeID &id, CreateFn create) {
+      auto &shard = Shards[id.ComputeHash() % NumShards];
+      llvm::sys::SmartScopedLock<true> lock(shard.Mutex);
+      void *insertPos = nullptr;
+      if (auto *existing = shard.Set.FindNodeOrInsertPos(id, insertPos))
+        return existing;
+
+      NodeT *node = create();
+      shard.Set.InsertNode(node, insertPos);
+      return node;
+    }
+  };
+
+  /// The DenseMap analogue of ShardedFoldingSet, for uniquing tables keyed
+  /// on something other than a folding-set profile.
+  template <typename KeyT, typename ValueT, unsigned NumShards = 8>
+  class ShardedDenseMap {
+    struct alignas(64) Shard {
+      llvm::sys::SmartMutex<true> Mutex;
+      llvm::DenseMap<KeyT, ValueT *> Map;
+    };
+    Shard Shards[NumShards];
+
+  public:
+    /// Return the value for the given key, calling \p create to build it
+    /// (while the shard's lock is held) if it is not already present.
+    template <typename CreateFn>
+    ValueT *findOrCreate(const KeyT &key, CreateFn create) {
+      auto &shard =
+        Shards[llvm::DenseMapInfo<KeyT>::getHashValue(key) % NumShards];
+      llvm::sys::SmartScopedLock<true> lock(shard.Mutex);
+      auto &entry = shard.Map[key];
+      if (!entry)
+        entry = create();
+      return entry;
+    }
+
+    size_t getMemorySize() const {
+      size_t size = 0;
+      for (const auto &shard : Shards)
+        size += llvm::capacity_in_bytes(shard.Map);
+      return size;
+    }
+  };
+} // end anonymous namespace
+
 #define FOR_KNOWN_FOUNDATION_TYPES(MACRO) \
   MACRO(NSError) \
   MACRO(NSNumber) \
@@ -113,13 +187,33 @@ struct ASTContext::Implementation {
 
   llvm::BumpPtrAllocator Allocator; // used in later initializations
 
+  /// Guards allocation from the bump-pointer allocators. Creation callbacks
+  /// in the sharded uniquing tables below run under only their shard's lock,
+  /// so two threads missing in different shards would otherwise race on the
+  /// allocator itself.
+  llvm::sys::SmartMutex<true> AllocatorMutex;
+
   /// The set of cleanups to be called when the ASTContext is destroyed.
   std::vector<std::function<void(void)>> Cleanups;
 
   /// The last resolver.
   LazyResolver *Resolver = nullptr;
 
-  llvm::StringMap<char, llvm::BumpPtrAllocator&> IdentifierTable;
+  /// The number of shards the identifier table is divided into; parallel
+  /// parsing threads intern into independently-locked shards.
+  static const unsigned NumIdentifierShards = 8;
+
+  /// One shard of the identifier table. Each shard owns the storage for
+  /// its identifiers, so interning never contends on the main allocator's
+  /// lock.
+  struct alignas(64) IdentifierShard {
+    llvm::sys::SmartMutex<true> Mutex;
+    llvm::BumpPtrAllocator Allocator;
+    llvm::StringMap<char, llvm::BumpPtrAllocator &> Table;
+
+    IdentifierShard() : Table(Allocator) {}
+  };
+  IdentifierShard IdentifierShards[NumIdentifierShards];
 
   /// The declaration of Swift.AssignmentPrecedence.
   PrecedenceGroupDecl *AssignmentPrecedence = nullptr;
@@ -275,11 +369,11 @@ FOR_KNOWN_FOUNDATION_TYPES(CACHE_FOUNDATION_DECL)
   struct Arena {
     llvm::DenseMap<Type, ErrorType *> ErrorTypesWithOriginal;
     llvm::FoldingSet<NameAliasType> NameAliasTypes;
-    llvm::FoldingSet<TupleType> TupleTypes;
+    ShardedFoldingSet<TupleType> TupleTypes;
     llvm::DenseMap<std::pair<Type,char>, MetatypeType*> MetatypeTypes;
     llvm::DenseMap<std::pair<Type,char>,
                    ExistentialMetatypeType*> ExistentialMetatypeTypes;
-    llvm::DenseMap<std::pair<Type,std::pair<Type,unsigned>>, FunctionType*>
+    ShardedDenseMap<std::pair<Type, std::pair<Type, unsigned>>, FunctionType>
       FunctionTypes;
     llvm::DenseMap<Type, ArraySliceType*> ArraySliceTypes;
     llvm::DenseMap<std::pair<Type, Type>, DictionaryType *> DictionaryTypes;
@@ -295,7 +389,7 @@ FOR_KNOWN_FOUNDATION_TYPES(CACHE_FOUNDATION_DECL)
     llvm::FoldingSet<StructType> StructTypes;
     llvm::FoldingSet<ClassType> ClassTypes;
     llvm::FoldingSet<UnboundGenericType> UnboundGenericTypes;
-    llvm::FoldingSet<BoundGenericType> BoundGenericTypes;
+    ShardedFoldingSet<BoundGenericType> BoundGenericTypes;
     llvm::FoldingSet<ProtocolType> ProtocolTypes;
     llvm::FoldingSet<ProtocolCompositionType> ProtocolCompositionTypes;
     llvm::FoldingSet<LayoutConstraintInfo> LayoutConstraints;
@@ -312,6 +406,13 @@ FOR_KNOWN_FOUNDATION_TYPES(CACHE_FOUNDATION_DECL)
     /// The set of substitution maps (uniqued by their storage).
     llvm::FoldingSet<SubstitutionMap::Storage> SubstitutionMaps;
 
+    /// Memoized compositions of substitution maps, keyed on the storage of
+    /// the original map and of the map it was substituted through. Entries
+    /// land in the arena of their operands, so compositions involving type
+    /// variables are released along with the constraint solver arena.
+    llvm::DenseMap<std::pair<const void *, const void *>, SubstitutionMap>
+      SubstitutionMapCompositions;
+
     ~Arena() {
       for (auto &conformance : SpecializedConformances)
         conformance.~SpecializedProtocolConformance();
@@ -387,6 +488,28 @@ FOR_KNOWN_FOUNDATION_TYPES(CACHE_FOUNDATION_DECL)
   /// \brief The current constraint solver arena, if any.
   std::unique_ptr<ConstraintSolverArena> CurrentConstraintSolverArena;
 
+  /// \brief Memory local to a single source file.
+  ///
+  /// Unlike the permanent arena, these allocations can be returned to the
+  /// system once the file's type checking is complete.
+  struct FileScopedArena {
+    /// The allocator used for file-scoped allocations.
+    llvm::BumpPtrAllocator Allocator;
+
+    /// Cleanup functions to run when this arena is destroyed, either by
+    /// an explicit release or at ASTContext teardown.
+    std::vector<std::function<void(void)>> Cleanups;
+
+    ~FileScopedArena() {
+      for (auto &cleanup : Cleanups)
+        cleanup();
+    }
+  };
+
+  /// \brief The per-source-file arenas that have been created so far.
+  llvm::DenseMap<const SourceFile *, std::unique_ptr<FileScopedArena>>
+    FileScopedArenas;
+
   Arena &getArena(AllocationArena arena) {
     switch (arena) {
     case AllocationArena::Permanent:
@@ -404,8 +527,7 @@ FOR_KNOWN_FOUNDATION_TYPES(CACHE_FOUNDATION_DECL)
   syntax::SyntaxArena TheSyntaxArena;
 };
 
-ASTContext::Implementation::Implementation()
- : IdentifierTable(Allocator) {}
+ASTContext::Implementation::Implementation() {}
 ASTContext::Implementation::~Implementation() {
   for (auto &cleanup : Cleanups)
     cleanup();
@@ -513,6 +635,10 @@ ASTContext::ASTContext(LangOptions &langOpts, SearchPathOptions &SearchPathOpts,
 
   // Register any request-evaluator functions available at the AST layer.
   registerAccessRequestFunctions(evaluator);
+
+  // Attach the on-disk request result cache, if one was requested.
+  if (!langOpts.EvaluatorResultCachePath.empty())
+    evaluator.setPersistentCachePath(langOpts.EvaluatorResultCachePath);
 }
 
 ASTContext::~ASTContext() {
@@ -531,6 +657,30 @@ llvm::BumpPtrAllocator &ASTContext::getAllocator(AllocationArena arena) const {
   llvm_unreachable("bad AllocationArena");
 }
 
+llvm::sys::SmartMutex<true> &ASTContext::getAllocatorLock() const {
+  return getImpl().AllocatorMutex;
+}
+
+llvm::BumpPtrAllocator &
+ASTContext::getFileScopedAllocator(const SourceFile *file) const {
+  auto &arena = getImpl().FileScopedArenas[file];
+  if (!arena)
+    arena.reset(new Implementation::FileScopedArena());
+  return arena->Allocator;
+}
+
+void ASTContext::addFileScopedCleanup(const SourceFile *file,
+                                      std::function<void(void)> cleanup) const {
+  auto known = getImpl().FileScopedArenas.find(file);
+  assert(known != getImpl().FileScopedArenas.end() &&
+         "File-scoped cleanup without any file-scoped allocations");
+  known->second->Cleanups.push_back(std::move(cleanup));
+}
+
+void ASTContext::releaseFileScopedMemory(const SourceFile *file) {
+  getImpl().FileScopedArenas.erase(file);
+}
+
 /// Set a new stats reporter.
 void ASTContext::setStatsReporter(UnifiedStatsReporter *stats) {
   Stats = stats;
@@ -563,7 +713,10 @@ Identifier ASTContext::getIdentifier(StringRef Str) const {
   if (Str.data() == nullptr)
     return Identifier(nullptr);
 
-  auto I = getImpl().IdentifierTable.insert(std::make_pair(Str, char())).first;
+  auto &shard = getImpl().IdentifierShards[
+      llvm::hash_value(Str) % Implementation::NumIdentifierShards];
+  llvm::sys::SmartScopedLock<true> lock(shard.Mutex);
+  auto I = shard.Table.insert(std::make_pair(Str, char())).first;
   return Identifier(I->getKeyData());
 }
 
@@ -1974,6 +2127,12 @@ size_t ASTContext::getTotalMemory() const {
 
     Size += getSolverMemory();
 
+    for (const auto &fileArena : getImpl().FileScopedArenas)
+      Size += fileArena.second->Allocator.getTotalMemory();
+
+    for (const auto &shard : getImpl().IdentifierShards)
+      Size += shard.Allocator.getTotalMemory();
+
     return Size;
 }
 
@@ -1993,7 +2152,7 @@ size_t ASTContext::Implementation::Arena::getTotalMemory() const {
     // TupleTypes ?
     llvm::capacity_in_bytes(MetatypeTypes) +
     llvm::capacity_in_bytes(ExistentialMetatypeTypes) +
-    llvm::capacity_in_bytes(FunctionTypes) +
+    FunctionTypes.getMemorySize() +
     llvm::capacity_in_bytes(ArraySliceTypes) +
     llvm::capacity_in_bytes(DictionaryTypes) +
     llvm::capacity_in_bytes(OptionalTypes) +
@@ -2002,7 +2161,8 @@ size_t ASTContext::Implementation::Arena::getTotalMemory() const {
     llvm::capacity_in_bytes(LValueTypes) +
     llvm::capacity_in_bytes(InOutTypes) +
     llvm::capacity_in_bytes(DependentMemberTypes) +
-    llvm::capacity_in_bytes(DynamicSelfTypes);
+    llvm::capacity_in_bytes(DynamicSelfTypes) +
+    llvm::capacity_in_bytes(SubstitutionMapCompositions);
     // EnumTypes ?
     // StructTypes ?
     // ClassTypes ?
@@ -3008,31 +3168,26 @@ Type TupleType::get(ArrayRef<TupleTypeElt> Fields, const ASTContext &C) {
 
   auto arena = getArena(properties);
 
-  void *InsertPos = nullptr;
   // Check to see if we've already seen this tuple before.
   llvm::FoldingSetNodeID ID;
   TupleType::Profile(ID, Fields);
 
-  if (TupleType *TT
-        = C.getImpl().getArena(arena).TupleTypes.FindNodeOrInsertPos(ID,InsertPos))
-    return TT;
-
-  bool IsCanonical = true;   // All canonical elts means this is canonical.
-  for (const TupleTypeElt &Elt : Fields) {
-    if (Elt.getType().isNull() || !Elt.getType()->isCanonical()) {
-      IsCanonical = false;
-      break;
+  return C.getImpl().getArena(arena).TupleTypes.findOrCreate(ID, [&] {
+    bool IsCanonical = true;   // All canonical elts means this is canonical.
+    for (const TupleTypeElt &Elt : Fields) {
+      if (Elt.getType().isNull() || !Elt.getType()->isCanonical()) {
+        IsCanonical = false;
+        break;
+      }
     }
-  }
 
-  // TupleType will copy the fields list into ASTContext owned memory.
-  void *mem = C.Allocate(sizeof(TupleType) +
-                         sizeof(TupleTypeElt) * Fields.size(),
-                         alignof(TupleType), arena);
-  auto New = new (mem) TupleType(Fields, IsCanonical ? &C : nullptr, properties,
-                                 hasInOut);
-  C.getImpl().getArena(arena).TupleTypes.InsertNode(New, InsertPos);
-  return New;
+    // TupleType will copy the fields list into ASTContext owned memory.
+    void *mem = C.Allocate(sizeof(TupleType) +
+                           sizeof(TupleTypeElt) * Fields.size(),
+                           alignof(TupleType), arena);
+    return new (mem) TupleType(Fields, IsCanonical ? &C : nullptr, properties,
+                               hasInOut);
+  });
 }
 
 TupleTypeElt::TupleTypeElt(Type ty, Identifier name,
@@ -3211,44 +3366,42 @@ BoundGenericType *BoundGenericType::get(NominalTypeDecl *TheDecl,
 
   auto arena = getArena(properties);
 
-  void *InsertPos = nullptr;
-  if (BoundGenericType *BGT =
-        C.getImpl().getArena(arena).BoundGenericTypes.FindNodeOrInsertPos(ID,
-                                                                     InsertPos))
-    return BGT;
-
-  bool IsCanonical = !Parent || Parent->isCanonical();
-  if (IsCanonical) {
-    for (Type Arg : GenericArgs) {
-      if (!Arg->isCanonical()) {
-        IsCanonical = false;
-        break;
+  return C.getImpl().getArena(arena).BoundGenericTypes.findOrCreate(ID, [&] {
+    bool IsCanonical = !Parent || Parent->isCanonical();
+    if (IsCanonical) {
+      for (Type Arg : GenericArgs) {
+        if (!Arg->isCanonical()) {
+          IsCanonical = false;
+          break;
+        }
       }
     }
-  }
-
-  BoundGenericType *newType;
-  if (auto theClass = dyn_cast<ClassDecl>(TheDecl)) {
-    auto sz = BoundGenericClassType::totalSizeToAlloc<Type>(GenericArgs.size());
-    auto mem = C.Allocate(sz, alignof(BoundGenericClassType), arena);
-    newType = new (mem) BoundGenericClassType(
-        theClass, Parent, GenericArgs, IsCanonical ? &C : nullptr, properties);
-  } else if (auto theStruct = dyn_cast<StructDecl>(TheDecl)) {
-    auto sz =BoundGenericStructType::totalSizeToAlloc<Type>(GenericArgs.size());
-    auto mem = C.Allocate(sz, alignof(BoundGenericStructType), arena);
-    newType = new (mem) BoundGenericStructType(
-        theStruct, Parent, GenericArgs, IsCanonical ? &C : nullptr, properties);
-  } else if (auto theEnum = dyn_cast<EnumDecl>(TheDecl)) {
-    auto sz = BoundGenericEnumType::totalSizeToAlloc<Type>(GenericArgs.size());
-    auto mem = C.Allocate(sz, alignof(BoundGenericEnumType), arena);
-    newType = new (mem) BoundGenericEnumType(
-        theEnum, Parent, GenericArgs, IsCanonical ? &C : nullptr, properties);
-  } else {
-    llvm_unreachable("Unhandled NominalTypeDecl");
-  }
-  C.getImpl().getArena(arena).BoundGenericTypes.InsertNode(newType, InsertPos);
 
-  return newType;
+    BoundGenericType *newType;
+    if (auto theClass = dyn_cast<ClassDecl>(TheDecl)) {
+      auto sz =
+        BoundGenericClassType::totalSizeToAlloc<Type>(GenericArgs.size());
+      auto mem = C.Allocate(sz, alignof(BoundGenericClassType), arena);
+      newType = new (mem) BoundGenericClassType(
+          theClass, Parent, GenericArgs, IsCanonical ? &C : nullptr,
+          properties);
+    } else if (auto theStruct = dyn_cast<StructDecl>(TheDecl)) {
+      auto sz =
+        BoundGenericStructType::totalSizeToAlloc<Type>(GenericArgs.size());
+      auto mem = C.Allocate(sz, alignof(BoundGenericStructType), arena);
+      newType = new (mem) BoundGenericStructType(
+          theStruct, Parent, GenericArgs, IsCanonical ? &C : nullptr,
+          properties);
+    } else if (auto theEnum = dyn_cast<EnumDecl>(TheDecl)) {
+      auto sz = BoundGenericEnumType::totalSizeToAlloc<Type>(GenericArgs.size());
+      auto mem = C.Allocate(sz, alignof(BoundGenericEnumType), arena);
+      newType = new (mem) BoundGenericEnumType(
+          theEnum, Parent, GenericArgs, IsCanonical ? &C : nullptr, properties);
+    } else {
+      llvm_unreachable("Unhandled NominalTypeDecl");
+    }
+    return newType;
+  });
 }
 
 NominalType *NominalType::get(NominalTypeDecl *D, Type Parent, const ASTContext &C) {
@@ -3636,17 +3789,15 @@ FunctionType *FunctionType::get(Type input, Type result,
 
   const ASTContext &C = input->getASTContext();
 
-  FunctionType *&Entry
-    = C.getImpl().getArena(arena).FunctionTypes[{input, {result, attrKey} }];
-  if (Entry) return Entry;
-  
-  SmallVector<AnyFunctionType::Param, 4> params;
-  AnyFunctionType::decomposeInput(input, params);
-  void *mem = C.Allocate(sizeof(FunctionType) +
-                           sizeof(AnyFunctionType::Param) * params.size(),
-                         alignof(FunctionType));
-  return Entry = new (mem) FunctionType(params, input, result,
-                                        properties, info);
+  return C.getImpl().getArena(arena).FunctionTypes.findOrCreate(
+      {input, {result, attrKey}}, [&] {
+    SmallVector<AnyFunctionType::Param, 4> params;
+    AnyFunctionType::decomposeInput(input, params);
+    void *mem = C.Allocate(sizeof(FunctionType) +
+                             sizeof(AnyFunctionType::Param) * params.size(),
+                           alignof(FunctionType));
+    return new (mem) FunctionType(params, input, result, properties, info);
+  });
 }
 
 // If the input and result types are canonical, then so is the result.
@@ -4307,6 +4458,46 @@ SubstitutionMap::Storage *SubstitutionMap::Storage::get(
   return result;
 }
 
+/// Determine the arena in which a composition of the two given substitution
+/// maps should be recorded, based on the recursive properties of their
+/// replacement types.
+static AllocationArena getSubstitutionMapCompositionArena(
+                                                    SubstitutionMap original,
+                                                    SubstitutionMap applied) {
+  RecursiveTypeProperties properties;
+  for (auto type : original.getReplacementTypes()) {
+    if (type)
+      properties |= type->getRecursiveProperties();
+  }
+  for (auto type : applied.getReplacementTypes()) {
+    if (type)
+      properties |= type->getRecursiveProperties();
+  }
+
+  return getArena(properties);
+}
+
+Optional<SubstitutionMap>
+ASTContext::getCachedSubstitutionMapComposition(SubstitutionMap original,
+                                                SubstitutionMap applied) {
+  auto arena = getSubstitutionMapCompositionArena(original, applied);
+  auto &compositions = getImpl().getArena(arena).SubstitutionMapCompositions;
+  auto known = compositions.find({original.getOpaqueValue(),
+                                  applied.getOpaqueValue()});
+  if (known == compositions.end())
+    return None;
+
+  return known->second;
+}
+
+void ASTContext::recordSubstitutionMapComposition(SubstitutionMap original,
+                                                  SubstitutionMap applied,
+                                                  SubstitutionMap result) {
+  auto arena = getSubstitutionMapCompositionArena(original, applied);
+  auto &compositions = getImpl().getArena(arena).SubstitutionMapCompositions;
+  compositions[{original.getOpaqueValue(), applied.getOpaqueValue()}] = result;
+}
+
 void GenericSignature::Profile(llvm::FoldingSetNodeID &ID,
                               TypeArrayView<GenericTypeParamType> genericParams,
                               ArrayRef<Requirement> requirements) {
@@ -485,6 +485,22 @@ std::string ASTMangler::mangleObjCRuntimeName(const NominalTypeDecl *Nominal) {
 #endif
 }
 
+std::string ASTMangler::mangleTypeWithoutPrefix(Type type) {
+  // The mangling of a standalone type is deterministic, so memoize whole
+  // results in the ASTContext; repeated manglings of the same generic
+  // application are common in IRGen and USR generation.
+  auto &cache = type->getASTContext().MangledTypeSymbols;
+  auto key = std::make_pair(type.getPointer(), StringRef());
+  auto known = cache.find(key);
+  if (known != cache.end())
+    return known->second;
+
+  appendType(type);
+  auto result = finalize();
+  cache[key] = result;
+  return result;
+}
+
 std::string ASTMangler::mangleTypeAsContextUSR(const NominalTypeDecl *type) {
   beginManglingWithoutPrefix();
   llvm::SaveAndRestore<bool> allowUnnamedRAII(AllowNamelessEntities, true);
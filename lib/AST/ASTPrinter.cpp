@@ -64,6 +64,35 @@ void PrintOptions::clearSynthesizedExtension() {
   TransformContext.reset();
 }
 
+TypeStringMemoizer::Key
+TypeStringMemoizer::getKey(TypeBase *type, const PrintOptions &options) {
+  unsigned flags =
+      (unsigned)options.FullyQualifiedTypes |
+      ((unsigned)options.FullyQualifiedTypesIfAmbiguous << 1) |
+      ((unsigned)options.PrintOptionalAsImplicitlyUnwrapped << 2) |
+      ((unsigned)options.SynthesizeSugarOnTypes << 3);
+  TypeBase *transformBase = nullptr;
+  if (options.TransformContext)
+    transformBase = options.TransformContext->getBaseType().getPointer();
+  return {type, {transformBase, flags}};
+}
+
+const std::string *
+TypeStringMemoizer::lookup(TypeBase *type, const PrintOptions &options) const {
+  auto known = RenderedTypes.find(getKey(type, options));
+  if (known == RenderedTypes.end())
+    return nullptr;
+  return &known->second;
+}
+
+const std::string &
+TypeStringMemoizer::record(TypeBase *type, const PrintOptions &options,
+                           std::string text) {
+  auto &stored = RenderedTypes[getKey(type, options)];
+  stored = std::move(text);
+  return stored;
+}
+
 TypeTransformContext::TypeTransformContext(Type T)
     : BaseType(T.getPointer()) {
   assert(T->mayHaveMembers());
@@ -137,11 +166,15 @@ ValueDecl* ASTPrinter::findConformancesWithDocComment(ValueDecl *VD) {
 void ASTPrinter::anchor() {}
 
 void ASTPrinter::printIndent() {
-  llvm::SmallString<16> Str;
-  for (unsigned i = 0; i != CurrentIndentation; ++i)
-    Str += ' ';
-
-  printText(Str);
+  // Print from a preformatted run of spaces rather than materializing one
+  // for every line.
+  static const char Spaces[] = "                                        ";
+  static const unsigned NumSpaces = sizeof(Spaces) - 1;
+  for (unsigned remaining = CurrentIndentation; remaining != 0; ) {
+    unsigned chunk = std::min(remaining, NumSpaces);
+    printText(StringRef(Spaces, chunk));
+    remaining -= chunk;
+  }
 }
 
 void ASTPrinter::printTextImpl(StringRef Text) {
@@ -285,6 +318,17 @@ void StreamPrinter::printText(StringRef Text) {
   OS << Text;
 }
 
+void BufferedStreamPrinter::printText(StringRef Text) {
+  Buffer += Text;
+  if (Buffer.size() >= 4096)
+    flush();
+}
+
+void BufferedStreamPrinter::flush() {
+  OS << Buffer.str();
+  Buffer.clear();
+}
+
 /// Whether we will be printing a TypeLoc by using the TypeRepr printer
 static bool willUseTypeReprPrinting(TypeLoc tyLoc,
                                     Type currentType,
@@ -3871,10 +3915,29 @@ void Type::print(raw_ostream &OS, const PrintOptions &PO) const {
   print(Printer, PO);
 }
 void Type::print(ASTPrinter &Printer, const PrintOptions &PO) const {
-  if (isNull())
+  if (isNull()) {
     Printer << "<null>";
-  else
-    TypePrinter(Printer, PO).visit(*this);
+    return;
+  }
+
+  // If the options carry a memoizer, render each distinct type only once
+  // and replay the resulting text on later occurrences.
+  if (auto *memoizer = PO.TypeMemoizer) {
+    if (auto *known = memoizer->lookup(getPointer(), PO)) {
+      Printer << *known;
+      return;
+    }
+
+    std::string text;
+    llvm::raw_string_ostream textOS(text);
+    StreamPrinter textPrinter(textOS);
+    TypePrinter(textPrinter, PO).visit(*this);
+    textOS.flush();
+    Printer << memoizer->record(getPointer(), PO, std::move(text));
+    return;
+  }
+
+  TypePrinter(Printer, PO).visit(*this);
 }
 
 void AnyFunctionType::printParams(raw_ostream &OS, const
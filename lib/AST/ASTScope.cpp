@@ -29,6 +29,7 @@
 #include "swift/Basic/STLExtras.h"
 #include "llvm/Support/Compiler.h"
 #include <algorithm>
+#include <memory>
 
 using namespace swift;
 
@@ -148,9 +149,10 @@ ASTScope::ASTScope(const ASTScope *parent, ArrayRef<ASTScope *> children)
   // Note that this node has already been expanded.
   parentAndExpanded.setInt(true);
 
-  // Register the destructor.
+  // Register the destructor with the file-scoped arena, so that it runs
+  // if the scope map is released before the ASTContext is destroyed.
   ASTContext &ctx = parent->getASTContext();
-  ctx.addDestructorCleanup(storedChildren);
+  ctx.addFileScopedDestructorCleanup(&parent->getSourceFile(), storedChildren);
 
   // Make sure the children were properly sorted.
   assert(std::is_sorted(children.begin(), children.end(),
@@ -177,6 +179,7 @@ static bool hasAccessors(AbstractStorageDecl *asd) {
 void ASTScope::expand() const {
   assert(!isExpanded() && "Already expanded the children of this node");
   ASTContext &ctx = getASTContext();
+  SourceFile *file = &getSourceFile();
 
 #ifndef NDEBUG
   auto verificationError = [&]() -> llvm::raw_ostream& {
@@ -261,7 +264,7 @@ void ASTScope::expand() const {
     // have them.
     pattern->forEachVariable([&](VarDecl *var) {
       if (hasAccessors(var)) {
-        addChild(new (ctx) ASTScope(this, var));
+        addChild(new (file) ASTScope(this, var));
       }
     });
   };
@@ -356,15 +359,15 @@ void ASTScope::expand() const {
     // Create a child for the initializer, if present.
     if (patternEntry.getInitAsWritten() &&
         patternEntry.getInitAsWritten()->getSourceRange().isValid()) {
-      addChild(new (ctx) ASTScope(ASTScopeKind::PatternInitializer, this,
-                                  patternBinding.decl, patternBinding.entry));
+      addChild(new (file) ASTScope(ASTScopeKind::PatternInitializer, this,
+                                   patternBinding.decl, patternBinding.entry));
     }
 
     // If there is an active continuation, nest the remaining pattern bindings.
     if (getActiveContinuation()) {
       // Note: the accessors will follow the pattern binding.
-      addChild(new (ctx) ASTScope(ASTScopeKind::AfterPatternBinding, this,
-                                  patternBinding.decl, patternBinding.entry));
+      addChild(new (file) ASTScope(ASTScopeKind::AfterPatternBinding, this,
+                                   patternBinding.decl, patternBinding.entry));
     } else {
       // Otherwise, add the accessors immediately.
       addAccessors(patternEntry.getPattern());
@@ -404,8 +407,8 @@ void ASTScope::expand() const {
   case ASTScopeKind::IfStmt:
     // The first conditional clause or, failing that, the 'then' clause.
     if (!ifStmt->getCond().empty()) {
-      addChild(new (ctx) ASTScope(this, ifStmt, 0,
-                                  /*isGuardContinuation=*/false));
+      addChild(new (file) ASTScope(this, ifStmt, 0,
+                                   /*isGuardContinuation=*/false));
     } else {
       if (auto thenChild = createIfNeeded(this, ifStmt->getThenStmt()))
         addChild(thenChild);
@@ -430,8 +433,8 @@ void ASTScope::expand() const {
     // If there's another conditional clause, add it as the child.
     unsigned nextIndex = conditionalClause.index + 1;
     if (nextIndex < conditionalClause.stmt->getCond().size()) {
-      addChild(new (ctx) ASTScope(this, conditionalClause.stmt, nextIndex,
-                                  conditionalClause.isGuardContinuation));
+      addChild(new (file) ASTScope(this, conditionalClause.stmt, nextIndex,
+                                   conditionalClause.isGuardContinuation));
       break;
     }
 
@@ -454,16 +457,16 @@ void ASTScope::expand() const {
 
   case ASTScopeKind::GuardStmt:
     // Add a child to describe the guard condition.
-    addChild(new (ctx) ASTScope(this, guard, 0,
-                                /*isGuardContinuation=*/false));
+    addChild(new (file) ASTScope(this, guard, 0,
+                                 /*isGuardContinuation=*/false));
 
     // Add a child for the 'guard' body, which always exits.
     if (auto bodyChild = createIfNeeded(this, guard->getBody()))
       addChild(bodyChild);
 
     // Add a child to describe the guard condition for the continuation.
-    addChild(new (ctx) ASTScope(this, guard, 0,
-                                /*isGuardContinuation=*/true));
+    addChild(new (file) ASTScope(this, guard, 0,
+                                 /*isGuardContinuation=*/true));
     break;
 
   case ASTScopeKind::RepeatWhileStmt:
@@ -483,7 +486,7 @@ void ASTScope::expand() const {
       addChild(seqChild);
 
     // Add a child describing the scope of the pattern.
-    addChild(new (ctx) ASTScope(ASTScopeKind::ForEachPattern, this, forEach));
+    addChild(new (file) ASTScope(ASTScopeKind::ForEachPattern, this, forEach));
     break;
 
   case ASTScopeKind::ForEachPattern:
@@ -576,7 +579,8 @@ void ASTScope::expand() const {
   // that there's a SmallVector that needs to be cleaned up.
   // FIXME: If we had access to SmallVector::isSmall(), we could do better.
   if (previouslyEmpty && !storedChildren.empty())
-    getASTContext().addDestructorCleanup(storedChildren);
+    getASTContext().addFileScopedDestructorCleanup(&getSourceFile(),
+                                                   storedChildren);
 
   // The scope is considered "expanded" at this point, although there might be
   // further work to do if there is an active continuation.
@@ -607,10 +611,8 @@ bool ASTScope::isExpanded() const {
 /// Create the AST scope for a source file, which is the root of the scope
 /// tree.
 ASTScope *ASTScope::createRoot(SourceFile *sourceFile) {
-  ASTContext &ctx = sourceFile->getASTContext();
-
   // Create the scope.
-  ASTScope *scope = new (ctx) ASTScope(sourceFile, 0);
+  ASTScope *scope = new (sourceFile) ASTScope(sourceFile, 0);
   scope->sourceFile.file = sourceFile;
   scope->sourceFile.nextElement = 0;
 
@@ -791,13 +793,13 @@ ASTScope *ASTScope::createIfNeeded(const ASTScope *parent, Decl *decl) {
       return nullptr;
   }
 
-  ASTContext &ctx = decl->getASTContext();
+  SourceFile *file = &parent->getSourceFile();
 
   // If this is a type declaration for which we have not introduced a TypeDecl
   // scope, add it now.
   if (auto typeDecl = dyn_cast<TypeDecl>(decl)) {
     if (!parentDirectDescendedFromTypeDecl(parent, typeDecl)) {
-      return new (ctx) ASTScope(parent, typeDecl);
+      return new (file) ASTScope(parent, typeDecl);
     }
   }
 
@@ -805,8 +807,8 @@ ASTScope *ASTScope::createIfNeeded(const ASTScope *parent, Decl *decl) {
   // an AbstractFunctionDecl scope, add it now.
   if (auto func = dyn_cast<AbstractFunctionDecl>(decl)) {
     if (!parentDirectDescendedFromAbstractFunctionDecl(parent, func)) {
-      return new (ctx) ASTScope(ASTScopeKind::AbstractFunctionDecl, parent,
-                                func);
+      return new (file) ASTScope(ASTScopeKind::AbstractFunctionDecl, parent,
+                                 func);
     }
   }
 
@@ -820,7 +822,7 @@ ASTScope *ASTScope::createIfNeeded(const ASTScope *parent, Decl *decl) {
                         ? parent->genericParams.index + 1
                         : 0;
     if (index < genericParams->size())
-      return new (ctx) ASTScope(parent, genericParams, decl, index);
+      return new (file) ASTScope(parent, genericParams, decl, index);
 
     return nullptr;
   };
@@ -854,14 +856,14 @@ ASTScope *ASTScope::createIfNeeded(const ASTScope *parent, Decl *decl) {
     // If we already have a scope of the (possible) generic parameters,
     // add the body.
     if (parent->getKind() == ASTScopeKind::ExtensionGenericParams)
-      return new (ctx) ASTScope(parent, cast<IterableDeclContext>(ext));
+      return new (file) ASTScope(parent, cast<IterableDeclContext>(ext));
 
     // Otherwise, form the extension's generic parameters scope.
-    return new (ctx) ASTScope(parent, ext);
+    return new (file) ASTScope(parent, ext);
   }
 
   case DeclKind::TopLevelCode:
-    return new (ctx) ASTScope(parent, cast<TopLevelCodeDecl>(decl));
+    return new (file) ASTScope(parent, cast<TopLevelCodeDecl>(decl));
 
   case DeclKind::Protocol:
     cast<ProtocolDecl>(decl)->createGenericParamsIfMissing();
@@ -877,7 +879,7 @@ ASTScope *ASTScope::createIfNeeded(const ASTScope *parent, Decl *decl) {
     if (auto scope = nextGenericParam(nominal->getGenericParams(), nominal))
       return scope;
 
-    return new (ctx) ASTScope(parent, cast<IterableDeclContext>(nominal));
+    return new (file) ASTScope(parent, cast<IterableDeclContext>(nominal));
   }
 
   case DeclKind::TypeAlias: {
@@ -930,17 +932,17 @@ ASTScope *ASTScope::createIfNeeded(const ASTScope *parent, Decl *decl) {
       // Determine whether there is a default argument.
       ASTScope *defaultArgumentScope = nullptr;
       if (currentParam->getDefaultValue())
-        defaultArgumentScope = new (ctx) ASTScope(parent, currentParam);
+        defaultArgumentScope = new (file) ASTScope(parent, currentParam);
 
       // If there is another parameter to visit, do so now.
-      ASTScope *afterParamScope = new (ctx) ASTScope(parent, abstractFunction,
-                                                     nextParameter->first,
-                                                     nextParameter->second);
+      ASTScope *afterParamScope = new (file) ASTScope(parent, abstractFunction,
+                                                      nextParameter->first,
+                                                      nextParameter->second);
 
       // If we have a default argument, use a pre-expanded node.
       if (defaultArgumentScope) {
         ASTScope *children[2] = { defaultArgumentScope, afterParamScope };
-        return new (ctx) ASTScope(parent, children);
+        return new (file) ASTScope(parent, children);
       }
 
       return afterParamScope;
@@ -948,8 +950,8 @@ ASTScope *ASTScope::createIfNeeded(const ASTScope *parent, Decl *decl) {
 
     // Function body, if present.
     if (abstractFunction->hasBody())
-      return new (ctx) ASTScope(ASTScopeKind::AbstractFunctionBody, parent,
-                                abstractFunction);
+      return new (file) ASTScope(ASTScopeKind::AbstractFunctionBody, parent,
+                                 abstractFunction);
     return nullptr;
   }
 
@@ -964,8 +966,8 @@ ASTScope *ASTScope::createIfNeeded(const ASTScope *parent, Decl *decl) {
                           ? parent->patternBinding.entry + 1
                           : 0;
       if (entry < patternBinding->getPatternList().size())
-        return new (ctx) ASTScope(ASTScopeKind::PatternBinding, parent,
-                                  patternBinding, entry);
+        return new (file) ASTScope(ASTScopeKind::PatternBinding, parent,
+                                   patternBinding, entry);
 
       return nullptr;
     }
@@ -974,24 +976,24 @@ ASTScope *ASTScope::createIfNeeded(const ASTScope *parent, Decl *decl) {
 
     // Handle a single binding directly.
     if (patternBinding->getNumPatternEntries() == 1)
-      return new (ctx) ASTScope(ASTScopeKind::PatternBinding, parent,
-                                patternBinding, 0);
+      return new (file) ASTScope(ASTScopeKind::PatternBinding, parent,
+                                 patternBinding, 0);
 
 
     // Pre-expand when there are multiple bindings.
     SmallVector<ASTScope *, 4> bindings;
     for (auto entry : range(patternBinding->getNumPatternEntries())) {
-      bindings.push_back(new (ctx) ASTScope(ASTScopeKind::PatternBinding,
-                                            parent, patternBinding, entry));
+      bindings.push_back(new (file) ASTScope(ASTScopeKind::PatternBinding,
+                                             parent, patternBinding, entry));
     }
 
-    return new (ctx) ASTScope(parent, bindings);
+    return new (file) ASTScope(parent, bindings);
   }
 
   case DeclKind::Subscript: {
     auto asd = cast<AbstractStorageDecl>(decl);
     if (hasAccessors(asd))
-      return new (ctx) ASTScope(parent, asd);
+      return new (file) ASTScope(parent, asd);
     return nullptr;
   }
   }
@@ -1002,11 +1004,11 @@ ASTScope *ASTScope::createIfNeeded(const ASTScope *parent, Decl *decl) {
 ASTScope *ASTScope::createIfNeeded(const ASTScope *parent, Stmt *stmt) {
   if (!stmt) return nullptr;
 
-  ASTContext &ctx = parent->getASTContext();
+  SourceFile *file = &parent->getSourceFile();
   switch (stmt->getKind()) {
   case StmtKind::Brace:
     if (stmt->getSourceRange().isInvalid()) return nullptr;
-    return new (ctx) ASTScope(parent, cast<BraceStmt>(stmt));
+    return new (file) ASTScope(parent, cast<BraceStmt>(stmt));
 
   case StmtKind::Return: {
     auto returnStmt = cast<ReturnStmt>(stmt);
@@ -1019,10 +1021,10 @@ ASTScope *ASTScope::createIfNeeded(const ASTScope *parent, Stmt *stmt) {
     return createIfNeeded(parent, cast<DeferStmt>(stmt)->getTempDecl());
 
   case StmtKind::If:
-    return new (ctx) ASTScope(parent, cast<IfStmt>(stmt));
+    return new (file) ASTScope(parent, cast<IfStmt>(stmt));
 
   case StmtKind::Guard:
-    return new (ctx) ASTScope(parent, cast<GuardStmt>(stmt));
+    return new (file) ASTScope(parent, cast<GuardStmt>(stmt));
 
   case StmtKind::While: {
     // If there are no conditions, just create the body.
@@ -1031,31 +1033,31 @@ ASTScope *ASTScope::createIfNeeded(const ASTScope *parent, Stmt *stmt) {
       return createIfNeeded(parent, whileStmt->getBody());
 
     // Create a node for the first conditional clause.
-    return new (ctx) ASTScope(parent, whileStmt, 0,
-                              /*isGuardContinuation=*/false);
+    return new (file) ASTScope(parent, whileStmt, 0,
+                               /*isGuardContinuation=*/false);
   }
 
   case StmtKind::RepeatWhile:
-    return new (ctx) ASTScope(parent, cast<RepeatWhileStmt>(stmt));
+    return new (file) ASTScope(parent, cast<RepeatWhileStmt>(stmt));
 
   case StmtKind::ForEach:
-    return new (ctx) ASTScope(ASTScopeKind::ForEachStmt, parent,
-                              cast<ForEachStmt>(stmt));
+    return new (file) ASTScope(ASTScopeKind::ForEachStmt, parent,
+                               cast<ForEachStmt>(stmt));
 
   case StmtKind::Do:
     return createIfNeeded(parent, cast<DoStmt>(stmt)->getBody());
 
   case StmtKind::DoCatch:
-    return new (ctx) ASTScope(parent, cast<DoCatchStmt>(stmt));
+    return new (file) ASTScope(parent, cast<DoCatchStmt>(stmt));
 
   case StmtKind::Catch:
-    return new (ctx) ASTScope(parent, cast<CatchStmt>(stmt));
+    return new (file) ASTScope(parent, cast<CatchStmt>(stmt));
 
   case StmtKind::Switch:
-    return new (ctx) ASTScope(parent, cast<SwitchStmt>(stmt));
+    return new (file) ASTScope(parent, cast<SwitchStmt>(stmt));
 
   case StmtKind::Case:
-    return new (ctx) ASTScope(parent, cast<CaseStmt>(stmt));
+    return new (file) ASTScope(parent, cast<CaseStmt>(stmt));
 
   case StmtKind::Break:
   case StmtKind::Continue:
@@ -1126,16 +1128,16 @@ ASTScope *ASTScope::createIfNeeded(const ASTScope *parent,
   if (closures.empty())
     return nullptr;
 
-  ASTContext &ctx = parent->getASTContext();
+  SourceFile *file = &parent->getSourceFile();
   if (closures.size() == 1)
-    return new (ctx) ASTScope(parent, closures[0]);
+    return new (file) ASTScope(parent, closures[0]);
 
   // Create the closure scopes for each of the closures.
   SmallVector<ASTScope *, 4> closureScopes;
   for (auto closure : closures)
-    closureScopes.push_back(new (ctx) ASTScope(parent, closure));
+    closureScopes.push_back(new (file) ASTScope(parent, closure));
 
-  return new (ctx) ASTScope(parent, closureScopes);
+  return new (file) ASTScope(parent, closureScopes);
 }
 
 ASTScope *ASTScope::createIfNeeded(const ASTScope *parent, ASTNode node) {
@@ -1585,9 +1587,15 @@ const ASTScope *ASTScope::findInnermostEnclosingScope(SourceLoc loc) const {
   ASTContext &ctx = getASTContext();
   SourceManager &sourceMgr = ctx.SourceMgr;
 
+  // When searching from the root, resume from the result of the previous
+  // search; lookups cluster around nearby locations, so the innermost scope
+  // is usually only a few parents away from the last one we found.
+  const ASTScope *searchNode = this;
+  if (kind == ASTScopeKind::SourceFile && sourceFile.cachedInnermostScope)
+    searchNode = sourceFile.cachedInnermostScope;
+
   // Search up the tree to find the nearest parent that contains this source
   // location.
-  const ASTScope *searchNode = this;
   while (!sourceMgr.rangeContainsTokenLoc(searchNode->getSourceRange(), loc))
     searchNode = searchNode->getParent();
 
@@ -1621,6 +1629,8 @@ const ASTScope *ASTScope::findInnermostEnclosingScope(SourceLoc loc) const {
 
     // Otherwise, our current search node is the best we could find.
     assert(sourceMgr.rangeContainsTokenLoc(searchNode->getSourceRange(), loc));
+    if (kind == ASTScopeKind::SourceFile)
+      sourceFile.cachedInnermostScope = searchNode;
     return searchNode;
   };
 }
@@ -1697,7 +1707,10 @@ DeclContext *ASTScope::getInnermostEnclosingDeclContext() const {
   llvm_unreachable("Top-most scope is a declaration context");
 }
 
-SmallVector<ValueDecl *, 4> ASTScope::getLocalBindings() const {
+ArrayRef<ValueDecl *> ASTScope::getLocalBindings() const {
+  if (cachedLocalBindings)
+    return *cachedLocalBindings;
+
   SmallVector<ValueDecl *, 4> result;
 
   auto handlePattern = [&](const Pattern *pattern) {
@@ -1812,7 +1825,18 @@ SmallVector<ValueDecl *, 4> ASTScope::getLocalBindings() const {
     break;
   }
 
-  return result;
+  // Cache the result in the file-scoped arena, so it is freed along with
+  // the scope itself.
+  if (result.empty()) {
+    cachedLocalBindings = ArrayRef<ValueDecl *>();
+  } else {
+    SourceFile &file = getSourceFile();
+    auto &allocator = getASTContext().getFileScopedAllocator(&file);
+    auto *mem = allocator.Allocate<ValueDecl *>(result.size());
+    std::uninitialized_copy(result.begin(), result.end(), mem);
+    cachedLocalBindings = llvm::makeArrayRef(mem, result.size());
+  }
+  return *cachedLocalBindings;
 }
 
 void ASTScope::expandAll() const {
@@ -2080,8 +2104,11 @@ void ASTScope::dump() const {
   print(llvm::errs(), 0, false);
 }
 
-void *ASTScope::operator new(size_t bytes, const ASTContext &ctx,
+void *ASTScope::operator new(size_t bytes, const SourceFile *file,
                              unsigned alignment) {
-  return ctx.Allocate(bytes, alignment);
+  // Scopes are placed in their file's file-scoped allocator, so the entire
+  // scope map can be released once the file has been type checked.
+  ASTContext &ctx = file->getASTContext();
+  return ctx.getFileScopedAllocator(file).Allocate(bytes, alignment);
 }
 
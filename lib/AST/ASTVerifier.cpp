@@ -3499,8 +3499,33 @@ public:
 
 void swift::verify(SourceFile &SF) {
 #if !(defined(NDEBUG) || defined(SWIFT_DISABLE_AST_VERIFIER))
-  Verifier verifier(SF, &SF);
-  SF.walk(verifier);
+  auto &ctx = SF.getASTContext();
+  unsigned currentEpoch = ctx.ASTMutationEpoch;
+
+  if (SF.LastVerifiedEpoch == 0) {
+    // The file has never been verified; fall back to the full walk.
+    Verifier verifier(SF, &SF);
+    SF.walk(verifier);
+  } else {
+    // Re-verify only the top-level declarations whose subtrees have been
+    // mutated since the previous pass. A declaration with no recorded
+    // epoch has unknown state, so treat it as dirty.
+    for (Decl *D : SF.Decls) {
+      unsigned declEpoch = D->getMutationEpoch();
+      if (declEpoch != 0 && declEpoch <= SF.LastVerifiedEpoch)
+        continue;
+
+      Verifier verifier(SF, &SF);
+      D->walk(verifier);
+
+      // Declarations without a recorded epoch would otherwise stay dirty
+      // forever; note that they are clean as of this pass.
+      if (declEpoch == 0)
+        D->setMutationEpoch(currentEpoch);
+    }
+  }
+
+  SF.LastVerifiedEpoch = currentEpoch;
 #endif
 }
 
@@ -139,6 +139,51 @@ void AccessLevelRequest::cacheResult(AccessLevel value) const {
   valueDecl->setAccess(value);
 }
 
+/// Whether the computed access level of \p D depends only on the contents of
+/// D's own source file. Declarations lexically inside an extension inherit
+/// from the extension's default access, which in turn depends on the
+/// extended type, possibly declared in another file.
+static bool accessDependsOnlyOnOwnFile(const Decl *D) {
+  for (auto *DC = D->getDeclContext(); DC; DC = DC->getParent()) {
+    if (DC->getContextKind() == DeclContextKind::ExtensionDecl)
+      return false;
+  }
+  return true;
+}
+
+/// Serialize an access level as its raw value; shared by the access-level
+/// requests.
+static std::string serializeAccessLevel(AccessLevel value) {
+  return std::to_string(static_cast<unsigned>(value));
+}
+
+/// Deserialize an access level from its raw value, rejecting out-of-range
+/// entries from stale or corrupt caches.
+static Optional<AccessLevel> deserializeAccessLevel(StringRef value) {
+  unsigned raw;
+  if (value.getAsInteger(10, raw) ||
+      raw > static_cast<unsigned>(AccessLevel::Open))
+    return None;
+  return static_cast<AccessLevel>(raw);
+}
+
+std::string
+AccessLevelRequest::getPersistentCacheKey(EvaluatorResultCache &cache) const {
+  auto valueDecl = std::get<0>(getStorage());
+  if (!accessDependsOnlyOnOwnFile(valueDecl))
+    return std::string();
+  return cache.getKeyForDecl("access-level", valueDecl);
+}
+
+std::string AccessLevelRequest::serializeResult(AccessLevel value) {
+  return serializeAccessLevel(value);
+}
+
+Optional<AccessLevel>
+AccessLevelRequest::deserializeResult(StringRef value) {
+  return deserializeAccessLevel(value);
+}
+
 //----------------------------------------------------------------------------//
 // SetterAccessLevel computation
 //----------------------------------------------------------------------------//
@@ -189,6 +234,23 @@ void SetterAccessLevelRequest::cacheResult(AccessLevel value) const {
   abstractStorageDecl->Accessors.setInt(value);
 }
 
+std::string SetterAccessLevelRequest::getPersistentCacheKey(
+    EvaluatorResultCache &cache) const {
+  auto abstractStorageDecl = std::get<0>(getStorage());
+  if (!accessDependsOnlyOnOwnFile(abstractStorageDecl))
+    return std::string();
+  return cache.getKeyForDecl("setter-access-level", abstractStorageDecl);
+}
+
+std::string SetterAccessLevelRequest::serializeResult(AccessLevel value) {
+  return serializeAccessLevel(value);
+}
+
+Optional<AccessLevel>
+SetterAccessLevelRequest::deserializeResult(StringRef value) {
+  return deserializeAccessLevel(value);
+}
+
 
 //----------------------------------------------------------------------------//
 // DefaultAccessLevel computation
@@ -323,10 +323,22 @@ DeclContext *Decl::getInnermostDeclContext() const {
   return getDeclContext();
 }
 
-void Decl::setDeclContext(DeclContext *DC) { 
+void Decl::setDeclContext(DeclContext *DC) {
   Context = DC;
 }
 
+void Decl::markMutated() {
+  // Dirtiness is tracked at module-scope granularity, so climb to the
+  // outermost declaration containing this one.
+  Decl *topLevel = this;
+  for (auto *dc = getDeclContext(); dc && !dc->isModuleScopeContext();
+       dc = dc->getParent()) {
+    if (auto *enclosing = dc->getAsDeclOrDeclExtensionContext())
+      topLevel = enclosing;
+  }
+  topLevel->MutationEpoch = ++getASTContext().ASTMutationEpoch;
+}
+
 bool Decl::isUserAccessible() const {
   if (auto VD = dyn_cast<ValueDecl>(this)) {
     return VD->isUserAccessible();
@@ -2120,6 +2132,7 @@ void ValueDecl::setInterfaceType(Type type) {
            "Archetype in interface type");
   }
   TypeAndAccess.setPointer(type);
+  markMutated();
 }
 
 bool ValueDecl::hasValidSignature() const {
@@ -2686,7 +2699,12 @@ ExtensionRange NominalTypeDecl::getExtensions() {
 void NominalTypeDecl::addExtension(ExtensionDecl *extension) {
   assert(!extension->NextExtension.getInt() && "Already added extension");
   extension->NextExtension.setInt(true);
-  
+
+  // The extension may declare conformances, including for subclasses of this
+  // type, so previously failed conformance lookups are no longer valid.
+  getASTContext().FailedConformanceLookups.clear();
+
+
   // First extension; set both first and last.
   if (!FirstExtension) {
     FirstExtension = extension;
@@ -678,6 +678,8 @@ void IterableDeclContext::addMember(Decl *member, Decl *Hint) {
   // Add the member to the list of declarations without notification.
   addMemberSilently(member, Hint);
 
+  member->markMutated();
+
   // Notify our parent declaration that we have added the member, which can
   // be used to update the lookup tables.
   switch (getIterableContextKind()) {
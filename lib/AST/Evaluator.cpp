@@ -18,6 +18,7 @@
 #include "swift/Basic/Range.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Threading.h"
 
 using namespace swift;
 
@@ -62,10 +63,19 @@ Evaluator::Evaluator(DiagnosticEngine &diags,
                      CycleDiagnosticKind shouldDiagnoseCycles)
   : diags(diags), shouldDiagnoseCycles(shouldDiagnoseCycles) { }
 
+llvm::SetVector<AnyRequest> &Evaluator::getActiveRequests() {
+  std::lock_guard<std::mutex> lock(stateMutex);
+  return activeRequestsByThread[llvm::get_threadid()];
+}
+
 bool Evaluator::checkDependency(const AnyRequest &request) {
+  auto &activeRequests = getActiveRequests();
+
   // If there is an active request, record it's dependency on this request.
-  if (!activeRequests.empty())
+  if (!activeRequests.empty()) {
+    std::lock_guard<std::mutex> lock(stateMutex);
     dependencies[activeRequests.back()].push_back(request);
+  }
 
   // Record this as an active request.
   if (activeRequests.insert(request)) {
@@ -98,7 +108,7 @@ bool Evaluator::checkDependency(const AnyRequest &request) {
 
 void Evaluator::diagnoseCycle(const AnyRequest &request) {
   request.diagnoseCycle(diags);
-  for (const auto &step : reversed(activeRequests)) {
+  for (const auto &step : reversed(getActiveRequests())) {
     if (step == request) return;
 
     step.noteCycleStep(diags);
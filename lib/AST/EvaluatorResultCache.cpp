@@ -0,0 +1,119 @@
+//===--- EvaluatorResultCache.cpp - Persistent Request Results ------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the on-disk cache of request-evaluator results.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/AST/EvaluatorResultCache.h"
+#include "swift/AST/ASTContext.h"
+#include "swift/AST/Decl.h"
+#include "swift/Basic/SourceManager.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace swift;
+
+/// Each line of the cache file holds one entry: the key, a tab, and the
+/// serialized value. Keys and values therefore must not contain tabs or
+/// newlines.
+void EvaluatorResultCache::load() {
+  if (Loaded)
+    return;
+  Loaded = true;
+
+  auto buffer = llvm::MemoryBuffer::getFile(CachePath);
+  if (!buffer)
+    return;
+
+  SmallVector<StringRef, 64> lines;
+  (*buffer)->getBuffer().split(lines, '\n', /*MaxSplit=*/-1,
+                               /*KeepEmpty=*/false);
+  for (StringRef line : lines) {
+    auto split = line.split('\t');
+    if (split.first.empty() || split.second.empty())
+      continue;
+    Entries[split.first] = split.second.str();
+  }
+}
+
+void EvaluatorResultCache::save() {
+  if (!Dirty)
+    return;
+
+  // Write to a unique temporary and rename it into place, so that
+  // concurrent frontend invocations sharing a cache never observe a
+  // partially written file.
+  SmallString<128> tempPath;
+  int tempFD;
+  if (llvm::sys::fs::createUniqueFile(CachePath + ".tmp-%%%%%%", tempFD,
+                                      tempPath))
+    return;
+
+  {
+    llvm::raw_fd_ostream out(tempFD, /*shouldClose=*/true);
+    for (const auto &entry : Entries)
+      out << entry.getKey() << '\t' << entry.getValue() << '\n';
+  }
+
+  if (llvm::sys::fs::rename(tempPath, CachePath))
+    llvm::sys::fs::remove(tempPath);
+}
+
+std::string EvaluatorResultCache::getKeyForDecl(StringRef requestTag,
+                                                const Decl *decl) {
+  // Implicit declarations have no stable source identity.
+  auto loc = decl->getLoc();
+  if (loc.isInvalid())
+    return std::string();
+
+  auto &sourceMgr = decl->getASTContext().SourceMgr;
+  unsigned bufferID = sourceMgr.findBufferContainingLoc(loc);
+
+  // Fingerprint the buffer so that any edit to the file invalidates the
+  // entries derived from it.
+  auto knownHash = BufferHashes.find(bufferID);
+  if (knownHash == BufferHashes.end()) {
+    uint64_t hash =
+      llvm::hash_value(sourceMgr.getEntireTextForBuffer(bufferID));
+    knownHash = BufferHashes.insert({bufferID, hash}).first;
+  }
+
+  std::string key;
+  {
+    llvm::raw_string_ostream out(key);
+    out << requestTag << ':'
+        << llvm::format_hex_no_prefix(knownHash->second, 16) << ':'
+        << sourceMgr.getLocOffsetInBuffer(loc, bufferID);
+  }
+  return key;
+}
+
+const std::string *EvaluatorResultCache::lookup(StringRef key) {
+  load();
+  auto known = Entries.find(key);
+  if (known == Entries.end())
+    return nullptr;
+  return &known->second;
+}
+
+void EvaluatorResultCache::record(StringRef key, StringRef value) {
+  load();
+  auto inserted = Entries.insert({key, value.str()});
+  if (inserted.second)
+    Dirty = true;
+}
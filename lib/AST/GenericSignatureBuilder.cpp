@@ -91,6 +91,10 @@ STATISTIC(NumArchetypeAnchorCacheHits,
           "# of hits in the archetype anchor cache");
 STATISTIC(NumArchetypeAnchorCacheMisses,
           "# of misses in the archetype anchor cache");
+STATISTIC(NumCanonicalTypeParameterCacheHits,
+          "# of hits in the canonical type parameter cache");
+STATISTIC(NumCanonicalTypeParameterCacheMisses,
+          "# of misses in the canonical type parameter cache");
 STATISTIC(NumNestedTypeCacheHits,
          "# of hits in the equivalence class nested type cache");
 STATISTIC(NumNestedTypeCacheMisses,
@@ -445,6 +449,17 @@ struct GenericSignatureBuilder::Implementation {
   /// increased every time a new rule gets added.
   unsigned RewriteGeneration = 0;
 
+  /// Memoized results of getCanonicalTypeParameter, valid only for
+  /// \c CanonicalTypeParameterCacheGeneration. The cache is bypassed while
+  /// the rewrite system is being minimized, because minimization
+  /// temporarily disables rules, and cleared afterwards, because
+  /// minimization rewrites rules in place without bumping the generation.
+  llvm::DenseMap<CanType, Type> CanonicalTypeParameterCache;
+
+  /// The rewrite generation against which the entries in
+  /// \c CanonicalTypeParameterCache were computed.
+  unsigned CanonicalTypeParameterCacheGeneration = 0;
+
   /// The generation at which the term-rewriting system was last minimized.
   unsigned LastRewriteMinimizedGeneration = 0;
 
@@ -461,6 +476,16 @@ struct GenericSignatureBuilder::Implementation {
   /// Whether we are currently minimizing the term-rewriting system.
   bool MinimizingRewriteSystem = false;
 
+  /// The explicit requirements fed to this builder, canonicalized, which
+  /// form the input fingerprint for the minimized-signature cache.
+  SmallVector<Requirement, 4> ExplicitInputRequirements;
+
+  /// Whether \c ExplicitInputRequirements covers everything that influenced
+  /// the builder's state. Paths that add constraints without recording them
+  /// (requirement inference and RequirementRepr-based additions) clear this,
+  /// which disables the minimized-signature cache for this builder.
+  bool InputsComplete = true;
+
   /// Whether there were any errors.
   bool HadAnyError = false;
 
@@ -3578,6 +3603,11 @@ void GenericSignatureBuilder::Implementation::minimizeRewriteTree(
 
   minimizeRewriteTreeRhs(builder);
   removeRewriteTreeRedundancies(builder);
+
+  // Minimization rewrote rules in place without bumping the rewrite
+  // generation; drop memoized canonical terms computed against the old
+  // rules.
+  CanonicalTypeParameterCache.clear();
 }
 
 void GenericSignatureBuilder::Implementation::minimizeRewriteTreeRhs(
@@ -3725,6 +3755,28 @@ bool GenericSignatureBuilder::addSameTypeRewriteRule(CanType type1,
 }
 
 Type GenericSignatureBuilder::getCanonicalTypeParameter(Type type) {
+  // Consult the memoized results for the current rewrite generation.
+  // Canonicalization is a pure function of the rule set, so terms that the
+  // minimization and equivalence-class-merging loops canonicalize over and
+  // over only pay for the rewrite walk once per generation.
+  CanType cacheKey;
+  if (!Impl->MinimizingRewriteSystem) {
+    if (Impl->CanonicalTypeParameterCacheGeneration
+          != Impl->RewriteGeneration) {
+      Impl->CanonicalTypeParameterCache.clear();
+      Impl->CanonicalTypeParameterCacheGeneration = Impl->RewriteGeneration;
+    }
+
+    cacheKey = type->getCanonicalType();
+    auto known = Impl->CanonicalTypeParameterCache.find(cacheKey);
+    if (known != Impl->CanonicalTypeParameterCache.end()) {
+      ++NumCanonicalTypeParameterCacheHits;
+      return known->second;
+    }
+
+    ++NumCanonicalTypeParameterCacheMisses;
+  }
+
   auto initialPath = RewritePath::createPath(type);
   auto genericParamType =
     GenericTypeParamType::get(initialPath.getBase()->Depth,
@@ -3784,7 +3836,10 @@ Type GenericSignatureBuilder::getCanonicalTypeParameter(Type type) {
     currentType = DependentMemberType::get(currentType, path[startIndex++]);
   } while (true);
 
-  return formDependentType(genericParamType, path);
+  Type result = formDependentType(genericParamType, path);
+  if (cacheKey)
+    Impl->CanonicalTypeParameterCache[cacheKey] = result;
+  return result;
 }
 
 #pragma mark Equivalence classes
@@ -4113,6 +4168,10 @@ void GenericSignatureBuilder::addGenericParameter(GenericTypeParamDecl *GenericP
 
 bool GenericSignatureBuilder::addGenericParameterRequirements(
                                            GenericTypeParamDecl *GenericParam) {
+  // Requirements from a parameter's inheritance clause are not recorded for
+  // the minimized-signature cache.
+  Impl->InputsComplete = false;
+
   GenericParamKey Key(GenericParam);
   auto PA = Impl->PotentialArchetypes[Key.findIndexIn(getGenericParams())];
   
@@ -5311,6 +5370,10 @@ ConstraintResult GenericSignatureBuilder::addRequirement(
                                              FloatingRequirementSource source,
                                              const SubstitutionMap *subMap,
                                              ModuleDecl *inferForModule) {
+  // Requirements added from their written representation are not recorded
+  // for the minimized-signature cache.
+  Impl->InputsComplete = false;
+
   auto subst = [&](Type t) {
     if (subMap)
       return t.subst(*subMap, SubstFlags::UseErrorType);
@@ -5395,6 +5458,24 @@ ConstraintResult
 GenericSignatureBuilder::addRequirement(const Requirement &req,
                                         FloatingRequirementSource source,
                                         ModuleDecl *inferForModule) {
+  // Record the raw requirement for the minimized-signature cache. Inference
+  // adds constraints that are not captured here, so it disables recording.
+  if (inferForModule) {
+    Impl->InputsComplete = false;
+  } else if (Impl->InputsComplete) {
+    auto canFirst = req.getFirstType()->getCanonicalType();
+    if (!canFirst->isTypeParameter()) {
+      Impl->InputsComplete = false;
+    } else if (req.getKind() == RequirementKind::Layout) {
+      Impl->ExplicitInputRequirements.push_back(
+          Requirement(req.getKind(), canFirst, req.getLayoutConstraint()));
+    } else {
+      Impl->ExplicitInputRequirements.push_back(
+          Requirement(req.getKind(), canFirst,
+                      req.getSecondType()->getCanonicalType()));
+    }
+  }
+
   auto firstType = req.getFirstType();
 
   switch (req.getKind()) {
@@ -5524,6 +5605,10 @@ void GenericSignatureBuilder::inferRequirements(
                                           FloatingRequirementSource source) {
   if (!type.getType())
     return;
+
+  // Inferred requirements are not recorded for the minimized-signature
+  // cache.
+  Impl->InputsComplete = false;
   // FIXME: Crummy source-location information.
   InferRequirementsWalker walker(module, *this, source);
   type.getType().walk(walker);
@@ -7455,6 +7540,22 @@ GenericSignature *GenericSignatureBuilder::computeGenericSignature(
                                           SourceLoc loc,
                                           bool allowConcreteGenericParams,
                                           bool allowBuilderToMove) && {
+  // If the raw inputs were fully recorded and no diagnostics will be
+  // emitted, equivalent inputs always minimize to the same signature, so
+  // consult the cache of previously minimized signatures. The key is the
+  // unminimized "input" signature, which is uniqued structurally.
+  GenericSignature *inputSig = nullptr;
+  if (loc.isInvalid() && Impl->InputsComplete &&
+      !Impl->GenericParams.empty()) {
+    inputSig = GenericSignature::get(getGenericParams(),
+                                     Impl->ExplicitInputRequirements);
+    auto known = Context.MinimizedGenericSignatures.find(inputSig);
+    if (known != Context.MinimizedGenericSignatures.end()) {
+      Impl.reset();
+      return known->second;
+    }
+  }
+
   // Finalize the builder, producing any necessary diagnostics.
   finalize(loc, getGenericParams(), allowConcreteGenericParams);
 
@@ -7465,6 +7566,11 @@ GenericSignature *GenericSignatureBuilder::computeGenericSignature(
   // Form the generic signature.
   auto sig = GenericSignature::get(getGenericParams(), requirements);
 
+  // Remember the minimized signature for these inputs, so that subsequent
+  // builders fed equivalent requirements become a hash lookup.
+  if (inputSig && !Impl->HadAnyError)
+    Context.MinimizedGenericSignatures.insert({inputSig, sig});
+
   // When we can, move this generic signature builder to make it the canonical
   // builder, rather than constructing a new generic signature builder that
   // will produce the same thing.
@@ -1443,6 +1443,17 @@ ASTScope &SourceFile::getScope() {
   return *Scope;
 }
 
+void SourceFile::clearScope() {
+  if (!Scope)
+    return;
+
+  // The scope map is the only structure in this file's file-scoped arena,
+  // so releasing the arena frees the entire tree (and runs the cleanups
+  // its nodes registered).
+  Scope = nullptr;
+  getASTContext().releaseFileScopedMemory(this);
+}
+
 Identifier
 SourceFile::getDiscriminatorForPrivateValue(const ValueDecl *D) const {
   assert(D->getDeclContext()->getModuleScopeContext() == this);
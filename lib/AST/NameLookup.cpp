@@ -1018,6 +1018,14 @@ public:
   /// \brief Add the given members to the lookup table.
   void addMembers(DeclRange members);
 
+  /// \brief Record that the given name was looked up and found nothing, so
+  /// that subsequent lookups of the same name hit this table instead of
+  /// re-querying the lazy member loader. A no-op if the name already has an
+  /// entry.
+  void addEmptyEntry(DeclName name) {
+    (void)Lookup[name];
+  }
+
   /// \brief The given extension has been extended with new members; add them
   /// if appropriate.
   void addExtensionMembers(NominalTypeDecl *nominal,
@@ -1448,6 +1456,13 @@ TinyPtrVector<ValueDecl *> NominalTypeDecl::lookupDirect(
         populateLookupTableEntryFromExtensions(ctx, Table, this, name,
                                                ignoreNewExtensions)) {
       useNamedLazyMemberLoading = false;
+    } else {
+      // The loads succeeded but may not have produced any members with this
+      // name. Record an empty entry in that case, so that repeated lookups
+      // of a missing name hit the table instead of re-probing the loader's
+      // serialized member tables every time. The entry is purged along with
+      // the rest of the table if new members or extensions arrive.
+      Table.addEmptyEntry(name);
     }
   }
 
@@ -1176,13 +1176,22 @@ void NominalTypeDecl::prepareConformanceTable() const {
 bool NominalTypeDecl::lookupConformance(
        ModuleDecl *module, ProtocolDecl *protocol,
        SmallVectorImpl<ProtocolConformance *> &conformances) const {
+  // A lookup that has already failed will fail again unless conformance
+  // state has changed, which clears this set.
+  auto &ctx = getASTContext();
+  if (ctx.FailedConformanceLookups.count({this, protocol}))
+    return false;
+
   prepareConformanceTable();
-  return ConformanceTable->lookupConformance(
-           module,
-           const_cast<NominalTypeDecl *>(this),
-           protocol,
-           getASTContext().getLazyResolver(),
-           conformances);
+  bool found = ConformanceTable->lookupConformance(
+                 module,
+                 const_cast<NominalTypeDecl *>(this),
+                 protocol,
+                 ctx.getLazyResolver(),
+                 conformances);
+  if (!found)
+    ctx.FailedConformanceLookups.insert({this, protocol});
+  return found;
 }
 
 SmallVector<ProtocolDecl *, 2> NominalTypeDecl::getAllProtocols() const {
@@ -1215,6 +1224,7 @@ void NominalTypeDecl::getImplicitProtocols(
 void NominalTypeDecl::registerProtocolConformance(
        ProtocolConformance *conformance) {
   prepareConformanceTable();
+  getASTContext().FailedConformanceLookups.clear();
   ConformanceTable->registerProtocolConformance(conformance);
 }
 
@@ -429,8 +429,30 @@ SubstitutionMap SubstitutionMap::mapReplacementTypesOutOfContext() const {
 }
 
 SubstitutionMap SubstitutionMap::subst(SubstitutionMap subMap) const {
-  return subst(QuerySubstitutionMap{subMap},
-               LookUpConformanceInSubstitutionMap(subMap));
+  if (empty()) return SubstitutionMap();
+
+  // Composing the same pair of maps recurs whenever a specialization of a
+  // generic declaration is itself specialized, so memoize the result in
+  // the ASTContext.
+  auto &ctx = getGenericSignature()->getASTContext();
+  if (auto cached = ctx.getCachedSubstitutionMapComposition(*this, subMap))
+    return *cached;
+
+  auto result = subst(QuerySubstitutionMap{subMap},
+                      LookUpConformanceInSubstitutionMap(subMap));
+
+  // An invalid conformance in the result can mean a lookup failed only
+  // because type witnesses were still being checked; don't freeze that.
+  bool isCacheable = true;
+  for (auto conformance : result.getConformances()) {
+    if (conformance.isInvalid()) {
+      isCacheable = false;
+      break;
+    }
+  }
+  if (isCacheable)
+    ctx.recordSubstitutionMapComposition(*this, subMap, result);
+  return result;
 }
 
 SubstitutionMap SubstitutionMap::subst(TypeSubstitutionFn subs,
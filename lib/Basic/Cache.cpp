@@ -33,12 +33,32 @@ struct DefaultCacheKey {
   DefaultCacheKey(void *Key, CacheImpl::CallBacks *CBs) : Key(Key), CBs(CBs) {}
 };
 
-struct DefaultCache {
+struct DefaultCacheShard {
   llvm::sys::Mutex Mux;
-  CacheImpl::CallBacks CBs;
   llvm::DenseMap<DefaultCacheKey, void *> Entries;
+};
+
+struct DefaultCache {
+  CacheImpl::CallBacks CBs;
+
+  // The entries are sharded by key hash with a mutex per shard, so that
+  // concurrent accesses for different keys usually don't contend on the
+  // same lock; clients like SourceKit hit a cache from several queues at
+  // once. The shard count is a fixed power of two: enough to spread out
+  // the handful of queues that typically touch one cache, while keeping
+  // the per-cache footprint small.
+  static const size_t NumShards = 8;
+  DefaultCacheShard Shards[NumShards];
 
   explicit DefaultCache(CacheImpl::CallBacks CBs) : CBs(std::move(CBs)) { }
+
+  DefaultCacheShard &getShard(const void *Key) {
+    uintptr_t Hash = CBs.keyHashCB(const_cast<void *>(Key), nullptr);
+    // Re-mix the client hash before taking the low bits; key hashes are
+    // often poorly distributed in their low bits (e.g. aligned pointers).
+    return Shards[llvm::DenseMapInfo<uintptr_t>::getHashValue(Hash) %
+                  NumShards];
+  }
 };
 } // end anonymous namespace
 
@@ -73,20 +93,21 @@ CacheImpl::ImplTy CacheImpl::create(StringRef Name, const CallBacks &CBs) {
 
 void CacheImpl::setAndRetain(void *Key, void *Value, size_t Cost) {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
+  DefaultCacheShard &Shard = DCache.getShard(Key);
+  llvm::sys::ScopedLock L(Shard.Mux);
 
   DefaultCacheKey CKey(Key, &DCache.CBs);
-  auto Entry = DCache.Entries.find(CKey);
-  if (Entry != DCache.Entries.end()) {
+  auto Entry = Shard.Entries.find(CKey);
+  if (Entry != Shard.Entries.end()) {
     if (Entry->second == Value)
       return;
     DCache.CBs.keyDestroyCB(Entry->first.Key, nullptr);
     DCache.CBs.valueReleaseCB(Entry->second, nullptr);
-    DCache.Entries.erase(Entry);
+    Shard.Entries.erase(Entry);
   }
 
   DCache.CBs.valueRetainCB(Value, nullptr);
-  DCache.Entries[CKey] = Value;
+  Shard.Entries[CKey] = Value;
 
   // FIXME: Not thread-safe! It should avoid deleting the value until
   // 'releaseValue is called on it.
@@ -94,11 +115,12 @@ void CacheImpl::setAndRetain(void *Key, void *Value, size_t Cost) {
 
 bool CacheImpl::getAndRetain(const void *Key, void **Value_out) {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
+  DefaultCacheShard &Shard = DCache.getShard(Key);
+  llvm::sys::ScopedLock L(Shard.Mux);
 
   DefaultCacheKey CKey(const_cast<void*>(Key), &DCache.CBs);
-  auto Entry = DCache.Entries.find(CKey);
-  if (Entry != DCache.Entries.end()) {
+  auto Entry = Shard.Entries.find(CKey);
+  if (Entry != Shard.Entries.end()) {
     // FIXME: Not thread-safe! It should avoid deleting the value until
     // 'releaseValue is called on it.
     *Value_out = Entry->second;
@@ -113,14 +135,15 @@ void CacheImpl::releaseValue(void *Value) {
 
 bool CacheImpl::remove(const void *Key) {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
+  DefaultCacheShard &Shard = DCache.getShard(Key);
+  llvm::sys::ScopedLock L(Shard.Mux);
 
   DefaultCacheKey CKey(const_cast<void*>(Key), &DCache.CBs);
-  auto Entry = DCache.Entries.find(CKey);
-  if (Entry != DCache.Entries.end()) {
+  auto Entry = Shard.Entries.find(CKey);
+  if (Entry != Shard.Entries.end()) {
     DCache.CBs.keyDestroyCB(Entry->first.Key, nullptr);
     DCache.CBs.valueReleaseCB(Entry->second, nullptr);
-    DCache.Entries.erase(Entry);
+    Shard.Entries.erase(Entry);
     return true;
   }
   return false;
@@ -128,13 +151,15 @@ bool CacheImpl::remove(const void *Key) {
 
 void CacheImpl::removeAll() {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
 
-  for (auto Entry : DCache.Entries) {
-    DCache.CBs.keyDestroyCB(Entry.first.Key, nullptr);
-    DCache.CBs.valueReleaseCB(Entry.second, nullptr);
+  for (auto &Shard : DCache.Shards) {
+    llvm::sys::ScopedLock L(Shard.Mux);
+    for (auto Entry : Shard.Entries) {
+      DCache.CBs.keyDestroyCB(Entry.first.Key, nullptr);
+      DCache.CBs.valueReleaseCB(Entry.second, nullptr);
+    }
+    Shard.Entries.clear();
   }
-  DCache.Entries.clear();
 }
 
 void CacheImpl::destroy() {
@@ -22,15 +22,18 @@
 using namespace swift;
 
 ClusteredBitVector ClusteredBitVector::fromAPInt(const llvm::APInt &bits) {
-  // This is not a very efficient algorithm.
+  // This assumes that the chunk size is the same as APInt's, so the
+  // value can be copied a whole word at a time. APInt keeps the unused
+  // high bits of its last word zeroed, matching our own invariant.
+  static_assert(ChunkSizeInBits == llvm::APInt::APINT_BITS_PER_WORD,
+                "expected chunks to match APInt words");
   ClusteredBitVector result;
-  for (unsigned i = 0, e = bits.getBitWidth(); i != e; ++i) {
-    if (bits[i]) {
-      result.appendSetBits(1);
-    } else {
-      result.appendClearBits(1);
-    }
-  }
+  auto numBits = bits.getBitWidth();
+  if (numBits == 0)
+    return result;
+
+  result.reserve(numBits);
+  result.appendReserved(numBits, bits.getRawData());
   return result;
 }
 
@@ -14,6 +14,10 @@
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/Format.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
 using namespace swift::json;
 using namespace swift;
 
@@ -149,74 +153,106 @@ void Output::endBitSetScalar() {
   Stream << ']';
 }
 
+// According to the JSON standard, the following characters must be escaped
+// inside a quoted string:
+//   - Quotation mark (U+0022)
+//   - Reverse solidus (U+005C)
+//   - Control characters (U+0000 to U+001F)
+// We additionally escape the solidus, which is optional in the standard.
+//
+// Since these are all represented by a single byte in UTF8 (and will not be
+// present in any multi-byte UTF8 representations), escaping can operate on
+// individual bytes; any other byte is emitted as-is.
+static bool needsEscape(unsigned char c) {
+  return c == '"' || c == '\\' || c == '/' || c <= '\x1F';
+}
+
+/// Return true if any byte of the given word needs escaping. Checking a word
+/// at a time lets the caller skip over the clean runs that make up almost
+/// the entirety of typical emitted strings.
+static bool wordNeedsEscape(uint64_t Word) {
+  const uint64_t Ones = 0x0101010101010101ULL;
+  const uint64_t Highs = 0x8080808080808080ULL;
+  // Standard bit tricks: a byte of V is zero iff its high bit is set in
+  // (V - Ones) & ~V, and a byte of Word is less than 0x20 by the analogous
+  // subtraction against a word of 0x20s.
+  auto hasZeroByte = [=](uint64_t V) { return (V - Ones) & ~V & Highs; };
+  uint64_t HasControl = (Word - 0x20 * Ones) & ~Word & Highs;
+  return HasControl | hasZeroByte(Word ^ ('"' * Ones)) |
+         hasZeroByte(Word ^ ('\\' * Ones)) | hasZeroByte(Word ^ ('/' * Ones));
+}
+
 void Output::scalarString(StringRef &S, bool MustQuote) {
-  if (MustQuote) {
-    Stream << '"';
-    for (unsigned char c : S) {
-      // According to the JSON standard, the following characters must be
-      // escaped:
-      //   - Quotation mark (U+0022)
-      //   - Reverse solidus (U+005C)
-      //   - Control characters (U+0000 to U+001F)
-      // We need to check for these and escape them if present.
-      //
-      // Since these are represented by a single byte in UTF8 (and will not be
-      // present in any multi-byte UTF8 representations), we can just switch on
-      // the value of the current byte.
-      //
-      // Any other bytes present in the string should therefore be emitted
-      // as-is, without any escaping.
-      switch (c) {
-      // First, check for characters for which JSON has custom escape sequences.
-      case '"':
-        Stream << '\\' << '"';
-        break;
-      case '\\':
-        Stream << '\\' << '\\';
-        break;
-      case '/':
-        Stream << '\\' << '/';
-        break;
-      case '\b':
-        Stream << '\\' << 'b';
-        break;
-      case '\f':
-        Stream << '\\' << 'f';
-        break;
-      case '\n':
-        Stream << '\\' << 'n';
-        break;
-      case '\r':
-        Stream << '\\' << 'r';
-        break;
-      case '\t':
-        Stream << '\\' << 't';
-        break;
-      default:
-        // Otherwise, check to see if the current byte is a control character.
-        if (c <= '\x1F') {
-          // Since we have a control character, we need to escape it using
-          // JSON's only valid escape sequence: \uxxxx (where x is a hex digit).
-
-          // The upper two digits for control characters are always 00.
-          Stream << "\\u00";
-
-          // Convert the current character into hexadecimal digits.
-          Stream << llvm::hexdigit((c >> 4) & 0xF);
-          Stream << llvm::hexdigit((c >> 0) & 0xF);
-        } else {
-          // This isn't a control character, so we don't need to escape it.
-          // As a result, emit it directly; if it's part of a multi-byte UTF8
-          // representation, all bytes will be emitted in this fashion.
-          Stream << c;
-        }
+  if (!MustQuote) {
+    Stream << S;
+    return;
+  }
+
+  Stream << '"';
+  const char *End = S.end();
+  const char *RunStart = S.begin();
+  const char *I = RunStart;
+  while (true) {
+    // Find the end of the current run of bytes that don't need escaping,
+    // a word at a time, so that the whole run can be emitted with a single
+    // write instead of byte-wise stream operations.
+    while (End - I >= ptrdiff_t(sizeof(uint64_t))) {
+      uint64_t Word;
+      memcpy(&Word, I, sizeof(uint64_t));
+      if (wordNeedsEscape(Word))
         break;
-      }
+      I += sizeof(uint64_t);
     }
-    Stream << '"';
+    while (I != End && !needsEscape(*I))
+      ++I;
+
+    Stream << StringRef(RunStart, I - RunStart);
+    if (I == End)
+      break;
+
+    unsigned char c = *I;
+    switch (c) {
+    // First, check for characters for which JSON has custom escape sequences.
+    case '"':
+      Stream << '\\' << '"';
+      break;
+    case '\\':
+      Stream << '\\' << '\\';
+      break;
+    case '/':
+      Stream << '\\' << '/';
+      break;
+    case '\b':
+      Stream << '\\' << 'b';
+      break;
+    case '\f':
+      Stream << '\\' << 'f';
+      break;
+    case '\n':
+      Stream << '\\' << 'n';
+      break;
+    case '\r':
+      Stream << '\\' << 'r';
+      break;
+    case '\t':
+      Stream << '\\' << 't';
+      break;
+    default:
+      // Otherwise this is a control character, which we need to escape using
+      // JSON's only valid escape sequence: \uxxxx (where x is a hex digit).
+      assert(c <= '\x1F' && "escaping a byte that doesn't need it?");
+
+      // The upper two digits for control characters are always 00.
+      Stream << "\\u00";
+
+      // Convert the current character into hexadecimal digits.
+      Stream << llvm::hexdigit((c >> 4) & 0xF);
+      Stream << llvm::hexdigit((c >> 0) & 0xF);
+      break;
+    }
+    RunStart = ++I;
   }
-  else
-    Stream << S;
+  Stream << '"';
 }
 
 void Output::null() {
@@ -15,6 +15,7 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
 
 using namespace swift;
 
@@ -292,28 +293,57 @@ void CharSourceRange::dump(const SourceManager &SM) const {
   print(llvm::errs(), SM);
 }
 
+ArrayRef<unsigned> SourceManager::getLineStartOffsets(unsigned BufferID) const {
+  auto Known = LineStartOffsets.find(BufferID);
+  if (Known != LineStartOffsets.end())
+    return Known->second;
+
+  // Scan the buffer once; every later line/column query binary searches the
+  // resulting index instead of rescanning.
+  StringRef Buffer = getEntireTextForBuffer(BufferID);
+  std::vector<unsigned> &Offsets = LineStartOffsets[BufferID];
+  Offsets.push_back(0);
+  for (size_t Pos = Buffer.find('\n'); Pos != StringRef::npos;
+       Pos = Buffer.find('\n', Pos + 1))
+    Offsets.push_back(Pos + 1);
+  return Offsets;
+}
+
+std::pair<unsigned, unsigned>
+SourceManager::getLineAndColumnRaw(SourceLoc Loc, unsigned BufferID) const {
+  assert(Loc.isValid());
+  if (BufferID == 0)
+    BufferID = findBufferContainingLoc(Loc);
+
+  ArrayRef<unsigned> LineStarts = getLineStartOffsets(BufferID);
+  unsigned Offset = getLocOffsetInBuffer(Loc, BufferID);
+
+  // Find the first line that starts after the offset; the location is on the
+  // line before it, and line numbers are 1-based.
+  auto NextLine =
+      std::upper_bound(LineStarts.begin(), LineStarts.end(), Offset);
+  assert(NextLine != LineStarts.begin() && "no line starts at offset zero?");
+  unsigned Line = NextLine - LineStarts.begin();
+  unsigned Column = Offset - *(NextLine - 1) + 1;
+  return { Line, Column };
+}
+
 llvm::Optional<unsigned> SourceManager::resolveFromLineCol(unsigned BufferId,
                                                            unsigned Line,
                                                            unsigned Col) const {
   if (Line == 0 || Col == 0) {
     return None;
   }
-  auto InputBuf = getLLVMSourceMgr().getMemoryBuffer(BufferId);
-  const char *Ptr = InputBuf->getBufferStart();
-  const char *End = InputBuf->getBufferEnd();
-  const char *LineStart = Ptr;
-  for (; Ptr < End; ++Ptr) {
-    if (*Ptr == '\n') {
-      --Line;
-      if (Line == 0)
-        break;
-      LineStart = Ptr+1;
-    }
-  }
-  if (Line != 0) {
+  // Use the per-buffer line index instead of rescanning the buffer; only the
+  // target line itself is walked to resolve the column. As before, the target
+  // line must be terminated by a newline in the buffer.
+  ArrayRef<unsigned> LineStarts = getLineStartOffsets(BufferId);
+  if (Line >= LineStarts.size()) {
     return None;
   }
-  Ptr = LineStart;
+  auto InputBuf = getLLVMSourceMgr().getMemoryBuffer(BufferId);
+  const char *End = InputBuf->getBufferEnd();
+  const char *Ptr = InputBuf->getBufferStart() + LineStarts[Line - 1];
   for (; Ptr < End; ++Ptr) {
     --Col;
     if (Col == 0)
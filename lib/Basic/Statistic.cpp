@@ -20,10 +20,12 @@
 #include "swift/SIL/SILFunction.h"
 #include "swift/Driver/DependencyGraph.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Config/config.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
+#include "llvm/Support/Signals.h"
 #include "llvm/Support/raw_ostream.h"
 #include <chrono>
 #include <limits>
@@ -90,6 +92,43 @@ makeTraceFileName(StringRef ProgramName,
   return makeFileName("trace", ProgramName, AuxName, "csv");
 }
 
+static std::string
+makeTimelineFileName(StringRef ProgramName,
+                     StringRef AuxName) {
+  return makeFileName("timeline", ProgramName, AuxName, "json");
+}
+
+static std::string
+makeTimersFileName(StringRef ProgramName,
+                   StringRef AuxName) {
+  return makeFileName("timers", ProgramName, AuxName, "txt");
+}
+
+static std::string
+makeSampleFileName(StringRef ProgramName,
+                   StringRef AuxName) {
+  return makeFileName("sample", ProgramName, AuxName, "csv");
+}
+
+// Sampled tracing (-sample-stats-events) is meant to stay enabled on every
+// compilation a toolchain runs, so both knobs err on the side of cheapness:
+// timestamping only one event in 64 amortizes the getrusage cost to noise,
+// and retaining 4096 samples bounds memory and flush time regardless of how
+// large the compilation gets.
+static const size_t SampleEventPeriod = 64;
+static const size_t SampleRingCapacity = 4096;
+
+// The crash handler has no context argument of its own, and we only ever make
+// one UnifiedStatsReporter per process, so the sampling reporter registers
+// itself here for the duration of its lifetime.
+static UnifiedStatsReporter *TheSamplingReporter = nullptr;
+
+static void
+flushSamplingReporterOnCrash(void *) {
+  if (UnifiedStatsReporter *R = TheSamplingReporter)
+    R->flushSampledTrace();
+}
+
 static std::string
 makeProfileDirName(StringRef ProgramName,
                    StringRef AuxName) {
@@ -313,7 +352,8 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
                                            clang::SourceManager *CSM,
                                            bool TraceEvents,
                                            bool ProfileEvents,
-                                           bool ProfileEntities)
+                                           bool ProfileEntities,
+                                           bool SampleEvents)
   : UnifiedStatsReporter(ProgramName,
                          auxName(ModuleName,
                                  InputName,
@@ -322,7 +362,8 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
                                  OptType),
                          Directory,
                          SM, CSM,
-                         TraceEvents, ProfileEvents, ProfileEntities)
+                         TraceEvents, ProfileEvents, ProfileEntities,
+                         SampleEvents)
 {
 }
 
@@ -333,11 +374,15 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
                                            clang::SourceManager *CSM,
                                            bool TraceEvents,
                                            bool ProfileEvents,
-                                           bool ProfileEntities)
+                                           bool ProfileEntities,
+                                           bool SampleEvents)
   : currentProcessExitStatusSet(false),
     currentProcessExitStatus(EXIT_FAILURE),
     StatsFilename(Directory),
     TraceFilename(Directory),
+    TimelineFilename(Directory),
+    TimersFilename(Directory),
+    SampleFilename(Directory),
     ProfileDirname(Directory),
     StartedTime(llvm::TimeRecord::getCurrentTime()),
     Timer(make_unique<NamedRegionTimer>(AuxName,
@@ -349,13 +394,24 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
 {
   path::append(StatsFilename, makeStatsFileName(ProgramName, AuxName));
   path::append(TraceFilename, makeTraceFileName(ProgramName, AuxName));
+  path::append(TimelineFilename, makeTimelineFileName(ProgramName, AuxName));
+  path::append(TimersFilename, makeTimersFileName(ProgramName, AuxName));
+  path::append(SampleFilename, makeSampleFileName(ProgramName, AuxName));
   path::append(ProfileDirname, makeProfileDirName(ProgramName, AuxName));
   EnableStatistics(/*PrintOnExit=*/false);
   SharedTimer::enableCompilationTimers();
   if (TraceEvents || ProfileEvents || ProfileEntities)
     LastTracedFrontendCounters.emplace();
-  if (TraceEvents)
+  if (TraceEvents) {
     FrontendStatsEvents.emplace();
+    TimelineEvents.emplace();
+  }
+  if (SampleEvents) {
+    Sampler.emplace();
+    Sampler->Ring.reserve(SampleRingCapacity);
+    TheSamplingReporter = this;
+    sys::AddSignalHandler(flushSamplingReporterOnCrash, nullptr);
+  }
   if (ProfileEvents)
     EventProfilers = make_unique<StatsProfilers>();
   if (ProfileEntities)
@@ -509,6 +565,25 @@ UnifiedStatsReporter::saveAnyFrontendStatsEvents(
     RecursiveTimers->endTimer(T.EventName);
   }
 
+  // Sampled tracing is designed to be cheap enough to leave enabled on every
+  // compilation: most events just bump a counter, and only every
+  // SampleEventPeriod-th event takes a timestamp and claims a ring slot.
+  if (Sampler) {
+    auto &S = *Sampler;
+    if (++S.EventCount % SampleEventPeriod == 0) {
+      auto Now = llvm::TimeRecord::getCurrentTime();
+      auto NowUS = uint64_t(1000000.0 * Now.getProcessTime());
+      FrontendStatsEvent Ev{NowUS, 0, IsEntry, T.EventName, "EventCount",
+                            (int64_t)SampleEventPeriod, (int64_t)S.EventCount,
+                            nullptr, nullptr};
+      if (S.Ring.size() < SampleRingCapacity)
+        S.Ring.push_back(Ev);
+      else
+        S.Ring[S.NextSlot] = Ev;
+      S.NextSlot = (S.NextSlot + 1) % SampleRingCapacity;
+    }
+  }
+
   // If we don't have a saved entry to form deltas against in the trace buffer
   // or profilers, we're not tracing or profiling: return early.
   if (!LastTracedFrontendCounters)
@@ -572,14 +647,77 @@ UnifiedStatsReporter::saveAnyFrontendStatsEvents(
 #undef FRONTEND_STATISTIC
   }
 
+  // The timeline wants one record per tracer entry and exit regardless of
+  // whether any counter changed, stamped with wall time rather than process
+  // time since it is read as a timeline.
+  if (TimelineEvents) {
+    auto WallUS = uint64_t(1000000.0 * Now.getWallTime());
+    TimelineEvents->emplace_back(FrontendStatsEvent{
+        WallUS, 0, IsEntry, T.EventName, StringRef(), 0, 0,
+        T.Entity, T.Formatter});
+  }
+
   // Save all counters (changed or otherwise).
   Last = Curr;
 }
 
+void
+UnifiedStatsReporter::flushSampledTrace() {
+  if (!Sampler || Sampler->Ring.empty())
+    return;
+  std::error_code EC;
+  raw_fd_ostream ostream(SampleFilename, EC, fs::F_Append | fs::F_Text);
+  if (EC) {
+    llvm::errs() << "Error opening -sample-stats-events file '"
+                 << SampleFilename << "' for writing\n";
+    return;
+  }
+  auto &S = *Sampler;
+  ostream << "Time,IsEntry,EventName,EventDelta,EventTotal\n";
+  // Once the ring has wrapped, the oldest retained sample lives at NextSlot.
+  size_t Begin = S.Ring.size() < SampleRingCapacity ? 0 : S.NextSlot;
+  for (size_t i = 0; i < S.Ring.size(); ++i) {
+    auto const &E = S.Ring[(Begin + i) % S.Ring.size()];
+    ostream << E.TimeUSec << ','
+            << (E.IsEntry ? "\"entry\"," : "\"exit\",")
+            << '"' << E.EventName << '"' << ','
+            << E.CounterDelta << ','
+            << E.CounterValue << '\n';
+  }
+  // Clearing here keeps a crash that arrives after a normal flush from
+  // writing the same samples twice.
+  S.Ring.clear();
+  ostream.flush();
+}
+
+// Event and entity names can contain characters that JSON strings must
+// escape (operator names, string-literal entities and the like).
+static void
+writeJSONQuoted(raw_ostream &OS, StringRef Text) {
+  OS << '"';
+  for (unsigned char c : Text) {
+    if (c == '"' || c == '\\') {
+      OS << '\\' << (char)c;
+    } else if (c < 0x20) {
+      OS << "\\u00" << llvm::hexdigit(c >> 4) << llvm::hexdigit(c & 0xF);
+    } else {
+      OS << (char)c;
+    }
+  }
+  OS << '"';
+}
+
 UnifiedStatsReporter::TraceFormatter::~TraceFormatter() {}
 
 UnifiedStatsReporter::~UnifiedStatsReporter()
 {
+  // Flush any sampled trace first: it is the one piece of output the crash
+  // handler also writes, and once it is flushed (and the handler's pointer
+  // cleared) a late crash has nothing left to duplicate.
+  flushSampledTrace();
+  if (TheSamplingReporter == this)
+    TheSamplingReporter = nullptr;
+
   // If nobody's marked this process as successful yet,
   // mark it as failing.
   if (currentProcessExitStatus != EXIT_SUCCESS) {
@@ -674,6 +812,54 @@ UnifiedStatsReporter::~UnifiedStatsReporter()
     }
   }
 
+  // Alongside the CSV trace, write the tracer entry/exit events as a
+  // chrome://tracing-compatible timeline (a Trace Event Format JSON array of
+  // "B"/"E" duration events), so that a slow frontend job can be opened
+  // directly in a flame-graph viewer. The strict nesting of the
+  // FrontendStatsTracer RAII scopes guarantees the begin/end pairs balance.
+  if (TimelineEvents && !TimelineEvents->empty()) {
+    std::error_code EC;
+    raw_fd_ostream jstream(TimelineFilename, EC, fs::F_Append | fs::F_Text);
+    if (EC) {
+      llvm::errs() << "Error opening -trace-stats-events timeline file '"
+                   << TimelineFilename << "' for writing\n";
+      return;
+    }
+    auto Pid = Process::getProcessId();
+    const char *delim = "[";
+    for (auto const &E : *TimelineEvents) {
+      jstream << delim << "\n{\"cat\":\"swift\",\"ph\":\""
+              << (E.IsEntry ? 'B' : 'E')
+              << "\",\"pid\":" << Pid
+              << ",\"tid\":1,\"ts\":" << E.TimeUSec
+              << ",\"name\":";
+      SmallString<64> Name(E.EventName);
+      if (E.Formatter) {
+        llvm::raw_svector_ostream NOS(Name);
+        NOS << ' ';
+        E.Formatter->traceName(E.Entity, NOS);
+      }
+      writeJSONQuoted(jstream, Name);
+      jstream << '}';
+      delim = ",";
+    }
+    jstream << "\n]\n";
+  }
+
+  // SharedTimer regions nest; write their self-times aggregated by nesting
+  // path (flamegraph input format) alongside the flat LLVM timer groups that
+  // went into the stats file above.
+  if (SharedTimer::hasHierarchicalTimes()) {
+    std::error_code EC;
+    raw_fd_ostream hstream(TimersFilename, EC, fs::F_Append | fs::F_Text);
+    if (EC) {
+      llvm::errs() << "Error opening -stats-output-dir timers file '"
+                   << TimersFilename << "' for writing\n";
+      return;
+    }
+    SharedTimer::printHierarchicalTimes(hstream);
+  }
+
   if (EventProfilers || EntityProfilers) {
     std::error_code EC = llvm::sys::fs::create_directories(ProfileDirname);
     if (EC) {
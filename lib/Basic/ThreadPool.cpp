@@ -0,0 +1,157 @@
+//===--- ThreadPool.cpp - In-process work-stealing thread pool ------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/ThreadPool.h"
+
+#include <cassert>
+#include <cstdlib>
+
+using namespace swift;
+
+/// The index of the worker the current thread is running as, or ~0u on
+/// threads that don't belong to a pool.  Workers of nested pools shadow the
+/// outer value for the thread's lifetime, which is fine because a worker
+/// thread belongs to exactly one pool.
+static thread_local unsigned CurrentWorkerIndex = ~0u;
+
+void ThreadPool::TaskGroup::taskEnqueued() {
+  std::lock_guard<std::mutex> Guard(Mtx);
+  ++PendingTasks;
+}
+
+void ThreadPool::TaskGroup::taskFinished() {
+  std::lock_guard<std::mutex> Guard(Mtx);
+  assert(PendingTasks > 0 && "finishing a task that was never enqueued");
+  if (--PendingTasks == 0)
+    AllDone.notify_all();
+}
+
+void ThreadPool::TaskGroup::wait() {
+  std::unique_lock<std::mutex> Lock(Mtx);
+  AllDone.wait(Lock, [this] { return PendingTasks == 0; });
+}
+
+unsigned ThreadPool::getDefaultNumThreads() {
+  if (const char *Env = ::getenv("SWIFT_THREAD_POOL_SIZE")) {
+    long Requested = ::strtol(Env, nullptr, 10);
+    if (Requested > 0)
+      return (unsigned)Requested;
+  }
+  unsigned HardwareThreads = std::thread::hardware_concurrency();
+  return HardwareThreads ? HardwareThreads : 1;
+}
+
+ThreadPool::ThreadPool(unsigned NumThreads) : QueuedTasks(0), NextWorker(0) {
+  if (NumThreads == 0)
+    NumThreads = getDefaultNumThreads();
+  Workers.reserve(NumThreads);
+  for (unsigned i = 0; i != NumThreads; ++i)
+    Workers.push_back(std::unique_ptr<Worker>(new Worker()));
+  Threads.reserve(NumThreads);
+  for (unsigned i = 0; i != NumThreads; ++i)
+    Threads.push_back(std::thread([this, i] { workerLoop(i); }));
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> Guard(SleepMtx);
+    ShuttingDown = true;
+  }
+  WorkAvailable.notify_all();
+  for (std::thread &T : Threads)
+    T.join();
+  assert(QueuedTasks.load() == 0 && "shutdown dropped enqueued tasks");
+}
+
+void ThreadPool::enqueue(Task &&T, Priority Prio) {
+  // Tasks enqueued from a worker go onto that worker's own deque; tasks from
+  // outside the pool are distributed round-robin.
+  unsigned Index = CurrentWorkerIndex;
+  if (Index >= Workers.size())
+    Index = NextWorker.fetch_add(1, std::memory_order_relaxed)
+            % Workers.size();
+  {
+    std::lock_guard<std::mutex> Guard(Workers[Index]->Mtx);
+    Workers[Index]->Queues[unsigned(Prio)].push_back(std::move(T));
+  }
+  QueuedTasks.fetch_add(1, std::memory_order_release);
+  // Synchronize with workers between their failed scan and going to sleep:
+  // once we have held SleepMtx, any worker that read QueuedTasks == 0 is
+  // already blocked in wait() and will receive the notification.
+  { std::lock_guard<std::mutex> Guard(SleepMtx); }
+  WorkAvailable.notify_one();
+}
+
+void ThreadPool::async(std::function<void()> Fn, Priority Prio) {
+  enqueue(Task{std::move(Fn), nullptr}, Prio);
+}
+
+void ThreadPool::async(TaskGroup &Group, std::function<void()> Fn,
+                       Priority Prio) {
+  Group.taskEnqueued();
+  enqueue(Task{std::move(Fn), &Group}, Prio);
+}
+
+bool ThreadPool::scanForTask(unsigned Index, Task &T) {
+  unsigned NumWorkers = (unsigned)Workers.size();
+  for (unsigned Prio = 0; Prio != NumPriorities; ++Prio) {
+    // The worker's own deque is popped LIFO for locality; other workers'
+    // deques are stolen from FIFO so the oldest tasks get picked up first.
+    {
+      Worker &Own = *Workers[Index];
+      std::lock_guard<std::mutex> Guard(Own.Mtx);
+      if (!Own.Queues[Prio].empty()) {
+        T = std::move(Own.Queues[Prio].back());
+        Own.Queues[Prio].pop_back();
+        return true;
+      }
+    }
+    for (unsigned i = 1; i != NumWorkers; ++i) {
+      Worker &Victim = *Workers[(Index + i) % NumWorkers];
+      std::lock_guard<std::mutex> Guard(Victim.Mtx);
+      if (!Victim.Queues[Prio].empty()) {
+        T = std::move(Victim.Queues[Prio].front());
+        Victim.Queues[Prio].pop_front();
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void ThreadPool::workerLoop(unsigned Index) {
+  CurrentWorkerIndex = Index;
+  while (true) {
+    Task T;
+    if (scanForTask(Index, T)) {
+      QueuedTasks.fetch_sub(1, std::memory_order_acquire);
+      T.Fn();
+      if (T.Group)
+        T.Group->taskFinished();
+      continue;
+    }
+
+    // Nothing runnable anywhere.  Sleep until more work is enqueued, or
+    // exit if the pool is shutting down.  Running tasks may still enqueue
+    // more work during shutdown; the QueuedTasks predicate brings sleeping
+    // workers back for it, and the worker running the task rescans before
+    // exiting.
+    std::unique_lock<std::mutex> Lock(SleepMtx);
+    if (QueuedTasks.load(std::memory_order_acquire) > 0)
+      continue;
+    if (ShuttingDown)
+      return;
+    WorkAvailable.wait(Lock, [this] {
+      return ShuttingDown || QueuedTasks.load(std::memory_order_acquire) > 0;
+    });
+  }
+}
@@ -11,7 +11,97 @@
 //===----------------------------------------------------------------------===//
 
 #include "swift/Basic/Timer.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/Mutex.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <vector>
 
 using namespace swift;
+using llvm::TimeRecord;
 
 SharedTimer::State SharedTimer::CompilationTimersEnabled = State::Initial;
+
+namespace {
+
+/// The stack of open timer regions on one thread, plus the time of the last
+/// region boundary on that thread.  Self-times are the spans between
+/// consecutive boundaries, each charged to whatever path was open during the
+/// span.
+struct RegionStack {
+  std::vector<StringRef> Names;
+  TimeRecord LastStamp;
+};
+
+} // end anonymous namespace
+
+static LLVM_THREAD_LOCAL RegionStack *ActiveRegions = nullptr;
+
+// The aggregation map is shared by all threads; it is only touched at region
+// boundaries, which are rare (per compilation phase, not per AST node).
+static llvm::sys::Mutex &getAggregateMutex() {
+  static llvm::sys::Mutex Mtx;
+  return Mtx;
+}
+
+static llvm::StringMap<TimeRecord> &getAggregateTimes() {
+  static llvm::StringMap<TimeRecord> Times;
+  return Times;
+}
+
+/// Charge the time elapsed since the last region boundary on this thread to
+/// the path of regions currently open, and restart the span.
+static void chargeElapsedToCurrentPath(RegionStack &Stack) {
+  TimeRecord Now = TimeRecord::getCurrentTime();
+  if (!Stack.Names.empty()) {
+    TimeRecord Delta = Now;
+    Delta -= Stack.LastStamp;
+    SmallString<128> Path;
+    for (StringRef Name : Stack.Names) {
+      if (!Path.empty())
+        Path += ';';
+      Path += Name;
+    }
+    llvm::sys::ScopedLock Guard(getAggregateMutex());
+    getAggregateTimes()[Path] += Delta;
+  }
+  Stack.LastStamp = Now;
+}
+
+void SharedTimer::beginRegion(StringRef name) {
+  if (!ActiveRegions)
+    ActiveRegions = new RegionStack();
+  chargeElapsedToCurrentPath(*ActiveRegions);
+  ActiveRegions->Names.push_back(name);
+}
+
+void SharedTimer::endRegion() {
+  assert(ActiveRegions && !ActiveRegions->Names.empty() &&
+         "ending a timer region that was never begun");
+  chargeElapsedToCurrentPath(*ActiveRegions);
+  ActiveRegions->Names.pop_back();
+}
+
+bool SharedTimer::hasHierarchicalTimes() {
+  llvm::sys::ScopedLock Guard(getAggregateMutex());
+  return !getAggregateTimes().empty();
+}
+
+void SharedTimer::printHierarchicalTimes(raw_ostream &OS) {
+  llvm::sys::ScopedLock Guard(getAggregateMutex());
+  auto &Times = getAggregateTimes();
+  std::vector<std::pair<StringRef, TimeRecord>> Sorted;
+  Sorted.reserve(Times.size());
+  for (auto const &I : Times)
+    Sorted.emplace_back(I.getKey(), I.getValue());
+  std::sort(Sorted.begin(), Sorted.end(),
+            [](std::pair<StringRef, TimeRecord> const &A,
+               std::pair<StringRef, TimeRecord> const &B) {
+              return A.first < B.first;
+            });
+  for (auto const &I : Sorted)
+    OS << I.first << ' '
+       << int64_t(1000000.0 * I.second.getWallTime()) << '\n';
+}
@@ -36,6 +36,19 @@ StringRef swift::unicode::extractFirstExtendedGraphemeCluster(StringRef S) {
   if (S.empty())
     return StringRef();
 
+  // Fast path for ASCII, which is what the lexer and diagnostics feed us
+  // almost exclusively. An ASCII code point can only be part of a larger
+  // cluster as CR in CR LF or when followed by a non-ASCII combining code
+  // point, so one byte of lookahead decides the answer without transcoding
+  // or consulting the break property tables.
+  unsigned char First = S[0];
+  if (First < 0x80 &&
+      (S.size() == 1 || static_cast<unsigned char>(S[1]) < 0x80)) {
+    if (First == '\r' && S.size() > 1 && S[1] == '\n')
+      return S.slice(0, 2);
+    return S.slice(0, 1);
+  }
+
   const llvm::UTF8 *SourceStart =
     reinterpret_cast<const llvm::UTF8 *>(S.data());
 
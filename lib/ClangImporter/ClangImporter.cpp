@@ -599,6 +599,13 @@ getNormalInvocationArguments(std::vector<std::string> &invocationArgStrs,
     invocationArgStrs.push_back("-fmodules-validate-system-headers");
   }
 
+  if (importerOpts.ValidateModulesOnce &&
+      !importerOpts.BuildSessionFilePath.empty()) {
+    invocationArgStrs.push_back("-fmodules-validate-once-per-build-session");
+    invocationArgStrs.push_back("-fbuild-session-file=" +
+                                importerOpts.BuildSessionFilePath);
+  }
+
   if (importerOpts.DetailedPreprocessingRecord) {
     invocationArgStrs.insert(invocationArgStrs.end(), {
       "-Xclang", "-detailed-preprocessing-record",
@@ -3472,10 +3479,20 @@ ClangImporter::Implementation::loadNamedMembers(
   // Also bail out if there are any global-as-member mappings for this type; we
   // can support some of them lazily but the full set of idioms seems
   // prohibitively complex (also they're not stored in by-name lookup, for
-  // reasons unclear).
-  if (forEachLookupTable([&](SwiftLookupTable &table) -> bool {
-        return (!table.lookupGlobalsAsMembers(effectiveClangContext).empty());
-      }))
+  // reasons unclear). The answer only depends on the type, not on the member
+  // name, so memoize it rather than re-scanning every table per lookup.
+  // Count the bridging header's table as well, so a fresh (zero-initialized)
+  // cache entry is never mistaken for a computed one.
+  size_t numTables = LookupTables.size() + 1;
+  auto &globalsEntry = NominalsWithGlobalsAsMembers[nominal];
+  if (globalsEntry.first != numTables) {
+    globalsEntry.second =
+        forEachLookupTable([&](SwiftLookupTable &table) -> bool {
+          return (!table.lookupGlobalsAsMembers(effectiveClangContext).empty());
+        });
+    globalsEntry.first = numTables;
+  }
+  if (globalsEntry.second)
     return None;
 
   // There are 3 cases:
@@ -424,6 +424,15 @@ public:
   llvm::DenseMap<std::pair<NominalTypeDecl *, const clang::Module *>,
                  ExtensionDecl *> extensionPoints;
 
+  /// \brief Whether a given nominal type has any global-as-member entries in
+  /// any lookup table, keyed alongside the number of lookup tables the
+  /// answer was computed over so it is recomputed when new modules load.
+  ///
+  /// Memoized so that loadNamedMembers does not re-scan every lookup table
+  /// for every member name it is asked about.
+  llvm::DenseMap<const NominalTypeDecl *, std::pair<size_t, bool>>
+      NominalsWithGlobalsAsMembers;
+
   /// \brief Typedefs that we should not be importing.  We should be importing
   /// underlying decls instead.
   llvm::DenseSet<const clang::Decl *> SuperfluousTypedefs;
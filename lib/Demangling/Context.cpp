@@ -17,9 +17,85 @@
 #include "swift/Demangling/Demangler.h"
 #include "swift/Demangling/ManglingMacros.h"
 
+#include <list>
+#include <unordered_map>
+
 namespace swift {
 namespace Demangle {
 
+/// An LRU cache of printed symbol demanglings.
+///
+/// Entries are keyed by the mangled symbol together with a fingerprint of the
+/// demangle options, so callers that alternate between option sets get
+/// correct (if uncached) results rather than stale ones.
+class SymbolDemanglingCache {
+  struct Entry {
+    std::string Symbol;
+    std::string Demangled;
+    uint32_t OptionsKey;
+  };
+
+  size_t MaxEntries;
+
+  /// All entries, in most-recently-used order.
+  std::list<Entry> Entries;
+
+  std::unordered_map<std::string, std::list<Entry>::iterator> Map;
+
+public:
+  SymbolDemanglingCache(size_t MaxEntries) : MaxEntries(MaxEntries) {}
+
+  /// Packs the option flags which affect printing into a cache key.
+  static uint32_t getOptionsKey(const DemangleOptions &Options) {
+    uint32_t Key = 0;
+    uint32_t Bit = 0;
+    for (bool Flag : {Options.SynthesizeSugarOnTypes,
+                      Options.DisplayDebuggerGeneratedModule,
+                      Options.QualifyEntities,
+                      Options.DisplayExtensionContexts,
+                      Options.DisplayUnmangledSuffix,
+                      Options.DisplayModuleNames,
+                      Options.DisplayGenericSpecializations,
+                      Options.DisplayProtocolConformances,
+                      Options.DisplayWhereClauses,
+                      Options.DisplayEntityTypes,
+                      Options.ShortenPartialApply,
+                      Options.ShortenThunk,
+                      Options.ShortenValueWitness,
+                      Options.ShortenArchetype,
+                      Options.ShowPrivateDiscriminators,
+                      Options.ShowFunctionArgumentTypes})
+      Key |= uint32_t(Flag) << Bit++;
+    return Key;
+  }
+
+  /// Returns the cached demangling for \p Symbol, or nullptr.
+  const std::string *lookup(llvm::StringRef Symbol, uint32_t OptionsKey) {
+    auto It = Map.find(Symbol.str());
+    if (It == Map.end() || It->second->OptionsKey != OptionsKey)
+      return nullptr;
+    Entries.splice(Entries.begin(), Entries, It->second);
+    return &It->second->Demangled;
+  }
+
+  void insert(llvm::StringRef Symbol, uint32_t OptionsKey,
+              const std::string &Demangled) {
+    auto It = Map.find(Symbol.str());
+    if (It != Map.end()) {
+      It->second->Demangled = Demangled;
+      It->second->OptionsKey = OptionsKey;
+      Entries.splice(Entries.begin(), Entries, It->second);
+      return;
+    }
+    if (Entries.size() >= MaxEntries) {
+      Map.erase(Entries.back().Symbol);
+      Entries.pop_back();
+    }
+    Entries.push_front(Entry{Symbol.str(), Demangled, OptionsKey});
+    Map.emplace(Entries.front().Symbol, Entries.begin());
+  }
+};
+
 //////////////////////////////////
 // Context member functions     //
 //////////////////////////////////
@@ -29,6 +105,12 @@ Context::Context() : D(new Demangler) {
 
 Context::~Context() {
   delete D;
+  delete Cache;
+}
+
+void Context::setSymbolDemanglingCacheSize(size_t MaxEntries) {
+  delete Cache;
+  Cache = MaxEntries == 0 ? nullptr : new SymbolDemanglingCache(MaxEntries);
 }
 
 void Context::clear() {
@@ -48,12 +130,23 @@ NodePointer Context::demangleTypeAsNode(llvm::StringRef MangledName) {
 
 std::string Context::demangleSymbolAsString(llvm::StringRef MangledName,
                                             const DemangleOptions &Options) {
-  NodePointer root = demangleSymbolAsNode(MangledName);
-  if (!root) return MangledName.str();
+  uint32_t OptionsKey = 0;
+  if (Cache) {
+    OptionsKey = SymbolDemanglingCache::getOptionsKey(Options);
+    if (const std::string *Cached = Cache->lookup(MangledName, OptionsKey))
+      return *Cached;
+  }
 
-  std::string demangling = nodeToString(root, Options);
+  NodePointer root = demangleSymbolAsNode(MangledName);
+  std::string demangling;
+  if (root)
+    demangling = nodeToString(root, Options);
+  // A failed demangling is printed as the mangled name; cache that outcome
+  // too, since it is just as expensive to rediscover.
   if (demangling.empty())
-    return MangledName.str();
+    demangling = MangledName.str();
+  if (Cache)
+    Cache->insert(MangledName, OptionsKey, demangling);
   return demangling;
 }
 
@@ -388,6 +388,7 @@ void Demangler::init(StringRef MangledName) {
   NumWords = 0;
   Text = MangledName;
   Pos = 0;
+  EncounteredSymbolicReferences = false;
 }
   
 NodePointer Demangler::demangleSymbol(StringRef MangledName) {
@@ -548,7 +549,8 @@ NodePointer Demangler::demangleSymbolicReference(const void *at) {
   int32_t value;
   memcpy(&value, Text.data() + Pos, 4);
   Pos += 4;
-  
+  EncounteredSymbolicReferences = true;
+
   // Use the resolver, if any, to produce the demangling tree the symbolic
   // reference represents.
   NodePointer resolved = nullptr;
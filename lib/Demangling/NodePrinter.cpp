@@ -168,7 +168,10 @@ private:
 
 public:
   NodePrinter(DemangleOptions options) : Options(options) {}
-  
+
+  NodePrinter(DemangleOptions options, std::string &&storage)
+      : Printer(std::move(storage)), Options(options) {}
+
   std::string printRoot(NodePointer root) {
     isValid = true;
     print(root);
@@ -2151,3 +2154,16 @@ std::string Demangle::nodeToString(NodePointer root,
 
   return NodePrinter(options).printRoot(root);
 }
+
+void Demangle::nodeToString(NodePointer root, std::string &out,
+                            const DemangleOptions &options) {
+  if (!root) {
+    out.clear();
+    return;
+  }
+
+  NodePrinter printer(options, std::move(out));
+  // printRoot hands the printer's storage back, so the round trip does not
+  // allocate once the buffer is large enough.
+  out = printer.printRoot(root);
+}
@@ -32,13 +32,16 @@
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/Option/Arg.h"
 #include "llvm/Option/ArgList.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/YAMLParser.h"
 #include "llvm/Support/raw_ostream.h"
@@ -143,6 +146,11 @@ Compilation::Compilation(DiagnosticEngine &Diags,
 
 static bool writeFilelistIfNecessary(const Job *job, const ArgList &args,
                                      DiagnosticEngine &diags);
+static void loadCompileTimes(StringRef path, StringRef argsHash,
+                             llvm::StringMap<double> &times);
+static void writeCompileTimes(StringRef path, StringRef argsHash,
+                              const llvm::StringMap<double> &times,
+                              ArrayRef<InputPair> inputs);
 
 using CommandSet = llvm::SmallPtrSet<const Job *, 16>;
 using CommandSetVector = llvm::SetVector<const Job*>;
@@ -203,6 +211,11 @@ namespace driver {
     /// Jobs that incremental-mode has decided it can skip.
     CommandSet DeferredCommands;
 
+    /// True if scheduleInitialJobs() determined that nothing is out of date
+    /// and deferred every dependency-tracked job without parsing any
+    /// swiftdeps files, leaving DepGraph empty.
+    bool SkippedLoadingDependencyGraph = false;
+
     /// Jobs in the initial set with Condition::Always, or lacking existing
     /// .swiftdeps files.
     SmallVector<const Job *, 16> InitialOutOfDateCommands;
@@ -230,6 +243,19 @@ namespace driver {
     llvm::SmallDenseMap<const Job *, std::unique_ptr<llvm::Timer>, 16>
     DriverTimers;
 
+    /// Predicted compile time of each input file (in seconds), loaded from
+    /// the record written by the previous build. Empty if there is no usable
+    /// record, in which case jobs are enqueued in their original order.
+    llvm::StringMap<double> PredictedDurations;
+
+    /// Measured compile time of each input file rebuilt during this build,
+    /// written back next to the compilation record for the next build to use.
+    llvm::StringMap<double> MeasuredDurations;
+
+    /// Wall-clock start times of currently executing tasks.
+    llvm::SmallDenseMap<const Job *, std::chrono::steady_clock::time_point, 16>
+    TaskStartTimes;
+
     void noteBuilding(const Job *cmd, StringRef reason) {
       if (!Comp.getShowIncrementalBuildDecisions())
         return;
@@ -327,12 +353,64 @@ namespace driver {
       return BatchJobs.count(MaybeBatchJob) != 0;
     }
 
+    /// Attribute \p Seconds of wall-clock time to each input file of \p Cmd.
+    void recordDuration(const Job *Cmd, double Seconds) {
+      for (const Action *A : Cmd->getSource().getInputs()) {
+        if (auto *IA = dyn_cast<InputAction>(A))
+          MeasuredDurations[IA->getInputArg().getValue()] = Seconds;
+      }
+    }
+
+    /// Sum the predicted durations of \p Cmd's input files. Inputs we have no
+    /// record of (e.g. newly added files) contribute nothing.
+    double getPredictedDuration(const Job *Cmd) const {
+      if (isBatchJob(Cmd)) {
+        double Total = 0;
+        for (const Job *J :
+               static_cast<const BatchJob *>(Cmd)->getCombinedJobs())
+          Total += getPredictedDuration(J);
+        return Total;
+      }
+      double Total = 0;
+      for (const Action *A : Cmd->getSource().getInputs()) {
+        if (auto *IA = dyn_cast<InputAction>(A))
+          Total += PredictedDurations.lookup(IA->getInputArg().getValue());
+      }
+      return Total;
+    }
+
+    /// If the previous build recorded compile times, reorder \p Cmds so the
+    /// jobs predicted to take longest are enqueued first. The TaskQueue
+    /// starts tasks in submission order, so with N parallel slots this
+    /// approximates longest-first scheduling: a slow file starts in the first
+    /// wave instead of being discovered last and tailing out the build alone.
+    void sortByPredictedDuration(std::vector<const Job *> &Cmds) {
+      if (PredictedDurations.empty())
+        return;
+      // Differences between tiny jobs are timing noise; if nothing here is
+      // predicted to take at least this long, reordering cannot meaningfully
+      // shorten the tail of the build, so preserve the original order.
+      const double MinimumSortableDuration = 1.0;
+      double Longest = 0;
+      for (const Job *Cmd : Cmds)
+        Longest = std::max(Longest, getPredictedDuration(Cmd));
+      if (Longest < MinimumSortableDuration)
+        return;
+      std::stable_sort(Cmds.begin(), Cmds.end(),
+                       [this](const Job *LHS, const Job *RHS) {
+                         return getPredictedDuration(LHS) >
+                                getPredictedDuration(RHS);
+                       });
+    }
+
     /// Callback which will be called immediately after a task has started. This
     /// callback may be used to provide output indicating that the task began.
     void taskBegan(ProcessId Pid, void *Context) {
       // TODO: properly handle task began.
       const Job *BeganCmd = (const Job *)Context;
 
+      TaskStartTimes[BeganCmd] = std::chrono::steady_clock::now();
+
       if (Comp.getShowDriverTimeCompilation()) {
         llvm::SmallString<128> TimerName;
         llvm::raw_svector_ostream OS(TimerName);
@@ -356,13 +434,19 @@ namespace driver {
       case OutputLevel::Verbose:
         BeganCmd->printCommandLine(llvm::errs());
         break;
-      case OutputLevel::Parseable:
+      case OutputLevel::Parseable: {
+        // Batch the contained jobs' messages into one write, so the consumer
+        // wakes up once per task-queue callback rather than once per message.
+        SmallString<256> Buffer;
+        llvm::raw_svector_ostream BufferStream(Buffer);
         BeganCmd->forEachContainedJobAndPID(Pid, [&](const Job *J, Job::PID P) {
-          parseable_output::emitBeganMessage(llvm::errs(), *J, P,
+          parseable_output::emitBeganMessage(BufferStream, *J, P,
                                              TaskProcessInformation(Pid));
         });
+        llvm::errs() << BufferStream.str();
         break;
       }
+      }
     }
 
     /// Note that a .swiftdeps file failed to load and take corrective actions:
@@ -519,20 +603,25 @@ namespace driver {
                                           StringRef Output,
                                           const Job *FinishedCmd,
                                           TaskProcessInformation ProcInfo) {
+      // As with began messages, batch the per-constituent messages into a
+      // single write.
+      SmallString<256> Buffer;
+      llvm::raw_svector_ostream BufferStream(Buffer);
       FinishedCmd->forEachContainedJobAndPID(Pid, [&](const Job *J,
                                                       Job::PID P) {
         if (jobIsCancelledBatchConstituent(ReturnCode, FinishedCmd, J)) {
           // Simulate SIGINT-interruption to parseable-output consumer for any
           // constituent of a failing batch job that produced no errors of its
           // own.
-          parseable_output::emitSignalledMessage(llvm::errs(), *J, P,
+          parseable_output::emitSignalledMessage(BufferStream, *J, P,
                                                  "cancelled batch constituent",
                                                  "", SIGINT, ProcInfo);
         } else {
-          parseable_output::emitFinishedMessage(llvm::errs(), *J, P, ReturnCode,
+          parseable_output::emitFinishedMessage(BufferStream, *J, P, ReturnCode,
                                                 Output, ProcInfo);
         }
       });
+      llvm::errs() << BufferStream.str();
     }
 
     /// Callback which will be called immediately after a task has finished
@@ -550,6 +639,30 @@ namespace driver {
           DriverTimers[FinishedCmd]->stopTimer();
         }
 
+        auto StartIt = TaskStartTimes.find(FinishedCmd);
+        if (StartIt != TaskStartTimes.end()) {
+          double Elapsed = std::chrono::duration<double>(
+              std::chrono::steady_clock::now() - StartIt->second).count();
+          TaskStartTimes.erase(StartIt);
+          // Only successful runs produce representative times; a failing
+          // frontend typically exits early.
+          if (ReturnCode == EXIT_SUCCESS) {
+            if (isBatchJob(FinishedCmd)) {
+              // Approximate each constituent's cost as an even share of the
+              // batch's wall time.
+              auto Constituents =
+                static_cast<const BatchJob *>(FinishedCmd)->getCombinedJobs();
+              if (!Constituents.empty()) {
+                double Share = Elapsed / Constituents.size();
+                for (const Job *J : Constituents)
+                  recordDuration(J, Share);
+              }
+            } else {
+              recordDuration(FinishedCmd, Elapsed);
+            }
+          }
+        }
+
         switch (Comp.getOutputLevel()) {
         case OutputLevel::PrintJobs:
           // Only print the jobs, not the outputs
@@ -633,11 +746,14 @@ namespace driver {
 
       if (Comp.getOutputLevel() == OutputLevel::Parseable) {
         // Parseable output was requested.
+        SmallString<256> Buffer;
+        llvm::raw_svector_ostream BufferStream(Buffer);
         SignalledCmd->forEachContainedJobAndPID(Pid, [&](const Job *J,
                                                          Job::PID P) {
-          parseable_output::emitSignalledMessage(llvm::errs(), *J, P, ErrorMsg,
+          parseable_output::emitSignalledMessage(BufferStream, *J, P, ErrorMsg,
                                                  Output, Signal, ProcInfo);
         });
+        llvm::errs() << BufferStream.str();
       } else {
         // Otherwise, send the buffered output to stderr, though only if we
         // support getting buffered output.
@@ -675,8 +791,68 @@ namespace driver {
         IncrementalTracer = &ActualIncrementalTracer;
     }
 
+    /// Returns true if the previous build's record shows every
+    /// dependency-tracked input to be up to date and every external
+    /// dependency unmodified, in which case all of those jobs can be
+    /// deferred without parsing a single swiftdeps file. Jobs without
+    /// dependency files are scheduled unconditionally on either path, so
+    /// they don't factor in here.
+    bool canSkipLoadingDependencyGraph() const {
+      if (!Comp.getIncrementalBuildEnabled())
+        return false;
+
+      // A record written before external dependencies were recorded cannot
+      // prove that no depended-upon module changed.
+      auto &externalDeps = Comp.getLastBuildExternalDependencies();
+      if (!externalDeps.hasValue())
+        return false;
+
+      for (const std::string &dependency : *externalDeps) {
+        llvm::sys::fs::file_status depStatus;
+        if (llvm::sys::fs::status(dependency, depStatus) ||
+            depStatus.getLastModificationTime() >= Comp.getLastBuildTime())
+          return false;
+      }
+
+      for (const Job *Cmd : Comp.getJobs()) {
+        StringRef DependenciesFile =
+            Cmd->getOutput().getAdditionalOutputForType(
+                file_types::TY_SwiftDeps);
+        if (DependenciesFile.empty())
+          continue;
+        if (Cmd->getCondition() != Job::Condition::CheckDependencies)
+          return false;
+        // A missing dependency file would disable incremental mode below;
+        // don't skip the load that would discover it.
+        if (!llvm::sys::fs::exists(DependenciesFile))
+          return false;
+      }
+      return true;
+    }
+
     /// Schedule all jobs we can from the initial list provided by Compilation.
     void scheduleInitialJobs() {
+      // On a null build, defer every dependency-tracked job up front; since
+      // nothing will ever be marked, the dependency graph (and the swiftdeps
+      // parsing it would take to build it) is not needed at all.
+      if (canSkipLoadingDependencyGraph()) {
+        if (Comp.getShowIncrementalBuildDecisions())
+          llvm::outs() << "Everything is up to date; "
+                       << "not loading dependency graph\n";
+        SkippedLoadingDependencyGraph = true;
+        for (const Job *Cmd : Comp.getJobs()) {
+          StringRef DependenciesFile =
+              Cmd->getOutput().getAdditionalOutputForType(
+                  file_types::TY_SwiftDeps);
+          if (DependenciesFile.empty()) {
+            scheduleCommandIfNecessaryAndPossible(Cmd);
+            continue;
+          }
+          DeferredCommands.insert(Cmd);
+        }
+        return;
+      }
+
       for (const Job *Cmd : Comp.getJobs()) {
         if (!Comp.getIncrementalBuildEnabled()) {
           scheduleCommandIfNecessaryAndPossible(Cmd);
@@ -822,6 +998,73 @@ namespace driver {
         Batches.push_back(Comp.addJob(std::move(J)));
     }
 
+    /// Assign jobs to batches balancing recorded compile times rather than
+    /// file counts, so the batches are predicted to finish together instead
+    /// of one batch inheriting all of the expensive files. Places each job,
+    /// most expensive first, into the least-loaded batch; \p PartitionIndex
+    /// is filled in positional order, so each batch remains a subsequence of
+    /// the inputs. Returns false (leaving \p PartitionIndex untouched) when
+    /// there are no usable predictions, in which case the caller falls back
+    /// to count-balanced contiguous runs.
+    bool assignJobsToPartitionsByCost(size_t PartitionSize,
+                                      ArrayRef<const Job *> Jobs,
+                                      std::vector<size_t> &PartitionIndex) {
+      if (PredictedDurations.empty())
+        return false;
+
+      // As with enqueue-order sorting, ignore noise-level predictions.
+      const double MinimumSortableDuration = 1.0;
+      double Longest = 0;
+      for (const Job *Cmd : Jobs)
+        Longest = std::max(Longest, getPredictedDuration(Cmd));
+      if (Longest < MinimumSortableDuration)
+        return false;
+
+      if (Comp.getShowJobLifecycle())
+        llvm::outs() << "Balancing " << Jobs.size()
+                     << " batchable jobs by recorded compile times\n";
+
+      // Cost jobs with no recorded time (e.g. newly added files) at the
+      // average of those that have one, so a run of unknown files does not
+      // masquerade as free.
+      size_t NumJobs = Jobs.size();
+      std::vector<double> Cost(NumJobs);
+      double KnownTotal = 0;
+      size_t NumKnown = 0;
+      for (size_t i = 0; i < NumJobs; ++i) {
+        Cost[i] = getPredictedDuration(Jobs[i]);
+        if (Cost[i] > 0) {
+          KnownTotal += Cost[i];
+          ++NumKnown;
+        }
+      }
+      assert(NumKnown != 0 && "a job exceeded the floor but none have costs?");
+      double AssumedUnknownCost = KnownTotal / NumKnown;
+      for (size_t i = 0; i < NumJobs; ++i) {
+        if (Cost[i] == 0)
+          Cost[i] = AssumedUnknownCost;
+      }
+
+      std::vector<size_t> Order(NumJobs);
+      for (size_t i = 0; i < NumJobs; ++i)
+        Order[i] = i;
+      std::stable_sort(Order.begin(), Order.end(),
+                       [&Cost](size_t L, size_t R) {
+                         return Cost[L] > Cost[R];
+                       });
+
+      std::vector<double> BatchLoad(PartitionSize, 0);
+      PartitionIndex.assign(NumJobs, 0);
+      for (size_t i : Order) {
+        size_t Lightest =
+            std::min_element(BatchLoad.begin(), BatchLoad.end()) -
+            BatchLoad.begin();
+        PartitionIndex[i] = Lightest;
+        BatchLoad[Lightest] += Cost[i];
+      }
+      return true;
+    }
+
     /// Build a vector of partition indices, one per Job: the i'th index says
     /// which batch of the partition the i'th Job will be assigned to. If we are
     /// shuffling due to -driver-batch-seed, the returned indices will not be
@@ -830,7 +1073,19 @@ namespace driver {
     /// subsequence of the full set of inputs, not just a subset.
     std::vector<size_t>
     assignJobsToPartitions(size_t PartitionSize,
-                           size_t NumJobs) {
+                           ArrayRef<const Job *> Jobs) {
+      size_t NumJobs = Jobs.size();
+
+      // When the previous build recorded compile times (and partitioning has
+      // not been explicitly randomized for testing), balance the batches by
+      // predicted cost instead of file count.
+      if (Comp.getBatchSeed() == 0) {
+        std::vector<size_t> CostBalancedIndex;
+        if (assignJobsToPartitionsByCost(PartitionSize, Jobs,
+                                         CostBalancedIndex))
+          return CostBalancedIndex;
+      }
+
       size_t Remainder = NumJobs % PartitionSize;
       size_t TargetSize = NumJobs / PartitionSize;
       std::vector<size_t> PartitionIndex;
@@ -861,7 +1116,7 @@ namespace driver {
 
       assert(!Partition.empty());
       auto PartitionIndex = assignJobsToPartitions(Partition.size(),
-                                                   Batchable.size());
+                                                   Batchable);
       assert(PartitionIndex.size() == Batchable.size());
       auto const &TC = Comp.getToolChain();
       for_each(Batchable, PartitionIndex, [&](const Job *Cmd, size_t Idx) {
@@ -927,9 +1182,13 @@ namespace driver {
     void formBatchJobsAndAddPendingJobsToTaskQueue() {
 
       // If batch mode is not enabled, just transfer the set of pending jobs to
-      // the task queue, as-is.
+      // the task queue, longest predicted first.
       if (!Comp.getBatchModeEnabled()) {
-        transferJobsToTaskQueue(PendingExecution, "standard");
+        std::vector<const Job *> Ordered(PendingExecution.begin(),
+                                         PendingExecution.end());
+        PendingExecution.clear();
+        sortByPredictedDuration(Ordered);
+        transferJobsToTaskQueue(Ordered, "standard");
         return;
       }
 
@@ -966,9 +1225,13 @@ namespace driver {
       for (const Job *Cmd : Batches)
         BatchJobs.insert(Cmd);
 
-      // Enqueue the resulting jobs, batched and non-batched alike.
+      // Enqueue the resulting jobs, batched and non-batched alike, longest
+      // predicted first.
+      sortByPredictedDuration(Batches);
+      auto NonBatchableOrdered = NonBatchable.takeVector();
+      sortByPredictedDuration(NonBatchableOrdered);
       transferJobsToTaskQueue(Batches, "batch");
-      transferJobsToTaskQueue(NonBatchable, "non-batch");
+      transferJobsToTaskQueue(NonBatchableOrdered, "non-batch");
     }
 
     void runTaskQueueToCompletion() {
@@ -1010,16 +1273,23 @@ namespace driver {
         }
 
         // If we got here, all the queued and pending work we know about is
-        // done; mark anything still in deferred state as skipped.
+        // done; mark anything still in deferred state as skipped. An
+        // incremental null build of a large module defers nearly every job,
+        // so the skipped messages are batched into a single write rather
+        // than paying the consumer a pipe wakeup per job.
+        SmallString<256> SkippedBuffer;
+        llvm::raw_svector_ostream SkippedStream(SkippedBuffer);
         for (const Job *Cmd : DeferredCommands) {
           if (Comp.getOutputLevel() == OutputLevel::Parseable) {
             // Provide output indicating this command was skipped if parseable
             // output was requested.
-            parseable_output::emitSkippedMessage(llvm::errs(), *Cmd);
+            parseable_output::emitSkippedMessage(SkippedStream, *Cmd);
           }
           ScheduledCommands.insert(Cmd);
           markFinished(Cmd, /*Skipped=*/true);
         }
+        if (!SkippedBuffer.empty())
+          llvm::errs() << SkippedStream.str();
         DeferredCommands.clear();
 
         // It's possible that by marking some jobs as skipped, we unblocked
@@ -1106,6 +1376,37 @@ namespace driver {
                            });
     }
 
+    /// Collect the external dependencies to record for the next build: the
+    /// loaded graph's set or, when the null-build fast path never loaded the
+    /// graph, the list carried over from the previous record. Sorted so the
+    /// record is deterministic.
+    std::vector<std::string> getExternalDependenciesForRecord() const {
+      std::vector<std::string> deps;
+      if (SkippedLoadingDependencyGraph) {
+        deps = *Comp.getLastBuildExternalDependencies();
+      } else {
+        for (StringRef dep : DepGraph.getExternalDependencies())
+          deps.push_back(dep.str());
+      }
+      std::sort(deps.begin(), deps.end());
+      return deps;
+    }
+
+    /// Load per-input compile times recorded by the previous build, for
+    /// enqueueing the predicted-longest jobs first.
+    void loadCompileTimeEstimates(StringRef Path, StringRef ArgsHash) {
+      loadCompileTimes(Path, ArgsHash, PredictedDurations);
+    }
+
+    /// Write this build's measured compile times for the next build to use.
+    /// Inputs that were not rebuilt this time keep their previous estimate.
+    void writeCompileTimeEstimates(StringRef Path, StringRef ArgsHash) {
+      for (const auto &entry : MeasuredDurations)
+        PredictedDurations[entry.first()] = entry.second;
+      writeCompileTimes(Path, ArgsHash, PredictedDurations,
+                        Comp.getInputFiles());
+    }
+
     int getResult() {
       if (Result == 0)
         Result = Comp.getDiags().hadAnyError();
@@ -1152,7 +1453,8 @@ static void checkForOutOfDateInputs(DiagnosticEngine &diags,
 
 static void writeCompilationRecord(StringRef path, StringRef argsHash,
                                    llvm::sys::TimePoint<> buildTime,
-                                   const InputInfoMap &inputs) {
+                                   const InputInfoMap &inputs,
+                                   ArrayRef<std::string> externalDeps) {
   // Before writing to the dependencies file path, preserve any previous file
   // that may have been there. No error handling -- this is just a nicety, it
   // doesn't matter if it fails.
@@ -1202,6 +1504,128 @@ static void writeCompilationRecord(StringRef path, StringRef argsHash,
     writeTimeValue(out, entry.second.previousModTime);
     out << "\n";
   }
+
+  out << compilation_record::getName(TopLevelKey::ExternalDependencies)
+      << ":\n";
+  for (const std::string &dep : externalDeps) {
+    out << "  - \"" << llvm::yaml::escape(dep) << "\"\n";
+  }
+}
+
+/// Returns the path at which per-input compile times are recorded, derived
+/// from the compilation record path like the record's other sibling files.
+static std::string getCompileTimesPath(StringRef compilationRecordPath) {
+  return (compilationRecordPath + "~compile-times").str();
+}
+
+/// Reads the per-input compile times recorded by a previous build into
+/// \p times.
+///
+/// The file carries the same version and option-hash guards as the
+/// compilation record; if either does not match the current invocation, the
+/// recorded times are ignored. A missing or malformed file only costs us the
+/// scheduling hint, so all failures here are silent.
+static void loadCompileTimes(StringRef path, StringRef argsHash,
+                             llvm::StringMap<double> &times) {
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer)
+    return;
+
+  namespace yaml = llvm::yaml;
+  llvm::SourceMgr SM;
+  yaml::Stream stream(buffer.get()->getMemBufferRef(), SM);
+
+  auto I = stream.begin();
+  if (I == stream.end() || !I->getRoot())
+    return;
+  auto *topLevelMap = dyn_cast<yaml::MappingNode>(I->getRoot());
+  if (!topLevelMap)
+    return;
+
+  SmallString<64> scratch;
+  llvm::StringMap<double> parsed;
+  bool versionValid = false;
+  bool optionsMatch = false;
+
+  // FIXME: LLVM's YAML support does incremental parsing in such a way that
+  // for-range loops break.
+  for (auto i = topLevelMap->begin(), e = topLevelMap->end(); i != e; ++i) {
+    auto *key = dyn_cast<yaml::ScalarNode>(i->getKey());
+    if (!key)
+      return;
+    StringRef keyStr = key->getValue(scratch);
+
+    if (keyStr == "version") {
+      auto *value = dyn_cast<yaml::ScalarNode>(i->getValue());
+      if (!value)
+        return;
+      versionValid =
+          (value->getValue(scratch) ==
+           version::getSwiftFullVersion(
+               version::Version::getCurrentLanguageVersion()));
+
+    } else if (keyStr == "options") {
+      auto *value = dyn_cast<yaml::ScalarNode>(i->getValue());
+      if (!value)
+        return;
+      optionsMatch = (argsHash == value->getValue(scratch));
+
+    } else if (keyStr == "times") {
+      auto *timesMap = dyn_cast<yaml::MappingNode>(i->getValue());
+      if (!timesMap)
+        return;
+
+      // FIXME: LLVM's YAML support does incremental parsing in such a way
+      // that for-range loops break.
+      for (auto t = timesMap->begin(), te = timesMap->end(); t != te; ++t) {
+        auto *inputKey = dyn_cast<yaml::ScalarNode>(t->getKey());
+        auto *inputValue = dyn_cast<yaml::ScalarNode>(t->getValue());
+        if (!inputKey || !inputValue)
+          return;
+
+        double seconds;
+        SmallString<16> valueScratch;
+        if (inputValue->getValue(valueScratch).getAsDouble(seconds))
+          return;
+        parsed[inputKey->getValue(scratch)] = seconds;
+      }
+    }
+  }
+
+  if (versionValid && optionsMatch)
+    times = std::move(parsed);
+}
+
+/// Writes per-input compile times next to the compilation record so the next
+/// build can enqueue the longest compiles first.
+///
+/// Entries are restricted to the current compilation's inputs, so times for
+/// removed files do not accumulate.
+static void writeCompileTimes(StringRef path, StringRef argsHash,
+                              const llvm::StringMap<double> &times,
+                              ArrayRef<InputPair> inputs) {
+  std::error_code error;
+  llvm::raw_fd_ostream out(path, error, llvm::sys::fs::F_None);
+  if (out.has_error()) {
+    // As when reading, losing this file only costs a scheduling hint.
+    out.clear_error();
+    return;
+  }
+
+  out << "version: \""
+      << llvm::yaml::escape(version::getSwiftFullVersion(
+                              version::Version::getCurrentLanguageVersion()))
+      << "\"\n";
+  out << "options: \"" << llvm::yaml::escape(argsHash) << "\"\n";
+  out << "times:\n";
+
+  for (auto inputPair : inputs) {
+    auto known = times.find(inputPair.second->getValue());
+    if (known == times.end())
+      continue;
+    out << "  \"" << llvm::yaml::escape(known->first()) << "\": "
+        << llvm::format("%.6f", known->second) << "\n";
+  }
 }
 
 static bool writeFilelistIfNecessary(const Job *job, const ArgList &args,
@@ -1271,6 +1695,10 @@ int Compilation::performJobsImpl(bool &abnormalExit,
                                  std::unique_ptr<TaskQueue> &&TQ) {
   PerformJobsState State(*this, std::move(TQ));
 
+  if (!CompilationRecordPath.empty())
+    State.loadCompileTimeEstimates(getCompileTimesPath(CompilationRecordPath),
+                                   ArgsHash);
+
   State.scheduleInitialJobs();
   State.scheduleAdditionalJobs();
   State.formBatchJobsAndAddPendingJobsToTaskQueue();
@@ -1282,13 +1710,17 @@ int Compilation::performJobsImpl(bool &abnormalExit,
     State.populateInputInfoMap(InputInfo);
     checkForOutOfDateInputs(Diags, InputInfo);
     writeCompilationRecord(CompilationRecordPath, ArgsHash, BuildStartTime,
-                           InputInfo);
+                           InputInfo,
+                           State.getExternalDependenciesForRecord());
 
     if (OutputCompilationRecordForModuleOnlyBuild) {
       // TODO: Optimize with clonefile(2) ?
       llvm::sys::fs::copy_file(CompilationRecordPath,
                                CompilationRecordPath + "~moduleonly");
     }
+
+    State.writeCompileTimeEstimates(getCompileTimesPath(CompilationRecordPath),
+                                    ArgsHash);
   }
 
   abnormalExit = State.hadAnyAbnormalExit();
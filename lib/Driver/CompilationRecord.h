@@ -34,6 +34,11 @@ enum class TopLevelKey {
   /// The key for the list of inputs to the compilation that produced the
   /// compilation record.
   Inputs,
+  /// The key for the union of external dependencies (e.g. imported module
+  /// files) seen by the inputs' swiftdeps files. Recording it here lets a
+  /// null build verify that no external dependency changed without parsing
+  /// any of the swiftdeps files.
+  ExternalDependencies,
 };
 
 /// \returns A string representation of the given key.
@@ -43,6 +48,7 @@ inline static StringRef getName(TopLevelKey Key) {
   case TopLevelKey::Options: return "options";
   case TopLevelKey::BuildTime: return "build_time";
   case TopLevelKey::Inputs: return "inputs";
+  case TopLevelKey::ExternalDependencies: return "external_deps";
   }
 
   // Work around MSVC warning: not all control paths return a value
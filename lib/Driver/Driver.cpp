@@ -378,6 +378,38 @@ static bool getCompilationRecordPath(std::string &buildRecordPath,
   return false;
 }
 
+/// Default -pch-output-dir when the user imports a textual bridging header
+/// but did not pick a location for persistent PCH output themselves. The
+/// default lives next to the build record, so any build configured well
+/// enough to be incremental also reuses its bridging header PCH across
+/// builds instead of precompiling it once per driver invocation. Files
+/// inside the directory are keyed by bridging header content and importer
+/// options (see ClangImporter::getPCHFilename), so a stale PCH is
+/// regenerated rather than misused.
+static void addDefaultPCHOutputDirIfNeeded(llvm::opt::DerivedArgList &Args,
+                                           const ToolChain &TC,
+                                           const llvm::opt::OptTable &Opts,
+                                           StringRef buildRecordPath) {
+  if (buildRecordPath.empty())
+    return;
+  if (Args.hasArgNoClaim(options::OPT_pch_output_dir))
+    return;
+  if (!Args.hasFlag(options::OPT_enable_bridging_pch,
+                    options::OPT_disable_bridging_pch,
+                    true))
+    return;
+  const Arg *A = Args.getLastArgNoClaim(options::OPT_import_objc_header);
+  if (!A)
+    return;
+  auto Ty = TC.lookupTypeForExtension(
+      llvm::sys::path::extension(A->getValue()));
+  if (Ty != file_types::TY_ObjCHeader)
+    return;
+  Args.AddSeparateArg(/*BaseArg=*/nullptr,
+                      Opts.getOption(options::OPT_pch_output_dir),
+                      (buildRecordPath + "~pch").str());
+}
+
 static bool failedToReadOutOfDateMap(bool ShowIncrementalBuildDecisions,
                                      StringRef buildRecordPath,
                                      StringRef reason = "") {
@@ -394,6 +426,7 @@ static bool failedToReadOutOfDateMap(bool ShowIncrementalBuildDecisions,
 
 static bool populateOutOfDateMap(InputInfoMap &map,
                                  llvm::sys::TimePoint<> &LastBuildTime,
+                                 Optional<std::vector<std::string>> &externalDeps,
                                  StringRef argsHashStr,
                                  const InputFileList &inputs,
                                  StringRef buildRecordPath,
@@ -539,6 +572,27 @@ static bool populateOutOfDateMap(InputInfoMap &map,
         auto inputName = key->getValue(scratch);
         previousInputs[inputName] = { *previousBuildState, timeValue };
       }
+
+    } else if (keyStr ==
+               compilation_record::getName(TopLevelKey::ExternalDependencies)) {
+      auto *value = dyn_cast<yaml::SequenceNode>(i->getValue());
+      if (!value) {
+        auto reason = ("Malformed value for key '" + keyStr + "'.")
+          .toStringRef(scratch);
+        return failedToReadOutOfDateMap(ShowIncrementalBuildDecisions,
+                                        buildRecordPath, reason);
+      }
+
+      std::vector<std::string> deps;
+      // FIXME: LLVM's YAML support does incremental parsing in such a way that
+      // for-range loops break.
+      for (auto d = value->begin(), de = value->end(); d != de; ++d) {
+        auto *scalar = dyn_cast<yaml::ScalarNode>(&*d);
+        if (!scalar)
+          return true;
+        deps.push_back(scalar->getValue(scratch).str());
+      }
+      externalDeps = std::move(deps);
     }
   }
 
@@ -823,14 +877,19 @@ Driver::buildCompilation(const ToolChain &TC,
   getCompilationRecordPath(buildRecordPath, outputBuildRecordForModuleOnlyBuild,
                            OI, OFM, Incremental ? &Diags : nullptr);
 
+  addDefaultPCHOutputDirIfNeeded(*TranslatedArgList, TC, getOpts(),
+                                 buildRecordPath);
+
   SmallString<32> ArgsHash;
   computeArgsHash(ArgsHash, *TranslatedArgList);
   llvm::sys::TimePoint<> LastBuildTime = llvm::sys::TimePoint<>::min();
   InputInfoMap outOfDateMap;
+  Optional<std::vector<std::string>> previousExternalDeps;
   bool rebuildEverything = true;
   if (Incremental && !buildRecordPath.empty()) {
-    if (populateOutOfDateMap(outOfDateMap, LastBuildTime, ArgsHash, Inputs,
-                             buildRecordPath, ShowIncrementalBuildDecisions)) {
+    if (populateOutOfDateMap(outOfDateMap, LastBuildTime, previousExternalDeps,
+                             ArgsHash, Inputs, buildRecordPath,
+                             ShowIncrementalBuildDecisions)) {
       // FIXME: Distinguish errors from "file removed", which is benign.
     } else {
       rebuildEverything = false;
@@ -903,6 +962,9 @@ Driver::buildCompilation(const ToolChain &TC,
         std::move(StatsReporter));
   }
 
+  if (!rebuildEverything && previousExternalDeps.hasValue())
+    C->setLastBuildExternalDependencies(std::move(*previousExternalDeps));
+
   // Construct the graph of Actions.
   SmallVector<const Action *, 8> TopLevelActions;
   buildActions(TopLevelActions, TC, OI, OFM ? OFM.getPointer() : nullptr,
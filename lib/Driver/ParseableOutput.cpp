@@ -258,8 +258,14 @@ static void emitMessage(raw_ostream &os, Message &msg) {
   json::Output yout(BufferStream);
   yout << msg;
   BufferStream.flush();
-  os << JSONString.length() << '\n';
-  os << JSONString << '\n';
+  // Frame the whole message (length prefix included) in one write: the
+  // destination is typically an unbuffered pipe to the build system, and a
+  // single write per message both halves the syscall count and keeps
+  // messages from interleaving.
+  SmallString<256> Framed;
+  llvm::raw_svector_ostream FramedStream(Framed);
+  FramedStream << JSONString.length() << '\n' << JSONString << '\n';
+  os << FramedStream.str();
 }
 
 void parseable_output::emitBeganMessage(raw_ostream &os, const Job &Cmd,
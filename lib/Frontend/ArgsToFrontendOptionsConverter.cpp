@@ -65,6 +65,7 @@ bool ArgsToFrontendOptionsConverter::convert(
   }
 
   Opts.IndexSystemModules |= Args.hasArg(OPT_index_system_modules);
+  Opts.SkipFunctionBodies |= Args.hasArg(OPT_skip_function_bodies);
 
   Opts.EmitVerboseSIL |= Args.hasArg(OPT_emit_verbose_sil);
   Opts.EmitSortedSIL |= Args.hasArg(OPT_emit_sorted_sil);
@@ -193,6 +194,9 @@ void ArgsToFrontendOptionsConverter::computeDebugTimeOptions() {
     if (Args.getLastArg(OPT_profile_stats_entities)) {
       Opts.ProfileEntities = true;
     }
+    if (Args.getLastArg(OPT_sample_stats_events)) {
+      Opts.SampleEvents = true;
+    }
   }
 }
 
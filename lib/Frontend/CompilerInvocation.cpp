@@ -209,6 +209,7 @@ static bool ParseLangArgs(LangOptions &Opts, ArgList &Args,
   }
   
   Opts.EnableASTScopeLookup |= Args.hasArg(OPT_enable_astscope_lookup);
+  Opts.EnableASTScopeLookup &= !Args.hasArg(OPT_disable_astscope_lookup);
   Opts.DebugConstraintSolver |= Args.hasArg(OPT_debug_constraints);
   Opts.NamedLazyMemberLoading &= !Args.hasArg(OPT_disable_named_lazy_member_loading);
   Opts.DebugGenericSignatures |= Args.hasArg(OPT_debug_generic_signatures);
@@ -282,6 +283,13 @@ static bool ParseLangArgs(LangOptions &Opts, ArgList &Args,
   if (const Arg *A = Args.getLastArg(OPT_solver_disable_shrink))
     Opts.SolverDisableShrink = true;
 
+  if (const Arg *A = Args.getLastArg(OPT_solver_solution_cache_path))
+    Opts.SolverSolutionCachePath = A->getValue();
+
+  if (const Arg *A =
+          Args.getLastArg(OPT_experimental_evaluator_result_cache_path))
+    Opts.EvaluatorResultCachePath = A->getValue();
+
   if (const Arg *A = Args.getLastArg(OPT_value_recursion_threshold)) {
     unsigned threshold;
     if (StringRef(A->getValue()).getAsInteger(10, threshold)) {
@@ -413,6 +421,10 @@ static bool ParseClangImporterArgs(ClangImporterOptions &Opts,
 
   Opts.DisableModulesValidateSystemHeaders |= Args.hasArg(OPT_disable_modules_validate_system_headers);
 
+  Opts.ValidateModulesOnce |= Args.hasArg(OPT_validate_clang_modules_once);
+  if (auto *A = Args.getLastArg(OPT_clang_build_session_file))
+    Opts.BuildSessionFilePath = A->getValue();
+
   Opts.DisableAdapterModules |= Args.hasArg(OPT_emit_imported_modules);
 
   if (const Arg *A = Args.getLastArg(OPT_pch_output_dir)) {
@@ -590,6 +602,9 @@ static bool ParseSILArgs(SILOptions &Opts, ArgList &Args,
   if (Args.hasArg(OPT_sil_merge_partial_modules))
     Opts.MergePartialModules = true;
 
+  Opts.SkipNonInlinableFunctionBodies |=
+      Args.hasArg(OPT_experimental_skip_non_inlinable_function_bodies);
+
   // Parse the optimization level.
   // Default to Onone settings if no option is passed.
   Opts.OptMode = OptimizationMode::NoOptimization;
@@ -942,6 +957,10 @@ static bool ParseIRGenArgs(IRGenOptions &Opts, ArgList &Args,
     Opts.EnableReflectionNames = false;
   }
 
+  if (Args.hasArg(OPT_enable_strippable_reflection_metadata)) {
+    Opts.StrippableReflectionMetadata = true;
+  }
+
   if (Args.hasArg(OPT_enable_class_resilience)) {
     Opts.EnableClassResilience = true;
   }
@@ -1166,9 +1185,15 @@ CompilerInvocation::setUpInputForSILTool(
   bool hasSerializedAST = result.status == serialization::Status::Valid;
 
   if (hasSerializedAST) {
-    const StringRef stem = !moduleNameArg.empty()
-                               ? moduleNameArg
-                               : llvm::sys::path::stem(inputFilename);
+    // Prefer an explicit module name, then the name recorded in the
+    // serialized module itself; fall back to the file's stem. Without the
+    // recorded name, round-tripping a module through -emit-sib and back
+    // only works when the file happens to be named after the module.
+    const StringRef stem =
+        !moduleNameArg.empty()
+            ? moduleNameArg
+            : !result.name.empty() ? result.name
+                                   : llvm::sys::path::stem(inputFilename);
     setModuleName(stem);
     setInputKind(InputFileKind::IFK_Swift_Library);
   } else {
@@ -127,6 +127,7 @@ void CompilerInstance::recordPrimaryInputBuffer(unsigned BufID) {
 void CompilerInstance::recordPrimarySourceFile(SourceFile *SF) {
   assert(MainModule && "main module not created yet");
   PrimarySourceFiles.push_back(SF);
+  SF->setIsPrimary();
   SF->createReferencedNameTracker();
   if (SF->getBufferID().hasValue())
     recordPrimaryInputBuffer(SF->getBufferID().getValue());
@@ -571,6 +572,8 @@ CompilerInstance::computeDelayedParsingCallback(bool isPrimary) {
   if (Invocation.isCodeCompletion())
     return llvm::make_unique<CodeCompleteDelayedCallbacks>(
         SourceMgr.getCodeCompletionLoc());
+  if (Invocation.getFrontendOptions().SkipFunctionBodies)
+    return llvm::make_unique<SkipFunctionBodiesCallbacks>();
   if (!isPrimary)
     return llvm::make_unique<AlwaysDelayedCallbacks>();
   return nullptr;
@@ -855,6 +858,10 @@ SourceFile *CompilerInstance::createSourceFileForMainModule(
 
   if (bufferID && isPrimaryInput(*bufferID)) {
     recordPrimarySourceFile(inputFile);
+  } else if (isWholeModuleCompilation()) {
+    // A whole-module job checks every file as a primary, even though none is
+    // a primary *input*.
+    inputFile->setIsPrimary();
   }
 
   return inputFile;
@@ -83,6 +83,7 @@
 #include "llvm/Support/YAMLTraits.h"
 #include "llvm/Target/TargetMachine.h"
 
+#include <cstdlib>
 #include <deque>
 #include <memory>
 #include <unordered_set>
@@ -764,7 +765,8 @@ static void emitReferenceDependenciesForAllPrimaryInputsIfNeeded(
 }
 
 static bool writeTBDIfNeeded(CompilerInvocation &Invocation,
-                             CompilerInstance &Instance) {
+                             CompilerInstance &Instance,
+                             TBDSymbolCache &tbdSymbolCache) {
   const auto &frontendOpts = Invocation.getFrontendOptions();
   if (!frontendOpts.InputsAndOutputs.hasTBDPath())
     return false;
@@ -782,7 +784,7 @@ static bool writeTBDIfNeeded(CompilerInvocation &Invocation,
   opts.HasMultipleIGMs = Invocation.getSILOptions().hasMultipleIGMs();
   opts.ModuleLinkName = frontendOpts.ModuleLinkName;
 
-  return writeTBD(Instance.getMainModule(), TBDPath, opts);
+  return writeTBD(Instance.getMainModule(), TBDPath, opts, &tbdSymbolCache);
 }
 
 static std::deque<PostSILGenInputs>
@@ -867,7 +869,7 @@ static bool performCompileStepsPostSILGen(
     std::unique_ptr<SILModule> SM, bool astGuaranteedToCorrespondToSIL,
     ModuleOrSourceFile MSF, const PrimarySpecificPaths &PSPs,
     bool moduleIsPublic, int &ReturnValue, FrontendObserver *observer,
-    UnifiedStatsReporter *Stats);
+    UnifiedStatsReporter *Stats, TBDSymbolCache &tbdSymbolCache);
 
 /// Performs the compile requested by the user.
 /// \param Instance Will be reset after performIRGeneration when the verifier
@@ -989,7 +991,11 @@ static bool performCompile(CompilerInstance &Instance,
     return hadPrintAsObjCError || hadEmitIndexDataError || Context.hadError();
   }
 
-  if (writeTBDIfNeeded(Invocation, Instance))
+  // Shared between TBD emission above and TBD validation against the IR
+  // below, so the public symbols of each file are only enumerated once.
+  TBDSymbolCache tbdSymbolCache;
+
+  if (writeTBDIfNeeded(Invocation, Instance, tbdSymbolCache))
     return true;
 
   assert(Action >= FrontendOptions::ActionType::EmitSILGen &&
@@ -1006,7 +1012,8 @@ static bool performCompile(CompilerInstance &Instance,
                                       PSGI.ModuleOrPrimarySourceFile,
                                       PSGI.PSPs,
                                       moduleIsPublic,
-                                      ReturnValue, observer, Stats))
+                                      ReturnValue, observer, Stats,
+                                      tbdSymbolCache))
       return true;
   }
   return false;
@@ -1165,7 +1172,8 @@ static bool processCommandLineAndRunImmediately(CompilerInvocation &Invocation,
 static bool validateTBDIfNeeded(CompilerInvocation &Invocation,
                                 ModuleOrSourceFile MSF,
                                 bool astGuaranteedToCorrespondToSIL,
-                                llvm::Module &IRModule) {
+                                llvm::Module &IRModule,
+                                TBDSymbolCache &tbdSymbolCache) {
   if (!astGuaranteedToCorrespondToSIL ||
       !inputFileKindCanHaveTBDValidated(Invocation.getInputKind()))
     return false;
@@ -1197,8 +1205,10 @@ static bool validateTBDIfNeeded(CompilerInvocation &Invocation,
 
   const bool allSymbols = mode == FrontendOptions::TBDValidationMode::All;
   return MSF.is<SourceFile *>()
-             ? validateTBD(MSF.get<SourceFile *>(), IRModule, opts, allSymbols)
-             : validateTBD(MSF.get<ModuleDecl *>(), IRModule, opts, allSymbols);
+             ? validateTBD(MSF.get<SourceFile *>(), IRModule, opts, allSymbols,
+                           &tbdSymbolCache)
+             : validateTBD(MSF.get<ModuleDecl *>(), IRModule, opts, allSymbols,
+                           &tbdSymbolCache);
 }
 
 static bool generateCode(CompilerInvocation &Invocation,
@@ -1236,7 +1246,7 @@ static bool performCompileStepsPostSILGen(
     std::unique_ptr<SILModule> SM, bool astGuaranteedToCorrespondToSIL,
     ModuleOrSourceFile MSF, const PrimarySpecificPaths &PSPs,
     bool moduleIsPublic, int &ReturnValue, FrontendObserver *observer,
-    UnifiedStatsReporter *Stats) {
+    UnifiedStatsReporter *Stats, TBDSymbolCache &tbdSymbolCache) {
 
   FrontendOptions opts = Invocation.getFrontendOptions();
   FrontendOptions::ActionType Action = opts.RequestedAction;
@@ -1384,7 +1394,7 @@ static bool performCompileStepsPostSILGen(
     return HadError;
 
   if (validateTBDIfNeeded(Invocation, MSF, astGuaranteedToCorrespondToSIL,
-                          *IRModule))
+                          *IRModule, tbdSymbolCache))
     return true;
 
   return generateCode(Invocation, Instance, OutputFilename, IRModule.get(),
@@ -1519,8 +1529,18 @@ silOptModeArgStr(OptimizationMode mode) {
 
 static std::unique_ptr<UnifiedStatsReporter>
 computeStatsReporter(const CompilerInvocation &Invocation, CompilerInstance *Instance) {
-  const std::string &StatsOutputDir =
-      Invocation.getFrontendOptions().StatsOutputDir;
+  std::string StatsOutputDir = Invocation.getFrontendOptions().StatsOutputDir;
+  bool SampleEvents = Invocation.getFrontendOptions().SampleEvents;
+  if (StatsOutputDir.empty()) {
+    // Toolchains that want continuous compile-time telemetry export
+    // SWIFT_STATS_OUTPUT_DIR rather than editing every build invocation;
+    // since it applies fleet-wide it enables only the cheap sampled trace,
+    // not the full event trace or profilers.
+    if (const char *EnvDir = ::getenv("SWIFT_STATS_OUTPUT_DIR")) {
+      StatsOutputDir = EnvDir;
+      SampleEvents = true;
+    }
+  }
   std::unique_ptr<UnifiedStatsReporter> StatsReporter;
   if (StatsOutputDir.empty())
     return std::unique_ptr<UnifiedStatsReporter>();
@@ -1547,7 +1567,7 @@ computeStatsReporter(const CompilerInvocation &Invocation, CompilerInstance *Ins
   return llvm::make_unique<UnifiedStatsReporter>(
       "swift-frontend", FEOpts.ModuleName, InputName, TripleName, OutputType,
       OptType, StatsOutputDir, SM, CSM, Trace,
-      ProfileEvents, ProfileEntities);
+      ProfileEvents, ProfileEntities, SampleEvents);
 }
 
 /// Creates a diagnostic consumer that handles dispatching diagnostics to
@@ -104,6 +104,10 @@ private:
     /// to a public protocol and add a public member.
     llvm::SmallVector<const ExtensionDecl *, 8> extensionsWithJustMembers;
 
+    /// Records nominal types declared in this file, so their members can be
+    /// emitted as member provides alongside members added by extensions.
+    llvm::SmallVector<const NominalTypeDecl *, 8> declaredNominals;
+
     /// Recursively computes the transitive closure over members
     /// adding memberOperatorDecls and extendedNominals to the receiver.
     void findNominalsAndOperators(const DeclRange members);
@@ -372,6 +376,7 @@ void ProvidesEmitter::emitNominalTypeDecl(const NominalTypeDecl *const NTD,
   }
   out << "- \"" << escape(NTD->getName()) << "\"\n";
   cpd.extendedNominals[NTD] |= true;
+  cpd.declaredNominals.push_back(NTD);
   cpd.findNominalsAndOperators(NTD->getMembers());
 }
 
@@ -395,6 +400,7 @@ void ProvidesEmitter::CollectedDeclarations::findNominalsAndOperators(
     if (!nominal)
       continue;
     extendedNominals[nominal] |= true;
+    declaredNominals.push_back(nominal);
     findNominalsAndOperators(nominal->getMembers());
   }
 }
@@ -430,11 +436,13 @@ void ProvidesEmitter::emitMembers(const CollectedDeclarations &cpd) const {
   }
 
   // This is also part of providesMember.
-  for (auto *ED : cpd.extensionsWithJustMembers) {
-    auto mangledName =
-        mangleTypeAsContext(ED->getExtendedType()->getAnyNominal());
-
-    for (auto *member : ED->getMembers()) {
+  auto emitMemberEntries = [this](StringRef mangledName, DeclRange members,
+                                  bool skipImplicit) {
+    for (auto *member : members) {
+      // Synthesized members are not declared in this file; the wildcard entry
+      // for the base type already covers them.
+      if (skipImplicit && member->isImplicit())
+        continue;
       auto *VD = dyn_cast<ValueDecl>(member);
       if (!VD || !VD->hasName() ||
           VD->getFormalAccess() <= AccessLevel::FilePrivate) {
@@ -443,7 +451,18 @@ void ProvidesEmitter::emitMembers(const CollectedDeclarations &cpd) const {
       out << "- [\"" << mangledName << "\", \"" << escape(VD->getBaseName())
           << "\"]\n";
     }
+  };
+  for (auto *ED : cpd.extensionsWithJustMembers) {
+    emitMemberEntries(mangleTypeAsContext(ED->getExtendedType()->getAnyNominal()),
+                      ED->getMembers(), /*skipImplicit=*/false);
   }
+
+  // Members declared in the body of a nominal type in this file are provided
+  // at the same (type, member) granularity as members added by extensions, so
+  // the driver's member map covers every member, not just extension members.
+  for (auto *NTD : cpd.declaredNominals)
+    emitMemberEntries(mangleTypeAsContext(NTD), NTD->getMembers(),
+                      /*skipImplicit=*/true);
 }
 
 void ProvidesEmitter::emitDynamicLookupMembers() const {
@@ -39,7 +39,7 @@ static std::vector<StringRef> sortSymbols(llvm::StringSet<> &symbols) {
 }
 
 bool swift::writeTBD(ModuleDecl *M, StringRef OutputFilename,
-                     TBDGenOptions &Opts) {
+                     TBDGenOptions &Opts, TBDSymbolCache *Cache) {
   std::error_code EC;
   llvm::raw_fd_ostream OS(OutputFilename, EC, llvm::sys::fs::F_None);
   if (EC) {
@@ -48,7 +48,7 @@ bool swift::writeTBD(ModuleDecl *M, StringRef OutputFilename,
     return true;
   }
 
-  writeTBDFile(M, OS, Opts);
+  writeTBDFile(M, OS, Opts, Cache);
 
   return false;
 }
@@ -121,18 +121,20 @@ static bool validateSymbolSet(DiagnosticEngine &diags,
 }
 
 bool swift::validateTBD(ModuleDecl *M, llvm::Module &IRModule,
-                        TBDGenOptions &opts, bool diagnoseExtraSymbolsInTBD) {
+                        TBDGenOptions &opts, bool diagnoseExtraSymbolsInTBD,
+                        TBDSymbolCache *cache) {
   llvm::StringSet<> symbols;
-  enumeratePublicSymbols(M, symbols, opts);
+  enumeratePublicSymbols(M, symbols, opts, cache);
 
   return validateSymbolSet(M->getASTContext().Diags, symbols, IRModule,
                            diagnoseExtraSymbolsInTBD);
 }
 
 bool swift::validateTBD(FileUnit *file, llvm::Module &IRModule,
-                        TBDGenOptions &opts, bool diagnoseExtraSymbolsInTBD) {
+                        TBDGenOptions &opts, bool diagnoseExtraSymbolsInTBD,
+                        TBDSymbolCache *cache) {
   llvm::StringSet<> symbols;
-  enumeratePublicSymbols(file, symbols, opts);
+  enumeratePublicSymbols(file, symbols, opts, cache);
 
   return validateSymbolSet(file->getParentModule()->getASTContext().Diags,
                            symbols, IRModule, diagnoseExtraSymbolsInTBD);
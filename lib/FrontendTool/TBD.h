@@ -24,13 +24,17 @@ class ModuleDecl;
 class FileUnit;
 class FrontendOptions;
 struct TBDGenOptions;
+struct TBDSymbolCache;
 
-bool writeTBD(ModuleDecl *M, StringRef OutputFilename, TBDGenOptions &Opts);
+bool writeTBD(ModuleDecl *M, StringRef OutputFilename, TBDGenOptions &Opts,
+              TBDSymbolCache *Cache = nullptr);
 bool inputFileKindCanHaveTBDValidated(InputFileKind kind);
 bool validateTBD(ModuleDecl *M, llvm::Module &IRModule, TBDGenOptions &opts,
-                 bool diagnoseExtraSymbolsInTBD);
+                 bool diagnoseExtraSymbolsInTBD,
+                 TBDSymbolCache *cache = nullptr);
 bool validateTBD(FileUnit *M, llvm::Module &IRModule, TBDGenOptions &opts,
-                 bool diagnoseExtraSymbolsInTBD);
+                 bool diagnoseExtraSymbolsInTBD,
+                 TBDSymbolCache *cache = nullptr);
 }
 
 #endif
@@ -261,7 +261,9 @@ void getSwiftDocKeyword(const Decl* D, CommandWordsPairs &Words) {
   }
   if (!Interested)
     return;
-  static swift::markup::MarkupContext MC;
+  // The result sink copies out anything extracted from the doc comment, so
+  // the markup arena only needs to live for this one decl.
+  swift::markup::MarkupContext MC;
   auto DC = getSingleDocComment(MC, D);
   if (!DC.hasValue())
     return;
@@ -854,7 +856,13 @@ static ArrayRef<std::pair<StringRef, StringRef>> copyStringPairArray(
     ArrayRef<std::pair<StringRef, StringRef>> Arr) {
   std::pair<StringRef, StringRef> *Buff = Allocator.Allocate<std::pair<StringRef,
     StringRef>>(Arr.size());
-  std::copy(Arr.begin(), Arr.end(), Buff);
+  // Copy the string bytes as well: the input pairs may point into a
+  // MarkupContext arena that does not outlive the result sink.
+  std::transform(Arr.begin(), Arr.end(), Buff,
+                 [&](const std::pair<StringRef, StringRef> &P) {
+    return std::make_pair(copyString(Allocator, P.first),
+                          copyString(Allocator, P.second));
+  });
   return llvm::makeArrayRef(Buff, Arr.size());
 }
 
@@ -16,6 +16,7 @@
 #include "llvm/ADT/Hashing.h"
 #include "llvm/Support/EndianStream.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 
@@ -100,7 +101,26 @@ CodeCompletionCache::~CodeCompletionCache() {}
 ///
 /// This should be incremented any time we commit a change to the format of the
 /// cached results. This isn't expected to change very often.
-static constexpr uint32_t onDiskCompletionCacheVersion = 1;
+static constexpr uint32_t onDiskCompletionCacheVersion =
+    2; // Added module content hash.
+
+/// Hashes the contents of the module file at \p filename, or returns 0 if it
+/// cannot be read.
+///
+/// The hash lets cached results be validated against a byte-identical module
+/// whose modification time differs, which is what makes cache files sharable
+/// between sessions and between machines with the same SDK.
+static uint64_t hashModuleFile(StringRef filename) {
+  auto buffer = llvm::MemoryBuffer::getFile(filename);
+  if (!buffer)
+    return 0;
+
+  llvm::MD5 hash;
+  hash.update((*buffer)->getBuffer());
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  return result.low();
+}
 
 static StringRef copyString(llvm::BumpPtrAllocator &Allocator, StringRef Str) {
   char *Mem = Allocator.Allocate<char>(Str.size());
@@ -149,13 +169,23 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
     auto mtime = llvm::support::endian::read64le(cursor);
     cursor += sizeof(mtime);
 
-    // Check the module file's last modification time.
+    auto contentHash = llvm::support::endian::read64le(cursor);
+    cursor += sizeof(contentHash);
+
+    // Check the module file's last modification time, and fall back to its
+    // content hash. The hash check is what lets a cache file produced by
+    // another session or another machine validate against a byte-identical
+    // module whose modification time differs.
     if (!allowOutOfDate) {
       llvm::sys::fs::file_status status;
-      if (llvm::sys::fs::status(K.ModuleFilename, status) ||
-          status.getLastModificationTime().time_since_epoch().count() !=
+      if (llvm::sys::fs::status(K.ModuleFilename, status))
+        return false; // Module doesn't exist.
+      if (status.getLastModificationTime().time_since_epoch().count() !=
           std::chrono::nanoseconds(mtime).count()) {
-        return false; // Out of date, or doesn't exist.
+        if (contentHash == 0 ||
+            contentHash != hashModuleFile(K.ModuleFilename)) {
+          return false; // Out of date.
+        }
       }
     }
   }
@@ -270,6 +300,8 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
 ///   HEADER
 ///     * version, which **must be bumped** if we change the format!
 ///     * mtime for the module file
+///     * hash of the module file contents, for validating the cache against
+///       an identical module with a different mtime
 ///
 ///   KEY
 ///     * the original CodeCompletionCache::Key, used for debugging the cache.
@@ -296,6 +328,7 @@ static void writeCachedModule(llvm::raw_ostream &out,
   LE.write(onDiskCompletionCacheVersion);           // Version
   auto mtime = V.ModuleModificationTime.time_since_epoch().count();
   LE.write(mtime);                                  // Mtime for module file
+  LE.write(hashModuleFile(K.ModuleFilename));       // Module content hash
 
   // KEY
   // We don't need the stored key to load the results, but it is useful if we
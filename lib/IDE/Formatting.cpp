@@ -665,8 +665,28 @@ class FormatWalker : public SourceEntityWalker {
   LangOptions Options;
   TokenIt CurrentTokIt;
   unsigned TargetLine;
+  SourceLoc SiblingSeparator;
   SiblingCollector SCollector;
 
+  /// Finds the comma immediately preceding the target location, if any.
+  /// Sibling alignment only triggers when the target directly follows a
+  /// comma (see SiblingCollector's addPair), so when there is none the
+  /// collector doesn't need to inspect any node at all.
+  SourceLoc findPrecedingComma() {
+    auto After = std::lower_bound(Tokens.begin(), Tokens.end(),
+                                  TargetLocation,
+                                  [&](const Token &Tok, SourceLoc Loc) {
+                                    return SM.isBeforeInBuffer(Tok.getLoc(),
+                                                               Loc);
+                                  });
+    if (After == Tokens.begin())
+      return SourceLoc();
+    auto &Prev = *(After - 1);
+    if (Prev.getKind() != tok::comma)
+      return SourceLoc();
+    return Prev.getLoc();
+  }
+
   /// Sometimes, target is a part of "parent", for instance, "#else" is a part
   /// of an IfConfigDecl, so that IfConfigDecl is not really the parent of "#else".
   bool isTargetPartOf(swift::ASTWalker::ParentTy Parent) {
@@ -689,7 +709,12 @@ class FormatWalker : public SourceEntityWalker {
   template <class T>
   bool HandlePre(T* Node, SourceLoc Start, SourceLoc End) {
     scanForComments(Start);
-    SCollector.collect(Node);
+    // The separator comma matched by the collector lies after one of the
+    // node's elements, so nodes starting after it can never produce a
+    // sibling.
+    if (SiblingSeparator.isValid() &&
+        !SM.isBeforeInBuffer(SiblingSeparator, Start))
+      SCollector.collect(Node);
 
     if (SM.isBeforeInBuffer(TargetLocation, Start))
       return false; // Target is before start of Node, skip it.
@@ -748,6 +773,7 @@ public:
     Stack.clear();
     TargetLocation = Loc;
     TargetLine = SM.getLineNumber(TargetLocation);
+    SiblingSeparator = findPrecedingComma();
     AtStart = AtEnd = swift::ASTWalker::ParentTy();
     walk(SF);
     scanForComments(SourceLoc());
@@ -3167,6 +3167,18 @@ resolveRenameLocations(ArrayRef<RenameLoc> RenameLocs, SourceFile &SF,
   return Resolver.resolve(UnresolvedLocs, SF.getAllTokens());
 }
 
+// Note on batching and parallelism: module-wide rename is deliberately not
+// driven from here. The entry points below operate on a single SourceFile;
+// the cross-file fan-out lives in the client, which resolves occurrences
+// from the index and issues one syntactic rename request per affected file.
+// That is also where parallelism belongs: each request parses its file into
+// its own CompilerInstance, so independent files can be processed on
+// independent threads or processes with no shared mutable state. Within this
+// module the SourceFiles of a ModuleDecl share an ASTContext, SourceManager
+// and DiagnosticEngine, none of which tolerate concurrent access, so walking
+// several files of one compiler instance from multiple threads is not an
+// option. Per file the work is already batched: a single NameMatcher pass
+// over the token stream resolves every occurrence at once.
 int swift::ide::syntacticRename(SourceFile *SF, ArrayRef<RenameLoc> RenameLocs,
                                 SourceEditConsumer &EditConsumer,
                                 DiagnosticConsumer &DiagConsumer) {
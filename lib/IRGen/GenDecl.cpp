@@ -2288,6 +2288,27 @@ static bool isReadOnlyFunction(SILFunction *f) {
   return false;
 }
 
+/// Return True if the SIL @_effects attribute of the function \p f guarantees
+/// that it never releases any reference. This mirrors the interpretation of
+/// the attribute in SideEffectAnalysis: readnone and readonly subsume
+/// releasenone, but an 'owned' parameter is consumed by the callee, which may
+/// run a deinit and release arbitrary references.
+static bool isReleaseNoneFunction(SILFunction *f) {
+  if (f->hasOwnedParameters())
+    return false;
+
+  switch (f->getEffectsKind()) {
+  case EffectsKind::ReadNone:
+  case EffectsKind::ReadOnly:
+  case EffectsKind::ReleaseNone:
+    return true;
+  case EffectsKind::ReadWrite:
+  case EffectsKind::Unspecified:
+    return false;
+  }
+  llvm_unreachable("bad effects kind");
+}
+
 static clang::GlobalDecl getClangGlobalDeclForFunction(const clang::Decl *decl) {
   if (auto ctor = dyn_cast<clang::CXXConstructorDecl>(decl))
     return clang::GlobalDecl(ctor, clang::Ctor_Complete);
@@ -2378,6 +2399,15 @@ llvm::Function *IRGenModule::getAddrOfSILFunction(SILFunction *f,
                                llvm::AttributeList::FunctionIndex,
                                llvm::Attribute::ReadOnly);
   }
+
+  // Carry the SIL-level guarantee that the function never releases a
+  // reference into LLVM, where the Swift ARC optimizer uses it to move
+  // retains across calls (see isKnownReleaseNone in LLVMARCOpts.h).
+  if (isReleaseNoneFunction(f)) {
+    attrs = attrs.addAttribute(signature.getType()->getContext(),
+                               llvm::AttributeList::FunctionIndex,
+                               "releasenone");
+  }
   fn = createFunction(*this, link, signature, insertBefore,
                       f->getOptimizationMode());
 
@@ -4367,7 +4397,7 @@ IRGenModule::getAddrOfContinuationPrototype(CanSILFunctionType fnType) {
   llvm::Function *&entry = GlobalFuncs[entity];
   if (entry) return entry;
 
-  auto signature = Signature::forCoroutineContinuation(*this, fnType);
+  auto signature = getCoroutineContinuationSignature(fnType);
   LinkInfo link = LinkInfo::get(*this, entity, NotForDefinition);
   entry = createFunction(*this, link, signature);
   return entry;
@@ -3232,6 +3232,10 @@ namespace {
                                     SILType Type,
                                     EnumDecl *theEnum,
                                     llvm::StructType *enumTy);
+    TypeInfo *applyFixedLayout(TypeConverter &TC,
+                               SILType Type,
+                               llvm::StructType *enumTy,
+                          const IRGenerator::MultiPayloadEnumLayout &layout);
 
     unsigned getNumCaseBits() const {
       return CommonSpareBits.size() - CommonSpareBits.count();
@@ -5867,6 +5871,16 @@ MultiPayloadEnumImplStrategy::completeFixedLayout(TypeConverter &TC,
                                                   SILType Type,
                                                   EnumDecl *theEnum,
                                                   llvm::StructType *enumTy) {
+  // The layout only depends on the canonical type and the target, not on the
+  // IRGenModule. If another module of a multi-threaded compilation already
+  // computed the layout, reuse the result instead of re-running the
+  // spare-bit analysis over the payloads.
+  CanType key = Type.getASTType();
+  if (auto *cachedLayout = TC.IGM.IRGen.getMultiPayloadEnumLayout(key))
+    return applyFixedLayout(TC, Type, enumTy, *cachedLayout);
+
+  IRGenerator::MultiPayloadEnumLayout layout;
+
   // We need tags for each of the payload types, which we may be able to form
   // using spare bits, plus a minimal number of tags with which we can
   // represent the empty cases.
@@ -5876,25 +5890,23 @@ MultiPayloadEnumImplStrategy::completeFixedLayout(TypeConverter &TC,
   // See if the payload types have any spare bits in common.
   // At the end of the loop CommonSpareBits.size() will be the size (in bits)
   // of the largest payload.
-  CommonSpareBits = {};
-  Alignment worstAlignment(1);
-  IsPOD_t isPOD = IsPOD;
-  IsBitwiseTakable_t isBT = IsBitwiseTakable;
-  PayloadSize = 0;
+  layout.WorstAlignment = Alignment(1);
+  layout.POD = IsPOD;
+  layout.BitwiseTakable = IsBitwiseTakable;
   for (auto &elt : ElementsWithPayload) {
     auto &fixedPayloadTI = cast<FixedTypeInfo>(*elt.ti);
-    if (fixedPayloadTI.getFixedAlignment() > worstAlignment)
-      worstAlignment = fixedPayloadTI.getFixedAlignment();
+    if (fixedPayloadTI.getFixedAlignment() > layout.WorstAlignment)
+      layout.WorstAlignment = fixedPayloadTI.getFixedAlignment();
     if (!fixedPayloadTI.isPOD(ResilienceExpansion::Maximal))
-      isPOD = IsNotPOD;
+      layout.POD = IsNotPOD;
     if (!fixedPayloadTI.isBitwiseTakable(ResilienceExpansion::Maximal))
-      isBT = IsNotBitwiseTakable;
+      layout.BitwiseTakable = IsNotBitwiseTakable;
 
     unsigned payloadBytes = fixedPayloadTI.getFixedSize().getValue();
     unsigned payloadBits = fixedPayloadTI.getFixedSize().getValueInBits();
 
-    if (payloadBytes > PayloadSize)
-      PayloadSize = payloadBytes;
+    if (payloadBytes > layout.PayloadSize)
+      layout.PayloadSize = payloadBytes;
 
     // See what spare bits from the payload we can use for layout optimization.
 
@@ -5902,8 +5914,8 @@ MultiPayloadEnumImplStrategy::completeFixedLayout(TypeConverter &TC,
     // if the type is layout-dependent. (Even when the runtime does, it will
     // likely only track a subset of the spare bits.)
     if (!AllowFixedLayoutOptimizations || TIK < Loadable) {
-      if (CommonSpareBits.size() < payloadBits)
-        CommonSpareBits.extendWithClearBits(payloadBits);
+      if (layout.CommonSpareBits.size() < payloadBits)
+        layout.CommonSpareBits.extendWithClearBits(payloadBits);
       continue;
     }
 
@@ -5915,101 +5927,118 @@ MultiPayloadEnumImplStrategy::completeFixedLayout(TypeConverter &TC,
     // they can contain Obj-C tagged pointers. To handle this case
     // correctly, we get spare bits from the unsubstituted type.
     auto &fixedOrigTI = cast<FixedTypeInfo>(*elt.origTI);
-    fixedOrigTI.applyFixedSpareBitsMask(CommonSpareBits);
+    fixedOrigTI.applyFixedSpareBitsMask(layout.CommonSpareBits);
   }
 
-  unsigned commonSpareBitCount = CommonSpareBits.count();
-  unsigned usedBitCount = CommonSpareBits.size() - commonSpareBitCount;
+  unsigned commonSpareBitCount = layout.CommonSpareBits.count();
+  unsigned usedBitCount = layout.CommonSpareBits.size() - commonSpareBitCount;
 
   // Determine how many tags we need to accommodate the empty cases, if any.
   if (ElementsWithNoPayload.empty()) {
-    NumEmptyElementTags = 0;
+    layout.NumEmptyElementTags = 0;
   } else {
     // We can store tags for the empty elements using the inhabited bits with
     // their own tag(s).
     if (usedBitCount >= 32) {
-      NumEmptyElementTags = 1;
+      layout.NumEmptyElementTags = 1;
     } else {
       unsigned emptyElementsPerTag = 1 << usedBitCount;
-      NumEmptyElementTags
+      layout.NumEmptyElementTags
         = (numEmptyElements + (emptyElementsPerTag-1))/emptyElementsPerTag;
     }
   }
 
-  unsigned numTags = numPayloadTags + NumEmptyElementTags;
+  unsigned numTags = numPayloadTags + layout.NumEmptyElementTags;
   unsigned numTagBits = llvm::Log2_32(numTags-1) + 1;
-  ExtraTagBitCount = numTagBits <= commonSpareBitCount
+  layout.ExtraTagBitCount = numTagBits <= commonSpareBitCount
     ? 0 : numTagBits - commonSpareBitCount;
-  NumExtraTagValues =
+  layout.NumExtraTagValues =
       (commonSpareBitCount < 32) ? numTags >> commonSpareBitCount : 0;
 
-  // Create the type. We need enough bits to store the largest payload plus
-  // extra tag bits we need.
-  setTaggedEnumBody(TC.IGM, enumTy,
-                    CommonSpareBits.size(),
-                    ExtraTagBitCount);
-
   // The enum has the worst alignment of its payloads. The size includes the
   // added tag bits.
-  auto sizeWithTag = (CommonSpareBits.size() + 7U)/8U;
-  unsigned extraTagByteCount = (ExtraTagBitCount+7U)/8U;
-  sizeWithTag += extraTagByteCount;
-
-  SpareBitVector spareBits;
+  layout.SizeInBytes = (layout.CommonSpareBits.size() + 7U)/8U;
+  unsigned extraTagByteCount = (layout.ExtraTagBitCount+7U)/8U;
+  layout.SizeInBytes += extraTagByteCount;
 
   // Determine the bits we're going to use for the tag.
-  assert(PayloadTagBits.empty());
 
   // The easiest case is if we're going to use all of the available
   // payload tag bits (plus potentially some extra bits), because we
   // can just straight-up use CommonSpareBits as that bitset.
   if (numTagBits >= commonSpareBitCount) {
-    PayloadTagBits = CommonSpareBits;
+    layout.PayloadTagBits = layout.CommonSpareBits;
 
     // We're using all of the common spare bits as tag bits, so none
     // of them are spare; nor are the extra tag bits.
-    spareBits.appendClearBits(CommonSpareBits.size() + ExtraTagBitCount);
+    layout.SpareBits.appendClearBits(layout.CommonSpareBits.size() +
+                                     layout.ExtraTagBitCount);
 
     // The remaining bits in the extra tag bytes are spare.
-    spareBits.appendSetBits(extraTagByteCount * 8 - ExtraTagBitCount);
+    layout.SpareBits.appendSetBits(extraTagByteCount * 8 -
+                                   layout.ExtraTagBitCount);
 
   // Otherwise, we need to construct a new bitset that doesn't
   // include the bits we aren't using.
   } else {
-    assert(ExtraTagBitCount == 0
+    assert(layout.ExtraTagBitCount == 0
            && "spilled extra tag bits with spare bits available?!");
-    PayloadTagBits =
-      ClusteredBitVector::getConstant(CommonSpareBits.size(), false);
+    layout.PayloadTagBits =
+      ClusteredBitVector::getConstant(layout.CommonSpareBits.size(), false);
 
     // Start the spare bit set using all the common spare bits.
-    spareBits = CommonSpareBits;
+    layout.SpareBits = layout.CommonSpareBits;
 
     // Mark the bits we'll use as occupied in both bitsets.
     // We take bits starting from the most significant.
     unsigned remainingTagBits = numTagBits;
-    for (unsigned bit = CommonSpareBits.size() - 1; true; --bit) {
-      if (!CommonSpareBits[bit]) {
+    for (unsigned bit = layout.CommonSpareBits.size() - 1; true; --bit) {
+      if (!layout.CommonSpareBits[bit]) {
         assert(bit > 0 && "ran out of spare bits?!");
         continue;
       }
 
       // Use this bit as a payload tag bit.
-      PayloadTagBits.setBit(bit);
+      layout.PayloadTagBits.setBit(bit);
 
       // A bit used as a payload tag bit is not a spare bit.
-      spareBits.clearBit(bit);
+      layout.SpareBits.clearBit(bit);
 
       if (--remainingTagBits == 0) break;
       assert(bit > 0 && "ran out of spare bits?!");
     }
-    assert(PayloadTagBits.count() == numTagBits);
+    assert(layout.PayloadTagBits.count() == numTagBits);
   }
-  
+
   applyLayoutAttributes(TC.IGM, Type.getASTType(), /*fixed*/ true,
-                        worstAlignment);
+                        layout.WorstAlignment);
 
-  getFixedEnumTypeInfo(enumTy, Size(sizeWithTag), std::move(spareBits),
-                       worstAlignment, isPOD, isBT);
+  TC.IGM.IRGen.cacheMultiPayloadEnumLayout(key, layout);
+  return applyFixedLayout(TC, Type, enumTy, layout);
+}
+
+TypeInfo *
+MultiPayloadEnumImplStrategy::applyFixedLayout(TypeConverter &TC,
+                                               SILType Type,
+                                               llvm::StructType *enumTy,
+                          const IRGenerator::MultiPayloadEnumLayout &layout) {
+  assert(PayloadTagBits.empty());
+  CommonSpareBits = layout.CommonSpareBits;
+  PayloadTagBits = layout.PayloadTagBits;
+  NumEmptyElementTags = layout.NumEmptyElementTags;
+  PayloadSize = layout.PayloadSize;
+  ExtraTagBitCount = layout.ExtraTagBitCount;
+  NumExtraTagValues = layout.NumExtraTagValues;
+
+  // Create the type. We need enough bits to store the largest payload plus
+  // extra tag bits we need.
+  setTaggedEnumBody(TC.IGM, enumTy,
+                    CommonSpareBits.size(),
+                    ExtraTagBitCount);
+
+  getFixedEnumTypeInfo(enumTy, Size(layout.SizeInBytes), layout.SpareBits,
+                       layout.WorstAlignment, layout.POD,
+                       layout.BitwiseTakable);
   if (TIK >= Loadable &&
       (CopyDestroyKind == Normal || CopyDestroyKind == BitwiseTakable)) {
     computePayloadTypesAndTagType(TC.IGM, *TI, PayloadTypesAndTagType);
@@ -6150,17 +6179,22 @@ const TypeInfo *TypeConverter::convertEnumType(TypeBase *key, CanType type,
 }
 
 void IRGenModule::emitEnumDecl(EnumDecl *theEnum) {
-  if (!IRGen.tryEnableLazyTypeMetadata(theEnum))
+  bool isLazy = IRGen.tryEnableLazyTypeMetadata(theEnum);
+  if (!isLazy)
     emitEnumMetadata(*this, theEnum);
 
   emitNestedTypeDecls(theEnum->getMembers());
 
-  if (shouldEmitOpaqueTypeMetadataRecord(theEnum)) {
-    emitOpaqueTypeMetadataRecord(theEnum);
-    return;
-  }
+  // For a lazy type the reflection metadata is emitted on demand together
+  // with the type metadata.
+  if (!isLazy) {
+    if (shouldEmitOpaqueTypeMetadataRecord(theEnum)) {
+      emitOpaqueTypeMetadataRecord(theEnum);
+      return;
+    }
 
-  emitFieldMetadataRecord(theEnum);
+    emitFieldMetadataRecord(theEnum);
+  }
 
   if (!isResilient(theEnum, ResilienceExpansion::Minimal))
     return;
@@ -991,15 +991,25 @@ void irgen::emitLazyTypeMetadata(IRGenModule &IGM, NominalTypeDecl *type) {
   eraseExistingTypeContextDescriptor(IGM, type);
 
   if (auto sd = dyn_cast<StructDecl>(type)) {
-    return emitStructMetadata(IGM, sd);
+    emitStructMetadata(IGM, sd);
   } else if (auto ed = dyn_cast<EnumDecl>(type)) {
     emitEnumMetadata(IGM, ed);
   } else if (auto pd = dyn_cast<ProtocolDecl>(type)) {
+    // The protocol decl emission already takes care of the reflection
+    // metadata.
     IGM.emitProtocolDecl(pd);
+    return;
   } else {
     llvm_unreachable("should not have enqueued a class decl here!");
   }
 
+  // The reflection metadata of a lazy type is only emitted together with the
+  // type metadata: if the metadata is not needed, the reflection strings are
+  // dead as well and don't have to take up space in the binary.
+  if (IGM.shouldEmitOpaqueTypeMetadataRecord(type))
+    IGM.emitOpaqueTypeMetadataRecord(type);
+  else
+    IGM.emitFieldMetadataRecord(type);
 }
 
 llvm::Constant *
@@ -254,7 +254,14 @@ protected:
 
     var->setSection(section);
 
-    IGM.addUsedGlobal(var);
+    // Nothing references reflection records directly; the runtime discovers
+    // them by scanning their section. Registering them as used pins every
+    // record in the final image. When strippable reflection metadata is
+    // requested, skip the registration so the linker's dead-stripping can
+    // drop the records (and the strings they reference) of types it has
+    // already proved unreferenced.
+    if (!IGM.IRGen.Opts.StrippableReflectionMetadata)
+      IGM.addUsedGlobal(var);
 
     disableAddressSanitizer(IGM, var);
 
@@ -858,16 +858,22 @@ Optional<unsigned> irgen::getPhysicalStructFieldIndex(IRGenModule &IGM,
 }
 
 void IRGenModule::emitStructDecl(StructDecl *st) {
-  if (!IRGen.tryEnableLazyTypeMetadata(st))
+  bool isLazy = IRGen.tryEnableLazyTypeMetadata(st);
+  if (!isLazy)
     emitStructMetadata(*this, st);
 
   emitNestedTypeDecls(st->getMembers());
 
+  // For a lazy type the reflection metadata is emitted on demand together
+  // with the type metadata.
+  if (isLazy)
+    return;
+
   if (shouldEmitOpaqueTypeMetadataRecord(st)) {
     emitOpaqueTypeMetadataRecord(st);
   } else {
     emitFieldMetadataRecord(st);
-  }  
+  }
 }
 
 namespace {
@@ -318,6 +318,14 @@ static void getHashOfModule(MD5::MD5Result &Result, IRGenOptions &Opts,
   // reflected in the llvm module itself.
   HashStream << Opts.getLLVMCodeGenOptionsHash();
 
+  // The target CPU and the feature set are properties of the TargetMachine
+  // and are not reflected in the bitcode of the module. We want to recompile
+  // if an existing object file was produced for a different target
+  // configuration.
+  HashStream << TargetMachine->getTargetTriple().str()
+             << TargetMachine->getTargetCPU()
+             << TargetMachine->getTargetFeatureString();
+
   HashStream.final(Result);
 }
 
@@ -425,6 +433,8 @@ bool swift::performLLVM(IRGenOptions &Opts, DiagnosticEngine *Diags,
         !Opts.PrintInlineTree &&
         !needsRecompile(OutputFilename, HashData, HashGlobal, DiagMutex)) {
       // The llvm IR did not change. We don't need to re-create the object file.
+      if (Stats)
+        Stats->getFrontendCounters().NumLLVMCompilesSkipped++;
       return false;
     }
 
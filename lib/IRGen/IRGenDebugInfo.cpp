@@ -113,6 +113,8 @@ class IRGenDebugInfoImpl : public IRGenDebugInfo {
 
   SILLocation::DebugLoc LastDebugLoc; /// The last location that was emitted.
   const SILDebugScope *LastScope;     /// The scope of that last location.
+  llvm::DebugLoc LastResolvedLoc;     /// The llvm location constructed for
+                                      /// LastDebugLoc and LastScope.
 
   /// Used by pushLoc.
   SmallVector<std::pair<SILLocation::DebugLoc, const SILDebugScope *>, 8>
@@ -1586,6 +1588,15 @@ void IRGenDebugInfoImpl::setCurrentLoc(IRBuilder &Builder,
     }
   }
 
+  // A run of instructions in the same scope with the same source location
+  // resolves to the same llvm location. Reuse the previously constructed one
+  // instead of re-running the file check and rebuilding the inlined-at chain
+  // for every instruction.
+  if (LastResolvedLoc && DS == LastScope && L == LastDebugLoc) {
+    Builder.SetCurrentDebugLocation(LastResolvedLoc);
+    return;
+  }
+
   auto *File = getOrCreateFile(L.Filename);
   if (File->getFilename() != Scope->getFilename()) {
     // We changed files in the middle of a scope. This happens, for
@@ -1606,12 +1617,14 @@ void IRGenDebugInfoImpl::setCurrentLoc(IRBuilder &Builder,
   assert(((!InlinedAt) || (InlinedAt && Scope)) && "inlined w/o scope");
   assert(parentScopesAreSane(DS) && "parent scope sanity check failed");
   auto DL = llvm::DebugLoc::get(L.Line, L.Column, Scope, InlinedAt);
+  LastResolvedLoc = DL;
   Builder.SetCurrentDebugLocation(DL);
 }
 
 void IRGenDebugInfoImpl::clearLoc(IRBuilder &Builder) {
   LastDebugLoc = {};
   LastScope = nullptr;
+  LastResolvedLoc = {};
   Builder.SetCurrentDebugLocation(llvm::DebugLoc());
 }
 
@@ -1621,11 +1634,13 @@ void IRGenDebugInfoImpl::pushLoc() {
   LocationStack.push_back(std::make_pair(LastDebugLoc, LastScope));
   LastDebugLoc = {};
   LastScope = nullptr;
+  LastResolvedLoc = {};
 }
 
 /// Restore the current debug location from the stack.
 void IRGenDebugInfoImpl::popLoc() {
   std::tie(LastDebugLoc, LastScope) = LocationStack.pop_back_val();
+  LastResolvedLoc = {};
 }
 
 void IRGenDebugInfoImpl::setEntryPointLoc(IRBuilder &Builder) {
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "IRGenMangler.h"
+#include "swift/AST/ASTContext.h"
 #include "swift/AST/ExistentialLayout.h"
 #include "swift/AST/IRGenOptions.h"
 #include "swift/Demangling/ManglingMacros.h"
@@ -31,6 +32,24 @@ const char *getManglingForWitness(swift::Demangle::ValueWitnessKind kind) {
   llvm_unreachable("not a function witness");
 }
 
+std::string IRGenMangler::mangleTypeSymbol(Type type, const char *Op) {
+  // Type symbols are mangled over and over for the same types as metadata,
+  // value witness tables and caches are requested; the result only depends
+  // on the type and the operator, so memoize it in the ASTContext.
+  auto &cache = type->getASTContext().MangledTypeSymbols;
+  auto key = std::make_pair(type.getPointer(), StringRef(Op));
+  auto known = cache.find(key);
+  if (known != cache.end())
+    return known->second;
+
+  beginMangling();
+  appendType(type);
+  appendOperator(Op);
+  auto result = finalize();
+  cache[key] = result;
+  return result;
+}
+
 std::string IRGenMangler::mangleValueWitness(Type type, ValueWitness witness) {
   beginMangling();
   appendType(type);
@@ -364,12 +364,7 @@ public:
                                               const SymbolicMangling &mangling);
 protected:
 
-  std::string mangleTypeSymbol(Type type, const char *Op) {
-    beginMangling();
-    appendType(type);
-    appendOperator(Op);
-    return finalize();
-  }
+  std::string mangleTypeSymbol(Type type, const char *Op);
 
   std::string mangleNominalTypeSymbol(const NominalTypeDecl *Decl,
                                       const char *Op) {
@@ -254,6 +254,94 @@ private:
   /// appear in the translation unit.
   llvm::DenseMap<SILFunction*, unsigned> FunctionOrder;
 
+public:
+  /// The fixed layout of a multi-payload enum, in a form which does not
+  /// reference a specific LLVMContext.
+  ///
+  /// The layout only depends on the canonical enum type and the target, so
+  /// in multi-threaded compilation it is computed once and shared by all
+  /// IRGenModules instead of re-running the spare-bit analysis over the
+  /// payloads for every module which lowers the enum.
+  struct MultiPayloadEnumLayout {
+    /// The spare bits shared by all payloads.
+    SpareBitVector CommonSpareBits;
+
+    /// The common spare bits actually used for a tag in the payload area.
+    SpareBitVector PayloadTagBits;
+
+    /// The spare bits of the enum itself.
+    SpareBitVector SpareBits;
+
+    /// The number of tag values used for no-payload cases.
+    unsigned NumEmptyElementTags = 0;
+
+    /// The payload size in bytes.
+    unsigned PayloadSize = 0;
+
+    /// The number of extra tag bits outside of the payload required.
+    unsigned ExtraTagBitCount = 0;
+
+    /// The number of possible values for the extra tag bits that are used.
+    unsigned NumExtraTagValues = 0;
+
+    /// The size of the enum in bytes, including the tag.
+    unsigned SizeInBytes = 0;
+
+    /// The alignment of the enum, with layout attributes applied.
+    Alignment WorstAlignment;
+
+    IsPOD_t POD = IsNotPOD;
+    IsBitwiseTakable_t BitwiseTakable = IsNotBitwiseTakable;
+  };
+
+  /// The fixed layout of a non-heap aggregate, in a form which does not
+  /// reference a specific LLVMContext.
+  ///
+  /// Like MultiPayloadEnumLayout, this only depends on the canonical type
+  /// and the target and is shared by all IRGenModules of a multi-threaded
+  /// compilation, so that the layout algorithm, including the concatenation
+  /// of the field spare-bit masks, runs only once per type.
+  struct FixedStructLayout {
+    struct Field {
+      /// The offset of the field in bytes from the start of the aggregate.
+      unsigned ByteOffset;
+
+      /// The index of the field in the LLVM struct, if it has storage.
+      unsigned Index;
+
+      /// The ElementLayout::Kind of the field.
+      uint8_t Kind;
+
+      /// Whether the field is POD (an IsPOD_t value).
+      uint8_t POD;
+    };
+
+    /// The layouts of the fields, parallel to the stored properties.
+    SmallVector<Field, 8> Fields;
+
+    /// The spare bits of the aggregate.
+    SpareBitVector SpareBits;
+
+    /// The size of the aggregate in bytes.
+    unsigned SizeInBytes = 0;
+
+    /// The alignment of the aggregate.
+    Alignment Align;
+
+    IsPOD_t POD = IsNotPOD;
+    IsBitwiseTakable_t BitwiseTakable = IsNotBitwiseTakable;
+    IsFixedSize_t AlwaysFixedSize = IsNotFixedSize;
+  };
+
+private:
+  /// The fixed layouts of multi-payload enums, keyed on the canonical enum
+  /// type and shared by all IRGenModules of this compilation.
+  llvm::DenseMap<CanType, MultiPayloadEnumLayout> MultiPayloadEnumLayouts;
+
+  /// The fixed layouts of non-heap aggregates, keyed on the canonical type
+  /// and shared by all IRGenModules of this compilation.
+  llvm::DenseMap<CanType, FixedStructLayout> FixedStructLayouts;
+
   /// The queue of IRGenModules for multi-threaded compilation.
   SmallVector<IRGenModule *, 8> Queue;
 
@@ -298,7 +386,37 @@ public:
   }
   
   bool hasMultipleIGMs() const { return GenModules.size() >= 2; }
-  
+
+  /// Returns the cached layout of the multi-payload enum type \p ty, or null
+  /// if no module of this compilation computed the layout yet.
+  const MultiPayloadEnumLayout *getMultiPayloadEnumLayout(CanType ty) const {
+    auto found = MultiPayloadEnumLayouts.find(ty);
+    if (found == MultiPayloadEnumLayouts.end())
+      return nullptr;
+    return &found->second;
+  }
+
+  /// Caches the layout of the multi-payload enum type \p ty so that other
+  /// modules of this compilation can reuse it.
+  void cacheMultiPayloadEnumLayout(CanType ty, MultiPayloadEnumLayout layout) {
+    MultiPayloadEnumLayouts.try_emplace(ty, std::move(layout));
+  }
+
+  /// Returns the cached layout of the non-heap aggregate type \p ty, or null
+  /// if no module of this compilation computed the layout yet.
+  const FixedStructLayout *getFixedStructLayout(CanType ty) const {
+    auto found = FixedStructLayouts.find(ty);
+    if (found == FixedStructLayouts.end())
+      return nullptr;
+    return &found->second;
+  }
+
+  /// Caches the layout of the non-heap aggregate type \p ty so that other
+  /// modules of this compilation can reuse it.
+  void cacheFixedStructLayout(CanType ty, FixedStructLayout layout) {
+    FixedStructLayouts.try_emplace(ty, std::move(layout));
+  }
+
   llvm::DenseMap<SourceFile *, IRGenModule *>::iterator begin() {
     return GenModules.begin();
   }
@@ -1105,6 +1223,7 @@ public:
   void finishEmitAfterTopLevel();
 
   Signature getSignature(CanSILFunctionType fnType);
+  Signature getCoroutineContinuationSignature(CanSILFunctionType fnType);
   llvm::FunctionType *getFunctionType(CanSILFunctionType type,
                                       llvm::AttributeList &attrs,
                                       ForeignFunctionInfo *foreignInfo=nullptr);
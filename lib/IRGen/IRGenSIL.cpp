@@ -2722,7 +2722,7 @@ void IRGenSILFunction::visitAbortApplyInst(AbortApplyInst *i) {
 void IRGenSILFunction::visitEndApply(BeginApplyInst *i, bool isAbort) {
   const auto &coroutine = getLoweredCoroutine(i->getTokenResult());
 
-  auto sig = Signature::forCoroutineContinuation(IGM, i->getOrigCalleeType());
+  auto sig = IGM.getCoroutineContinuationSignature(i->getOrigCalleeType());
 
   // Cast the continuation pointer to the right function pointer type.
   auto continuation = coroutine.Continuation;
@@ -5418,12 +5418,34 @@ void IRGenSILFunction::visitWitnessMethodInst(swift::WitnessMethodInst *i) {
     return;
   }
 
+  // If the witness table of a concrete conformance is defined in this
+  // module, the conformance set is closed and the dispatch target is
+  // statically known: reference the witness function directly instead of
+  // loading it from the witness table. This catches the sites the SIL
+  // devirtualizer could not rewrite, e.g. inside serialized functions whose
+  // witnesses have non-public linkage.
+  if (conformance.isConcrete()) {
+    auto found =
+        IGM.getSILModule().lookUpFunctionInWitnessTable(conformance, member);
+    SILFunction *witness = found.first;
+    if (witness && witness->isDefinition()) {
+      auto fnType = IGM.getSILTypes().getConstantFunctionType(member);
+      auto sig = IGM.getSignature(fnType);
+      llvm::Constant *fnPtr = IGM.getAddrOfSILFunction(witness,
+                                                       NotForDefinition);
+      fnPtr = llvm::ConstantExpr::getBitCast(fnPtr,
+                                             sig.getType()->getPointerTo());
+      setLoweredFunctionPointer(i, FunctionPointer::forDirect(fnPtr, sig));
+      return;
+    }
+  }
+
   // It would be nice if this weren't discarded.
   llvm::Value *baseMetadataCache = nullptr;
 
   auto fn = emitWitnessMethodValue(*this, baseTy, &baseMetadataCache,
                                    member, conformance);
-  
+
   setLoweredFunctionPointer(i, fn);
 }
 
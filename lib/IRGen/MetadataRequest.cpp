@@ -1309,6 +1309,14 @@ void irgen::emitLazyCacheAccessFunction(IRGenModule &IGM,
   bool returnsResponse =
     (accessor->getReturnType() == IGM.TypeMetadataResponseTy);
 
+  // The accessor is the shared copy of the acquisition sequence: one cache
+  // check plus a slow path, duplicated across potentially hundreds of call
+  // sites if the optimizer decides to inline it. Keep it outlined to reduce
+  // code size and icache pressure; the call is cheap compared to the cached
+  // load it guards.
+  if (cacheVariable)
+    accessor->addFnAttr(llvm::Attribute::NoInline);
+
   // If there's no cache variable, just perform the direct access.
   if (cacheVariable == nullptr) {
     auto response = getValue(IGF, parameters);
@@ -19,6 +19,7 @@
 #include "llvm/IR/DerivedTypes.h"
 #include "swift/AST/ASTContext.h"
 #include "swift/AST/DiagnosticsIRGen.h"
+#include "swift/Basic/Range.h"
 
 #include "FixedTypeInfo.h"
 #include "IRGenFunction.h"
@@ -38,6 +39,57 @@ static bool requiresHeapHeader(LayoutKind kind) {
   llvm_unreachable("bad layout kind!");
 }
 
+/// Complete the given element layouts from a layout which was already
+/// computed by another IRGenModule of this compilation, and build the
+/// corresponding LLVM struct body, including any padding fields.
+static llvm::Type *
+applyFixedStructLayout(IRGenModule &IGM,
+                       const IRGenerator::FixedStructLayout &fixed,
+                       llvm::MutableArrayRef<ElementLayout> elements,
+                       llvm::StructType *typeToFill) {
+  SmallVector<llvm::Type*, 8> structFields;
+  Size curSize(0);
+
+  assert(fixed.Fields.size() == elements.size());
+  for (unsigned i : indices(elements)) {
+    auto &elt = elements[i];
+    auto &field = fixed.Fields[i];
+    switch (ElementLayout::Kind(field.Kind)) {
+    case ElementLayout::Kind::Empty:
+      elt.completeEmpty(IsPOD_t(field.POD), Size(field.ByteOffset));
+      break;
+    case ElementLayout::Kind::Fixed: {
+      // Re-insert the padding which the layout algorithm placed in front of
+      // the field.
+      Size offset(field.ByteOffset);
+      if (offset > curSize) {
+        auto paddingTy = llvm::ArrayType::get(IGM.Int8Ty,
+                                              (offset - curSize).getValue());
+        structFields.push_back(paddingTy);
+      }
+      assert(field.Index == structFields.size() &&
+             "cached layout does not match the field storage types");
+      elt.completeFixed(IsPOD_t(field.POD), offset, structFields.size());
+      structFields.push_back(elt.getTypeForLayout().getStorageType());
+      curSize = offset +
+        cast<FixedTypeInfo>(elt.getTypeForLayout()).getFixedSize();
+      break;
+    }
+    case ElementLayout::Kind::NonFixed:
+    case ElementLayout::Kind::InitialNonFixedSize:
+      llvm_unreachable("only fixed layouts are cached");
+    }
+  }
+  assert(curSize == Size(fixed.SizeInBytes));
+
+  if (typeToFill) {
+    typeToFill->setBody(structFields, /*isPacked*/ true);
+    return typeToFill;
+  }
+  return llvm::StructType::get(IGM.getLLVMContext(), structFields,
+                               /*isPacked*/ true);
+}
+
 /// Perform structure layout on the given types.
 StructLayout::StructLayout(IRGenModule &IGM, CanType astTy,
                            LayoutKind layoutKind,
@@ -53,6 +105,26 @@ StructLayout::StructLayout(IRGenModule &IGM, CanType astTy,
 
   assert(typeToFill == nullptr || typeToFill->isOpaque());
 
+  // The layout of a fixed-size non-heap aggregate only depends on the
+  // canonical type and the target, not on the IRGenModule. If another module
+  // of a multi-threaded compilation already computed the layout, reuse the
+  // result instead of re-running the layout algorithm.
+  bool isCacheable = astTy && layoutKind == LayoutKind::NonHeapObject;
+  if (isCacheable) {
+    if (auto *fixed = IGM.IRGen.getFixedStructLayout(astTy)) {
+      Ty = applyFixedStructLayout(IGM, *fixed, Elements, typeToFill);
+      MinimumAlign = fixed->Align;
+      MinimumSize = Size(fixed->SizeInBytes);
+      SpareBits = fixed->SpareBits;
+      IsFixedLayout = true;
+      IsKnownPOD = fixed->POD;
+      IsKnownBitwiseTakable = fixed->BitwiseTakable;
+      IsKnownAlwaysFixedSize = fixed->AlwaysFixedSize;
+      assert(typeToFill == nullptr || Ty == typeToFill);
+      return;
+    }
+  }
+
   StructLayoutBuilder builder(IGM);
 
   // Add the heap header if necessary.
@@ -100,6 +172,30 @@ StructLayout::StructLayout(IRGenModule &IGM, CanType astTy,
   assert(typeToFill == nullptr || Ty == typeToFill);
   if (ASTTy)
     applyLayoutAttributes(IGM, ASTTy, IsFixedLayout, MinimumAlign);
+
+  // Publish the layout for the other modules of the compilation. Only
+  // non-empty fixed layouts are worth sharing; the empty case is cheap to
+  // recompute.
+  if (isCacheable && nonEmpty && IsFixedLayout) {
+    IRGenerator::FixedStructLayout fixed;
+    fixed.Fields.reserve(Elements.size());
+    for (auto &elt : Elements) {
+      IRGenerator::FixedStructLayout::Field field;
+      field.Kind = uint8_t(elt.getKind());
+      field.POD = uint8_t(elt.isPOD());
+      field.ByteOffset = elt.getByteOffset().getValue();
+      field.Index = elt.getKind() == ElementLayout::Kind::Fixed
+                      ? elt.getStructIndex() : 0;
+      fixed.Fields.push_back(field);
+    }
+    fixed.SpareBits = SpareBits;
+    fixed.SizeInBytes = MinimumSize.getValue();
+    fixed.Align = MinimumAlign;
+    fixed.POD = IsKnownPOD;
+    fixed.BitwiseTakable = IsKnownBitwiseTakable;
+    fixed.AlwaysFixedSize = IsKnownAlwaysFixedSize;
+    IGM.IRGen.cacheFixedStructLayout(ASTTy, std::move(fixed));
+  }
 }
 
 void irgen::applyLayoutAttributes(IRGenModule &IGM,
@@ -153,8 +153,13 @@ SwiftTargetInfo SwiftTargetInfo::get(IRGenModule &IGM) {
   // which exposes a barrier-free inline path with -1 as the "done" value.
   if (triple.isOSDarwin())
     target.OnceDonePredicateValue = -1L;
-  // Other platforms use std::call_once() and we don't
-  // assume that they have a barrier-free inline fast path.
+  // Elsewhere the runtime implements "once" over a word-sized predicate
+  // that it sets to all-ones with release ordering when initialization
+  // completes, so the same inline check applies.  Cygwin's legacy
+  // implementation has no barrier-free "done" state, so we make no
+  // assumption there.
+  else if (!triple.isWindowsCygwinEnvironment())
+    target.OnceDonePredicateValue = -1L;
   
   switch (triple.getArch()) {
   case llvm::Triple::x86_64:
@@ -26,18 +26,24 @@
 #include "swift/AST/Module.h"
 #include "swift/Basic/LLVM.h"
 #include "swift/Basic/LLVMContext.h"
+#include "swift/Basic/Version.h"
 #include "swift/Frontend/Frontend.h"
 #include "swift/IRGen/IRGenPublic.h"
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/Config/config.h"
 #include "llvm/ExecutionEngine/MCJIT.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/IR/DiagnosticPrinter.h"
 #include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/Linker/Linker.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 
 #if defined(_WIN32)
@@ -278,6 +284,88 @@ bool swift::immediate::IRGenImportedModules(
   return hadError;
 }
 
+namespace {
+/// An on-disk cache for immediate-mode object code.
+///
+/// The execution engine consults the cache before optimizing and compiling a
+/// module and writes the resulting object back afterwards, so re-running an
+/// unchanged script skips LLVM optimization and codegen entirely.
+class ImmediateObjectCache : public llvm::ObjectCache {
+  /// The directory holding cached objects; empty if no user cache directory
+  /// is available, in which case caching is disabled.
+  llvm::SmallString<128> CacheDir;
+
+  /// State hashed alongside the module's bitcode: the compiler version and
+  /// the target configuration, which influence codegen but are not part of
+  /// the bitcode itself.
+  std::string Salt;
+
+public:
+  ImmediateObjectCache(const ASTContext &Context, StringRef Triple,
+                       StringRef CPU, ArrayRef<std::string> Features) {
+    if (llvm::sys::path::user_cache_directory(CacheDir, "org.swift.immediate"))
+      if (llvm::sys::fs::create_directories(CacheDir))
+        CacheDir.clear();
+
+    llvm::raw_string_ostream OS(Salt);
+    OS << version::getSwiftFullVersion(
+              Context.LangOpts.EffectiveLanguageVersion)
+       << Triple << CPU;
+    for (const std::string &Feature : Features)
+      OS << Feature;
+    OS.flush();
+  }
+
+  bool isUsable() const { return !CacheDir.empty(); }
+
+  void notifyObjectCompiled(const llvm::Module *M,
+                            llvm::MemoryBufferRef Obj) override {
+    llvm::SmallString<128> Path;
+    getCacheFilename(M, Path);
+    std::error_code EC;
+    llvm::raw_fd_ostream OS(Path, EC, llvm::sys::fs::F_None);
+    if (EC)
+      return;
+    OS << Obj.getBuffer();
+    DEBUG(llvm::dbgs() << "Cached object code in " << Path << '\n');
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer>
+  getObject(const llvm::Module *M) override {
+    llvm::SmallString<128> Path;
+    getCacheFilename(M, Path);
+    auto Buffer = llvm::MemoryBuffer::getFile(Path);
+    if (!Buffer)
+      return nullptr;
+    DEBUG(llvm::dbgs() << "Using cached object code from " << Path << '\n');
+    return std::move(*Buffer);
+  }
+
+private:
+  /// Computes the path of the cached object for \p M: the MD5 hash of the
+  /// module's bitcode and the salt, in the cache directory.
+  void getCacheFilename(const llvm::Module *M, SmallVectorImpl<char> &Path) {
+    llvm::SmallString<1024> Bitcode;
+    {
+      llvm::raw_svector_ostream BitcodeStream(Bitcode);
+      llvm::WriteBitcodeToFile(M, BitcodeStream);
+    }
+
+    llvm::MD5 Hash;
+    Hash.update(Bitcode);
+    Hash.update(Salt);
+    llvm::MD5::MD5Result Result;
+    Hash.final(Result);
+    llvm::SmallString<32> HashString;
+    llvm::MD5::stringifyResult(Result, HashString);
+    HashString += ".o";
+
+    Path.assign(CacheDir.begin(), CacheDir.end());
+    llvm::sys::path::append(Path, HashString);
+  }
+};
+} // end anonymous namespace
+
 int swift::RunImmediately(CompilerInstance &CI, const ProcessCmdLine &CmdLine,
                           IRGenOptions &IRGenOpts, const SILOptions &SILOpts) {
   ASTContext &Context = CI.getASTContext();
@@ -360,6 +448,12 @@ int swift::RunImmediately(CompilerInstance &CI, const ProcessCmdLine &CmdLine,
     return -1;
   }
 
+  // Let the engine reuse object code from previous runs of the same script,
+  // so warm startups skip LLVM optimization and codegen.
+  ImmediateObjectCache ObjectCache(Context, Triple, CPU, Features);
+  if (ObjectCache.isUsable())
+    EE->setObjectCache(&ObjectCache);
+
   DEBUG(llvm::dbgs() << "Module to be executed:\n";
         Module->dump());
 
@@ -271,6 +271,15 @@ StringRef StdlibGroupsIndexRecordingConsumer::findGroupForSymbol(const IndexSymb
   llvm_unreachable("did not find group name for reference");
 }
 
+// Record and unit files are written synchronously at the end of the job.
+// Deferring them to a background thread that overlaps LLVM codegen is not
+// an option with the current structure: write failures are reported through
+// the frontend's unsynchronized DiagnosticEngine, which codegen is using
+// concurrently, and the store layout is owned by clang's IndexRecordWriter
+// and IndexUnitWriter, so the directory operations cannot be batched from
+// this side. The cost of small repeated writes is already bounded, though:
+// record files are content-addressed by hashRecord() and an unchanged
+// record is skipped via Result::AlreadyExists rather than rewritten.
 static bool writeRecord(SymbolTracker &record, std::string Filename,
                         std::string indexStorePath, DiagnosticEngine *diags,
                         std::string &outRecordFile) {
@@ -721,6 +730,16 @@ bool index::indexAndRecord(ModuleDecl *module,
 #endif
 
   // Write a unit for each source file.
+  //
+  // Indexing the files of this loop concurrently keeps being suggested since
+  // the walks are nominally read-only over a type-checked AST. They are not:
+  // SourceEntityWalker triggers lazy member loading and type resolution
+  // through the ClangImporter, USR generation allocates canonical types in
+  // the shared ASTContext's arenas, and the DiagnosticEngine and
+  // clang::FileManager used for record/unit writing are all unsynchronized.
+  // Until the AST supports concurrent lazy resolution, the way to index in
+  // parallel is the one that already exists: non-WMO builds run one frontend
+  // job per primary file and each job indexes only its own file.
   unsigned unitIndex = 0;
   for (auto *F : module->getFiles()) {
     if (auto *SF = dyn_cast<SourceFile>(F)) {
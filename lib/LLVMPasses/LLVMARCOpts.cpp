@@ -496,6 +496,14 @@ static bool performLocalRetainMotion(CallInst &Retain, BasicBlock &BB,
           isa<MemIntrinsic>(CurInst))
         break;
 
+      // A call known to never release any reference can't hit the retained
+      // object's reference count, so the retain can move past it. The object
+      // stays alive over the call either way: the reference the retain is
+      // copying from still holds it.
+      if (auto *CI = dyn_cast<CallInst>(&CurInst))
+        if (isKnownReleaseNone(*CI))
+          break;
+
       // CurInst->dump(); BBI->dump();
       // Otherwise, we get to something unknown/unhandled.  Bail out for now.
       goto OutOfLoop;
@@ -57,5 +57,13 @@ inline RT_Kind classifyInstruction(const llvm::Instruction &I) {
     .Default(RT_Unknown);
 }
 
+/// isKnownReleaseNone - Returns true if \p CI is a call which provably never
+/// releases any reference. IRGen lowers the corresponding SIL @_effects
+/// guarantee to the "releasenone" string attribute on the callee, which is
+/// how effect information survives into the LLVM-level ARC optimizer.
+inline bool isKnownReleaseNone(const llvm::CallInst &CI) {
+  return CI.hasFnAttr("releasenone");
+}
+
 } // end namespace swift
 #endif
@@ -399,6 +399,14 @@ bool Migrator::emitRemap() const {
 
   auto InputText = States.front()->getOutputText();
   auto OutputText = States.back()->getOutputText();
+  if (InputText == OutputText) {
+    // No changes were made to this file. Emit an empty replacement map
+    // without running the diff, which is the common case when re-migrating
+    // a mostly-migrated project.
+    FileOS << "[\n]";
+    FileOS.flush();
+    return FileOS.has_error();
+  }
   printRemap(getInputFilename(), InputText, OutputText, FileOS);
 
   FileOS.flush();
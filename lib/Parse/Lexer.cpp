@@ -24,6 +24,7 @@
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/ADT/Twine.h"
 // FIXME: Figure out if this can be migrated to LLVM.
@@ -31,6 +32,12 @@
 
 #include <limits>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 using namespace swift;
 using namespace swift::syntax;
 
@@ -221,6 +228,11 @@ Lexer::Lexer(const LangOptions &Options, const SourceManager &SourceMgr,
             RetainComments, TriviaRetention) {
   unsigned EndOffset = SourceMgr.getRangeForBuffer(BufferID).getByteLength();
   initialize(/*Offset=*/0, EndOffset);
+
+  // We are about to walk the whole buffer anyway, so prime the line-start
+  // index now while the buffer is hot; diagnostics and cursor-info requests
+  // later turn SourceLocs into line/column pairs via binary search on it.
+  (void)SourceMgr.getLineStartOffsets(BufferID);
 }
 
 Lexer::Lexer(const LangOptions &Options, const SourceManager &SourceMgr,
@@ -357,8 +369,148 @@ static void diagnoseEmbeddedNul(DiagnosticEngine *Diags, const char *Ptr) {
       .fixItRemoveChars(NulLoc, NulEndLoc);
 }
 
+//===----------------------------------------------------------------------===//
+// Vectorized scanning fast paths
+//===----------------------------------------------------------------------===//
+//
+// Long runs of "boring" bytes -- ASCII identifier characters, spaces, and
+// comment text -- dominate the byte stream of large (often generated) source
+// files.  The helpers below advance over such runs a vector register at a
+// time and hand off to the existing byte-at-a-time loops at the first byte
+// that needs individual attention (a run terminator, a NUL, or a non-ASCII
+// byte that must go through UTF-8 validation).  The helpers only commit whole
+// chunks that are entirely boring, so the scalar loops that follow them see
+// exactly the bytes they would have seen without the fast path.
+
+#if defined(__SSE2__)
+
+/// Advance \p Ptr over 16-byte chunks in which every byte is an ASCII
+/// identifier-continuation character: [A-Za-z0-9_$].
+static const char *fastScanIdentifierBody(const char *Ptr, const char *End) {
+  const __m128i Lower_a = _mm_set1_epi8('a');
+  const __m128i Upper_z = _mm_set1_epi8('z');
+  const __m128i Lower_A = _mm_set1_epi8('A');
+  const __m128i Upper_Z = _mm_set1_epi8('Z');
+  const __m128i Lower_0 = _mm_set1_epi8('0');
+  const __m128i Upper_9 = _mm_set1_epi8('9');
+  const __m128i Under = _mm_set1_epi8('_');
+  const __m128i Dollar = _mm_set1_epi8('$');
+  while (End - Ptr >= 16) {
+    __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+    auto inRange = [&](__m128i Lo, __m128i Hi) {
+      return _mm_and_si128(
+          _mm_cmpeq_epi8(_mm_max_epu8(Chunk, Lo), Chunk),
+          _mm_cmpeq_epi8(_mm_min_epu8(Chunk, Hi), Chunk));
+    };
+    __m128i IsIdent = _mm_or_si128(
+        _mm_or_si128(inRange(Lower_a, Upper_z), inRange(Lower_A, Upper_Z)),
+        _mm_or_si128(inRange(Lower_0, Upper_9),
+                     _mm_or_si128(_mm_cmpeq_epi8(Chunk, Under),
+                                  _mm_cmpeq_epi8(Chunk, Dollar))));
+    if (_mm_movemask_epi8(IsIdent) != 0xFFFF)
+      break;
+    Ptr += 16;
+  }
+  return Ptr;
+}
+
+/// Advance \p Ptr over 16-byte chunks containing no line terminator, no NUL,
+/// and no byte with the high bit set.
+static const char *fastScanToEndOfLine(const char *Ptr, const char *End) {
+  const __m128i LF = _mm_set1_epi8('\n');
+  const __m128i CR = _mm_set1_epi8('\r');
+  const __m128i Nul = _mm_setzero_si128();
+  while (End - Ptr >= 16) {
+    __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+    __m128i Interesting = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(Chunk, LF), _mm_cmpeq_epi8(Chunk, CR)),
+        _mm_cmpeq_epi8(Chunk, Nul));
+    // movemask of Chunk itself picks up any non-ASCII (high bit set) bytes.
+    if (_mm_movemask_epi8(Interesting) | _mm_movemask_epi8(Chunk))
+      break;
+    Ptr += 16;
+  }
+  return Ptr;
+}
+
+/// Advance \p Ptr over 16-byte chunks consisting entirely of \p Byte.
+static const char *fastScanMatchingByte(const char *Ptr, const char *End,
+                                        char Byte) {
+  const __m128i Pattern = _mm_set1_epi8(Byte);
+  while (End - Ptr >= 16) {
+    __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(Chunk, Pattern)) != 0xFFFF)
+      break;
+    Ptr += 16;
+  }
+  return Ptr;
+}
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+static const char *fastScanIdentifierBody(const char *Ptr, const char *End) {
+  while (End - Ptr >= 16) {
+    uint8x16_t Chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+    auto inRange = [&](uint8_t Lo, uint8_t Hi) {
+      return vandq_u8(vcgeq_u8(Chunk, vdupq_n_u8(Lo)),
+                      vcleq_u8(Chunk, vdupq_n_u8(Hi)));
+    };
+    uint8x16_t IsIdent = vorrq_u8(
+        vorrq_u8(inRange('a', 'z'), inRange('A', 'Z')),
+        vorrq_u8(inRange('0', '9'),
+                 vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8('_')),
+                          vceqq_u8(Chunk, vdupq_n_u8('$')))));
+    if (vminvq_u8(IsIdent) == 0)
+      break;
+    Ptr += 16;
+  }
+  return Ptr;
+}
+
+static const char *fastScanToEndOfLine(const char *Ptr, const char *End) {
+  while (End - Ptr >= 16) {
+    uint8x16_t Chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+    uint8x16_t Interesting = vorrq_u8(
+        vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8('\n')),
+                 vceqq_u8(Chunk, vdupq_n_u8('\r'))),
+        vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8(0)),
+                 vcgeq_u8(Chunk, vdupq_n_u8(0x80))));
+    if (vmaxvq_u8(Interesting) != 0)
+      break;
+    Ptr += 16;
+  }
+  return Ptr;
+}
+
+static const char *fastScanMatchingByte(const char *Ptr, const char *End,
+                                        char Byte) {
+  while (End - Ptr >= 16) {
+    uint8x16_t Chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+    if (vminvq_u8(vceqq_u8(Chunk, vdupq_n_u8(Byte))) == 0)
+      break;
+    Ptr += 16;
+  }
+  return Ptr;
+}
+
+#else
+
+// No vector unit available; the scalar loops handle everything.
+static const char *fastScanIdentifierBody(const char *Ptr, const char *) {
+  return Ptr;
+}
+static const char *fastScanToEndOfLine(const char *Ptr, const char *) {
+  return Ptr;
+}
+static const char *fastScanMatchingByte(const char *Ptr, const char *, char) {
+  return Ptr;
+}
+
+#endif
+
 void Lexer::skipToEndOfLine(bool EatNewline) {
   while (1) {
+    CurPtr = fastScanToEndOfLine(CurPtr, BufferEnd);
     switch (*CurPtr++) {
     case '\n':
     case '\r':
@@ -606,16 +758,29 @@ bool Lexer::isOperator(StringRef string) {
 
 
 tok Lexer::kindOfIdentifier(StringRef Str, bool InSILMode) {
-#define SIL_KEYWORD(kw)
-#define KEYWORD(kw) if (Str == #kw) return tok::kw_##kw;
+  // The keyword set is closed, so build the table once and answer each
+  // query with a single hashed probe rather than comparing against every
+  // keyword in turn; this runs for every identifier-shaped token we lex.
+  enum class KeywordMode : uint8_t { Always, SILOnly };
+  static const llvm::StringMap<std::pair<tok, KeywordMode>> Keywords = [] {
+    llvm::StringMap<std::pair<tok, KeywordMode>> table;
+#define SIL_KEYWORD(kw) \
+    table.insert({#kw, {tok::kw_##kw, KeywordMode::SILOnly}});
+#define KEYWORD(kw) \
+    table.insert({#kw, {tok::kw_##kw, KeywordMode::Always}});
 #include "swift/Syntax/TokenKinds.def"
+    return table;
+  }();
+
+  auto known = Keywords.find(Str);
+  if (known == Keywords.end())
+    return tok::identifier;
 
   // SIL keywords are only active in SIL mode.
-  if (InSILMode) {
-#define SIL_KEYWORD(kw) if (Str == #kw) return tok::kw_##kw;
-#include "swift/Syntax/TokenKinds.def"
-  }
-  return tok::identifier;
+  if (known->second.second == KeywordMode::SILOnly && !InSILMode)
+    return tok::identifier;
+
+  return known->second.first;
 }
 
 /// lexIdentifier - Match [a-zA-Z_][a-zA-Z_$0-9]*
@@ -627,7 +792,9 @@ void Lexer::lexIdentifier() {
   (void) didStart;
 
   // Lex [a-zA-Z_$0-9[[:XID_Continue:]]]*
-  while (advanceIfValidContinuationOfIdentifier(CurPtr, BufferEnd));
+  CurPtr = fastScanIdentifierBody(CurPtr, BufferEnd);
+  while (advanceIfValidContinuationOfIdentifier(CurPtr, BufferEnd))
+    CurPtr = fastScanIdentifierBody(CurPtr, BufferEnd);
 
   tok Kind = kindOfIdentifier(StringRef(TokStart, CurPtr-TokStart), InSILMode);
   return formToken(Kind, TokStart);
@@ -2378,12 +2545,24 @@ Restart:
       Pieces.appendOrSquash(TriviaPiece::carriageReturns(1));
     }
     goto Restart;
-  case ' ':
-    Pieces.appendOrSquash(TriviaPiece::spaces(1));
+  case ' ': {
+    // Consume the whole run of spaces at once; indentation of generated code
+    // produces very long runs.
+    const char *SpaceStart = CurPtr - 1;
+    CurPtr = fastScanMatchingByte(CurPtr, BufferEnd, ' ');
+    while (CurPtr < BufferEnd && *CurPtr == ' ')
+      ++CurPtr;
+    Pieces.appendOrSquash(TriviaPiece::spaces(CurPtr - SpaceStart));
     goto Restart;
-  case '\t':
-    Pieces.appendOrSquash(TriviaPiece::tabs(1));
+  }
+  case '\t': {
+    const char *TabStart = CurPtr - 1;
+    CurPtr = fastScanMatchingByte(CurPtr, BufferEnd, '\t');
+    while (CurPtr < BufferEnd && *CurPtr == '\t')
+      ++CurPtr;
+    Pieces.appendOrSquash(TriviaPiece::tabs(CurPtr - TabStart));
     goto Restart;
+  }
   case '\v':
     Pieces.appendOrSquash(TriviaPiece::verticalTabs(1));
     goto Restart;
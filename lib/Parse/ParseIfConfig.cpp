@@ -689,9 +689,19 @@ ParserResult<IfConfigDecl> Parser::parseIfConfig(
         isVersionCondition = false;
       } else if (!foundActive && State->PerformConditionEvaluation) {
         // Evaluate the condition only if we haven't found any active one and
-        // we're not in parse-only mode.
-        isActive = evaluateIfConfigCondition(Condition, Context);
-        isVersionCondition = isVersionIfConfigCondition(Condition);
+        // we're not in parse-only mode. Identically spelled conditions recur
+        // many times in some codebases, so memoize results per context.
+        auto Spelling = extractExprSource(SourceMgr, Condition);
+        auto Memo = Context.IfConfigConditionMemo.find(Spelling);
+        if (Memo != Context.IfConfigConditionMemo.end()) {
+          isActive = Memo->second.first;
+          isVersionCondition = Memo->second.second;
+        } else {
+          isActive = evaluateIfConfigCondition(Condition, Context);
+          isVersionCondition = isVersionIfConfigCondition(Condition);
+          Context.IfConfigConditionMemo[Spelling] = {isActive,
+                                                     isVersionCondition};
+        }
       }
     }
 
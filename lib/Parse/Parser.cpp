@@ -301,6 +301,92 @@ std::vector<Token> swift::tokenize(const LangOptions &LangOpts,
   return Tokens;
 }
 
+/// Rebase \p Old, a token lexed at \p OldOffset in the pre-edit buffer, onto
+/// the post-edit buffer text, shifting its position by \p Delta bytes.
+static Token rebaseToken(const Token &Old, unsigned OldOffset, int64_t Delta,
+                         StringRef NewBuffer) {
+  size_t NewOffset = size_t(int64_t(OldOffset) + Delta);
+  assert(NewOffset + Old.getRawText().size() <= NewBuffer.size() &&
+         "rebased token is outside the post-edit buffer");
+  Token New;
+  New.setToken(Old.getKind(),
+               StringRef(NewBuffer.data() + NewOffset, Old.getRawText().size()),
+               /*CommentLength=*/0, Old.IsMultilineString());
+  New.setAtStartOfLine(Old.isAtStartOfLine());
+  New.setEscapedIdentifier(Old.isEscapedIdentifier());
+  return New;
+}
+
+std::vector<Token> swift::relexTokensAfterEdit(
+    const LangOptions &LangOpts, const SourceManager &SM, unsigned OldBufferID,
+    unsigned NewBufferID, ArrayRef<Token> OldTokens, unsigned EditStart,
+    unsigned EditEnd, unsigned ReplacementLength, DiagnosticEngine *Diags) {
+  assert(EditStart <= EditEnd && "invalid edit range");
+  StringRef NewBuffer = SM.getEntireTextForBuffer(NewBufferID);
+
+  // How far bytes at or after EditEnd moved due to the edit.
+  int64_t Delta = int64_t(ReplacementLength) - int64_t(EditEnd - EditStart);
+
+  // Collect the pre-edit byte offset of every old token.
+  SmallVector<unsigned, 64> OldOffsets;
+  OldOffsets.reserve(OldTokens.size());
+  for (auto &Tok : OldTokens)
+    OldOffsets.push_back(SM.getLocOffsetInBuffer(Tok.getLoc(), OldBufferID));
+
+  // Tokens strictly before the edit are unaffected; a token merely touching
+  // the edit start may merge with the replacement text, so it is re-lexed.
+  size_t FirstAffected = 0;
+  while (FirstAffected < OldTokens.size() &&
+         OldOffsets[FirstAffected] +
+                 OldTokens[FirstAffected].getRawText().size() <
+             EditStart)
+    ++FirstAffected;
+
+  std::vector<Token> NewTokens;
+  NewTokens.reserve(OldTokens.size());
+  for (size_t I = 0; I != FirstAffected; ++I)
+    NewTokens.push_back(
+        rebaseToken(OldTokens[I], OldOffsets[I], /*Delta=*/0, NewBuffer));
+
+  // Re-lex from the start of the first affected token (an exact token
+  // boundary in unchanged text) until we reach a token past the replacement
+  // that aligns with an old token boundary, then splice the old suffix.
+  unsigned RelexStart =
+      FirstAffected < OldTokens.size() ? OldOffsets[FirstAffected] : EditStart;
+  Lexer L(LangOpts, SM, NewBufferID, Diags, /*InSILMode=*/false,
+          CommentRetentionMode::ReturnAsTokens,
+          TriviaRetentionMode::WithoutTrivia, RelexStart, NewBuffer.size());
+
+  while (true) {
+    Token Tok;
+    L.lex(Tok);
+    if (Tok.is(tok::eof))
+      break;
+
+    unsigned NewOffset = SM.getLocOffsetInBuffer(Tok.getLoc(), NewBufferID);
+    if (int64_t(NewOffset) >= int64_t(EditStart) + ReplacementLength) {
+      // Candidate splice point: does an identical old token start here?
+      int64_t OldOffset = int64_t(NewOffset) - Delta;
+      auto It = std::lower_bound(OldOffsets.begin() + FirstAffected,
+                                 OldOffsets.end(), OldOffset);
+      if (It != OldOffsets.end() && int64_t(*It) == OldOffset) {
+        size_t J = It - OldOffsets.begin();
+        const Token &Old = OldTokens[J];
+        if (Old.getKind() == Tok.getKind() &&
+            Old.getRawText().size() == Tok.getRawText().size()) {
+          NewTokens.push_back(Tok);
+          for (size_t K = J + 1; K != OldTokens.size(); ++K)
+            NewTokens.push_back(
+                rebaseToken(OldTokens[K], OldOffsets[K], Delta, NewBuffer));
+          return NewTokens;
+        }
+      }
+    }
+    NewTokens.push_back(Tok);
+  }
+  return NewTokens;
+}
+
 std::vector<std::pair<RC<syntax::RawSyntax>, syntax::AbsolutePosition>>
 swift::tokenizeWithTrivia(const LangOptions &LangOpts, const SourceManager &SM,
                           unsigned BufferID, unsigned Offset,
@@ -312,15 +312,20 @@ void finalizeSourceFile(RootContextData &RootData,
     std::copy(Items.begin(), Items.end(), std::back_inserter(AllTopLevel));
   }
 
+  // Build the remaining nodes in the arena as well; the root and the
+  // top-level item list are the last individually allocated nodes of a parse.
+  SyntaxArena &Arena = RootData.Arena;
   if (!EOFToken)
-    EOFToken = RawSyntax::missing(tok::eof, "");
+    EOFToken = RawSyntax::missing(tok::eof, "", &Arena);
 
   auto newRaw = SyntaxFactory::createRaw(
       SyntaxKind::SourceFile,
       {
-          SyntaxFactory::createRaw(SyntaxKind::CodeBlockItemList, AllTopLevel),
+          SyntaxFactory::createRaw(SyntaxKind::CodeBlockItemList, AllTopLevel,
+                                   &Arena),
           EOFToken,
-      });
+      },
+      &Arena);
   assert(newRaw);
   SF.setSyntaxRoot(make<SourceFileSyntax>(newRaw));
 
@@ -352,13 +357,13 @@ void SyntaxParsingContext::synthesize(tok Kind, StringRef Text) {
     return;
   if (Text.empty())
     Text = getTokenText(Kind);
-  getStorage().push_back(RawSyntax::missing(Kind, Text));
+  getStorage().push_back(RawSyntax::missing(Kind, Text, &getArena()));
 }
 
 void SyntaxParsingContext::synthesize(SyntaxKind Kind) {
   if (!Enabled)
     return;
-  getStorage().push_back(RawSyntax::missing(Kind));
+  getStorage().push_back(RawSyntax::missing(Kind, &getArena()));
 }
 
 void SyntaxParsingContext::dumpStorage() const  {
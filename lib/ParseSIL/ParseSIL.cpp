@@ -61,6 +61,15 @@ public:
   /// A map from textual .sil scope number to SILDebugScopes.
   llvm::DenseMap<unsigned, SILDebugScope *> ScopeSlots;
 
+  /// Caches the result of type checking type annotations, keyed by the
+  /// annotation's source text and the generic environment it was resolved
+  /// against. Compiler-printed SIL repeats the same annotations many times,
+  /// and re-resolving each occurrence dominates parse time on large files.
+  /// SIL type annotations keep their leading '$', so they never collide
+  /// with AST type annotations resolved in formal-type mode.
+  llvm::DenseMap<std::pair<GenericEnvironment *, StringRef>, Type>
+      ParsedTypeCache;
+
   /// Did we parse a sil_stage for this module?
   bool DidParseSILStage = false;
 
@@ -370,6 +379,10 @@ namespace {
     /// \brief Parses the basic block arguments as part of branch instruction.
     bool parseSILBBArgsAtBranch(SmallVector<SILValue, 6> &Args, SILBuilder &B);
 
+    /// \brief Parses the optional profile count annotations of a cond_br.
+    bool parseSILBranchProfileCounts(ProfileCounter &TrueCount,
+                                     ProfileCounter &FalseCount);
+
     bool parseSILLocation(SILLocation &L);
     bool parseScopeRef(SILDebugScope *&DS);
     bool parseSILDebugLocation(SILLocation &L, SILBuilder &B,
@@ -1024,6 +1037,15 @@ bool SILParser::performTypeLocChecking(TypeLoc &T, bool IsSILType,
                                        GenericEnv, DC);
 }
 
+/// Returns the source text of the tokens parsed since \p StartLoc, i.e. up
+/// to the end of the parser's previous token. Used to key the parsed-type
+/// cache.
+static StringRef extractParsedText(Parser &P, SourceLoc StartLoc) {
+  SourceLoc EndLoc = Lexer::getLocForEndOfToken(P.SourceMgr, P.PreviousLoc);
+  return P.SourceMgr.extractText(
+      CharSourceRange(P.SourceMgr, StartLoc, EndLoc));
+}
+
 /// Find the top-level ValueDecl or Module given a name.
 static llvm::PointerUnion<ValueDecl *, ModuleDecl *>
 lookupTopDecl(Parser &P, DeclBaseName Name) {
@@ -1067,19 +1089,29 @@ static ValueDecl *lookupMember(Parser &P, Type Ty, DeclBaseName Name,
 }
 
 bool SILParser::parseASTType(CanType &result, GenericEnvironment *env) {
+  SourceLoc TypeStart = P.Tok.getLoc();
   ParserResult<TypeRepr> parsedType = P.parseType();
   if (parsedType.isNull()) return true;
-  TypeLoc loc = parsedType.get();
-  if (performTypeLocChecking(loc, /*IsSILType=*/ false, env))
-    return true;
+
+  // Check whether we already resolved this annotation in this environment.
+  auto CacheKey = std::make_pair(env ? env : ContextGenericEnv,
+                                 extractParsedText(P, TypeStart));
+  Type ContextTy = TUState.ParsedTypeCache.lookup(CacheKey);
+  if (!ContextTy) {
+    TypeLoc loc = parsedType.get();
+    if (performTypeLocChecking(loc, /*IsSILType=*/ false, env))
+      return true;
+    ContextTy = loc.getType();
+    TUState.ParsedTypeCache[CacheKey] = ContextTy;
+  }
 
   if (env)
-    result = loc.getType()->mapTypeOutOfContext()->getCanonicalType();
+    result = ContextTy->mapTypeOutOfContext()->getCanonicalType();
   else
-    result = loc.getType()->getCanonicalType();
+    result = ContextTy->getCanonicalType();
 
   // Invoke the callback on the parsed type.
-  ParsedTypeCallback(loc.getType());
+  ParsedTypeCallback(ContextTy);
   return false;
 }
 
@@ -1092,6 +1124,7 @@ bool SILParser::parseSILType(SILType &Result,
                              GenericEnvironment *OuterGenericEnv) {
   ParsedGenericEnv = nullptr;
 
+  SourceLoc TypeStart = P.Tok.getLoc();
   if (P.parseToken(tok::sil_dollar, diag::expected_sil_type))
     return true;
 
@@ -1126,31 +1159,36 @@ bool SILParser::parseSILType(SILType &Result,
   class HandleSILGenericParamsWalker : public ASTWalker {
     ASTContext &C;
     SourceFile *SF;
+    bool &HasGenericParams;
   public:
     HandleSILGenericParamsWalker(ASTContext &C,
-                                 SourceFile *SF)
-      : C(C), SF(SF)
+                                 SourceFile *SF,
+                                 bool &HasGenericParams)
+      : C(C), SF(SF), HasGenericParams(HasGenericParams)
     {}
-    
+
     bool walkToTypeReprPre(TypeRepr *T) override {
       if (auto fnType = dyn_cast<FunctionTypeRepr>(T)) {
         if (auto generics = fnType->getGenericParams()) {
           auto env = handleSILGenericParams(C, generics, SF);
           fnType->setGenericEnvironment(env);
+          HasGenericParams = true;
         }
       }
       if (auto boxType = dyn_cast<SILBoxTypeRepr>(T)) {
         if (auto generics = boxType->getGenericParams()) {
           auto env = handleSILGenericParams(C, generics, SF);
           boxType->setGenericEnvironment(env);
+          HasGenericParams = true;
         }
       }
       return true;
     }
   };
 
+  bool HasGenericParams = false;
   TyR.get()
-    ->walk(HandleSILGenericParamsWalker(P.Context, &P.SF));
+    ->walk(HandleSILGenericParamsWalker(P.Context, &P.SF, HasGenericParams));
   
   // Save the top-level function generic environment if there was one.
   if (auto fnType = dyn_cast<FunctionTypeRepr>(TyR.get()))
@@ -1160,14 +1198,30 @@ bool SILParser::parseSILType(SILType &Result,
   // Apply attributes to the type.
   TypeLoc Ty = P.applyAttributeToType(TyR.get(), attrs, specifier, specifierLoc);
 
-  if (performTypeLocChecking(Ty, /*IsSILType=*/true, OuterGenericEnv))
-    return true;
-
-  Result = SILType::getPrimitiveType(Ty.getType()->getCanonicalType(),
+  // Check whether we already resolved this annotation in this environment.
+  // Annotations with a local generic parameter list get a fresh environment
+  // on every parse, and function declaration types may carry an implicit
+  // convention the source text does not show; neither is cacheable.
+  bool IsCacheable = !IsFuncDecl && !HasGenericParams;
+  auto CacheKey =
+      std::make_pair(OuterGenericEnv ? OuterGenericEnv : ContextGenericEnv,
+                     extractParsedText(P, TypeStart));
+  Type ResolvedTy;
+  if (IsCacheable)
+    ResolvedTy = TUState.ParsedTypeCache.lookup(CacheKey);
+  if (!ResolvedTy) {
+    if (performTypeLocChecking(Ty, /*IsSILType=*/true, OuterGenericEnv))
+      return true;
+    ResolvedTy = Ty.getType();
+    if (IsCacheable)
+      TUState.ParsedTypeCache[CacheKey] = ResolvedTy;
+  }
+
+  Result = SILType::getPrimitiveType(ResolvedTy->getCanonicalType(),
                                      category);
 
   // Invoke the callback on the parsed type.
-  ParsedTypeCallback(Ty.getType());
+  ParsedTypeCallback(ResolvedTy);
 
   return false;
 }
@@ -1516,6 +1570,41 @@ bool SILParser::parseSILBBArgsAtBranch(SmallVector<SILValue, 6> &Args,
   return false;
 }
 
+/// Parse the optional profile count annotations of a cond_br, in the form
+/// the SILPrinter emits them:
+///   ('!true_count' '(' integer_literal ')')?
+///   ('!false_count' '(' integer_literal ')')?
+bool SILParser::parseSILBranchProfileCounts(ProfileCounter &TrueCount,
+                                            ProfileCounter &FalseCount) {
+  while (P.Tok.is(tok::sil_exclamation)) {
+    P.consumeToken(tok::sil_exclamation);
+    bool IsTrueCount = P.Tok.getText() == "true_count";
+    if (!P.Tok.is(tok::identifier) ||
+        (!IsTrueCount && P.Tok.getText() != "false_count")) {
+      P.diagnose(P.Tok, diag::expected_tok_in_sil_instr,
+                 "true_count or false_count");
+      return true;
+    }
+    P.consumeToken(tok::identifier);
+    if (P.parseToken(tok::l_paren, diag::expected_tok_in_sil_instr, "("))
+      return true;
+    uint64_t Count;
+    if (P.Tok.isNot(tok::integer_literal) ||
+        P.Tok.getText().getAsInteger(0, Count)) {
+      P.diagnose(P.Tok, diag::expected_tok_in_sil_instr, "integer literal");
+      return true;
+    }
+    P.consumeToken(tok::integer_literal);
+    if (P.parseToken(tok::r_paren, diag::expected_tok_in_sil_instr, ")"))
+      return true;
+    if (IsTrueCount)
+      TrueCount = Count;
+    else
+      FalseCount = Count;
+  }
+  return false;
+}
+
 /// Parse the substitution list for an apply instruction or
 /// specialized protocol conformance.
 bool SILParser::parseSubstitutions(SmallVectorImpl<ParsedSubstitution> &parsed,
@@ -3986,6 +4075,7 @@ bool SILParser::parseSILInstruction(SILBuilder &B) {
     Identifier BBName, BBName2;
     SourceLoc NameLoc, NameLoc2;
     SmallVector<SILValue, 6> Args, Args2;
+    ProfileCounter TrueBBCount, FalseBBCount;
     if (parseValueName(Cond) ||
         P.parseToken(tok::comma, diag::expected_tok_in_sil_instr, ",") ||
         parseSILIdentifier(BBName, NameLoc, diag::expected_sil_block_name) ||
@@ -3994,6 +4084,7 @@ bool SILParser::parseSILInstruction(SILBuilder &B) {
         parseSILIdentifier(BBName2, NameLoc2,
                            diag::expected_sil_block_name) ||
         parseSILBBArgsAtBranch(Args2, B) ||
+        parseSILBranchProfileCounts(TrueBBCount, FalseBBCount) ||
         parseSILDebugLocation(InstLoc, B))
       return true;
 
@@ -4004,7 +4095,7 @@ bool SILParser::parseSILInstruction(SILBuilder &B) {
                                    getBBForReference(BBName, NameLoc),
                                    Args,
                                    getBBForReference(BBName2, NameLoc2),
-                                   Args2);
+                                   Args2, TrueBBCount, FalseBBCount);
     break;
   }
   case SILInstructionKind::UnreachableInst:
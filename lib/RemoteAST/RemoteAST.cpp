@@ -28,6 +28,8 @@
 #include "swift/AST/TypeRepr.h"
 #include "swift/Basic/Mangler.h"
 #include "swift/ClangImporter/ClangImporter.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSwitch.h"
 
 // TODO: Develop a proper interface for this.
@@ -798,6 +800,12 @@ namespace {
 /// The template subclasses do target-specific logic.
 class RemoteASTContextImpl {
   std::unique_ptr<IRGenContext> IRGen;
+
+  /// Successfully resolved member offsets, keyed by type and member name.
+  /// Valid only while the remote process is stopped; cleared by
+  /// clearCaches().
+  llvm::DenseMap<TypeBase *, llvm::StringMap<uint64_t>> MemberOffsetCache;
+
 public:
   RemoteASTContextImpl() = default;
   virtual ~RemoteASTContextImpl() = default;
@@ -822,15 +830,38 @@ public:
     if (type->hasTypeParameter() || type->hasArchetype())
       return Result<uint64_t>::emplaceFailure(Failure::DependentArgument);
 
-    // Split into cases.
-    if (auto typeDecl = type->getNominalOrBoundGenericNominal()) {
-      return getOffsetOfField(type, typeDecl, optMetadata, memberName);
-    } else if (auto tupleType = type->getAs<TupleType>()) {
-      return getOffsetOfTupleElement(tupleType, optMetadata, memberName);
-    } else {
-      return Result<uint64_t>::emplaceFailure(Failure::TypeHasNoSuchMember,
-                                              memberName);
+    // Debugger workflows ask for the same members at every stop; serve
+    // repeated queries from the cache.
+    auto cachedType = MemberOffsetCache.find(type.getPointer());
+    if (cachedType != MemberOffsetCache.end()) {
+      auto cachedMember = cachedType->second.find(memberName);
+      if (cachedMember != cachedType->second.end())
+        return cachedMember->second;
     }
+
+    // Split into cases.
+    Result<uint64_t> result = [&]() -> Result<uint64_t> {
+      if (auto typeDecl = type->getNominalOrBoundGenericNominal()) {
+        return getOffsetOfField(type, typeDecl, optMetadata, memberName);
+      } else if (auto tupleType = type->getAs<TupleType>()) {
+        return getOffsetOfTupleElement(tupleType, optMetadata, memberName);
+      } else {
+        return Result<uint64_t>::emplaceFailure(Failure::TypeHasNoSuchMember,
+                                                memberName);
+      }
+    }();
+
+    // Only successes are cached; a failure may just mean the necessary
+    // metadata has not been instantiated or passed in yet.
+    if (result)
+      MemberOffsetCache[type.getPointer()][memberName] = result.getValue();
+    return result;
+  }
+
+  /// Discard everything cached from the remote process.
+  void clearCaches() {
+    MemberOffsetCache.clear();
+    clearReaderCache();
   }
 
 protected:
@@ -847,6 +878,7 @@ protected:
 private:
   virtual RemoteASTTypeBuilder &getBuilder() = 0;
   virtual MemoryReader &getReader() = 0;
+  virtual void clearReaderCache() = 0;
   virtual bool readWordOffset(RemoteAddress address, int64_t *offset) = 0;
   virtual std::unique_ptr<IRGenContext> createIRGenContext() = 0;
   virtual Result<uint64_t>
@@ -1094,6 +1126,10 @@ class RemoteASTContextConcreteImpl final : public RemoteASTContextImpl {
     return *Reader.Reader;
   }
 
+  void clearReaderCache() override {
+    Reader.clear();
+  }
+
   bool readWordOffset(RemoteAddress address, int64_t *extendedOffset) override {
     using unsigned_size_t = typename Runtime::StoredSize;
     using signed_size_t = typename std::make_signed<unsigned_size_t>::type;
@@ -1219,3 +1255,7 @@ Result<remote::RemoteAddress>
 RemoteASTContext::getHeapMetadataForObject(remote::RemoteAddress address) {
   return asImpl(Impl)->getHeapMetadataForObject(address);
 }
+
+void RemoteASTContext::clearCaches() {
+  asImpl(Impl)->clearCaches();
+}
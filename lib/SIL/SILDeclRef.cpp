@@ -20,6 +20,7 @@
 #include "swift/ClangImporter/ClangImporter.h"
 #include "swift/ClangImporter/ClangModule.h"
 #include "swift/SIL/SILLinkage.h"
+#include "swift/SIL/SILModule.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include "clang/AST/Attr.h"
@@ -61,6 +62,62 @@ swift::getMethodDispatch(AbstractFunctionDecl *method) {
   return MethodDispatch::Static;
 }
 
+bool swift::isEffectivelyFinalMethod(SILDeclRef method, SILModule &M) {
+  // Foreign entry points use ObjC dispatch, which we can never reason
+  // about statically.
+  if (method.isForeign)
+    return false;
+
+  auto *AFD = method.getAbstractFunctionDecl();
+  if (!AFD)
+    return false;
+
+  // If the method is overridden somewhere in this module, there are other
+  // implementations.
+  if (AFD->isOverridden())
+    return false;
+
+  if (AFD->isDynamic())
+    return false;
+
+  const DeclContext *AssocDC = M.getAssociatedContext();
+  if (!AssocDC)
+    return false;
+
+  // Only handle members defined within the SILModule's associated context;
+  // for anything else we cannot see the full set of overrides.
+  if (!AFD->isChildContextOf(AssocDC))
+    return false;
+
+  if (!AFD->hasAccess())
+    return false;
+
+  // Only consider 'private' members, unless we are in whole-module
+  // compilation.
+  switch (AFD->getEffectiveAccess()) {
+  case AccessLevel::Open:
+    return false;
+  case AccessLevel::Public:
+    if (isa<ConstructorDecl>(AFD)) {
+      // Constructors are special: a derived class in another module can
+      // "override" a constructor if its class is "open", although the
+      // constructor itself is not open.
+      auto *ND = AFD->getDeclContext()
+          ->getAsNominalTypeOrNominalTypeExtensionContext();
+      if (ND->getEffectiveAccess() == AccessLevel::Open)
+        return false;
+    }
+    LLVM_FALLTHROUGH;
+  case AccessLevel::Internal:
+    return M.isWholeModule();
+  case AccessLevel::FilePrivate:
+  case AccessLevel::Private:
+    return true;
+  }
+
+  llvm_unreachable("Unhandled access level in switch.");
+}
+
 bool swift::requiresForeignToNativeThunk(ValueDecl *vd) {
   // Functions imported from C, Objective-C methods imported from Objective-C,
   // as well as methods in @objc protocols (even protocols defined in Swift)
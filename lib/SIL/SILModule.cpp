@@ -27,7 +27,9 @@
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/YAMLTraits.h"
+#include <algorithm>
 #include <functional>
 using namespace swift;
 using namespace Lowering;
@@ -130,12 +132,78 @@ void *SILModule::allocate(unsigned Size, unsigned Align) const {
   return BPA.Allocate(Size, Align);
 }
 
+/// Each instruction allocation carries this many bytes of header recording
+/// its size class, so deallocateInst can recycle the block. Sixteen bytes
+/// keeps any instruction alignment up to 16 intact for the payload.
+static constexpr unsigned InstAllocHeaderSize = 16;
+
+/// The smallest size class, including the header. Classes double from here.
+static constexpr unsigned InstAllocMinClassSize = 64;
+
+/// Size-class value marking a block that came straight from the system
+/// allocator because it was too large to recycle.
+static constexpr unsigned InstAllocFallbackClass = ~0U;
+
+static unsigned getInstAllocSizeClass(unsigned totalSize) {
+  unsigned size = std::max(totalSize, InstAllocMinClassSize);
+  return llvm::Log2_32_Ceil(size) - llvm::Log2_32(InstAllocMinClassSize);
+}
+
 void *SILModule::allocateInst(unsigned Size, unsigned Align) const {
-  return AlignedAlloc(Size, Align);
+  assert(Align <= InstAllocHeaderSize &&
+         "instruction alignment exceeds the allocation header size");
+  unsigned sizeClass = getInstAllocSizeClass(Size + InstAllocHeaderSize);
+
+  // Oversized instructions go straight to the system allocator.
+  if (sizeClass >= InstructionFreeLists::NumSizeClasses) {
+    auto *base = reinterpret_cast<char *>(
+        AlignedAlloc(Size + InstAllocHeaderSize, InstAllocHeaderSize));
+    *reinterpret_cast<unsigned *>(base) = InstAllocFallbackClass;
+    return base + InstAllocHeaderSize;
+  }
+
+  // Pop a recycled block off the free list for this size class, or
+  // allocate a fresh one.
+  void *&freeList = instFreeLists.Heads[sizeClass];
+  char *base;
+  if (freeList) {
+    base = reinterpret_cast<char *>(freeList);
+    freeList = *reinterpret_cast<void **>(base + InstAllocHeaderSize);
+  } else {
+    base = reinterpret_cast<char *>(
+        AlignedAlloc(InstAllocMinClassSize << sizeClass, InstAllocHeaderSize));
+    *reinterpret_cast<unsigned *>(base) = sizeClass;
+  }
+  return base + InstAllocHeaderSize;
 }
 
 void SILModule::deallocateInst(SILInstruction *I) {
-  AlignedFree(I);
+  auto *base = reinterpret_cast<char *>(I) - InstAllocHeaderSize;
+  unsigned sizeClass = *reinterpret_cast<unsigned *>(base);
+  if (sizeClass == InstAllocFallbackClass) {
+    AlignedFree(base);
+    return;
+  }
+
+  // Push the block onto its free list, linking through the dead
+  // instruction's storage.
+  assert(sizeClass < InstructionFreeLists::NumSizeClasses &&
+         "corrupted instruction allocation header");
+  *reinterpret_cast<void **>(base + InstAllocHeaderSize) =
+      instFreeLists.Heads[sizeClass];
+  instFreeLists.Heads[sizeClass] = base;
+}
+
+SILModule::InstructionFreeLists::~InstructionFreeLists() {
+  for (void *head : Heads) {
+    while (head) {
+      void *next =
+          *reinterpret_cast<void **>(reinterpret_cast<char *>(head) +
+                                     InstAllocHeaderSize);
+      AlignedFree(head);
+      head = next;
+    }
+  }
 }
 
 SILWitnessTable *
@@ -504,6 +572,22 @@ bool SILModule::loadFunction(SILFunction *F) {
   return true;
 }
 
+SILFunction *SILModule::loadFunction(StringRef Name) {
+  SILFunction *F = getSILLoader()->lookupSILFunction(
+      Name, /*declarationOnly*/ false, /*Linkage*/ None);
+  if (!F)
+    return nullptr;
+
+  // Make sure that any referenced shared functions get their bodies, like
+  // the linker does for any other deserialized definition.
+  linkFunction(F);
+  return F;
+}
+
+void SILModule::preloadFunctions(ArrayRef<StringRef> Names) {
+  getSILLoader()->preloadSILFunctions(Names);
+}
+
 bool SILModule::linkFunction(SILFunction *F, SILModule::LinkingMode Mode) {
   return SILLinkerVisitor(*this, Mode).processFunction(F);
 }
@@ -151,6 +151,19 @@ public:
   CleanupManager(SILGenFunction &SGF)
       : SGF(SGF), innermostScope(stack.stable_end()) {}
 
+  /// Seed the cleanup stack with storage recycled from a previous function
+  /// emission.
+  void adoptRecycledStorage(DiverseStackBase::RecycledStorage &&storage) {
+    stack.adoptRecycledStorage(std::move(storage));
+  }
+
+  /// Detach the cleanup stack's heap storage, if any, for reuse by a later
+  /// function emission.  Yields an empty handle unless all cleanups have
+  /// been popped.
+  DiverseStackBase::RecycledStorage recycleStorage() {
+    return stack.recycleStorage();
+  }
+
   /// Return a stable reference to the last cleanup pushed.
   CleanupsDepth getCleanupsDepth() const { return stack.stable_begin(); }
 
@@ -127,6 +127,17 @@ public:
            "entries remaining on formal evaluation cleanup stack at end of function!");
   }
 
+  /// Seed the stack with storage recycled from a previous function emission.
+  void adoptRecycledStorage(DiverseStackBase::RecycledStorage &&storage) {
+    stack.adoptRecycledStorage(std::move(storage));
+  }
+
+  /// Detach the stack's heap storage, if any, for reuse by a later function
+  /// emission.
+  DiverseStackBase::RecycledStorage recycleStorage() {
+    return stack.recycleStorage();
+  }
+
   iterator begin() { return stack.begin(); }
   iterator end() { return stack.end(); }
   stable_iterator stabilize(iterator iter) const {
@@ -585,6 +585,15 @@ void emitOrDelayFunction(SILGenModule &SGM,
                          SILDeclRef constant,
                          Fn &&emitter,
                          bool forceEmission = false) {
+  // If all we are producing is a module, a body that is neither serialized
+  // nor eligible for inlining into a serialized body never reaches the
+  // output; skip lowering it entirely and let any references produce bare
+  // declarations.
+  if (SGM.M.getOptions().SkipNonInlinableFunctionBodies &&
+      constant.isSerialized() == IsNotSerialized &&
+      !constant.isTransparent())
+    return;
+
   auto emitAfter = SGM.lastEmittedFunction;
 
   SILFunction *f = nullptr;
@@ -1478,6 +1487,12 @@ void SILGenModule::useConformance(ProtocolConformanceRef conformanceRef) {
 
 void SILGenModule::useConformancesFromSubstitutions(
                                                 const SubstitutionMap subs) {
+  // Substitution maps recur constantly across applies of the same generic
+  // declarations. Once a map's conformances have been marked used, each of
+  // its roots is in a terminal state, so later visits would be no-ops.
+  if (!subs.empty() && !usedSubstitutionMaps.insert(subs).second)
+    return;
+
   for (auto conf : subs.getConformances())
     useConformance(conf);
 }
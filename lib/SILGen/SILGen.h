@@ -80,6 +80,11 @@ public:
   /// Set of used conformances for which witness tables need to be emitted.
   llvm::DenseSet<NormalProtocolConformance *> usedConformances;
 
+  /// Substitution maps whose conformances have already been marked used.
+  /// Substitution maps are uniqued, and using a conformance is idempotent,
+  /// so an already-seen map does not need its conformances walked again.
+  llvm::DenseSet<SubstitutionMap> usedSubstitutionMaps;
+
   struct DelayedWitnessTable {
     NormalProtocolConformance *insertAfter;
   };
@@ -100,6 +105,14 @@ public:
   /// Constructors within extensions are profiled separately.
   llvm::DenseMap<Decl *, SILProfiler *> constructorProfilers;
 
+  /// Heap storage recycled from the cleanup and formal-evaluation stacks of
+  /// finished function emissions, used to seed the stacks of the next
+  /// emission.  Each slot keeps the largest allocation seen so far, so once
+  /// one deeply nested function has grown a stack no later function has to
+  /// grow one again.
+  DiverseStackBase::RecycledStorage CleanupStackStorage;
+  DiverseStackBase::RecycledStorage FormalEvalStackStorage;
+
   SILFunction *emitTopLevelFunction(SILLocation Loc);
 
   size_t anonymousSymbolCounter = 0;
@@ -955,6 +955,19 @@ public:
                         .asForeign(requiresForeignEntryPoint(afd));
 
     auto subs = e->getDeclRef().getSubstitutions();
+
+    // When optimizing, emit a direct call if the method can never be
+    // overridden in this compilation, instead of leaving the
+    // devirtualization of the class_method to the optimizer. Serialized
+    // functions must keep dynamic dispatch, since the direct callee may
+    // not be referenceable from other modules.
+    if (isa<FuncDecl>(afd) && SGF.F.shouldOptimize() &&
+        !SGF.F.isSerialized() &&
+        isEffectivelyFinalMethod(constant, SGF.SGM.M)) {
+      setCallee(Callee::forDirect(SGF, constant, subs, e));
+      return;
+    }
+
     setCallee(Callee::forClassMethod(SGF, constant, subs, e));
   }
 
@@ -4895,9 +4908,14 @@ static Callee getBaseAccessorFunctionRef(SILGenFunction &SGF,
     return Callee::forDirect(SGF, constant, subs, loc);
 
   // Otherwise, if we have a non-final class dispatch to a normal method,
-  // perform a dynamic dispatch.
-  if (!isSuper)
+  // perform a dynamic dispatch, unless the accessor can never be
+  // overridden in this compilation and we are optimizing.
+  if (!isSuper) {
+    if (SGF.F.shouldOptimize() && !SGF.F.isSerialized() &&
+        isEffectivelyFinalMethod(constant, SGF.SGM.M))
+      return Callee::forDirect(SGF, constant, subs, loc);
     return Callee::forClassMethod(SGF, constant, subs, loc);
+  }
 
   // If this is a "super." dispatch, we do a dynamic dispatch for objc methods
   // or non-final native Swift methods.
@@ -39,6 +39,12 @@ SILGenFunction::SILGenFunction(SILGenModule &SGM, SILFunction &F,
   B.setInsertionPoint(createBasicBlock());
   B.setCurrentDebugScope(F.getDebugScope());
   B.setOpenedArchetypesTracker(&OpenedArchetypesTracker);
+
+  // Seed the cleanup and formal-evaluation stacks with storage recycled
+  // from previous function emissions, so that scope churn in deeply nested
+  // functions doesn't re-grow them from their inline buffers every time.
+  Cleanups.adoptRecycledStorage(std::move(SGM.CleanupStackStorage));
+  FormalEvalContext.adoptRecycledStorage(std::move(SGM.FormalEvalStackStorage));
 }
 
 /// SILGenFunction destructor - called after the entire function's AST has been
@@ -51,6 +57,16 @@ SILGenFunction::~SILGenFunction() {
   // If we didn't clean up the rethrow destination, we screwed up somewhere.
   assert(!ThrowDest.isValid() &&
          "SILGenFunction did not emit throw destination");
+
+  // Donate the cleanup stacks' storage back to the module for the next
+  // emission, keeping whichever allocation is larger.
+  auto recycledCleanups = Cleanups.recycleStorage();
+  if (recycledCleanups.getCapacity() > SGM.CleanupStackStorage.getCapacity())
+    SGM.CleanupStackStorage = std::move(recycledCleanups);
+  auto recycledFormalEval = FormalEvalContext.recycleStorage();
+  if (recycledFormalEval.getCapacity() >
+        SGM.FormalEvalStackStorage.getCapacity())
+    SGM.FormalEvalStackStorage = std::move(recycledFormalEval);
 }
 
 //===----------------------------------------------------------------------===//
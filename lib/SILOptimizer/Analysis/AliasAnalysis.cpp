@@ -11,6 +11,8 @@
 //===----------------------------------------------------------------------===//
 
 #define DEBUG_TYPE "sil-aa"
+#include "swift/AST/ASTContext.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/SILOptimizer/Analysis/AliasAnalysis.h"
 #include "swift/SILOptimizer/Analysis/ValueTracking.h"
 #include "swift/SILOptimizer/Analysis/SideEffectAnalysis.h"
@@ -537,12 +539,17 @@ bool AliasAnalysis::typesMayAlias(SILType T1, SILType T2) {
 AliasResult AliasAnalysis::alias(SILValue V1, SILValue V2,
                                  SILType TBAAType1, SILType TBAAType2) {
   AliasKeyTy Key = toAliasKey(V1, V2, TBAAType1, TBAAType2);
+  auto *Stats = Mod->getASTContext().Stats;
 
   // Check if we've already computed this result.
   auto It = AliasCache.find(Key);
   if (It != AliasCache.end()) {
+    if (Stats)
+      Stats->getFrontendCounters().NumAliasAnalysisCacheHits++;
     return It->second;
   }
+  if (Stats)
+    Stats->getFrontendCounters().NumAliasAnalysisCacheMisses++;
 
   // Flush the cache if the size of the cache is too large.
   if (AliasCache.size() > AliasAnalysisMaxCacheSize) {
@@ -26,6 +26,29 @@ static SILValue getCondition(SILValue C) {
   return C;
 }
 
+/// \return a BranchHint if the profile counts of the cond_br show that one
+/// of the edges is taken rarely compared to the other one.
+ColdBlockInfo::BranchHint
+ColdBlockInfo::getProfileHint(const CondBranchInst *CBI) {
+  auto TrueCount = CBI->getTrueBBCount();
+  auto FalseCount = CBI->getFalseBBCount();
+  if (!TrueCount || !FalseCount)
+    return BranchHint::None;
+
+  uint64_t TrueVal = TrueCount.getValue();
+  uint64_t FalseVal = FalseCount.getValue();
+
+  // Don't draw any conclusion from a branch with too few samples.
+  if (TrueVal < ColdEdgeCountFactor && FalseVal < ColdEdgeCountFactor)
+    return BranchHint::None;
+
+  if (FalseVal <= TrueVal / ColdEdgeCountFactor)
+    return BranchHint::LikelyTrue;
+  if (TrueVal <= FalseVal / ColdEdgeCountFactor)
+    return BranchHint::LikelyFalse;
+  return BranchHint::None;
+}
+
 /// \return a BranchHint if this call is a builtin branch hint.
 ColdBlockInfo::BranchHint ColdBlockInfo::getBranchHint(SILValue Cond,
                                                        int recursionDepth) {
@@ -118,6 +141,10 @@ bool ColdBlockInfo::isSlowPath(const SILBasicBlock *FromBB,
   SILValue C = getCondition(CBI->getCondition());
 
   BranchHint hint = getBranchHint(C, recursionDepth);
+  // In the absence of a static branch hint, consult the profile counts of
+  // the branch, if there are any.
+  if (hint == BranchHint::None)
+    hint = getProfileHint(CBI);
   if (hint == BranchHint::None)
     return false;
 
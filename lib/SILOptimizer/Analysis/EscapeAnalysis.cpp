@@ -1239,6 +1239,21 @@ void EscapeAnalysis::analyzeInstruction(SILInstruction *I,
           return;
         }
         break;
+      case ArrayCallKind::kArrayInit:
+        // array.init allocates a new array and stores the arguments (e.g. the
+        // repeated element of Array(repeating:count:)) into it. Model the
+        // result like a fresh allocation which contains the arguments, similar
+        // to array.uninitialized. This enables stack promotion of objects
+        // which are stored into locally created and consumed arrays.
+        if (CGNode *ArrayNode = ConGraph->getNode(ASC.getCallResult(), this)) {
+          CGNode *ArrayContent = ConGraph->getContentNode(ArrayNode);
+          for (SILValue Arg : FAS.getArgumentsWithoutIndirectResults()) {
+            if (CGNode *ArgNode = ConGraph->getNode(Arg, this))
+              ArrayContent = ConGraph->defer(ArrayContent, ArgNode);
+          }
+          return;
+        }
+        break;
       case ArrayCallKind::kGetArrayOwner:
         if (CGNode *BufferNode = ConGraph->getNode(ASC.getSelf(), this)) {
           ConGraph->defer(ConGraph->getNode(ASC.getCallResult(), this),
@@ -1339,6 +1354,44 @@ void EscapeAnalysis::analyzeInstruction(SILInstruction *I,
       if (Fn->getName() == "swift_bufferAllocate")
         // The call is a buffer allocation, e.g. for Array.
         return;
+
+      // The callee is not visible, e.g. it lives in another module and was
+      // not serialized. If the programmer declared its effects we still know
+      // that the callee cannot write to memory: no argument can escape by
+      // the call, and at most the results may point to what the arguments
+      // point to.
+      // Note: @_effects(readonly) is worthless if we have owned parameters,
+      // because the release inside the callee may call a deinit, which
+      // itself can do anything.
+      if (Fn->getEffectsKind() == EffectsKind::ReadNone ||
+          (Fn->getEffectsKind() == EffectsKind::ReadOnly &&
+           !Fn->hasOwnedParameters())) {
+        llvm::SmallVector<CGNode *, 2> ResultNodes;
+        if (auto *AI = dyn_cast<ApplyInst>(I)) {
+          if (CGNode *ResultNode = ConGraph->getNode(AI, this))
+            ResultNodes.push_back(ResultNode);
+        } else if (auto *TAI = dyn_cast<TryApplyInst>(I)) {
+          if (CGNode *ResultNode =
+                  ConGraph->getNode(TAI->getNormalBB()->getArgument(0), this))
+            ResultNodes.push_back(ResultNode);
+          if (CGNode *ErrorNode =
+                  ConGraph->getNode(TAI->getErrorBB()->getArgument(0), this))
+            ResultNodes.push_back(ErrorNode);
+        }
+        for (SILValue IndirectResult : FAS.getIndirectSILResults()) {
+          if (CGNode *AddrNode = ConGraph->getNode(IndirectResult, this))
+            ResultNodes.push_back(ConGraph->getContentNode(AddrNode));
+        }
+        // Create defer-edges from the results to the arguments, like for a
+        // partial_apply.
+        for (SILValue Arg : FAS.getArgumentsWithoutIndirectResults()) {
+          if (CGNode *ArgNode = ConGraph->getNode(Arg, this)) {
+            for (CGNode *&ResultNode : ResultNodes)
+              ResultNode = ConGraph->defer(ResultNode, ArgNode);
+          }
+        }
+        return;
+      }
     }
   }
 
@@ -0,0 +1,40 @@
+//===--- InlineCostAnalysis.cpp -------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/SILOptimizer/Analysis/InlineCostAnalysis.h"
+#include "swift/SILOptimizer/Analysis/ColdBlockInfo.h"
+#include "swift/SILOptimizer/Analysis/DominanceAnalysis.h"
+#include "swift/SILOptimizer/Analysis/LoopAnalysis.h"
+#include "swift/SILOptimizer/PassManager/PassManager.h"
+
+using namespace swift;
+
+void InlineCostAnalysis::initialize(SILPassManager *PM) {
+  DA = PM->getAnalysis<DominanceAnalysis>();
+  LA = PM->getAnalysis<SILLoopAnalysis>();
+}
+
+ShortestPathAnalysis *InlineCostAnalysis::newFunctionAnalysis(SILFunction *F) {
+  auto *SPA = new ShortestPathAnalysis(F, LA->get(F));
+  ColdBlockInfo CBI(DA);
+  // Analyze the function in "callee mode": we don't compute the shortest
+  // path analysis for another call-level. Functions called from \p F are
+  // assumed to have a constant length.
+  SPA->analyze(CBI, [](FullApplySite FAS) {
+    return (int)ShortestPathAnalysis::DefaultApplyLength;
+  });
+  return SPA;
+}
+
+SILAnalysis *swift::createInlineCostAnalysis(SILModule *M) {
+  return new InlineCostAnalysis(M);
+}
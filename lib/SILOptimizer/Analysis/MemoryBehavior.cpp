@@ -12,10 +12,13 @@
 
 #define DEBUG_TYPE "sil-membehavior"
 
+#include "swift/AST/ASTContext.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/SILOptimizer/Analysis/AliasAnalysis.h"
 #include "swift/SILOptimizer/Analysis/EscapeAnalysis.h"
 #include "swift/SILOptimizer/Analysis/SideEffectAnalysis.h"
 #include "swift/SILOptimizer/Analysis/ValueTracking.h"
+#include "swift/SIL/SILModule.h"
 #include "swift/SIL/SILVisitor.h"
 #include "llvm/Support/Debug.h"
 
@@ -336,11 +339,17 @@ MemBehavior
 AliasAnalysis::computeMemoryBehavior(SILInstruction *Inst, SILValue V,
                                      RetainObserveKind InspectionMode) {
   MemBehaviorKeyTy Key = toMemoryBehaviorKey(Inst, V, InspectionMode);
+  auto *Stats = Mod->getASTContext().Stats;
+
   // Check if we've already computed this result.
   auto It = MemoryBehaviorCache.find(Key);
   if (It != MemoryBehaviorCache.end()) {
+    if (Stats)
+      Stats->getFrontendCounters().NumMemoryBehaviorCacheHits++;
     return It->second;
   }
+  if (Stats)
+    Stats->getFrontendCounters().NumMemoryBehaviorCacheMisses++;
 
   // Flush the cache if the size of the cache is too large.
   if (MemoryBehaviorCache.size() > MemoryBehaviorAnalysisMaxCacheSize) {
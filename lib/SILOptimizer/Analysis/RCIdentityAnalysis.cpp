@@ -406,8 +406,14 @@ llvm::cl::opt<bool> StripOffArgs(
 //===----------------------------------------------------------------------===//
 
 SILValue RCIdentityFunctionInfo::stripRCIdentityPreservingOps(SILValue V,
-                                                      unsigned RecursionDepth) {
+                                      unsigned RecursionDepth,
+                                      llvm::SmallVectorImpl<SILValue> *Chain) {
   while (true) {
+    // Every value on the strip chain has the same root, so record the
+    // intermediate values if the caller wants to cache them.
+    if (Chain)
+      Chain->push_back(V);
+
     // First strip off any RC identity preserving instructions. This is cheap.
     if (SILValue NewV = stripRCIdentityPreservingInsts(V)) {
       V = NewV;
@@ -434,13 +440,14 @@ SILValue RCIdentityFunctionInfo::stripRCIdentityPreservingOps(SILValue V,
 
 
 SILValue RCIdentityFunctionInfo::getRCIdentityRootInner(SILValue V,
-                                                    unsigned RecursionDepth) {
+                                      unsigned RecursionDepth,
+                                      llvm::SmallVectorImpl<SILValue> *Chain) {
   // Only allow this method to be recursed on for a limited number of times to
   // make sure we don't explode compile time.
   if (RecursionDepth >= MaxRecursionDepth)
     return SILValue();
 
-  SILValue NewValue = stripRCIdentityPreservingOps(V, RecursionDepth);
+  SILValue NewValue = stripRCIdentityPreservingOps(V, RecursionDepth, Chain);
   if (!NewValue)
     return SILValue();
 
@@ -458,7 +465,8 @@ SILValue RCIdentityFunctionInfo::getRCIdentityRoot(SILValue V) {
   if (Iter != RCCache.end())
     return Iter->second;
 
-  SILValue Root = getRCIdentityRootInner(V, 0);
+  llvm::SmallVector<SILValue, 8> Chain;
+  SILValue Root = getRCIdentityRootInner(V, 0, &Chain);
   VisitedArgs.clear();
 
   // If we fail to find a root, return V.
@@ -466,9 +474,16 @@ SILValue RCIdentityFunctionInfo::getRCIdentityRoot(SILValue V) {
     return V;
 
   // Make sure the cache does not grow too big.
-  if (RCCache.size() > MaxRCIdentityCacheSize)
+  if (RCCache.size() + Chain.size() > MaxRCIdentityCacheSize)
     RCCache.clear();
 
+  // Cache the result for all intermediate values of the strip chain, so that
+  // a future query which starts in the middle of the chain does not have to
+  // walk its tail again.
+  for (SILValue Link : Chain)
+    if (Link != Root)
+      RCCache[Link] = Root;
+
   // Return and cache it.
   return RCCache[V] = Root;
 }
@@ -54,6 +54,13 @@ static LiteralInst *getConstant(SILValue V) {
     return getConstant(I->getOperand());
   if (auto I = dyn_cast<ConvertFunctionInst>(V))
     return getConstant(I->getOperand());
+  // Look through a wrapping struct, e.g. an Int wrapping a Builtin.Int64.
+  // This is how literal configuration values are usually captured.
+  if (auto I = dyn_cast<StructInst>(V)) {
+    if (I->getNumOperands() == 1)
+      return getConstant(I->getOperand(0));
+    return nullptr;
+  }
   return dyn_cast<LiteralInst>(V);
 }
 
@@ -151,7 +158,7 @@ void CapturePropagationCloner::cloneConstValue(SILValue Val) {
 
   if (Inst->getNumOperands() > 0) {
     // Only handle single operands for simple recursion without a worklist.
-    assert(Inst->getNumOperands() == 1 && "expected single-operand cast");
+    assert(Inst->getNumOperands() == 1 && "expected single-operand instruction");
     cloneConstValue(Inst->getOperand(0));
   }
   visit(Inst);
@@ -295,11 +302,34 @@ void CapturePropagation::rewritePartialApply(PartialApplyInst *OrigPAI,
   DEBUG(llvm::dbgs() << "  Rewrote caller:\n" << *T2TF);
 }
 
-/// For now, we conservative only specialize if doing so can eliminate dynamic
-/// dispatch.
-///
-/// TODO: Check for other profitable constant propagation, like builtin compare.
-static bool isProfitable(SILFunction *Callee) {
+/// Returns true if the use \p Use of a propagated literal can be constant
+/// folded in the specialized function, e.g. a builtin operation on the
+/// literal or a branch on it. Looks through extracts of wrapping structs,
+/// like an Int wrapping a Builtin.Int64, up to \p Depth levels.
+static bool isFoldableUse(Operand *Use, int Depth) {
+  SILInstruction *User = Use->getUser();
+  if (isa<BuiltinInst>(User) || isa<SwitchValueInst>(User) ||
+      isa<SelectValueInst>(User) || isa<SwitchEnumInst>(User) ||
+      isa<SelectEnumInst>(User))
+    return true;
+  if (auto *CBI = dyn_cast<CondBranchInst>(User))
+    return CBI->getCondition() == Use->get();
+  if (Depth > 0 &&
+      (isa<StructExtractInst>(User) || isa<TupleExtractInst>(User))) {
+    for (auto *ExtractUse : cast<SingleValueInstruction>(User)->getUses()) {
+      if (isFoldableUse(ExtractUse, Depth - 1))
+        return true;
+    }
+  }
+  return false;
+}
+
+/// We only specialize if doing so is profitable: either a captured function
+/// is called in the body, so that specialization eliminates the dynamic
+/// dispatch, or a captured literal has uses which can be constant folded in
+/// the specialized body, e.g. a buffer size which feeds a builtin compare or
+/// a configuration flag which is branched on.
+static bool isProfitable(SILFunction *Callee, PartialApplyInst *PAI) {
   SILBasicBlock *EntryBB = &*Callee->begin();
   for (auto *Arg : EntryBB->getArguments()) {
     for (auto *Operand : Arg->getUses()) {
@@ -309,6 +339,16 @@ static bool isProfitable(SILFunction *Callee) {
       }
     }
   }
+  // Check the uses of the arguments which receive the propagated constants.
+  unsigned FirstCapturedIdx =
+      EntryBB->getNumArguments() - PAI->getNumArguments();
+  for (unsigned Idx = FirstCapturedIdx, End = EntryBB->getNumArguments();
+       Idx < End; ++Idx) {
+    for (auto *Use : EntryBB->getArgument(Idx)->getUses()) {
+      if (isFoldableUse(Use, /*Depth*/ 1))
+        return true;
+    }
+  }
   return false;
 }
 
@@ -462,7 +502,7 @@ bool CapturePropagation::optimizePartialApply(PartialApplyInst *PAI) {
     if (!isConstant(Arg))
       return false;
   }
-  if (!isProfitable(SubstF))
+  if (!isProfitable(SubstF, PAI))
     return false;
 
   DEBUG(llvm::dbgs() << "Specializing closure for constant arguments:\n"
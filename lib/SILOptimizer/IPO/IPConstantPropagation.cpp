@@ -0,0 +1,358 @@
+//===--- IPConstantPropagation.cpp - Propagate constants across calls -----===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// A summary-based interprocedural constant propagation pass. Configuration
+// constants -- feature flags, buffer sizes -- are typically wrapped in small
+// accessor functions and flow through several layers of calls, so the flag
+// checks on hot paths only fold away if the constants cross function
+// boundaries. This pass computes two per-function summaries:
+//
+//  * A return summary: whether every return of a function produces the same
+//    literal value. Uses of the results of calls to such functions are
+//    replaced by the literal in every caller. The summary is also computed
+//    for function bodies deserialized from other modules, so constants behind
+//    @inlinable accessors propagate cross-module without a separate
+//    serialization format.
+//
+//  * An argument summary: whether every caller of a function passes the same
+//    literal for an argument. If all callers are known -- the function is not
+//    visible externally and is only referenced as the direct callee of full
+//    applies -- uses of the argument are replaced by the literal in the
+//    callee.
+//
+// Functions are processed bottom-up, so a constant return folds through
+// chains of wrapper functions in a single run.
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "ip-constant-prop"
+#include "swift/SIL/SILBuilder.h"
+#include "swift/SIL/SILFunction.h"
+#include "swift/SIL/SILInstruction.h"
+#include "swift/SIL/SILModule.h"
+#include "swift/SILOptimizer/Analysis/BasicCalleeAnalysis.h"
+#include "swift/SILOptimizer/Analysis/FunctionOrder.h"
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Support/Debug.h"
+
+using namespace swift;
+
+STATISTIC(NumReturnsFolded, "Number of constant returns folded into callers");
+STATISTIC(NumArgumentsFolded,
+          "Number of constant arguments folded into callees");
+
+/// Return the defining instruction of \p V if it is a literal, possibly
+/// wrapped in structs (an Int wrapping a Builtin.Int64 is how configuration
+/// constants usually look), and null otherwise.
+static SingleValueInstruction *getConstant(SILValue V) {
+  if (auto *SI = dyn_cast<StructInst>(V)) {
+    for (SILValue Op : SI->getElements())
+      if (!getConstant(Op))
+        return nullptr;
+    return SI;
+  }
+  if (isa<IntegerLiteralInst>(V) || isa<FloatLiteralInst>(V) ||
+      isa<StringLiteralInst>(V))
+    return cast<SingleValueInstruction>(V);
+  return nullptr;
+}
+
+/// Compare two constants matched by getConstant, which may live in different
+/// functions.
+static bool isSameConstant(SingleValueInstruction *A,
+                           SingleValueInstruction *B) {
+  if (A->getKind() != B->getKind() || A->getType() != B->getType())
+    return false;
+  if (auto *IA = dyn_cast<IntegerLiteralInst>(A))
+    return IA->getValue() == cast<IntegerLiteralInst>(B)->getValue();
+  if (auto *FA = dyn_cast<FloatLiteralInst>(A))
+    return FA->getValue().bitwiseIsEqual(
+        cast<FloatLiteralInst>(B)->getValue());
+  if (auto *SA = dyn_cast<StringLiteralInst>(A)) {
+    auto *SB = cast<StringLiteralInst>(B);
+    return SA->getValue() == SB->getValue() &&
+           SA->getEncoding() == SB->getEncoding();
+  }
+  auto *StA = cast<StructInst>(A);
+  auto *StB = cast<StructInst>(B);
+  auto ElemsA = StA->getElements();
+  auto ElemsB = StB->getElements();
+  if (ElemsA.size() != ElemsB.size())
+    return false;
+  for (unsigned Idx = 0, End = ElemsA.size(); Idx != End; ++Idx)
+    if (!isSameConstant(getConstant(ElemsA[Idx]), getConstant(ElemsB[Idx])))
+      return false;
+  return true;
+}
+
+/// Rebuild the constant \p C at the insertion point of \p B.
+static SingleValueInstruction *materializeConstant(SingleValueInstruction *C,
+                                                   SILBuilder &B,
+                                                   SILLocation Loc) {
+  if (auto *IL = dyn_cast<IntegerLiteralInst>(C))
+    return B.createIntegerLiteral(Loc, IL->getType(), IL->getValue());
+  if (auto *FL = dyn_cast<FloatLiteralInst>(C))
+    return B.createFloatLiteral(Loc, FL->getType(), FL->getValue());
+  if (auto *SL = dyn_cast<StringLiteralInst>(C))
+    return B.createStringLiteral(Loc, SL->getValue(), SL->getEncoding());
+  auto *SI = cast<StructInst>(C);
+  SmallVector<SILValue, 4> Elements;
+  for (SILValue Op : SI->getElements())
+    Elements.push_back(materializeConstant(getConstant(Op), B, Loc));
+  return B.createStruct(Loc, SI->getType(), Elements);
+}
+
+/// If \p F returns the same constant on every path, return its defining
+/// instruction inside \p F, and null otherwise.
+static SingleValueInstruction *getConstantReturn(SILFunction *F) {
+  if (F->getConventions().hasIndirectSILResults())
+    return nullptr;
+
+  SingleValueInstruction *Constant = nullptr;
+  for (SILBasicBlock &BB : *F) {
+    auto *RI = dyn_cast<ReturnInst>(BB.getTerminator());
+    if (!RI)
+      continue;
+    auto *C = getConstant(RI->getOperand());
+    if (!C || C->getType().hasArchetype())
+      return nullptr;
+    if (Constant && !isSameConstant(Constant, C))
+      return nullptr;
+    Constant = C;
+  }
+  return Constant;
+}
+
+namespace {
+
+class IPConstantPropagation : public SILModuleTransform {
+  /// The constant-return summaries computed so far: for each mapped function,
+  /// the constant every one of its returns produces.
+  llvm::DenseMap<SILFunction *, SingleValueInstruction *> ConstantReturns;
+
+  /// All full apply sites of each function whose set of callers is fully
+  /// known. Functions with any caller we cannot see have no entry.
+  llvm::DenseMap<SILFunction *, SmallVector<FullApplySite, 4>> KnownCallSites;
+
+  void run() override;
+  void collectCallSites();
+  bool propagateReturns(SILFunction *F);
+  bool propagateArguments(SILFunction *F);
+};
+
+} // end anonymous namespace
+
+/// Record the full apply sites of every function in the module, and drop the
+/// records of functions which can be called in ways the records don't cover.
+void IPConstantPropagation::collectCallSites() {
+  SILModule &M = *getModule();
+  llvm::SmallPtrSet<SILFunction *, 16> UnknownCallers;
+
+  auto markUnknown = [&](SILFunction *F) {
+    if (F)
+      UnknownCallers.insert(F);
+  };
+
+  // Functions referenced from vtables, witness tables, or key paths are
+  // callable through dynamic dispatch without any direct reference.
+  for (SILVTable &VT : M.getVTableList())
+    for (const SILVTable::Entry &Entry : VT.getEntries())
+      markUnknown(Entry.Implementation);
+  for (SILWitnessTable &WT : M.getWitnessTableList())
+    for (const SILWitnessTable::Entry &Entry : WT.getEntries())
+      if (Entry.getKind() == SILWitnessTable::Method)
+        markUnknown(Entry.getMethodWitness().Witness);
+  for (SILDefaultWitnessTable &WT : M.getDefaultWitnessTableList())
+    for (const SILDefaultWitnessTable::Entry &Entry : WT.getEntries())
+      if (Entry.isValid())
+        markUnknown(Entry.getWitness());
+
+  for (SILFunction &F : M) {
+    for (SILBasicBlock &BB : F) {
+      for (SILInstruction &I : BB) {
+        if (auto *FRI = dyn_cast<FunctionRefInst>(&I)) {
+          SILFunction *Callee = FRI->getReferencedFunction();
+          for (Operand *Use : FRI->getUses()) {
+            auto Apply = FullApplySite::isa(Use->getUser());
+            if (Apply && Apply.getCallee() == SILValue(FRI)) {
+              KnownCallSites[Callee].push_back(Apply);
+            } else {
+              // Any other use -- a partial_apply, a store, a closure
+              // conversion -- can produce calls we cannot see.
+              markUnknown(Callee);
+            }
+          }
+        } else if (auto *KPI = dyn_cast<KeyPathInst>(&I)) {
+          for (auto &Component : KPI->getPattern()->getComponents()) {
+            switch (Component.getKind()) {
+            case KeyPathPatternComponent::Kind::SettableProperty:
+              markUnknown(Component.getComputedPropertySetter());
+              LLVM_FALLTHROUGH;
+            case KeyPathPatternComponent::Kind::GettableProperty: {
+              markUnknown(Component.getComputedPropertyGetter());
+              auto Id = Component.getComputedPropertyId();
+              if (Id.getKind() ==
+                  KeyPathPatternComponent::ComputedPropertyId::Function)
+                markUnknown(Id.getFunction());
+              markUnknown(Component.getSubscriptIndexEquals());
+              markUnknown(Component.getSubscriptIndexHash());
+              break;
+            }
+            case KeyPathPatternComponent::Kind::StoredProperty:
+            case KeyPathPatternComponent::Kind::OptionalChain:
+            case KeyPathPatternComponent::Kind::OptionalForce:
+            case KeyPathPatternComponent::Kind::OptionalWrap:
+              break;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  for (SILFunction *F : UnknownCallers)
+    KnownCallSites.erase(F);
+}
+
+/// Replace the uses of results of applies in \p F whose callee has a
+/// constant-return summary.
+bool IPConstantPropagation::propagateReturns(SILFunction *F) {
+  bool Changed = false;
+  for (SILBasicBlock &BB : *F) {
+    for (SILInstruction &I : BB) {
+      auto Apply = FullApplySite::isa(&I);
+      if (!Apply || Apply.getSubstCalleeConv().hasIndirectSILResults())
+        continue;
+      SILFunction *Callee = Apply.getCalleeFunction();
+      if (!Callee)
+        continue;
+      auto Iter = ConstantReturns.find(Callee);
+      if (Iter == ConstantReturns.end())
+        continue;
+      SingleValueInstruction *C = Iter->second;
+
+      // The call itself stays; if it has no other effect, dead-code
+      // elimination removes it later.
+      if (auto *AI = dyn_cast<ApplyInst>(&I)) {
+        if (AI->use_empty() || AI->getType() != C->getType())
+          continue;
+        SILBuilder B(AI);
+        AI->replaceAllUsesWith(materializeConstant(C, B, AI->getLoc()));
+      } else if (auto *TAI = dyn_cast<TryApplyInst>(&I)) {
+        SILBasicBlock *NormalBB = TAI->getNormalBB();
+        if (NormalBB->getNumArguments() != 1)
+          continue;
+        SILArgument *Result = NormalBB->getArgument(0);
+        if (Result->use_empty() || Result->getType() != C->getType())
+          continue;
+        SILBuilder B(&*NormalBB->begin());
+        Result->replaceAllUsesWith(materializeConstant(C, B, TAI->getLoc()));
+      } else {
+        continue;
+      }
+      ++NumReturnsFolded;
+      Changed = true;
+    }
+  }
+  return Changed;
+}
+
+/// Replace the uses of arguments of \p F for which every known caller passes
+/// the same constant.
+bool IPConstantPropagation::propagateArguments(SILFunction *F) {
+  // Deserialized function bodies have callers in other modules, and ObjC
+  // entry points and functions with C-level references are called without
+  // any SIL-visible call site.
+  if (!F->isDefinition() || F->isAvailableExternally() ||
+      F->isPossiblyUsedExternally() || F->hasCReferences() ||
+      F->getRepresentation() == SILFunctionTypeRepresentation::ObjCMethod)
+    return false;
+
+  auto Iter = KnownCallSites.find(F);
+  if (Iter == KnownCallSites.end() || Iter->second.empty())
+    return false;
+  auto &Sites = Iter->second;
+
+  bool Changed = false;
+  auto FnArgs = F->getArguments();
+  for (unsigned ArgIdx = 0, NumArgs = FnArgs.size(); ArgIdx != NumArgs;
+       ++ArgIdx) {
+    SILArgument *Arg = FnArgs[ArgIdx];
+    SILType ArgTy = Arg->getType();
+    if (Arg->use_empty() || ArgTy.hasArchetype() || !ArgTy.isObject() ||
+        !ArgTy.isTrivial(F->getModule()))
+      continue;
+
+    SingleValueInstruction *Constant = nullptr;
+    bool AllSame = true;
+    for (FullApplySite Site : Sites) {
+      if (Site.getNumArguments() != NumArgs) {
+        AllSame = false;
+        break;
+      }
+      auto *C = getConstant(Site.getArguments()[ArgIdx]);
+      if (!C || C->getType() != ArgTy ||
+          (Constant && !isSameConstant(Constant, C))) {
+        AllSame = false;
+        break;
+      }
+      Constant = C;
+    }
+    if (!AllSame || !Constant)
+      continue;
+
+    DEBUG(llvm::dbgs() << "  folding argument " << ArgIdx << " of "
+                       << F->getName() << '\n');
+    SILBuilder B(&*F->begin()->begin());
+    Arg->replaceAllUsesWith(
+        materializeConstant(Constant, B, RegularLocation::getAutoGeneratedLocation()));
+    ++NumArgumentsFolded;
+    Changed = true;
+  }
+  return Changed;
+}
+
+void IPConstantPropagation::run() {
+  auto *BCA = getAnalysis<BasicCalleeAnalysis>();
+
+  collectCallSites();
+
+  // Process callees before callers, so constant returns propagate through
+  // chains of wrappers in one run and the argument summaries below see the
+  // folded values.
+  BottomUpFunctionOrder BottomUpOrder(*getModule(), BCA);
+  for (SILFunction *F : BottomUpOrder.getFunctions()) {
+    if (!F->isDefinition())
+      continue;
+    bool Changed = propagateReturns(F);
+    if (auto *C = getConstantReturn(F))
+      ConstantReturns[F] = C;
+    if (Changed)
+      invalidateAnalysis(F, SILAnalysis::InvalidationKind::Instructions);
+  }
+
+  for (SILFunction *F : BottomUpOrder.getFunctions()) {
+    if (propagateArguments(F))
+      invalidateAnalysis(F, SILAnalysis::InvalidationKind::Instructions);
+  }
+
+  ConstantReturns.clear();
+  KnownCallSites.clear();
+}
+
+SILTransform *swift::createIPConstantPropagation() {
+  return new IPConstantPropagation();
+}
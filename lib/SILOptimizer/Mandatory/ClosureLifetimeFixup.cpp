@@ -546,9 +546,10 @@ class ClosureLifetimeFixup : public SILFunctionTransform {
       return;
 
     // Fixup convert_escape_to_noescape [not_guaranteed] and
-    // copy_block_without_escaping instructions.
+    // copy_block_without_escaping instructions. We only insert and remove
+    // instructions; the CFG is not changed.
     if (fixupClosureLifetimes(*getFunction()))
-      invalidateAnalysis(SILAnalysis::InvalidationKind::FunctionBody);
+      invalidateAnalysis(SILAnalysis::InvalidationKind::Instructions);
     DEBUG(getFunction()->verify());
 
   }
@@ -13,6 +13,8 @@
 #define DEBUG_TYPE "sil-passmanager"
 
 #include "swift/SILOptimizer/PassManager/PassManager.h"
+#include "swift/AST/ASTContext.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/Demangling/Demangle.h"
 #include "swift/SIL/SILFunction.h"
 #include "swift/SIL/SILModule.h"
@@ -29,6 +31,7 @@
 #include "llvm/Support/GraphWriter.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/Chrono.h"
+#include "llvm/Support/Process.h"
 
 using namespace swift;
 
@@ -304,6 +307,19 @@ void SILPassManager::dumpPassInfo(const char *Title, unsigned TransIdx,
   llvm::dbgs() << '\n';
 }
 
+/// Update the running counters which feed the fine-grained stats trace.
+/// They are refreshed before and after each pass, so the deltas the
+/// FrontendStatsTracer records around the pass attribute created/deleted
+/// instructions and malloc usage to the individual (pass, function) event.
+static void updateStatsTraceCounters(UnifiedStatsReporter *Stats) {
+  if (!Stats)
+    return;
+  auto &C = Stats->getFrontendCounters();
+  C.NumSILInstructionsCreated = SILInstruction::getNumCreatedInstructions();
+  C.NumSILInstructionsDeleted = SILInstruction::getNumDeletedInstructions();
+  C.SILOptMallocUsage = llvm::sys::Process::GetMallocUsage();
+}
+
 void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
 
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
@@ -343,11 +359,18 @@ void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
     F->dump(getOptions().EmitVerboseSIL);
   }
 
+  auto *Stats = F->getModule().getASTContext().Stats;
+  updateStatsTraceCounters(Stats);
+
   llvm::sys::TimePoint<> StartTime = std::chrono::system_clock::now();
   Mod->registerDeleteNotificationHandler(SFT);
   if (breakBeforeRunning(F->getName(), SFT))
     LLVM_BUILTIN_DEBUGTRAP;
-  SFT->run();
+  {
+    FrontendStatsTracer StatsTracer(Stats, SFT->getID(), F);
+    SFT->run();
+    updateStatsTraceCounters(Stats);
+  }
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
   Mod->removeDeleteNotificationHandler(SFT);
 
@@ -384,14 +407,24 @@ runFunctionPasses(unsigned FromTransIdx, unsigned ToTransIdx) {
   if (ToTransIdx <= FromTransIdx)
     return;
 
-  BasicCalleeAnalysis *BCA = getAnalysis<BasicCalleeAnalysis>();
-  BottomUpFunctionOrder BottomUpOrder(*Mod, BCA);
-  auto BottomUpFunctions = BottomUpOrder.getFunctions();
+  // Recompute the bottom-up function order if the call graph changed since
+  // it was last computed. This walks the whole module, so reuse the cached
+  // order for pipeline segments which follow passes that left the call graph
+  // alone.
+  if (FunctionOrderIsStale) {
+    BasicCalleeAnalysis *BCA = getAnalysis<BasicCalleeAnalysis>();
+    BottomUpFunctionOrder BottomUpOrder(*Mod, BCA);
+    auto BottomUpFunctions = BottomUpOrder.getFunctions();
+    BottomUpFunctionOrderCache.assign(BottomUpFunctions.begin(),
+                                      BottomUpFunctions.end());
+    FunctionOrderIsStale = false;
+  }
 
   assert(FunctionWorklist.empty() && "Expected empty function worklist!");
 
-  FunctionWorklist.reserve(BottomUpFunctions.size());
-  for (auto I = BottomUpFunctions.rbegin(), E = BottomUpFunctions.rend();
+  FunctionWorklist.reserve(BottomUpFunctionOrderCache.size());
+  for (auto I = BottomUpFunctionOrderCache.rbegin(),
+            E = BottomUpFunctionOrderCache.rend();
        I != E; ++I) {
     auto &F = **I;
 
@@ -458,6 +491,8 @@ void SILPassManager::runModulePass(unsigned TransIdx) {
   updateSILModuleStatsBeforeTransform(*Mod, SMT, *this, NumPassesRun);
 
   CurrentPassHasInvalidated = false;
+  CurrentPassChangedFunctions.clear();
+  CurrentPassInvalidatedAll = false;
 
   if (SILPrintPassName)
     dumpPassInfo("Run module pass", TransIdx);
@@ -467,10 +502,17 @@ void SILPassManager::runModulePass(unsigned TransIdx) {
     printModule(Mod, Options.EmitVerboseSIL);
   }
 
+  auto *Stats = Mod->getASTContext().Stats;
+  updateStatsTraceCounters(Stats);
+
   llvm::sys::TimePoint<> StartTime = std::chrono::system_clock::now();
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
   Mod->registerDeleteNotificationHandler(SMT);
-  SMT->run();
+  {
+    FrontendStatsTracer StatsTracer(Stats, SMT->getID());
+    SMT->run();
+    updateStatsTraceCounters(Stats);
+  }
   Mod->removeDeleteNotificationHandler(SMT);
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
 
@@ -490,7 +532,16 @@ void SILPassManager::runModulePass(unsigned TransIdx) {
 
   if (Options.VerifyAll &&
       (CurrentPassHasInvalidated || !SILVerifyWithoutInvalidation)) {
-    Mod->verify();
+    // If the pass reported every change through the per-function
+    // invalidation notifications, it suffices to re-verify the functions it
+    // touched. Wholesale invalidations (and table changes, which funnel
+    // through invalidateFunctionTables) fall back to the whole module.
+    if (CurrentPassHasInvalidated && !CurrentPassInvalidatedAll) {
+      for (SILFunction *changed : CurrentPassChangedFunctions)
+        changed->verify();
+    } else {
+      Mod->verify();
+    }
     verifyAnalyses();
   }
 }
@@ -603,6 +654,8 @@ void SILPassManager::addFunctionToWorklist(SILFunction *F,
 
   StoredLevel = NewLevel;
   FunctionWorklist.push_back(F);
+  // The new function is not part of the cached bottom-up order yet.
+  FunctionOrderIsStale = true;
 }
 
 void SILPassManager::restartWithCurrentFunction(SILTransform *T) {
@@ -268,6 +268,10 @@ void addSSAPasses(SILPassPipelinePlan &P, OptimizationLevelKind OpLevel) {
   case OptimizationLevelKind::MidLevel:
     P.addGlobalOpt();
     P.addLetPropertiesOpt();
+    // Annotate externally visible functions with their computed effects, so
+    // that clients importing this module don't have to assume the worst for
+    // calls whose callee bodies are not serialized.
+    P.addSideEffectsInference();
     // It is important to serialize before any of the @_semantics
     // functions are inlined, because otherwise the information about
     // uses of such functions inside the module is lost,
@@ -366,6 +370,10 @@ static void addMidModulePassesStackPromotePassPipeline(SILPassPipelinePlan &P) {
   P.addDeadObjectElimination();
   P.addGlobalPropertyOpt();
 
+  // Fold constant returns and arguments across function boundaries while a
+  // module pass still sees every caller.
+  P.addIPConstantPropagation();
+
   // Do the first stack promotion on high-level SIL.
   P.addStackPromotion();
 }
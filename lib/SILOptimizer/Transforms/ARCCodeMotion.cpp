@@ -73,7 +73,9 @@
 #include "swift/SIL/SILBuilder.h"
 #include "swift/SILOptimizer/Analysis/AliasAnalysis.h"
 #include "swift/SILOptimizer/Analysis/ARCAnalysis.h"
+#include "swift/SILOptimizer/Analysis/DominanceAnalysis.h"
 #include "swift/SILOptimizer/Analysis/EscapeAnalysis.h"
+#include "swift/SILOptimizer/Analysis/LoopAnalysis.h"
 #include "swift/SILOptimizer/Analysis/PostOrderAnalysis.h"
 #include "swift/SILOptimizer/Analysis/RCIdentityAnalysis.h"
 #include "swift/SILOptimizer/PassManager/Passes.h"
@@ -91,6 +93,8 @@ using namespace swift;
 
 STATISTIC(NumRetainsSunk, "Number of retains sunk");
 STATISTIC(NumReleasesHoisted, "Number of releases hoisted");
+STATISTIC(NumRetainReleasePairsEliminated,
+          "Number of retain/release pairs eliminated after code motion");
 
 llvm::cl::opt<bool> DisableARCCodeMotion("disable-arc-cm", llvm::cl::init(false));
 
@@ -677,6 +681,66 @@ class ReleaseCodeMotionContext : public CodeMotionContext {
     return nullptr;
   }
 
+  /// Find the retains which form a balanced pair with \p Release, i.e. they
+  /// retain the same RC root and no instruction in between can observe the
+  /// reference count. This is either the instruction immediately before the
+  /// release, or, if the release was anchored at the beginning of its block, a
+  /// retain at the end of every predecessor.
+  ///
+  /// In the latter case the released value may be a block argument and the
+  /// retains operate on the incoming values, e.g.
+  ///    bb1:
+  ///      strong_retain %a
+  ///      br bb3(%a)
+  ///    bb2:
+  ///      strong_retain %b
+  ///      br bb3(%b)
+  ///    bb3(%c):
+  ///      strong_release %c
+  /// All the retains execute immediately before the release on every path and
+  /// only the branches are in between, which do not touch any reference count.
+  ///
+  /// \return true and the paired retains in \p Retains if such retains are
+  /// found on all paths.
+  bool findPairedRetains(SILInstruction *Release,
+                         llvm::SmallVectorImpl<SILInstruction *> &Retains) {
+    SILBasicBlock *BB = Release->getParent();
+    auto InstIter = Release->getIterator();
+    if (InstIter != BB->begin()) {
+      SILInstruction *Prev = &*std::prev(InstIter);
+      if (!isRetainInstruction(Prev) || getRCRoot(Prev) != getRCRoot(Release))
+        return false;
+      Retains.push_back(Prev);
+      return true;
+    }
+
+    if (BB->pred_empty())
+      return false;
+
+    SILValue Root = getRCRoot(Release);
+    auto *RootArg = dyn_cast<SILArgument>(Root);
+    if (RootArg && RootArg->getParent() != BB)
+      RootArg = nullptr;
+
+    for (SILBasicBlock *Pred : BB->getPredecessorBlocks()) {
+      // Only unconditional branches qualify: any other terminator has more
+      // successors, so the retain in the predecessor is also needed on the
+      // other paths.
+      auto *Branch = dyn_cast<BranchInst>(Pred->getTerminator());
+      if (!Branch || &*Pred->begin() == Branch)
+        return false;
+      // If the released value is an argument of this block, the retain in the
+      // predecessor pairs with the incoming value on this edge.
+      SILValue PredRoot =
+          RootArg ? getRCRoot(Branch->getArg(RootArg->getIndex())) : Root;
+      SILInstruction *Prev = &*std::prev(Branch->getIterator());
+      if (!isRetainInstruction(Prev) || getRCRoot(Prev) != PredRoot)
+        return false;
+      Retains.push_back(Prev);
+    }
+    return true;
+  }
+
 public:
   /// Constructor.
   ReleaseCodeMotionContext(llvm::SpecificBumpPtrAllocator<BlockState> &BPA,
@@ -906,16 +970,18 @@ bool ReleaseCodeMotionContext::performCodeMotion() {
   // retain/release the same RCRoot, e.g.
   //    strong_retain %2
   //    strong_release %2
+  // The pairs may also meet on block boundaries: the retains were sunk to the
+  // end of the predecessors and the release was hoisted to the beginning of
+  // the block where the paths merge.
   for (SILInstruction *ReleaseInst : NewReleases) {
-    auto InstIter = ReleaseInst->getIterator();
-    if (InstIter == ReleaseInst->getParent()->begin())
+    llvm::SmallVector<SILInstruction *, 4> PairedRetains;
+    if (!findPairedRetains(ReleaseInst, PairedRetains))
       continue;
-
-    SILInstruction *PrevInst = &*std::prev(InstIter);
-    if (isRetainInstruction(PrevInst) && getRCRoot(PrevInst) == getRCRoot(ReleaseInst)) {
-      recursivelyDeleteTriviallyDeadInstructions(PrevInst, true);
-      recursivelyDeleteTriviallyDeadInstructions(ReleaseInst, true);
-    }
+    for (SILInstruction *RetainInst : PairedRetains)
+      recursivelyDeleteTriviallyDeadInstructions(RetainInst, true);
+    recursivelyDeleteTriviallyDeadInstructions(ReleaseInst, true);
+    ++NumRetainReleasePairsEliminated;
+    Changed = true;
   }
 
   return Changed;
@@ -1084,12 +1150,18 @@ public:
     DEBUG(llvm::dbgs() << "*** ARCCM on function: " << F->getName() << " ***\n");
 
     PostOrderAnalysis *POA = PM->getAnalysis<PostOrderAnalysis>();
+    auto *DA = PM->getAnalysis<DominanceAnalysis>();
+    auto *LA = PM->getAnalysis<SILLoopAnalysis>();
 
-    // Split all critical edges.
+    // Split all critical edges. If the dominator tree or loop info have
+    // already been computed for this function, update them incrementally
+    // instead of throwing them away below.
     //
     // TODO: maybe we can do this lazily or maybe we should disallow SIL passes
     // to create critical edges.
-    bool EdgeChanged = splitAllCriticalEdges(*F, false, nullptr, nullptr);
+    bool EdgeChanged = splitAllCriticalEdges(
+        *F, false, DA->maybeGet(F).getPtrOrNull(),
+        LA->maybeGet(F).getPtrOrNull());
     if (EdgeChanged)
       POA->invalidateFunction(F);
 
@@ -1118,8 +1190,13 @@ public:
     }
 
     if (EdgeChanged) {
-      // We splitted critical edges.
+      // We splitted critical edges, but kept the dominator tree and loop
+      // info up to date while doing so.
+      DA->lockInvalidation();
+      LA->lockInvalidation();
       invalidateAnalysis(SILAnalysis::InvalidationKind::FunctionBody);
+      DA->unlockInvalidation();
+      LA->unlockInvalidation();
       return;
     }
     if (InstChanged) {
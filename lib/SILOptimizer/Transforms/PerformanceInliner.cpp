@@ -13,6 +13,7 @@
 #define DEBUG_TYPE "sil-inliner"
 #include "swift/AST/Module.h"
 #include "swift/SIL/OptimizationRemark.h"
+#include "swift/SILOptimizer/Analysis/InlineCostAnalysis.h"
 #include "swift/SILOptimizer/Analysis/SideEffectAnalysis.h"
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "swift/SILOptimizer/PassManager/Transforms.h"
@@ -53,7 +54,11 @@ class SILPerformanceInliner {
   SILLoopAnalysis *LA;
   SideEffectAnalysis *SEA;
 
-  // For keys of SILFunction and SILLoop.
+  /// Caches the caller-independent shortest-path analysis of callees.
+  InlineCostAnalysis *ICA;
+
+  // The caller's shortest-path analysis, which is computed with the real
+  // lengths of the called functions. For keys of SILFunction and SILLoop.
   llvm::DenseMap<SILFunction *, ShortestPathAnalysis *> SPAs;
   llvm::SpecificBumpPtrAllocator<ShortestPathAnalysis> SPAAllocator;
 
@@ -113,7 +118,7 @@ class SILPerformanceInliner {
     OverallCallerBlockLimit = 400,
 
     /// The assumed execution length of a function call.
-    DefaultApplyLength = 10
+    DefaultApplyLength = ShortestPathAnalysis::DefaultApplyLength
   };
 
   OptimizationMode OptMode;
@@ -166,9 +171,10 @@ class SILPerformanceInliner {
 public:
   SILPerformanceInliner(InlineSelection WhatToInline, DominanceAnalysis *DA,
                         SILLoopAnalysis *LA, SideEffectAnalysis *SEA,
-                        OptimizationMode OptMode, OptRemark::Emitter &ORE)
-      : WhatToInline(WhatToInline), DA(DA), LA(LA), SEA(SEA), CBI(DA), ORE(ORE),
-        OptMode(OptMode) {}
+                        InlineCostAnalysis *ICA, OptimizationMode OptMode,
+                        OptRemark::Emitter &ORE)
+      : WhatToInline(WhatToInline), DA(DA), LA(LA), SEA(SEA), ICA(ICA),
+        CBI(DA), ORE(ORE), OptMode(OptMode) {}
 
   bool inlineCallsIntoFunction(SILFunction *F);
 };
@@ -283,8 +289,7 @@ bool SILPerformanceInliner::isProfitableToInline(
     return false;
   }
 
-  SILLoopInfo *LI = LA->get(Callee);
-  ShortestPathAnalysis *SPA = getSPA(Callee, LI);
+  ShortestPathAnalysis *SPA = ICA->get(Callee);
   assert(SPA->isValid());
 
   ConstantTracker constTracker(Callee, &callerTracker, AI);
@@ -699,16 +704,10 @@ void SILPerformanceInliner::collectAppliesToInline(
     addWeightCorrection(FAS, WeightCorrections);
 
     if (SILFunction *Callee = getEligibleFunction(FAS, WhatToInline)) {
-      // Compute the shortest-path analysis for the callee.
-      SILLoopInfo *CalleeLI = LA->get(Callee);
-      ShortestPathAnalysis *CalleeSPA = getSPA(Callee, CalleeLI);
-      if (!CalleeSPA->isValid()) {
-        CalleeSPA->analyze(CBI, [](FullApplySite FAS) {
-          // We don't compute SPA for another call-level. Functions called from
-          // the callee are assumed to have DefaultApplyLength.
-          return DefaultApplyLength;
-        });
-      }
+      // Get the cached shortest-path analysis for the callee. It is computed
+      // without looking at another call-level, so it is independent of this
+      // caller and shared by all call sites of the callee.
+      ShortestPathAnalysis *CalleeSPA = ICA->get(Callee);
       int CalleeLength = CalleeSPA->getScopeLength(&Callee->front(), 0);
       // Just in case the callee is a noreturn function.
       if (CalleeLength >= ShortestPathAnalysis::InitialDist)
@@ -810,6 +809,27 @@ bool SILPerformanceInliner::inlineCallsIntoFunction(SILFunction *Caller) {
   if (AppliesToInline.empty())
     return false;
 
+  // Inlining a cross-module callee copies its apply sites into the caller,
+  // where the next inlining round will want the bodies of the functions they
+  // reference. Hint the deserializer about all of them up front so it can
+  // materialize them in one batched pass per module instead of one lookup at
+  // a time.
+  SmallVector<StringRef, 8> CalleesOfCallees;
+  for (auto AI : AppliesToInline) {
+    SILFunction *Callee = AI.getReferencedFunction();
+    if (!Callee->isAvailableExternally())
+      continue;
+    for (auto &BB : *Callee)
+      for (auto &I : BB)
+        if (auto *FRI = dyn_cast<FunctionRefInst>(&I)) {
+          SILFunction *Ref = FRI->getReferencedFunction();
+          if (Ref->isExternalDeclaration())
+            CalleesOfCallees.push_back(Ref->getName());
+        }
+  }
+  if (!CalleesOfCallees.empty())
+    Caller->getModule().preloadFunctions(CalleesOfCallees);
+
   // Second step: do the actual inlining.
   for (auto AI : AppliesToInline) {
     SILFunction *Callee = AI.getReferencedFunction();
@@ -897,6 +917,7 @@ public:
     DominanceAnalysis *DA = PM->getAnalysis<DominanceAnalysis>();
     SILLoopAnalysis *LA = PM->getAnalysis<SILLoopAnalysis>();
     SideEffectAnalysis *SEA = PM->getAnalysis<SideEffectAnalysis>();
+    InlineCostAnalysis *ICA = PM->getAnalysis<InlineCostAnalysis>();
     OptRemark::Emitter ORE(DEBUG_TYPE, getFunction()->getModule());
 
     if (getOptions().InlineThreshold == 0) {
@@ -905,7 +926,8 @@ public:
 
     auto OptMode = getFunction()->getEffectiveOptimizationMode();
 
-    SILPerformanceInliner Inliner(WhatToInline, DA, LA, SEA, OptMode, ORE);
+    SILPerformanceInliner Inliner(WhatToInline, DA, LA, SEA, ICA, OptMode,
+                                  ORE);
 
     assert(getFunction()->isDefinition() &&
            "Expected only functions with bodies!");
@@ -176,13 +176,21 @@ namespace {
 /// # of BBs x(times) # of locations.
 ///
 /// we could run RLE on functions with 128 basic blocks and 128 locations,
-/// which is a large function.  
+/// which is a large function.
 constexpr unsigned MaxLSLocationBBMultiplicationNone = 128*128;
 
 /// we could run optimistic RLE on functions with less than 64 basic blocks
 /// and 64 locations which is a sizable function.
 constexpr unsigned MaxLSLocationBBMultiplicationPessimistic = 64*64;
 
+/// Beyond MaxLSLocationBBMultiplicationNone we do not run the iterative data
+/// flow anymore, but a single round processed in reverse post order is still
+/// affordable: each basic block is processed once with the states summarized
+/// at its boundaries, and only values which are available along all forward
+/// paths are forwarded. Above this limit even the memory for the per-block
+/// states becomes excessive and the function is not optimized at all.
+constexpr uint64_t MaxLSLocationBBMultiplicationSingleRound = 2048*2048;
+
 /// forward declaration.
 class RLEContext;
 
@@ -1122,14 +1130,22 @@ getProcessFunctionKind(unsigned LoadCount, unsigned StoreCount) {
     HandledBBs.insert(B);
   }
 
-  // Data flow may take too long to run.
-  if (BBCount * LocationCount > MaxLSLocationBBMultiplicationNone)
-    return ProcessKind::ProcessNone;
+  // The iterative data flow may take too long to converge. Process every
+  // basic block once in reverse post order instead, which caps the cost at
+  // roughly one round of the data flow while keeping all forwarding within
+  // blocks and across forward edges. Use a 64-bit product: both counts can
+  // be large enough to overflow 32 bits on generated code.
+  uint64_t BBLocProduct = (uint64_t)BBCount * LocationCount;
+  if (BBLocProduct > MaxLSLocationBBMultiplicationNone) {
+    if (BBLocProduct > MaxLSLocationBBMultiplicationSingleRound)
+      return ProcessKind::ProcessNone;
+    return ProcessKind::ProcessOneIteration;
+  }
 
   // This function's data flow would converge in 1 iteration.
   if (RunOneIteration)
     return ProcessKind::ProcessOneIteration;
-  
+
   // We run one pessimistic data flow to do dead store elimination on
   // the function.
   if (BBCount * LocationCount > MaxLSLocationBBMultiplicationPessimistic)
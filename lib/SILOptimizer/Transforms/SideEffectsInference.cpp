@@ -0,0 +1,109 @@
+//===--- SideEffectsInference.cpp - Infer effects attributes --------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Infers effects attributes (like @_effects(readnone)) from the side-effects
+// which SideEffectAnalysis computed from the function bodies.
+//
+// The effects attributes are the only function summaries which are carried
+// in the swiftmodule for functions whose bodies are not serialized: the
+// attribute is part of every SIL function record, including the
+// declaration-only records emitted for referenced functions. Annotating
+// externally visible functions therefore lets SideEffectAnalysis and
+// EscapeAnalysis in client modules see that a call does not write to memory
+// instead of assuming the worst at the module boundary.
+//
+// The pass must run before the module is serialized.
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "side-effects-inference"
+#include "swift/SILOptimizer/Analysis/SideEffectAnalysis.h"
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "llvm/ADT/Statistic.h"
+
+STATISTIC(NumInferredEffects, "Number of inferred effects attributes");
+
+using namespace swift;
+
+namespace {
+
+class SideEffectsInference : public SILModuleTransform {
+
+  /// Returns the most precise effects attribute which covers the computed
+  /// \p Effects, or Unspecified if there is none.
+  ///
+  /// Consumers reconstruct the effects of an attributed function with
+  /// FunctionSideEffects::setDefinedEffects. An attribute is only correct if
+  /// the effects it reconstructs to are a superset of the computed effects.
+  static EffectsKind inferEffectsKind(const FunctionSideEffects &Effects) {
+    // None of the attributes covers allocations, traps or reference count
+    // reads.
+    if (Effects.mayAllocObjects() || Effects.mayTrap() || Effects.mayReadRC())
+      return EffectsKind::Unspecified;
+
+    // The attributes don't distinguish between global and parameter effects.
+    FunctionSideEffectFlags AllEffects = Effects.getGlobalEffects();
+    for (const FunctionSideEffectFlags &ParamEffects :
+         Effects.getParameterEffects())
+      AllEffects.mergeFrom(ParamEffects);
+
+    // All three attributes promise the absence of retains and releases.
+    if (AllEffects.mayRetain() || AllEffects.mayRelease())
+      return EffectsKind::Unspecified;
+
+    if (!AllEffects.mayWrite()) {
+      if (!AllEffects.mayRead())
+        return EffectsKind::ReadNone;
+      return EffectsKind::ReadOnly;
+    }
+    return EffectsKind::ReleaseNone;
+  }
+
+public:
+  void run() override {
+    auto *SEA = PM->getAnalysis<SideEffectAnalysis>();
+
+    for (SILFunction &F : *getModule()) {
+      if (!F.isDefinition())
+        continue;
+
+      // Don't override an attribute written by the programmer.
+      if (F.getEffectsKind() != EffectsKind::Unspecified)
+        continue;
+
+      // Only annotate functions whose attribute can be seen from other
+      // modules. Within the module the analysis itself provides more precise
+      // per-parameter effects than the attribute can express.
+      if (!F.isPossiblyUsedExternally() && !F.isSerialized())
+        continue;
+
+      EffectsKind Inferred = inferEffectsKind(SEA->getEffects(&F));
+      if (Inferred == EffectsKind::Unspecified)
+        continue;
+
+      DEBUG(llvm::dbgs() << "  inferred [" << (unsigned)Inferred << "] for "
+                         << F.getName() << '\n');
+      F.setEffectsKind(Inferred);
+      ++NumInferredEffects;
+      // Setting the attribute does not change any SIL code, so there is no
+      // need to invalidate anything.
+    }
+  }
+
+};
+
+} // end anonymous namespace
+
+SILTransform *swift::createSideEffectsInference() {
+  return new SideEffectsInference();
+}
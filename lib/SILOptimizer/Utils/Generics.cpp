@@ -1796,7 +1796,16 @@ GenericFuncSpecializer::GenericFuncSpecializer(SILFunction *GenericFunc,
 
 /// Return an existing specialization if one exists.
 SILFunction *GenericFuncSpecializer::lookupSpecialization() {
-  if (SILFunction *SpecializedF = M.lookUpFunction(ClonedName)) {
+  SILFunction *SpecializedF = M.lookUpFunction(ClonedName);
+  if (!SpecializedF && Serialized == IsSerialized) {
+    // The module does not contain the specialization yet, but an imported
+    // module may: serialized specializations are emitted into the swiftmodule
+    // of the module which created them. Deserializing the already optimized
+    // body is much cheaper than cloning the generic function and optimizing
+    // the clone again in every module which requests the same specialization.
+    SpecializedF = M.loadFunction(ClonedName);
+  }
+  if (SpecializedF) {
     if (ReInfo.getSpecializedType() != SpecializedF->getLoweredFunctionType()) {
       llvm::dbgs() << "Looking for a function: " << ClonedName << "\n"
                    << "Expected type: " << ReInfo.getSpecializedType() << "\n"
@@ -8371,6 +8371,18 @@ Expr *TypeChecker::callWitness(Expr *base, DeclContext *dc,
   return result;
 }
 
+Expr *TypeChecker::applyLiteralDefaultType(LiteralExpr *literal, Type type,
+                                           DeclContext *dc) {
+  // Set up a trivial constraint system and solution in which the literal is
+  // already bound to the given type, and reuse the solution rewriter to
+  // build the initializer call. No solving takes place.
+  ConstraintSystem cs(*this, dc, ConstraintSystemOptions());
+  cs.setType(literal, type);
+  Solution solution(cs, Score());
+  return cs.applySolutionShallow(solution, literal,
+                                 /*suppressDiagnostics=*/false);
+}
+
 Expr *
 Solution::convertBooleanTypeToBuiltinI1(Expr *expr,
                                         ConstraintLocator *locator) const {
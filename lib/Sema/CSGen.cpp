@@ -23,6 +23,7 @@
 #include "swift/AST/SubstitutionMap.h"
 #include "swift/Sema/IDETypeChecking.h"
 #include "llvm/ADT/APInt.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringSwitch.h"
 #include <utility>
@@ -809,7 +810,92 @@ namespace {
                          mustConsider);
     }
   }
-  
+
+  /// Disable overload choices whose declared argument-list shape (arity,
+  /// labels, trailing-closure compatibility) cannot match the call site, so
+  /// the solver never attempts them.
+  ///
+  /// The check is purely syntactic and conservative: a choice is only
+  /// disabled when no argument matching could succeed without a fix, and
+  /// never when it would empty the overload set.
+  void disableShapeIncompatibleOverloads(ApplyExpr *expr,
+                                         ConstraintSystem &CS) {
+    // When fixes are allowed we are diagnosing; keep every candidate so
+    // diagnostics can consider near misses.
+    if (CS.shouldAttemptFixes())
+      return;
+
+    auto *call = dyn_cast<CallExpr>(expr);
+    if (!call || !isa<OverloadedDeclRefExpr>(call->getFn()))
+      return;
+
+    unsigned nArgs = call->getNumArguments();
+    auto argLabels = call->getArgumentLabels();
+    bool hasTrailingClosure = call->hasTrailingClosure();
+
+    auto &TC = CS.getTypeChecker();
+    auto isCompatible = [&](ValueDecl *decl) -> bool {
+      auto shape = TC.getArgumentShape(decl);
+      if (!shape)
+        return true;
+
+      if (nArgs < shape->MinArity)
+        return false;
+      if (!shape->HasVariadic && nArgs > shape->MaxArity)
+        return false;
+      if (hasTrailingClosure && !shape->AcceptsTrailingClosure)
+        return false;
+
+      // Every label the call supplies must be a label the declaration
+      // accepts somewhere.
+      for (auto label : argLabels) {
+        if (!label.empty() && !llvm::is_contained(shape->Labels, label))
+          return false;
+      }
+
+      return true;
+    };
+
+    // Find the disjunction that binds the overload set, as
+    // favorCallOverloads does.
+    auto tyvarType = CS.getType(call->getFn())->getAs<TypeVariableType>();
+    if (!tyvarType)
+      return;
+
+    auto &CG = CS.getConstraintGraph();
+    SmallVector<Constraint *, 4> constraints;
+    CG.gatherConstraints(tyvarType, constraints,
+                         ConstraintGraph::GatheringKind::EquivalenceClass);
+
+    for (auto *constraint : constraints) {
+      if (constraint->getKind() != ConstraintKind::Disjunction)
+        continue;
+
+      auto nested = constraint->getNestedConstraints();
+      if (nested[0]->getKind() != ConstraintKind::BindOverload)
+        continue;
+
+      SmallVector<Constraint *, 4> incompatible;
+      unsigned numViable = 0;
+      for (auto *choice : nested) {
+        if (choice->getKind() != ConstraintKind::BindOverload ||
+            !choice->getOverloadChoice().isDecl() ||
+            isCompatible(choice->getOverloadChoice().getDecl()))
+          ++numViable;
+        else
+          incompatible.push_back(choice);
+      }
+
+      // Never disable the entire overload set; if nothing can match, let the
+      // solver fail with all of the candidates visible.
+      if (numViable == 0)
+        continue;
+
+      for (auto *choice : incompatible)
+        choice->setDisabled();
+    }
+  }
+
   /// Favor binary operator constraints where we have exact matches
   /// for the operands and contextual type.
   void favorMatchingBinaryOperators(ApplyExpr *expr,
@@ -929,6 +1015,7 @@ namespace {
           favorMatchingBinaryOperators(applyExpr, CS);
         } else {
           favorMatchingOverloadExprs(applyExpr, CS);
+          disableShapeIncompatibleOverloads(applyExpr, CS);
         }
       }
       
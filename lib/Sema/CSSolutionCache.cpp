@@ -0,0 +1,153 @@
+//===--- CSSolutionCache.cpp - Persistent Expression Solutions ------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the build-local cache of constraint solver overload
+// choices described in CSSolutionCache.h.
+//
+// The cache is stored as a text file with one record per line:
+//
+//   <16 hex digit key> TAB <choice identity> [TAB <choice identity> ...]
+//
+// Records that fail to parse are dropped silently; the cache only ever
+// influences the order in which the solver explores disjunctions.
+//
+//===----------------------------------------------------------------------===//
+
+#include "CSSolutionCache.h"
+#include "ConstraintSystem.h"
+#include "swift/AST/Expr.h"
+#include "swift/AST/Module.h"
+#include "swift/Basic/SourceManager.h"
+#include "swift/Parse/Lexer.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace swift;
+using namespace constraints;
+
+ExprSolutionCache::ExprSolutionCache(StringRef cacheDirectory) {
+  llvm::SmallString<128> path(cacheDirectory);
+  llvm::sys::path::append(path, "expr-solutions.cache");
+  CachePath = path.str();
+}
+
+void ExprSolutionCache::load() {
+  Loaded = true;
+
+  auto bufferOrError = llvm::MemoryBuffer::getFile(CachePath);
+  if (!bufferOrError)
+    return;
+
+  StringRef remaining = bufferOrError.get()->getBuffer();
+  while (!remaining.empty()) {
+    StringRef line;
+    std::tie(line, remaining) = remaining.split('\n');
+
+    StringRef keyText;
+    std::tie(keyText, line) = line.split('\t');
+    uint64_t key;
+    if (keyText.getAsInteger(16, key) || line.empty())
+      continue;
+
+    auto &choices = Entries[key];
+    while (!line.empty()) {
+      StringRef choice;
+      std::tie(choice, line) = line.split('\t');
+      if (!choice.empty())
+        choices.insert(choice);
+    }
+  }
+}
+
+ExprSolutionCache::~ExprSolutionCache() {
+  if (!Dirty)
+    return;
+
+  // Write the merged entries to a temporary file and rename it into place so
+  // concurrent frontend jobs sharing the cache directory never observe a
+  // partially written file.
+  llvm::SmallString<128> tempPath;
+  int tempFD;
+  if (llvm::sys::fs::createUniqueFile(CachePath + ".tmp-%%%%%%", tempFD,
+                                      tempPath))
+    return;
+
+  {
+    llvm::raw_fd_ostream out(tempFD, /*shouldClose=*/true);
+    for (const auto &entry : Entries) {
+      out << llvm::format_hex_no_prefix(entry.first, 16);
+      for (const auto &choice : entry.second)
+        out << '\t' << choice.getKey();
+      out << '\n';
+    }
+  }
+
+  if (llvm::sys::fs::rename(tempPath, CachePath))
+    llvm::sys::fs::remove(tempPath);
+}
+
+Optional<uint64_t> ExprSolutionCache::getKeyForExpr(SourceManager &SM,
+                                                    Expr *expr,
+                                                    Type convertType) {
+  auto range = expr->getSourceRange();
+  if (range.isInvalid())
+    return None;
+
+  auto charRange = Lexer::getCharSourceRangeFromSourceRange(SM, range);
+  StringRef text = SM.extractText(charRange);
+  if (text.empty())
+    return None;
+
+  llvm::hash_code hash = llvm::hash_value(text);
+  if (convertType)
+    hash = llvm::hash_combine(hash, convertType->getString());
+  return uint64_t(hash);
+}
+
+std::string ExprSolutionCache::getChoiceIdentity(const OverloadChoice &choice) {
+  if (!choice.isDecl())
+    return std::string();
+
+  auto *decl = choice.getDecl();
+  llvm::SmallString<64> scratch;
+  llvm::raw_svector_ostream out(scratch);
+  out << decl->getModuleContext()->getName() << '.';
+  decl->getFullName().print(out, /*skipEmptyArgumentNames=*/false);
+
+  // Disambiguate overloads that share a full name.
+  if (auto type = decl->getInterfaceType())
+    out << " : " << type->getString();
+  return out.str();
+}
+
+const llvm::StringSet<> *ExprSolutionCache::lookup(uint64_t key) {
+  if (!Loaded)
+    load();
+
+  auto known = Entries.find(key);
+  if (known == Entries.end())
+    return nullptr;
+  return &known->second;
+}
+
+void ExprSolutionCache::record(uint64_t key, llvm::StringSet<> choices) {
+  if (!Loaded)
+    load();
+
+  Entries[key] = std::move(choices);
+  Dirty = true;
+}
@@ -0,0 +1,86 @@
+//===--- CSSolutionCache.h - Persistent Expression Solutions ----*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// This file provides a cache of the overload choices the constraint solver
+// discovered for previously solved expressions, persisted across frontend
+// invocations in a build-local directory. The cache is purely an exploration
+// hint: on a hit the recorded choices are favored so the solver tries them
+// first, but the set of admissible solutions is unaffected, so a stale or
+// corrupt cache can never change the result of type checking.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_SEMA_CSSOLUTIONCACHE_H
+#define SWIFT_SEMA_CSSOLUTIONCACHE_H
+
+#include "swift/AST/Type.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/StringSet.h"
+#include <string>
+
+namespace swift {
+
+class Expr;
+class SourceManager;
+
+namespace constraints {
+
+class OverloadChoice;
+
+/// A build-local, cross-invocation cache of the overload choices that made up
+/// the solution of each previously solved expression, keyed by a content hash
+/// of the expression source and its contextual type.
+class ExprSolutionCache {
+  /// The file in which the cache is persisted.
+  std::string CachePath;
+
+  /// Whether the cache file has been read.
+  bool Loaded = false;
+
+  /// Whether new entries were recorded since the cache was loaded.
+  bool Dirty = false;
+
+  /// The recorded overload choice identities for each expression key.
+  llvm::DenseMap<uint64_t, llvm::StringSet<>> Entries;
+
+  void load();
+
+public:
+  explicit ExprSolutionCache(StringRef cacheDirectory);
+
+  /// Writes any newly recorded entries back to the cache file.
+  ~ExprSolutionCache();
+
+  /// Compute the cache key for an expression solved against the given
+  /// contextual type, or None if the expression has no usable source range.
+  static Optional<uint64_t> getKeyForExpr(SourceManager &SM, Expr *expr,
+                                          Type convertType);
+
+  /// Render a stable, invocation-independent identity for an overload
+  /// choice, or an empty string if the choice does not reference a
+  /// declaration.
+  static std::string getChoiceIdentity(const OverloadChoice &choice);
+
+  /// Returns the overload choice identities recorded for the given key, or
+  /// null if the expression has not been solved before.
+  const llvm::StringSet<> *lookup(uint64_t key);
+
+  /// Record the overload choice identities of a successfully solved
+  /// expression.
+  void record(uint64_t key, llvm::StringSet<> choices);
+};
+
+} // end namespace constraints
+} // end namespace swift
+
+#endif // SWIFT_SEMA_CSSOLUTIONCACHE_H
@@ -13,6 +13,7 @@
 // This file implements the constraint solver used in the type checker.
 //
 //===----------------------------------------------------------------------===//
+#include "CSSolutionCache.h"
 #include "ConstraintGraph.h"
 #include "ConstraintSystem.h"
 #include "swift/AST/ParameterList.h"
@@ -1327,6 +1328,17 @@ bool ConstraintSystem::solve(Expr *&expr,
                              ExprTypeCheckListener *listener,
                              SmallVectorImpl<Solution> &solutions,
                              FreeTypeVariableBinding allowFreeTypeVariables) {
+  // If the persistent expression solution cache is enabled, look up the
+  // overload choices that solved this expression in a previous invocation so
+  // disjunction exploration can try them first.
+  ExprSolutionCache *solutionCache = TC.getExprSolutionCache();
+  if (solutionCache) {
+    SolutionCacheKey = ExprSolutionCache::getKeyForExpr(
+        getASTContext().SourceMgr, expr, convertType);
+    if (SolutionCacheKey)
+      RecordedOverloadChoices = solutionCache->lookup(*SolutionCacheKey);
+  }
+
   // Attempt to solve the constraint system.
   auto solution = solveImpl(expr,
                             convertType,
@@ -1370,6 +1382,20 @@ bool ConstraintSystem::solve(Expr *&expr,
     }
   }
 
+  // Record the overload choices of an unambiguous solution so the next
+  // invocation can favor them.
+  if (solutionCache && SolutionCacheKey && solutions.size() == 1) {
+    llvm::StringSet<> choices;
+    for (const auto &overload : solutions[0].overloadChoices) {
+      auto identity =
+          ExprSolutionCache::getChoiceIdentity(overload.second.choice);
+      if (!identity.empty())
+        choices.insert(identity);
+    }
+    if (!choices.empty())
+      solutionCache->record(*SolutionCacheKey, std::move(choices));
+  }
+
   return false;
 }
 
@@ -1713,31 +1739,9 @@ bool ConstraintSystem::solveRec(SmallVectorImpl<Solution> &solutions,
   SmallVector<unsigned, 2> indices(numComponents, 0);
   bool done = false;
   bool anySolutions = false;
-  do {
-    // Create a new solver scope in which we apply all of the partial
-    // solutions.
-    SolverScope scope(*this);
-    for (unsigned i = 0; i != numComponents; ++i)
-      applySolution(partialSolutions[i][indices[i]]);
 
-    // This solution might be worse than the best solution found so far. If so,
-    // skip it.
-    if (!worseThanBestSolution()) {
-      // Finalize this solution.
-      auto solution = finalize(allowFreeTypeVariables);
-      if (TC.getLangOpts().DebugConstraintSolver) {
-        auto &log = getASTContext().TypeCheckerDebug->getStream();
-        log.indent(solverState->depth * 2)
-          << "(composed solution " << CurrentScore << ")\n";
-      }
-
-      // Save this solution.
-      solutions.push_back(std::move(solution));
-
-      anySolutions = true;
-    }
-    
-    // Find the next combination.
+  // Find the next combination.
+  auto nextCombination = [&] {
     for (unsigned n = numComponents; n > 0; --n) {
       ++indices[n-1];
 
@@ -1749,12 +1753,59 @@ bool ConstraintSystem::solveRec(SmallVectorImpl<Solution> &solutions,
       if (n == 1) {
         done = true;
         break;
-      } 
+      }
 
       // Zero out the indices from here to the end.
       for (unsigned i = n-1; i != numComponents; ++i)
         indices[i] = 0;
     }
+  };
+
+  do {
+    // Scores are additive across components, so we can compute the score a
+    // combination would produce without applying it. If it cannot beat the
+    // best solution found so far, skip the combination outright; this keeps
+    // the cost of enumerating the cross product of partial solutions
+    // proportional to the number of viable combinations rather than all of
+    // them.
+    if (!retainAllSolutions() && solverState->BestScore) {
+      Score combinedScore = CurrentScore;
+      for (unsigned i = 0; i != numComponents; ++i)
+        combinedScore += partialSolutions[i][indices[i]].getFixedScore();
+
+      if (combinedScore > *solverState->BestScore) {
+        ++solverState->NumComponentCombinationsSkipped;
+        nextCombination();
+        continue;
+      }
+    }
+
+    {
+      // Create a new solver scope in which we apply all of the partial
+      // solutions.
+      SolverScope scope(*this);
+      for (unsigned i = 0; i != numComponents; ++i)
+        applySolution(partialSolutions[i][indices[i]]);
+
+      // This solution might be worse than the best solution found so far. If
+      // so, skip it.
+      if (!worseThanBestSolution()) {
+        // Finalize this solution.
+        auto solution = finalize(allowFreeTypeVariables);
+        if (TC.getLangOpts().DebugConstraintSolver) {
+          auto &log = getASTContext().TypeCheckerDebug->getStream();
+          log.indent(solverState->depth * 2)
+            << "(composed solution " << CurrentScore << ")\n";
+        }
+
+        // Save this solution.
+        solutions.push_back(std::move(solution));
+
+        anySolutions = true;
+      }
+    }
+
+    nextCombination();
   } while (!done);
 
   return !anySolutions;
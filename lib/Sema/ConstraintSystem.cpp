@@ -16,6 +16,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include "ConstraintSystem.h"
+#include "CSSolutionCache.h"
 #include "ConstraintGraph.h"
 #include "swift/AST/GenericEnvironment.h"
 #include "swift/Basic/Statistic.h"
@@ -1533,6 +1534,22 @@ void ConstraintSystem::addOverloadSet(Type boundType,
 
   tryOptimizeGenericDisjunction(*this, choices, favoredChoice);
 
+  // If the persistent expression solution cache recorded the choice that
+  // solved this expression in a previous invocation, favor it so the solver
+  // explores it first.
+  if (!favoredChoice && RecordedOverloadChoices) {
+    for (auto &choice : choices) {
+      if (!choice.isDecl() ||
+          choice.getDecl()->getAttrs().isUnavailable(getASTContext()))
+        continue;
+      if (RecordedOverloadChoices->count(
+              ExprSolutionCache::getChoiceIdentity(choice))) {
+        favoredChoice = const_cast<OverloadChoice *>(&choice);
+        break;
+      }
+    }
+  }
+
   SmallVector<Constraint *, 4> overloads;
   
   // As we do for other favored constraints, if a favored overload has been
@@ -36,6 +36,7 @@
 #include "llvm/ADT/SetOperations.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
@@ -894,7 +895,17 @@ public:
   DeclContext *DC;
   ConstraintSystemOptions Options;
   Optional<ExpressionTimer> Timer;
-  
+
+  /// The key identifying the expression being solved in the persistent
+  /// expression solution cache, if the cache is enabled.
+  Optional<uint64_t> SolutionCacheKey;
+
+  /// The overload choice identities recorded for this expression by a
+  /// previous invocation, if any. Matching choices are favored when building
+  /// disjunctions, which only affects the order in which the solver explores
+  /// them, never which solutions are admissible.
+  const llvm::StringSet<> *RecordedOverloadChoices = nullptr;
+
   friend class Fix;
   friend class OverloadChoice;
   friend class ConstraintGraph;
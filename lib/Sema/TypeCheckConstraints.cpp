@@ -30,6 +30,7 @@
 #include "swift/AST/PrettyStackTrace.h"
 #include "swift/AST/SubstitutionMap.h"
 #include "swift/AST/TypeCheckerDebugConsumer.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/Parse/Confusables.h"
 #include "swift/Parse/Lexer.h"
 #include "llvm/ADT/APInt.h"
@@ -1976,6 +1977,101 @@ bool GenericRequirementsCheckListener::diagnoseUnsatisfiedRequirement(
   return false;
 }
 
+Optional<TypeChecker::ArgumentShape>
+TypeChecker::getArgumentShape(ValueDecl *decl) {
+  auto known = argumentShapeCache.find(decl);
+  if (known != argumentShapeCache.end())
+    return known->second;
+
+  auto *func = dyn_cast<AbstractFunctionDecl>(decl);
+  if (!func)
+    return None;
+
+  auto *params = func->getParameterList(func->getImplicitSelfDecl() ? 1 : 0);
+
+  ArgumentShape shape;
+  shape.MinArity = 0;
+  shape.MaxArity = params->size();
+  shape.HasVariadic = false;
+  shape.AcceptsTrailingClosure = false;
+
+  for (auto *param : *params) {
+    if (!param->getArgumentName().empty())
+      shape.Labels.push_back(param->getArgumentName());
+
+    if (param->isVariadic()) {
+      shape.HasVariadic = true;
+      continue;
+    }
+
+    if (!param->isDefaultArgument())
+      ++shape.MinArity;
+  }
+
+  // A trailing closure can fulfill the final parameter when its type could
+  // possibly be a function type. Anything involving type parameters or
+  // unresolved types is treated as compatible.
+  if (params->size() > 0) {
+    Type lastTy = params->getArray().back()->getInterfaceType();
+    if (!lastTy || lastTy->hasError() || lastTy->hasTypeParameter() ||
+        lastTy->hasUnresolvedType() || lastTy->hasTypeVariable()) {
+      shape.AcceptsTrailingClosure = true;
+    } else {
+      while (auto objTy = lastTy->getOptionalObjectType())
+        lastTy = objTy;
+      shape.AcceptsTrailingClosure = lastTy->is<AnyFunctionType>();
+    }
+  }
+
+  argumentShapeCache.insert({decl, shape});
+  return shape;
+}
+
+/// Attempt to type check a plain literal expression with no contextual type
+/// by binding it directly to its default literal type, skipping constraint
+/// generation and solving.
+///
+/// \returns the type-checked expression, or null if the expression is not
+/// eligible for the fast path. Eligibility failures are not diagnosed; the
+/// general path handles them.
+static Expr *typeCheckLiteralViaDefaultType(TypeChecker &TC, Expr *expr,
+                                            DeclContext *dc) {
+  // Only plain literals whose default type is fully determined by the
+  // ExpressibleBy* defaults qualify. Interpolations, magic literals, 'nil',
+  // and collections all involve subexpressions or lack a default type.
+  KnownProtocolKind protocolKind;
+  if (isa<IntegerLiteralExpr>(expr))
+    protocolKind = KnownProtocolKind::ExpressibleByIntegerLiteral;
+  else if (isa<FloatLiteralExpr>(expr))
+    protocolKind = KnownProtocolKind::ExpressibleByFloatLiteral;
+  else if (isa<BooleanLiteralExpr>(expr))
+    protocolKind = KnownProtocolKind::ExpressibleByBooleanLiteral;
+  else if (isa<StringLiteralExpr>(expr))
+    protocolKind = KnownProtocolKind::ExpressibleByStringLiteral;
+  else
+    return nullptr;
+
+  auto *protocol = TC.getProtocol(expr->getLoc(), protocolKind);
+  if (!protocol)
+    return nullptr;
+
+  Type defaultType = TC.getDefaultType(protocol, dc);
+  if (!defaultType || defaultType->hasError())
+    return nullptr;
+
+  // With a nonstandard library the default type may not actually conform;
+  // let the general path produce the diagnostics in that case.
+  if (!TC.conformsToProtocol(defaultType, protocol, dc,
+                             ConformanceCheckFlags::InExpression))
+    return nullptr;
+
+  auto *result = TC.applyLiteralDefaultType(cast<LiteralExpr>(expr),
+                                            defaultType, dc);
+  if (result && TC.Context.Stats)
+    TC.Context.Stats->getFrontendCounters().NumLiteralExprsFastPathed++;
+  return result;
+}
+
 #pragma mark High-level entry points
 Type TypeChecker::typeCheckExpression(Expr *&expr, DeclContext *dc,
                                       TypeLoc convertType,
@@ -1990,6 +2086,22 @@ Type TypeChecker::typeCheckExpression(Expr *&expr, DeclContext *dc,
   if (preCheckExpression(expr, dc))
     return Type();
 
+  // A plain literal with no contextual pressure always solves to its default
+  // literal type; bind it directly instead of running the solver.
+  if (!convertType.getType() && !listener && !baseCS &&
+      !options.contains(TypeCheckExprFlags::SkipApplyingSolution) &&
+      !options.contains(TypeCheckExprFlags::AllowUnresolvedTypeVariables) &&
+      !options.contains(TypeCheckExprFlags::SuppressDiagnostics)) {
+    if (auto *fastResult = typeCheckLiteralViaDefaultType(*this, expr, dc)) {
+      if (!options.contains(TypeCheckExprFlags::DisableStructuralChecks)) {
+        bool isExprStmt = options.contains(TypeCheckExprFlags::IsExprStmt);
+        performSyntacticExprDiagnostics(*this, fastResult, dc, isExprStmt);
+      }
+      expr = fastResult;
+      return expr->getType();
+    }
+  }
+
   // Construct a constraint system from this expression.
   ConstraintSystemOptions csOptions = ConstraintSystemFlags::AllowFixes;
 
@@ -3705,8 +3705,13 @@ void TypeChecker::validateDecl(ValueDecl *D) {
     return;
   }
 
-  if (Context.Stats)
+  if (Context.Stats) {
     Context.Stats->getFrontendCounters().NumDeclsValidated++;
+    auto *SF =
+        dyn_cast<SourceFile>(D->getDeclContext()->getModuleScopeContext());
+    if (SF && !SF->isPrimary())
+      Context.Stats->getFrontendCounters().NumDeclsValidatedNonPrimary++;
+  }
 
   switch (D->getKind()) {
   case DeclKind::Import:
@@ -44,6 +44,7 @@
 #include "swift/ClangImporter/ClangModule.h"
 #include "swift/Sema/IDETypeChecking.h"
 #include "swift/Serialization/SerializedModuleLoader.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Compiler.h"
@@ -638,6 +639,28 @@ RequirementMatch swift::matchWitness(TypeChecker &tc,
                                      ValueDecl *witness) {
   using namespace constraints;
 
+  // When the requirement's type does not involve associated types, matching
+  // is deterministic for a given conformance and witness: it cannot be
+  // affected by type witnesses resolved later. Memoize such matches, since
+  // diagnostics and @objc witness discovery re-run them and the constraint
+  // solving below dominates conformance-heavy code.
+  bool canCache = false;
+  if (conformance) {
+    if (auto reqIfaceTy = req->getInterfaceType()) {
+      canCache = !reqIfaceTy->hasError() &&
+                 !reqIfaceTy.findIf([](Type type) {
+                   return type->is<DependentMemberType>();
+                 });
+    }
+  }
+  auto cacheKey = std::make_pair(std::make_pair(conformance, dc),
+                                 std::make_pair(req, witness));
+  if (canCache) {
+    auto known = tc.witnessMatchCache.find(cacheKey);
+    if (known != tc.witnessMatchCache.end())
+      return *known->second;
+  }
+
   // Initialized by the setup operation.
   Optional<ConstraintSystem> cs;
   ConstraintLocator *locator = nullptr;
@@ -816,7 +839,15 @@ RequirementMatch swift::matchWitness(TypeChecker &tc,
     return result;
   };
 
-  return matchWitness(tc, dc, req, witness, setup, matchTypes, finalize);
+  auto result = matchWitness(tc, dc, req, witness, setup, matchTypes, finalize);
+
+  // Invalid witnesses may become valid after further validation, so only
+  // remember settled results.
+  if (canCache && result.Kind != MatchKind::WitnessInvalid)
+    tc.witnessMatchCache[cacheKey] =
+      llvm::make_unique<RequirementMatch>(result);
+
+  return result;
 }
 
 /// \brief Determine whether one requirement match is better than the other.
@@ -17,6 +17,8 @@
 
 #include "swift/Subsystems.h"
 #include "TypeChecker.h"
+#include "CSSolutionCache.h"
+#include "TypeCheckProtocol.h"
 #include "TypeCheckObjC.h"
 #include "CodeSynthesis.h"
 #include "MiscDiagnostics.h"
@@ -67,6 +69,15 @@ TypeChecker::~TypeChecker() {
   Context.setLazyResolver(nullptr);
 }
 
+constraints::ExprSolutionCache *TypeChecker::getExprSolutionCache() {
+  if (Context.LangOpts.SolverSolutionCachePath.empty())
+    return nullptr;
+  if (!ExprSolutions)
+    ExprSolutions.reset(new constraints::ExprSolutionCache(
+        Context.LangOpts.SolverSolutionCachePath));
+  return ExprSolutions.get();
+}
+
 ProtocolDecl *TypeChecker::getProtocol(SourceLoc loc, KnownProtocolKind kind) {
   auto protocol = Context.getProtocol(kind);
   if (!protocol && loc.isValid()) {
@@ -528,8 +539,21 @@ static void typeCheckFunctionsAndExternalDecls(SourceFile &SF, TypeChecker &TC)
     // Complete any conformances that we used.
     for (unsigned i = 0; i != TC.UsedConformances.size(); ++i) {
       auto conformance = TC.UsedConformances[i];
-      if (conformance->isIncomplete())
-        TC.checkConformance(conformance);
+      if (!conformance->isIncomplete())
+        continue;
+
+      // A conformance declared in another file of this module is fully
+      // checked when that file is the primary. Here we only need the
+      // witnesses the primary file actually demands, and those are resolved
+      // lazily through the conformance itself. Class conformances are still
+      // checked eagerly, because derived witnesses can affect vtable layout.
+      auto *conformanceFile =
+        conformance->getDeclContext()->getParentSourceFile();
+      if (conformanceFile && conformanceFile != &SF &&
+          !conformance->getType()->getClassOrBoundGenericClass())
+        continue;
+
+      TC.checkConformance(conformance);
     }
     TC.UsedConformances.clear();
 
@@ -710,6 +734,11 @@ void swift::performTypeChecking(SourceFile &SF, TopLevelContext &TLC,
   // Verify that we've checked types correctly.
   SF.ASTStage = SourceFile::TypeChecked;
 
+  // The scope map was only needed for unqualified name lookup within this
+  // file, so return its memory to the system. It will be lazily rebuilt in
+  // the unlikely event that someone asks for it again.
+  SF.clearScope();
+
   {
     SharedTimer timer("AST verification");
     // Verify the SourceFile.
@@ -37,8 +37,11 @@ namespace swift {
 
 class GenericSignatureBuilder;
 class GenericTypeResolver;
+class LiteralExpr;
 class NominalTypeDecl;
 class NormalProtocolConformance;
+class ProtocolConformance;
+struct RequirementMatch;
 class TopLevelContext;
 class TypeChecker;
 class TypoCorrectionResults;
@@ -49,6 +52,7 @@ namespace constraints {
   enum class ConstraintKind : char;
   enum class SolutionKind : char;
   class ConstraintSystem;
+  class ExprSolutionCache;
   class Solution;
 }
 
@@ -656,9 +660,47 @@ public:
   SmallVector<NominalTypeDecl*, 8> DelayedCircularityChecks;
 
   // Caches whether a given declaration is "as specialized" as another.
-  llvm::DenseMap<std::pair<ValueDecl*, ValueDecl*>, bool> 
+  llvm::DenseMap<std::pair<ValueDecl*, ValueDecl*>, bool>
     specializedOverloadComparisonCache;
-  
+
+  /// Summarizes the shape of the argument lists a function declaration can
+  /// accept, used to prune overload disjunctions before solving.
+  struct ArgumentShape {
+    /// The smallest number of arguments a call may supply.
+    unsigned MinArity;
+
+    /// The largest number of arguments a call may supply. Ignored when
+    /// \c HasVariadic is set.
+    unsigned MaxArity;
+
+    /// Whether the declaration has a variadic parameter.
+    bool HasVariadic;
+
+    /// Whether the final parameter has function type and can therefore be
+    /// supplied by a trailing closure.
+    bool AcceptsTrailingClosure;
+
+    /// The non-empty argument labels the declaration accepts.
+    llvm::SmallVector<Identifier, 4> Labels;
+  };
+
+  /// Caches the argument-list shape of overloaded function declarations.
+  llvm::DenseMap<ValueDecl *, ArgumentShape> argumentShapeCache;
+
+  /// Retrieve the argument-list shape of the given declaration, or None if
+  /// its shape cannot be summarized (e.g. it is not function-like).
+  Optional<ArgumentShape> getArgumentShape(ValueDecl *decl);
+
+  /// Memoized results of witness matching, keyed on the conformance, the
+  /// declaration context performing the match, the requirement, and the
+  /// witness. Only populated for requirements whose types do not involve
+  /// associated types, so entries cannot be invalidated by later type
+  /// witness resolution.
+  llvm::DenseMap<std::pair<std::pair<ProtocolConformance *, DeclContext *>,
+                           std::pair<ValueDecl *, ValueDecl *>>,
+                 std::unique_ptr<RequirementMatch>>
+    witnessMatchCache;
+
   /// A list of closures for the most recently type-checked function, which we
   /// will need to compute captures for.
   std::vector<AnyFunctionRef> ClosuresWithUncomputedCaptures;
@@ -804,6 +846,10 @@ private:
   // (It's arbitrary, but will keep the compiler from taking too much time.)
   unsigned SwitchCheckingInvocationThreshold = 200000;
 
+  /// The persistent cache of overload choices for solved expressions, if
+  /// enabled by LangOptions::SolverSolutionCachePath.
+  std::unique_ptr<constraints::ExprSolutionCache> ExprSolutions;
+
   /// If true, the time it takes to type-check each function will be dumped
   /// to llvm::errs().
   bool DebugTimeFunctionBodies = false;
@@ -831,6 +877,10 @@ public:
 
   LangOptions &getLangOpts() const { return Context.LangOpts; }
 
+  /// Retrieve the persistent cache of overload choices for solved
+  /// expressions, or null if the cache is not enabled.
+  constraints::ExprSolutionCache *getExprSolutionCache();
+
   /// Dump the time it takes to type-check each function to llvm::errs().
   void enableDebugTimeFunctionBodies() {
     DebugTimeFunctionBodies = true;
@@ -1863,6 +1913,21 @@ public:
                     MutableArrayRef<Expr *> arguments,
                     Diag<> brokenProtocolDiag);
 
+  /// \brief Convert the given literal to its default literal type, as if a
+  /// constraint system had solved it to that type, producing the fully
+  /// type-checked initializer call.
+  ///
+  /// \param literal The literal to convert.
+  ///
+  /// \param type The literal's default type, which must conform to the
+  /// literal's protocol.
+  ///
+  /// \param dc The declaration context containing the literal.
+  ///
+  /// \returns a fully type-checked expression, or null on failure.
+  Expr *applyLiteralDefaultType(LiteralExpr *literal, Type type,
+                                DeclContext *dc);
+
   /// \brief Determine whether the given type contains the given protocol.
   ///
   /// \param DC The context in which to check conformance. This affects, for
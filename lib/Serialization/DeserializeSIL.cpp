@@ -99,7 +99,10 @@ class SILDeserializer::FuncTableInfo {
 public:
   using internal_key_type = StringRef;
   using external_key_type = StringRef;
-  using data_type = DeclID;
+  /// The ID of the named entity's record, plus the stable SIL linkage the
+  /// record was written with. Only function entries carry their linkage; the
+  /// other name tables store zero.
+  using data_type = std::pair<DeclID, unsigned char>;
   using hash_value_type = uint32_t;
   using offset_type = unsigned;
 
@@ -117,7 +120,7 @@ public:
 
   static std::pair<unsigned, unsigned> ReadKeyDataLength(const uint8_t *&data) {
     unsigned keyLength = endian::readNext<uint16_t, little, unaligned>(data);
-    return { keyLength, sizeof(uint32_t) };
+    return { keyLength, sizeof(uint32_t) + 1 };
   }
 
   static internal_key_type ReadKey(const uint8_t *data, unsigned length) {
@@ -126,9 +129,11 @@ public:
 
   static data_type ReadData(internal_key_type key, const uint8_t *data,
                             unsigned length) {
-    assert(length == sizeof(uint32_t) && "Expect a single DeclID.");
-    data_type result = endian::readNext<uint32_t, little, unaligned>(data);
-    return result;
+    assert(length == sizeof(uint32_t) + 1 &&
+           "Expect a DeclID plus a linkage byte.");
+    auto declID = endian::readNext<uint32_t, little, unaligned>(data);
+    auto linkage = endian::readNext<uint8_t, little, unaligned>(data);
+    return { declID, linkage };
   }
 };
 
@@ -345,7 +350,7 @@ SILFunction *SILDeserializer::getFuncForReference(StringRef name,
     // Otherwise, look for a function with this name in the module.
     auto iter = FuncTable->find(name);
     if (iter != FuncTable->end()) {
-      auto maybeFn = readSILFunctionChecked(*iter, nullptr, name,
+      auto maybeFn = readSILFunctionChecked((*iter).first, nullptr, name,
                                             /*declarationOnly*/ true);
       if (maybeFn) {
         fn = maybeFn.get();
@@ -375,7 +380,7 @@ SILFunction *SILDeserializer::getFuncForReference(StringRef name) {
   if (iter == FuncTable->end())
     return nullptr;
 
-  auto maybeFn = readSILFunctionChecked(*iter, nullptr, name,
+  auto maybeFn = readSILFunctionChecked((*iter).first, nullptr, name,
                                         /*declarationOnly*/ true);
   if (!maybeFn) {
     // Ignore the failure and just pretend the function doesn't exist
@@ -2422,7 +2427,7 @@ SILFunction *SILDeserializer::lookupSILFunction(SILFunction *InFunc) {
   if (iter == FuncTable->end())
     return nullptr;
 
-  auto maybeFunc = readSILFunctionChecked(*iter, InFunc, name,
+  auto maybeFunc = readSILFunctionChecked((*iter).first, InFunc, name,
                                           /*declarationOnly*/ false);
   if (!maybeFunc) {
     // Ignore the error; treat it as if we didn't have a definition.
@@ -2452,46 +2457,18 @@ bool SILDeserializer::hasSILFunction(StringRef Name,
 
   // There is a function with the required name.
   // Find out which linkage it has.
-  auto FID = *iter;
-  auto &cacheEntry = Funcs[FID-1];
+  auto entry = *iter;
+  auto &cacheEntry = Funcs[entry.first - 1];
   if (cacheEntry.isFullyDeserialized() ||
       (cacheEntry.isDeserialized()))
     return !Linkage || cacheEntry.get()->getLinkage() == *Linkage;
 
-  BCOffsetRAII restoreOffset(SILCursor);
-  SILCursor.JumpToBit(cacheEntry.getOffset());
-
-  auto entry = SILCursor.advance(AF_DontPopBlockAtEnd);
-  if (entry.Kind == llvm::BitstreamEntry::Error) {
-    DEBUG(llvm::dbgs() << "Cursor advance error in hasSILFunction.\n");
-    MF->error();
-    return false;
-  }
-
-  SmallVector<uint64_t, 64> scratch;
-  StringRef blobData;
-  unsigned kind = SILCursor.readRecord(entry.ID, scratch, &blobData);
-  assert(kind == SIL_FUNCTION && "expect a sil function");
-  (void)kind;
-
-  // Read function properties only, e.g. its linkage and other attributes.
-  // TODO: If this results in any noticeable performance problems, Cache the
-  // linkage to avoid re-reading it from the bitcode each time?
-  DeclID clangOwnerID;
-  TypeID funcTyID;
-  GenericEnvironmentID genericEnvID;
-  unsigned rawLinkage, isTransparent, isSerialized, isThunk, isGlobal,
-    inlineStrategy, optimizationMode, effect, numSpecAttrs,
-    hasQualifiedOwnership, isWeakLinked;
-  ArrayRef<uint64_t> SemanticsIDs;
-  SILFunctionLayout::readRecord(scratch, rawLinkage, isTransparent, isSerialized,
-                                isThunk, isGlobal, inlineStrategy,
-                                optimizationMode, effect, numSpecAttrs,
-                                hasQualifiedOwnership, isWeakLinked, funcTyID,
-                                genericEnvID, clangOwnerID, SemanticsIDs);
-  auto linkage = fromStableSILLinkage(rawLinkage);
+  // The function table records the linkage the function was serialized with,
+  // so the query can be answered without seeking to and decoding the
+  // SIL_FUNCTION record.
+  auto linkage = fromStableSILLinkage(entry.second);
   if (!linkage) {
-    DEBUG(llvm::dbgs() << "invalid linkage code " << rawLinkage
+    DEBUG(llvm::dbgs() << "invalid linkage code " << unsigned(entry.second)
                        << " for SIL function " << Name << "\n");
     return false;
   }
@@ -2513,7 +2490,7 @@ SILFunction *SILDeserializer::lookupSILFunction(StringRef name,
   if (iter == FuncTable->end())
     return nullptr;
 
-  auto maybeFunc = readSILFunctionChecked(*iter, nullptr, name,
+  auto maybeFunc = readSILFunctionChecked((*iter).first, nullptr, name,
                                           declarationOnly);
 
   if (!maybeFunc) {
@@ -2529,6 +2506,40 @@ SILFunction *SILDeserializer::lookupSILFunction(StringRef name,
   return maybeFunc.get();
 }
 
+void SILDeserializer::preloadSILFunctions(ArrayRef<StringRef> Names) {
+  if (!FuncTable)
+    return;
+
+  // Collect the IDs of the requested functions first. Function records were
+  // written in ID order, so visiting them sorted by ID reads the SIL block
+  // front to back instead of hopping around in it.
+  SmallVector<std::pair<DeclID, StringRef>, 16> toRead;
+  for (auto name : Names) {
+    auto iter = FuncTable->find(name);
+    if (iter == FuncTable->end())
+      continue;
+    auto entry = *iter;
+    if (Funcs[entry.first - 1].isFullyDeserialized())
+      continue;
+    toRead.push_back({entry.first, name});
+  }
+  std::sort(toRead.begin(), toRead.end(),
+            [](const std::pair<DeclID, StringRef> &lhs,
+               const std::pair<DeclID, StringRef> &rhs) {
+              return lhs.first < rhs.first;
+            });
+
+  for (auto &entry : toRead) {
+    auto maybeFunc = readSILFunctionChecked(entry.first, nullptr, entry.second,
+                                            /*declarationOnly*/ false,
+                                            false /*errorIfEmptyBody*/);
+    if (!maybeFunc) {
+      // Ignore the error; treat it as if we didn't have a definition.
+      llvm::consumeError(maybeFunc.takeError());
+    }
+  }
+}
+
 SILGlobalVariable *SILDeserializer::readGlobalVar(StringRef Name) {
   if (!GlobalVarList)
     return nullptr;
@@ -2543,7 +2554,7 @@ SILGlobalVariable *SILDeserializer::readGlobalVar(StringRef Name) {
   auto iter = GlobalVarList->find(Name);
   if (iter == GlobalVarList->end())
     return nullptr;
-  auto VId = *iter;
+  auto VId = (*iter).first;
   if (VId == 0)
     return nullptr;
 
@@ -2622,7 +2633,7 @@ void SILDeserializer::getAllSILFunctions() {
     auto DI = FuncTable->find(*KI);
     assert(DI != FuncTable->end() && "There should never be a key without data.");
 
-    auto maybeFunc = readSILFunctionChecked(*DI, nullptr, *KI, false,
+    auto maybeFunc = readSILFunctionChecked((*DI).first, nullptr, *KI, false,
                                             false/*errorIfEmptyBody*/);
     if (!maybeFunc) {
       // Ignore the error; treat it as if we didn't have a definition.
@@ -2737,7 +2748,7 @@ SILVTable *SILDeserializer::lookupVTable(Identifier Name) {
   if (iter == VTableList->end())
     return nullptr;
 
-  auto VT = readVTable(*iter);
+  auto VT = readVTable((*iter).first);
   return VT;
 }
 
@@ -2993,7 +3004,7 @@ SILDeserializer::lookupWitnessTable(SILWitnessTable *existingWt) {
     return nullptr;
 
   // Attempt to read the witness table.
-  auto Wt = readWitnessTable(*iter, existingWt);
+  auto Wt = readWitnessTable((*iter).first, existingWt);
   if (Wt)
     DEBUG(llvm::dbgs() << "Deserialize SIL:\n"; Wt->dump());
 
@@ -3142,7 +3153,7 @@ SILDeserializer::lookupDefaultWitnessTable(SILDefaultWitnessTable *existingWt) {
     return nullptr;
 
   // Attempt to read the default witness table.
-  auto Wt = readDefaultWitnessTable(*iter, existingWt);
+  auto Wt = readDefaultWitnessTable((*iter).first, existingWt);
   if (Wt)
     DEBUG(llvm::dbgs() << "Deserialize SIL:\n"; Wt->dump());
 
@@ -133,6 +133,11 @@ public:
     SILFunction *lookupSILFunction(SILFunction *InFunc);
     SILFunction *lookupSILFunction(StringRef Name,
                                    bool declarationOnly = false);
+
+    /// Deserialize the bodies of the named functions present in this module,
+    /// visiting their records in the order they appear in the SIL block
+    /// rather than the order requested. Unknown names are ignored.
+    void preloadSILFunctions(ArrayRef<StringRef> Names);
     bool hasSILFunction(StringRef Name, Optional<SILLinkage> Linkage = None);
     SILVTable *lookupVTable(Identifier Name);
     SILWitnessTable *lookupWitnessTable(SILWitnessTable *wt);
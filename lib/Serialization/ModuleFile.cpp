@@ -27,8 +27,15 @@
 #include "swift/Serialization/BCReadingExtras.h"
 #include "swift/Serialization/SerializedModuleLoader.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/Config/config.h"
+#include "llvm/Support/Compression.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/OnDiskHashTable.h"
+#include "llvm/Support/Process.h"
+
+#if LLVM_ON_UNIX
+#include <sys/mman.h>
+#endif
 
 using namespace swift;
 using namespace swift::serialization;
@@ -748,6 +755,17 @@ ModuleFile::readObjCMethodTable(ArrayRef<uint64_t> fields, StringRef blobData) {
                                              base + sizeof(uint32_t), base));
 }
 
+/// Populate \p offsets from an offsets record's blob of 32-bit little-endian
+/// entries (see index_block::OffsetsLayout).
+template <typename T>
+static void readOffsets(std::vector<T> &offsets, StringRef blobData) {
+  assert(blobData.size() % sizeof(uint32_t) == 0);
+  offsets.clear();
+  offsets.reserve(blobData.size() / sizeof(uint32_t));
+  for (size_t i = 0, e = blobData.size(); i != e; i += sizeof(uint32_t))
+    offsets.push_back(llvm::support::endian::read32le(blobData.data() + i));
+}
+
 bool ModuleFile::readIndexBlock(llvm::BitstreamCursor &cursor) {
   cursor.EnterSubBlock(INDEX_BLOCK_ID);
 
@@ -788,20 +806,20 @@ bool ModuleFile::readIndexBlock(llvm::BitstreamCursor &cursor) {
 
       switch (kind) {
       case index_block::DECL_OFFSETS:
-        assert(blobData.empty());
-        Decls.assign(scratch.begin(), scratch.end());
+        assert(scratch.empty());
+        readOffsets(Decls, blobData);
         break;
       case index_block::DECL_CONTEXT_OFFSETS:
-        assert(blobData.empty());
-        DeclContexts.assign(scratch.begin(), scratch.end());
+        assert(scratch.empty());
+        readOffsets(DeclContexts, blobData);
         break;
       case index_block::TYPE_OFFSETS:
-        assert(blobData.empty());
-        Types.assign(scratch.begin(), scratch.end());
+        assert(scratch.empty());
+        readOffsets(Types, blobData);
         break;
       case index_block::IDENTIFIER_OFFSETS:
-        assert(blobData.empty());
-        Identifiers.assign(scratch.begin(), scratch.end());
+        assert(scratch.empty());
+        readOffsets(Identifiers, blobData);
         break;
       case index_block::TOP_LEVEL_DECLS:
         TopLevelDecls = readDeclTable(scratch, blobData);
@@ -838,28 +856,28 @@ bool ModuleFile::readIndexBlock(llvm::BitstreamCursor &cursor) {
         DeclMemberNames = readDeclMemberNamesTable(scratch, blobData);
         break;
       case index_block::LOCAL_DECL_CONTEXT_OFFSETS:
-        assert(blobData.empty());
-        LocalDeclContexts.assign(scratch.begin(), scratch.end());
+        assert(scratch.empty());
+        readOffsets(LocalDeclContexts, blobData);
         break;
       case index_block::GENERIC_SIGNATURE_OFFSETS:
-        assert(blobData.empty());
-        GenericSignatures.assign(scratch.begin(), scratch.end());
+        assert(scratch.empty());
+        readOffsets(GenericSignatures, blobData);
         break;
       case index_block::GENERIC_ENVIRONMENT_OFFSETS:
-        assert(blobData.empty());
-        GenericEnvironments.assign(scratch.begin(), scratch.end());
+        assert(scratch.empty());
+        readOffsets(GenericEnvironments, blobData);
         break;
       case index_block::SUBSTITUTION_MAP_OFFSETS:
-        assert(blobData.empty());
-        SubstitutionMaps.assign(scratch.begin(), scratch.end());
+        assert(scratch.empty());
+        readOffsets(SubstitutionMaps, blobData);
         break;
       case index_block::NORMAL_CONFORMANCE_OFFSETS:
-        assert(blobData.empty());
-        NormalConformances.assign(scratch.begin(), scratch.end());
+        assert(scratch.empty());
+        readOffsets(NormalConformances, blobData);
         break;
       case index_block::SIL_LAYOUT_OFFSETS:
-        assert(blobData.empty());
-        SILLayouts.assign(scratch.begin(), scratch.end());
+        assert(scratch.empty());
+        readOffsets(SILLayouts, blobData);
         break;
 
       default:
@@ -939,10 +957,7 @@ public:
 };
 
 std::unique_ptr<ModuleFile::SerializedDeclCommentTable>
-ModuleFile::readDeclCommentTable(ArrayRef<uint64_t> fields,
-                                 StringRef blobData) {
-  uint32_t tableOffset;
-  index_block::DeclListLayout::readRecord(fields, tableOffset);
+ModuleFile::readDeclCommentTable(uint32_t tableOffset, StringRef blobData) {
   auto base = reinterpret_cast<const uint8_t *>(blobData.data());
 
   return std::unique_ptr<SerializedDeclCommentTable>(
@@ -992,9 +1007,30 @@ bool ModuleFile::readCommentBlock(llvm::BitstreamCursor &cursor) {
       unsigned kind = cursor.readRecord(entry.ID, scratch, &blobData);
 
       switch (kind) {
-      case comment_block::DECL_COMMENTS:
-        DeclCommentTable = readDeclCommentTable(scratch, blobData);
+      case comment_block::DECL_COMMENTS: {
+        uint32_t tableOffset;
+        comment_block::DeclCommentListLayout::readRecord(scratch, tableOffset);
+        DeclCommentTable = readDeclCommentTable(tableOffset, blobData);
+        break;
+      }
+      case comment_block::COMPRESSED_DECL_COMMENTS: {
+        if (!llvm::zlib::isAvailable())
+          return false;
+        uint32_t tableOffset;
+        uint64_t uncompressedSize;
+        comment_block::CompressedDeclCommentListLayout::readRecord(
+            scratch, tableOffset, uncompressedSize);
+        DecompressedCommentBlob.clear();
+        if (llvm::Error error = llvm::zlib::uncompress(
+                blobData, DecompressedCommentBlob, uncompressedSize)) {
+          llvm::consumeError(std::move(error));
+          return false;
+        }
+        DeclCommentTable = readDeclCommentTable(
+            tableOffset, StringRef(DecompressedCommentBlob.data(),
+                                   DecompressedCommentBlob.size()));
         break;
+      }
       case comment_block::GROUP_NAMES:
         GroupNamesMap = readGroupTable(scratch, blobData);
         break;
@@ -1071,6 +1107,27 @@ static bool isTargetTooNew(const llvm::Triple &moduleTarget,
   return ctxTarget.isOSVersionLT(major, minor, micro);
 }
 
+/// Ask the OS to start reading the given (usually memory-mapped) buffer into
+/// the page cache in the background. Deserializing one decl chases a serial
+/// chain of cross-references — its type, generic signature, conformances —
+/// whose jumps are data-dependent, so without the hint each step can stall on
+/// a synchronous page-in. The kernel's readahead overlaps that I/O with the
+/// decoding we do on this thread.
+static void prefetchModuleBuffer(const llvm::MemoryBuffer &buffer) {
+#if LLVM_ON_UNIX
+  if (buffer.getBufferSize() == 0)
+    return;
+  const size_t pageSize = llvm::sys::Process::getPageSize();
+  auto start = reinterpret_cast<uintptr_t>(buffer.getBufferStart());
+  uintptr_t alignedStart = start & ~uintptr_t(pageSize - 1);
+  size_t length = buffer.getBufferSize() + (start - alignedStart);
+  // This is purely advisory; if it fails (or the buffer was read into the
+  // heap rather than mapped), reads behave as before.
+  (void)::madvise(reinterpret_cast<void *>(alignedStart), length,
+                  MADV_WILLNEED);
+#endif
+}
+
 ModuleFile::ModuleFile(
     std::unique_ptr<llvm::MemoryBuffer> moduleInputBuffer,
     std::unique_ptr<llvm::MemoryBuffer> moduleDocInputBuffer,
@@ -1082,6 +1139,8 @@ ModuleFile::ModuleFile(
   assert(getStatus() == Status::Valid);
   Bits.IsFramework = isFramework;
 
+  prefetchModuleBuffer(*ModuleInputBuffer);
+
   PrettyStackTraceModuleFile stackEntry(*this);
 
   llvm::BitstreamCursor cursor{ModuleInputBuffer->getMemBufferRef()};
@@ -49,6 +49,7 @@
 #include "llvm/Config/config.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Compiler.h"
+#include "llvm/Support/Compression.h"
 #include "llvm/Support/EndianStream.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -913,6 +914,7 @@ void Serializer::writeDocBlockInfoBlock() {
   BLOCK(COMMENT_BLOCK);
   BLOCK_RECORD(comment_block, DECL_COMMENTS);
   BLOCK_RECORD(comment_block, GROUP_NAMES);
+  BLOCK_RECORD(comment_block, COMPRESSED_DECL_COMMENTS);
 
 #undef BLOCK
 #undef BLOCK_RECORD
@@ -4174,7 +4176,14 @@ void Serializer::writeAllIdentifiers() {
 
 void Serializer::writeOffsets(const index_block::OffsetsLayout &Offsets,
                               const std::vector<BitOffset> &values) {
-  Offsets.emit(ScratchRecord, getOffsetRecordCode(values), values);
+  llvm::SmallString<2048> blob;
+  {
+    llvm::raw_svector_ostream blobStream(blob);
+    endian::Writer<little> writer(blobStream);
+    for (auto offset : values)
+      writer.write<uint32_t>(offset);
+  }
+  Offsets.emit(ScratchRecord, getOffsetRecordCode(values), blob);
 }
 
 /// Writes an in-memory decl table to an on-disk representation, using the
@@ -4571,6 +4580,8 @@ static void writeGroupNames(const comment_block::GroupNamesLayout &GroupNames,
 
 static void writeDeclCommentTable(
     const comment_block::DeclCommentListLayout &DeclCommentList,
+    const comment_block::CompressedDeclCommentListLayout
+        &CompressedDeclCommentList,
     const SourceFile *SF, const ModuleDecl *M,
     DeclGroupNameContext &GroupContext) {
 
@@ -4684,6 +4695,22 @@ static void writeDeclCommentTable(
     tableOffset = Writer.generator.Emit(blobStream);
   }
 
+  // Large comment tables compress well and are only decompressed once per
+  // module load, so favor the compressed form whenever it is smaller.
+  const size_t minSizeForCompression = 1024;
+  if (llvm::zlib::isAvailable() &&
+      hashTableBlob.size() >= minSizeForCompression) {
+    llvm::SmallString<0> compressedBlob;
+    if (llvm::Error error = llvm::zlib::compress(hashTableBlob,
+                                                 compressedBlob)) {
+      llvm::consumeError(std::move(error));
+    } else if (compressedBlob.size() < hashTableBlob.size()) {
+      CompressedDeclCommentList.emit(scratch, tableOffset,
+                                     hashTableBlob.size(), compressedBlob);
+      return;
+    }
+  }
+
   DeclCommentList.emit(scratch, tableOffset, hashTableBlob);
 }
 
@@ -5048,7 +5075,10 @@ void Serializer::writeDocToStream(raw_ostream &os, ModuleOrSourceFile DC,
       BCBlockRAII restoreBlock(S.Out, COMMENT_BLOCK_ID, 4);
       DeclGroupNameContext GroupContext(GroupInfoPath, Ctx);
       comment_block::DeclCommentListLayout DeclCommentList(S.Out);
-      writeDeclCommentTable(DeclCommentList, S.SF, S.M, GroupContext);
+      comment_block::CompressedDeclCommentListLayout
+          CompressedDeclCommentList(S.Out);
+      writeDeclCommentTable(DeclCommentList, CompressedDeclCommentList,
+                            S.SF, S.M, GroupContext);
       comment_block::GroupNamesLayout GroupNames(S.Out);
 
       // FIXME: Multi-file compilation may cause group id collision.
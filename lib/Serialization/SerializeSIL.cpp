@@ -104,7 +104,11 @@ namespace {
   public:
     using key_type = Identifier;
     using key_type_ref = key_type;
-    using data_type = DeclID;
+    /// The ID of the named entity's record, plus the stable SIL linkage the
+    /// record was written with. Only function entries carry their linkage
+    /// (the other name tables store zero); it lets clients answer linkage
+    /// queries from the index without decoding the record itself.
+    using data_type = std::pair<DeclID, unsigned char>;
     using data_type_ref = const data_type &;
     using hash_value_type = uint32_t;
     using offset_type = unsigned;
@@ -118,7 +122,7 @@ namespace {
                                                     key_type_ref key,
                                                     data_type_ref data) {
       uint32_t keyLength = key.str().size();
-      uint32_t dataLength = sizeof(uint32_t);
+      uint32_t dataLength = sizeof(uint32_t) + 1;
       endian::Writer<little> writer(out);
       writer.write<uint16_t>(keyLength);
       // No need to write the data length; it's constant.
@@ -131,7 +135,9 @@ namespace {
 
     void EmitData(raw_ostream &out, key_type_ref key, data_type_ref data,
                   unsigned len) {
-      endian::Writer<little>(out).write<uint32_t>(data);
+      endian::Writer<little> writer(out);
+      writer.write<uint32_t>(data.first);
+      writer.write<uint8_t>(data.second);
     }
   };
 
@@ -156,7 +162,8 @@ namespace {
     using TableData = FuncTableInfo::data_type;
     using Table = llvm::MapVector<FuncTableInfo::key_type, TableData>;
   private:
-    /// FuncTable maps function name to an ID.
+    /// FuncTable maps function name to an ID and the stable linkage of the
+    /// emitted record.
     Table FuncTable;
     std::vector<BitOffset> Funcs;
     /// The current function ID.
@@ -357,7 +364,6 @@ void SILSerializer::writeSILFunction(const SILFunction &F, bool DeclOnly) {
   ValueIDs.clear();
   InstID = 0;
 
-  FuncTable[Ctx.getIdentifier(F.getName())] = NextFuncID++;
   Funcs.push_back(Out.GetCurrentBitNo());
   unsigned abbrCode = SILAbbrCodes[SILFunctionLayout::Code];
   TypeID FnID = S.addTypeRef(F.getLoweredType().getASTType());
@@ -383,6 +389,11 @@ void SILSerializer::writeSILFunction(const SILFunction &F, bool DeclOnly) {
     Linkage = addExternalToLinkage(Linkage);
   }
 
+  // Record the linkage in the function table entry so that clients can
+  // answer linkage queries without decoding the record.
+  FuncTable[Ctx.getIdentifier(F.getName())] = {
+      NextFuncID++, (unsigned char)toStableSILLinkage(Linkage)};
+
   // If we have a body, we might have a generic environment.
   GenericEnvironmentID genericEnvID = 0;
   if (!NoBody)
@@ -2171,7 +2182,7 @@ void SILSerializer::writeIndexTables() {
 }
 
 void SILSerializer::writeSILGlobalVar(const SILGlobalVariable &g) {
-  GlobalVarList[Ctx.getIdentifier(g.getName())] = NextGlobalVarID++;
+  GlobalVarList[Ctx.getIdentifier(g.getName())] = {NextGlobalVarID++, 0};
   GlobalVarOffset.push_back(Out.GetCurrentBitNo());
   TypeID TyID = S.addTypeRef(g.getLoweredType().getASTType());
   DeclID dID = S.addDeclRef(g.getDecl());
@@ -2190,7 +2201,7 @@ void SILSerializer::writeSILVTable(const SILVTable &vt) {
   if (!ShouldSerializeAll &&
       vt.getClass()->getEffectiveAccess() < swift::AccessLevel::Public)
     return;
-  VTableList[vt.getClass()->getName()] = NextVTableID++;
+  VTableList[vt.getClass()->getName()] = {NextVTableID++, 0};
   VTableOffset.push_back(Out.GetCurrentBitNo());
   VTableLayout::emitRecord(Out, ScratchRecord, SILAbbrCodes[VTableLayout::Code],
                            S.addDeclRef(vt.getClass()),
@@ -2242,7 +2253,7 @@ void SILSerializer::writeSILProperty(const SILProperty &prop) {
 }
 
 void SILSerializer::writeSILWitnessTable(const SILWitnessTable &wt) {
-  WitnessTableList[wt.getIdentifier()] = NextWitnessTableID++;
+  WitnessTableList[wt.getIdentifier()] = {NextWitnessTableID++, 0};
   WitnessTableOffset.push_back(Out.GetCurrentBitNo());
 
   WitnessTableLayout::emitRecord(
@@ -2320,7 +2331,7 @@ writeSILDefaultWitnessTable(const SILDefaultWitnessTable &wt) {
   if (wt.isDeclaration())
     return;
 
-  DefaultWitnessTableList[wt.getIdentifier()] = NextDefaultWitnessTableID++;
+  DefaultWitnessTableList[wt.getIdentifier()] = {NextDefaultWitnessTableID++, 0};
   DefaultWitnessTableOffset.push_back(Out.GetCurrentBitNo());
 
   DefaultWitnessTableLayout::emitRecord(
@@ -20,10 +20,16 @@
 #include "swift/Basic/SourceManager.h"
 #include "swift/Basic/Version.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Chrono.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Mutex.h"
+#include "llvm/Support/MutexGuard.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Debug.h"
+#include <cstdlib>
+#include <memory>
 #include <system_error>
 
 using namespace swift;
@@ -31,8 +37,126 @@ using swift::version::Version;
 
 namespace {
 using AccessPathElem = std::pair<Identifier, SourceLoc>;
+
+/// An opt-in, process-wide cache of serialized module buffers.
+///
+/// Decls deserialized from a module belong to a single ASTContext and can
+/// never be shared across CompilerInstances, but the buffers they are read
+/// from are immutable, so a long-lived process that builds many ASTs over the
+/// same dependencies (sourcekitd, batch-mode frontends) can share the file
+/// contents and skip re-opening them. Entries are validated against the
+/// file's current size and modification time before being reused, and the
+/// cache grows only with the number of distinct modules loaded.
+///
+/// Enabled by setting SWIFT_ENABLE_MODULE_BUFFER_CACHE in the environment.
+class ModuleBufferCache {
+  struct Entry {
+    uint64_t Size;
+    llvm::sys::TimePoint<> ModTime;
+    std::shared_ptr<llvm::MemoryBuffer> Buffer;
+  };
+
+  /// A view of a cached buffer that shares ownership of its backing storage.
+  ///
+  /// ModuleFiles hold on to the buffer they were deserialized from for their
+  /// whole lifetime and lazily read decl records out of it, so replacing a
+  /// stale cache entry must not free storage an older, still-live AST is
+  /// reading. Each view keeps its backing buffer alive instead; the storage
+  /// is released when the last view over it goes away.
+  class SharedBufferView : public llvm::MemoryBuffer {
+    std::shared_ptr<llvm::MemoryBuffer> storage;
+
+  public:
+    explicit SharedBufferView(std::shared_ptr<llvm::MemoryBuffer> buffer)
+        : storage(std::move(buffer)) {
+      init(storage->getBufferStart(), storage->getBufferEnd(),
+           /*RequiresNullTerminator=*/false);
+    }
+
+    StringRef getBufferIdentifier() const override {
+      return storage->getBufferIdentifier();
+    }
+
+    BufferKind getBufferKind() const override {
+      return storage->getBufferKind();
+    }
+  };
+
+  llvm::sys::Mutex Mux;
+  llvm::StringMap<Entry> Buffers;
+
+  static std::unique_ptr<llvm::MemoryBuffer>
+  makeView(const std::shared_ptr<llvm::MemoryBuffer> &buffer) {
+    return llvm::make_unique<SharedBufferView>(buffer);
+  }
+
+public:
+  /// Returns the process-wide cache, or null if caching is not enabled.
+  static ModuleBufferCache *get() {
+    static bool isEnabled = ::getenv("SWIFT_ENABLE_MODULE_BUFFER_CACHE");
+    if (!isEnabled)
+      return nullptr;
+    static ModuleBufferCache cache;
+    return &cache;
+  }
+
+  /// Returns a view of the cached buffer for \p path, or null if there is no
+  /// entry matching the file's current status. Evicting a stale entry is safe
+  /// even while views of it are in use: the views share ownership of the old
+  /// storage.
+  std::unique_ptr<llvm::MemoryBuffer>
+  lookup(StringRef path, const llvm::sys::fs::file_status &status) {
+    llvm::MutexGuard guard(Mux);
+    auto known = Buffers.find(path);
+    if (known == Buffers.end())
+      return nullptr;
+    if (known->second.Size != status.getSize() ||
+        known->second.ModTime != status.getLastModificationTime()) {
+      Buffers.erase(known);
+      return nullptr;
+    }
+    return makeView(known->second.Buffer);
+  }
+
+  /// Takes ownership of \p buffer and returns a view of it.
+  std::unique_ptr<llvm::MemoryBuffer>
+  insert(StringRef path, const llvm::sys::fs::file_status &status,
+         std::unique_ptr<llvm::MemoryBuffer> buffer) {
+    llvm::MutexGuard guard(Mux);
+    auto &entry = Buffers[path];
+    entry.Size = status.getSize();
+    entry.ModTime = status.getLastModificationTime();
+    entry.Buffer = std::move(buffer);
+    return makeView(entry.Buffer);
+  }
+};
 } // end unnamed namespace
 
+/// Opens \p path, consulting the process-wide buffer cache if it is enabled.
+static llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
+openModuleBuffer(StringRef path) {
+  if (auto *cache = ModuleBufferCache::get()) {
+    llvm::sys::fs::file_status status;
+    if (!llvm::sys::fs::status(path, status)) {
+      if (auto buffer = cache->lookup(path, status))
+        return std::move(buffer);
+      auto bufferOrErr =
+          llvm::MemoryBuffer::getFile(path, /*FileSize=*/-1,
+                                      /*RequiresNullTerminator=*/false);
+      if (!bufferOrErr)
+        return bufferOrErr.getError();
+      return cache->insert(path, status, std::move(bufferOrErr.get()));
+    }
+  }
+
+  // The bitstream reader does not need a null terminator. Not requiring one
+  // lets the buffer be memory-mapped regardless of how the file size falls
+  // relative to a page boundary, so lookups only page in the decl records
+  // they actually jump to instead of eagerly reading the whole file.
+  return llvm::MemoryBuffer::getFile(path, /*FileSize=*/-1,
+                                     /*RequiresNullTerminator=*/false);
+}
+
 // Defined out-of-line so that we can see ~ModuleFile.
 SerializedModuleLoader::SerializedModuleLoader(ASTContext &ctx,
                                                DependencyTracker *tracker)
@@ -60,7 +184,7 @@ openModuleFiles(StringRef DirName, StringRef ModuleFilename,
   }
 
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> ModuleOrErr =
-  llvm::MemoryBuffer::getFile(StringRef(Scratch.data(), Scratch.size()));
+      openModuleBuffer(StringRef(Scratch.data(), Scratch.size()));
   if (!ModuleOrErr)
     return ModuleOrErr.getError();
 
@@ -69,7 +193,7 @@ openModuleFiles(StringRef DirName, StringRef ModuleFilename,
   Scratch.clear();
   llvm::sys::path::append(Scratch, DirName, ModuleDocFilename);
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> ModuleDocOrErr =
-      llvm::MemoryBuffer::getFile(StringRef(Scratch.data(), Scratch.size()));
+      openModuleBuffer(StringRef(Scratch.data(), Scratch.size()));
   if (!ModuleDocOrErr &&
       ModuleDocOrErr.getError() != std::errc::no_such_file_or_directory) {
     return ModuleDocOrErr.getError();
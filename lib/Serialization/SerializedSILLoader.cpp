@@ -99,6 +99,11 @@ bool SerializedSILLoader::hasSILFunction(StringRef Name,
 }
 
 
+void SerializedSILLoader::preloadSILFunctions(ArrayRef<StringRef> Names) {
+  for (auto &Des : LoadedSILSections)
+    Des->preloadSILFunctions(Names);
+}
+
 SILVTable *SerializedSILLoader::lookupVTable(Identifier Name) {
   for (auto &Des : LoadedSILSections) {
     if (auto VT = Des->lookupVTable(Name))
@@ -17,53 +17,6 @@
 using namespace swift;
 using namespace swift::syntax;
 
-namespace {
-class RawSyntaxCacheNode;
-}
-
-/// Implementation detail of SyntaxArena.
-struct SyntaxArena::Implementation {
-  /// Allocator.
-  llvm::BumpPtrAllocator Allocator;
-
-  /// List of pointers to the allocated RawSyntax
-  std::vector<RawSyntax *> AllocatedRawSyntaxList;
-
-  Implementation() = default;
-  void *Allocate(size_t size, size_t alignment) {
-    return Allocator.Allocate(size, alignment);
-  }
-
-  void *AllocateRawSyntax(size_t size, size_t alignment) {
-    void *data = Allocator.Allocate(size, alignment);
-    /// Remember the allocated pointers so that we can destruct them.
-    AllocatedRawSyntaxList.push_back(static_cast<RawSyntax *>(data));
-    return data;
-  }
-
-  ~Implementation() {
-    // Destruct all allocated RawSyntax. They might contain heap allocated
-    // propeties and/or children.
-    for (auto *N : AllocatedRawSyntaxList)
-      N->~RawSyntax();
-  }
-};
-
-SyntaxArena::SyntaxArena() : Impl(*new Implementation()){};
-SyntaxArena::~SyntaxArena() { delete &Impl; }
-
-llvm::BumpPtrAllocator &SyntaxArena::getAllocator() const {
-  return Impl.Allocator;
-}
-
-void *SyntaxArena::Allocate(size_t size, size_t alignment) {
-  return Impl.Allocate(size, alignment);
-}
-
-void *SyntaxArena::AllocateRawSyntax(size_t size, size_t alignment) {
-  return Impl.AllocateRawSyntax(size, alignment);
-}
-
 namespace {
 
 /// Cache node for RawSyntax.
@@ -116,12 +69,73 @@ template <> struct FoldingSetTrait<RawSyntaxCacheNode> {
 
 } // namespace llvm
 
+/// Implementation detail of SyntaxArena.
+struct SyntaxArena::Implementation {
+  /// Allocator.
+  llvm::BumpPtrAllocator Allocator;
+
+  /// List of pointers to the allocated RawSyntax
+  std::vector<RawSyntax *> AllocatedRawSyntaxList;
+
+  /// Uniquing table returning a shared immutable node for identical
+  /// (token kind, text, trivia) combinations.
+  llvm::FoldingSet<RawSyntaxCacheNode> CachedTokens;
+
+  Implementation() = default;
+  void *Allocate(size_t size, size_t alignment) {
+    return Allocator.Allocate(size, alignment);
+  }
+
+  void *AllocateRawSyntax(size_t size, size_t alignment) {
+    void *data = Allocator.Allocate(size, alignment);
+    /// Remember the allocated pointers so that we can destruct them.
+    AllocatedRawSyntaxList.push_back(static_cast<RawSyntax *>(data));
+    return data;
+  }
+
+  ~Implementation() {
+    // Destruct all allocated RawSyntax. They might contain heap allocated
+    // propeties and/or children.
+    for (auto *N : AllocatedRawSyntaxList)
+      N->~RawSyntax();
+  }
+};
+
+SyntaxArena::SyntaxArena() : Impl(*new Implementation()){};
+SyntaxArena::~SyntaxArena() { delete &Impl; }
+
+llvm::BumpPtrAllocator &SyntaxArena::getAllocator() const {
+  return Impl.Allocator;
+}
+
+void *SyntaxArena::Allocate(size_t size, size_t alignment) {
+  return Impl.Allocate(size, alignment);
+}
+
+void *SyntaxArena::AllocateRawSyntax(size_t size, size_t alignment) {
+  return Impl.AllocateRawSyntax(size, alignment);
+}
+
 /// Retrive "token" RawSyntax from the given Arena.
 RC<RawSyntax> RawSyntax::getToken(SyntaxArena &Arena, tok TokKind,
                                   OwnedString Text,
                                   llvm::ArrayRef<TriviaPiece> LeadingTrivia,
                                   llvm::ArrayRef<TriviaPiece> TrailingTrivia) {
-
-  return RawSyntax::make(TokKind, Text, LeadingTrivia, TrailingTrivia,
-                         SourcePresence::Present, &Arena);
+  // A handful of tokens ('let', 'self', punctuation) account for most nodes
+  // in a tree. Since arena-allocated RawSyntax is immutable and not
+  // refcounted, identical tokens can all share one node.
+  llvm::FoldingSetNodeID ID;
+  RawSyntax::Profile(ID, TokKind, Text, LeadingTrivia, TrailingTrivia);
+
+  auto &CachedTokens = Arena.Impl.CachedTokens;
+  void *insertPos = nullptr;
+  if (auto *Existing = CachedTokens.FindNodeOrInsertPos(ID, insertPos))
+    return Existing->get();
+
+  auto Raw = RawSyntax::make(TokKind, Text, LeadingTrivia, TrailingTrivia,
+                             SourcePresence::Present, &Arena);
+  auto IDRef = ID.Intern(Arena.getAllocator());
+  auto *Node = new (Arena) RawSyntaxCacheNode(Raw.get(), IDRef);
+  CachedTokens.InsertNode(Node, insertPos);
+  return Raw;
 }
@@ -29,6 +29,7 @@
 #include "swift/SIL/SILWitnessTable.h"
 #include "swift/SIL/TypeLowering.h"
 #include "llvm/ADT/StringSet.h"
+#include "llvm/Support/MD5.h"
 
 #include "TBDGenVisitor.h"
 
@@ -370,28 +371,79 @@ void TBDGenVisitor::addFirstFileSymbols() {
   }
 }
 
+/// Enumerate the public symbols of a single file of \p M into \p symbols.
+static void enumerateFileSymbols(FileUnit *file, ModuleDecl *M,
+                                 const UniversalLinkageInfo &linkInfo,
+                                 TBDGenOptions &opts, StringSet &symbols) {
+  TBDGenVisitor visitor(symbols, M->getASTContext().LangOpts.Target, linkInfo,
+                        M, opts);
+
+  if (file == M->getFiles()[0]) {
+    visitor.addFirstFileSymbols();
+  }
+
+  SmallVector<Decl *, 16> decls;
+  file->getTopLevelDecls(decls);
+
+  visitor.setFileHasEntryPoint(file->hasEntryPoint());
+
+  for (auto d : decls)
+    visitor.visit(d);
+}
+
+/// Compute \p SF's current interface hash into \p str. MD5::final is
+/// destructive, so finalize a copy of the state rather than the state itself,
+/// which reference-dependencies output still needs.
+static void getFileInterfaceHash(SourceFile *SF, llvm::SmallString<32> &str) {
+  llvm::MD5 hash = SF->getInterfaceHashState();
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  llvm::MD5::stringifyResult(result, str);
+}
+
 static void enumeratePublicSymbolsAndWrite(ModuleDecl *M, FileUnit *singleFile,
                                            StringSet &symbols,
                                            llvm::raw_ostream *os,
-                                           TBDGenOptions &opts) {
+                                           TBDGenOptions &opts,
+                                           TBDSymbolCache *cache) {
   auto isWholeModule = singleFile == nullptr;
   const auto &target = M->getASTContext().LangOpts.Target;
   UniversalLinkageInfo linkInfo(target, opts.HasMultipleIGMs, isWholeModule);
 
-  TBDGenVisitor visitor(symbols, target, linkInfo, M, opts);
-
+  // Each file is enumerated into its own set and the results merged into
+  // \p symbols, so that the per-file lists can be cached and reused
+  // independently. (The walks themselves stay serial: mangling and lazy
+  // member loading mutate shared ASTContext state.)
   auto visitFile = [&](FileUnit *file) {
-    if (file == M->getFiles()[0]) {
-      visitor.addFirstFileSymbols();
+    // Only source files have interface hashes to key a cache entry by.
+    TBDSymbolCache::FileSymbols *entry = nullptr;
+    llvm::SmallString<32> interfaceHash;
+    if (cache) {
+      if (auto *SF = dyn_cast<SourceFile>(file)) {
+        getFileInterfaceHash(SF, interfaceHash);
+        entry = &cache->PerFileSymbols[file];
+        if (entry->InterfaceHash == interfaceHash &&
+            entry->IsWholeModule == isWholeModule) {
+          for (auto &symbol : entry->Symbols)
+            symbols.insert(symbol);
+          return;
+        }
+      }
     }
 
-    SmallVector<Decl *, 16> decls;
-    file->getTopLevelDecls(decls);
+    StringSet fileSymbols;
+    enumerateFileSymbols(file, M, linkInfo, opts, fileSymbols);
 
-    visitor.setFileHasEntryPoint(file->hasEntryPoint());
+    if (entry) {
+      entry->InterfaceHash = interfaceHash;
+      entry->IsWholeModule = isWholeModule;
+      entry->Symbols.clear();
+      for (auto &symbol : fileSymbols)
+        entry->Symbols.push_back(symbol.getKey());
+    }
 
-    for (auto d : decls)
-      visitor.visit(d);
+    for (auto &symbol : fileSymbols)
+      symbols.insert(symbol.getKey());
   };
 
   if (singleFile) {
@@ -417,16 +469,16 @@ static void enumeratePublicSymbolsAndWrite(ModuleDecl *M, FileUnit *singleFile,
 }
 
 void swift::enumeratePublicSymbols(FileUnit *file, StringSet &symbols,
-                                   TBDGenOptions &opts) {
+                                   TBDGenOptions &opts, TBDSymbolCache *cache) {
   enumeratePublicSymbolsAndWrite(file->getParentModule(), file, symbols,
-                                 nullptr, opts);
+                                 nullptr, opts, cache);
 }
 void swift::enumeratePublicSymbols(ModuleDecl *M, StringSet &symbols,
-                                   TBDGenOptions &opts) {
-  enumeratePublicSymbolsAndWrite(M, nullptr, symbols, nullptr, opts);
+                                   TBDGenOptions &opts, TBDSymbolCache *cache) {
+  enumeratePublicSymbolsAndWrite(M, nullptr, symbols, nullptr, opts, cache);
 }
 void swift::writeTBDFile(ModuleDecl *M, llvm::raw_ostream &os,
-                         TBDGenOptions &opts) {
+                         TBDGenOptions &opts, TBDSymbolCache *cache) {
   StringSet symbols;
-  enumeratePublicSymbolsAndWrite(M, nullptr, symbols, &os, opts);
+  enumeratePublicSymbolsAndWrite(M, nullptr, symbols, &os, opts, cache);
 }
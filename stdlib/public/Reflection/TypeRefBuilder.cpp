@@ -53,9 +53,21 @@ TypeRefBuilder::TypeRefBuilder() : TC(*this) {}
 /// Normalize a mangled name so it can be matched with string equality.
 static std::string normalizeReflectionName(Demangler &dem, StringRef reflectionName) {
   reflectionName = dropSwiftManglingPrefix(reflectionName);
-  
+
+  // '\1' is the only marker for a symbolic reference, and resolving those is
+  // the only way demangling and remangling can change the bytes of a
+  // compiler-emitted name, so a name without it is already normalized and
+  // does not need to be demangled at all.
+  if (reflectionName.find('\1') == StringRef::npos)
+    return reflectionName;
+
   // Remangle the reflection name to resolve symbolic references.
   if (auto node = dem.demangleType(reflectionName)) {
+    // Reflection names come out of the compiler's mangler, so when one
+    // contains no symbolic references it is already canonical and can be
+    // used directly instead of being rebuilt from the parse tree.
+    if (!dem.hasSymbolicReferences())
+      return reflectionName;
     return mangleNode(node);
   }
 
@@ -71,6 +83,25 @@ static bool reflectionNameMatches(Demangler &dem,
   return searchName.equals(normalized);
 }
 
+const TypeRef *TypeRefBuilder::decodeMangledType(StringRef MangledName) {
+  // A symbolic reference ('\1') resolves relative to its own position, so
+  // the same bytes at a different address can name a different type; only
+  // memoize position-independent names.
+  bool Cacheable = MangledName.find('\1') == StringRef::npos;
+  if (Cacheable) {
+    auto Found = DecodedTypeCache.find(MangledName.str());
+    if (Found != DecodedTypeCache.end())
+      return Found->second;
+  }
+
+  auto Demangled = Dem.demangleType(MangledName);
+  auto *TR = swift::Demangle::decodeMangledType(*this, Demangled);
+  // Failures are memoized as well; they are just as expensive to rediscover.
+  if (Cacheable)
+    DecodedTypeCache.insert({MangledName.str(), TR});
+  return TR;
+}
+
 const TypeRef * TypeRefBuilder::
 lookupTypeWitness(const std::string &MangledTypeName,
                   const std::string &Member,
@@ -107,8 +138,7 @@ lookupTypeWitness(const std::string &MangledTypeName,
 
         auto SubstitutedTypeName =
             AssocTy.getMangledSubstitutedTypeName(TypeRefOffset);
-        auto Demangled = Dem.demangleType(SubstitutedTypeName);
-        auto *TypeWitness = swift::Demangle::decodeMangledType(*this, Demangled);
+        auto *TypeWitness = decodeMangledType(SubstitutedTypeName);
 
         AssociatedTypeCache.insert(std::make_pair(key, TypeWitness));
         return TypeWitness;
@@ -126,8 +156,8 @@ lookupSuperclass(const TypeRef *TR) {
 
   auto TypeRefOffset = FD.second->Field.SectionOffset
                      - FD.second->TypeReference.SectionOffset;
-  auto Demangled = Dem.demangleType(FD.first->getSuperclass(TypeRefOffset));
-  auto Unsubstituted = swift::Demangle::decodeMangledType(*this, Demangled);
+  auto Unsubstituted =
+      decodeMangledType(FD.first->getSuperclass(TypeRefOffset));
   if (!Unsubstituted)
     return nullptr;
 
@@ -149,9 +179,11 @@ TypeRefBuilder::getFieldTypeInfo(const TypeRef *TR) {
   if (Found != FieldTypeInfoCache.end())
     return Found->second;
 
-  // On failure, fill out the cache with everything we know about.
-  std::vector<std::pair<std::string, const TypeRef *>> Fields;
-  for (auto &Info : ReflectionInfos) {
+  // On failure, index the field sections we haven't looked at yet, one image
+  // at a time, stopping as soon as the requested type shows up. Whatever is
+  // left over stays unindexed until a later lookup misses the cache.
+  while (NumIndexedReflectionInfos < ReflectionInfos.size()) {
+    const auto &Info = ReflectionInfos[NumIndexedReflectionInfos++];
     uintptr_t TypeRefOffset = Info.Field.SectionOffset
                             - Info.TypeReference.SectionOffset;
     for (auto &FD : Info.Field.Metadata) {
@@ -162,12 +194,11 @@ TypeRefBuilder::getFieldTypeInfo(const TypeRef *TR) {
       FieldTypeInfoCache[NormalizedName] = {&FD, &Info};
       Dem.clear();
     }
-  }
 
-  // We've filled the cache with everything we know about now. Try the cache again.
-  Found = FieldTypeInfoCache.find(MangledName);
-  if (Found != FieldTypeInfoCache.end())
-    return Found->second;
+    Found = FieldTypeInfoCache.find(MangledName);
+    if (Found != FieldTypeInfoCache.end())
+      return Found->second;
+  }
 
   return {nullptr, 0};
 }
@@ -194,8 +225,8 @@ bool TypeRefBuilder::getFieldTypeRefs(
       continue;
     }
 
-    auto Demangled = Dem.demangleType(Field.getMangledTypeName(TypeRefOffset));
-    auto Unsubstituted = swift::Demangle::decodeMangledType(*this, Demangled);
+    auto Unsubstituted =
+        decodeMangledType(Field.getMangledTypeName(TypeRefOffset));
     if (!Unsubstituted)
       return false;
 
@@ -267,8 +298,7 @@ TypeRefBuilder::getClosureContextInfo(const CaptureDescriptor &CD,
     const TypeRef *TR = nullptr;
     if (i->hasMangledTypeName()) {
       auto MangledName = i->getMangledTypeName(TypeRefOffset);
-      auto DemangleTree = Dem.demangleType(MangledName);
-      TR = swift::Demangle::decodeMangledType(*this, DemangleTree);
+      TR = decodeMangledType(MangledName);
     }
     Info.CaptureTypes.push_back(TR);
   }
@@ -277,8 +307,7 @@ TypeRefBuilder::getClosureContextInfo(const CaptureDescriptor &CD,
     const TypeRef *TR = nullptr;
     if (i->hasMangledTypeName()) {
       auto MangledName = i->getMangledTypeName(TypeRefOffset);
-      auto DemangleTree = Dem.demangleType(MangledName);
-      TR = swift::Demangle::decodeMangledType(*this, DemangleTree);
+      TR = decodeMangledType(MangledName);
     }
 
     const MetadataSource *MS = nullptr;
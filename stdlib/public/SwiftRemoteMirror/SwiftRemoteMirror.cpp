@@ -118,6 +118,14 @@ swift_reflection_addReflectionInfo(SwiftReflectionContextRef ContextRef,
   Context->addReflectionInfo(*reinterpret_cast<ReflectionInfo *>(&Info));
 }
 
+void
+swift_reflection_setReadAheadCache(SwiftReflectionContextRef ContextRef,
+                                   uint64_t BlockSize, uint64_t MaxBlocks) {
+  auto Context = ContextRef->nativeContext;
+
+  Context->setReadAheadCache(BlockSize, MaxBlocks);
+}
+
 #if defined(__APPLE__) && defined(__MACH__)
 #ifndef __LP64__
 typedef const struct mach_header MachHeader;
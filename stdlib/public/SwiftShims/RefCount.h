@@ -174,6 +174,31 @@ typedef InlineRefCountsPlaceholder InlineRefCounts;
 
   DEAD
   The object and its side table are gone.
+
+
+  A note on biased (owner-thread) reference counting:
+
+  Periodically it is proposed that contended refcounts on widely shared
+  objects be handled by biasing the count toward an owner thread, with
+  non-atomic updates on that thread and a transfer protocol for everyone
+  else.  This has been evaluated and deliberately not adopted:
+
+  * The inline refcount word has no room to record an owning thread, so
+    biasing would force a side table allocation onto exactly the objects
+    the scheme targets, and gaining a side table is a one-way transition.
+  * Every non-owner retain/release would need to resolve the bias before
+    it could proceed, trading an atomic RMW for a protocol involving the
+    owner thread; for objects that are genuinely shared this is a
+    regression, and for objects that are not, the atomic is uncontended
+    and already cheap.
+  * The object lifecycle state machine above is carefully arranged so
+    that deinit and deallocation decisions read one atomic word.  A
+    count split across an owner's non-atomic cell and a shared overflow
+    cell breaks that invariant in the states where it matters most.
+
+  Code that can prove an object is unshared should instead be lowered to
+  the swift_nonatomic_* entry points, which the optimizer already emits
+  for provably thread-local objects.
 */
 
 namespace swift {
@@ -1297,6 +1322,11 @@ class HeapObjectSideTableEntry {
     : object(newObject), refCounts()
   { }
 
+  // Side table entries are allocated out of a pool of cache-line sized
+  // slots instead of individually from malloc; see RefCount.cpp.
+  void *operator new(size_t size);
+  void operator delete(void *p);
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Winvalid-offsetof"
   static ptrdiff_t refCountsOffset() {
@@ -170,6 +170,17 @@ public struct AnyHashable {
       return
     }
 
+    // A non-class value has no superclass that could introduce the Hashable
+    // conformance, so it always ends up with the default representation;
+    // build that directly rather than making a runtime round trip to decide
+    // it. The box for a small bitwise-takable payload such as an `Int` or a
+    // `String` is stored inline in the existential's buffer, so this path
+    // does not allocate.
+    if !_isClassOrObjCExistential(H.self) {
+      self.init(_usingDefaultRepresentationOf: base)
+      return
+    }
+
     self.init(_box: _ConcreteHashableBox(false)) // Dummy value
     _makeAnyHashableUpcastingToHashableBaseType(
       base,
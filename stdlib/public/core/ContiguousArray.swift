@@ -618,6 +618,110 @@ extension ContiguousArray: RangeReplaceableCollection, ArrayProtocol {
     return (result, result._buffer.firstElementAddress)
   }
 
+  /// Creates an array with the specified capacity, then calls the given
+  /// closure with a buffer covering the array's uninitialized memory.
+  ///
+  /// Inside the closure, set the `initializedCount` parameter to the number of
+  /// elements that are initialized by the closure. The memory in the range
+  /// `buffer[0..<initializedCount]` must be initialized at the end of the
+  /// closure's execution, and the memory in the range
+  /// `buffer[initializedCount...]` must be uninitialized.
+  ///
+  /// - Note: While the resulting array may have a capacity larger than the
+  ///   requested amount, the buffer passed to the closure will cover exactly
+  ///   the requested number of elements.
+  ///
+  /// - Parameters:
+  ///   - _unsafeUninitializedCapacity: The number of elements to allocate
+  ///     space for in the new array.
+  ///   - initializer: A closure that initializes elements and sets the count
+  ///     of the new array.
+  ///     - Parameters:
+  ///       - buffer: A buffer covering uninitialized memory with room for the
+  ///         specified number of of elements.
+  ///       - initializedCount: The count of initialized elements in the array,
+  ///         which begins as zero. Set `initializedCount` to the number of
+  ///         elements you initialize.
+  @inlinable
+  public init(
+    _unsafeUninitializedCapacity: Int,
+    initializingWith initializer: (
+      _ buffer: inout UnsafeMutableBufferPointer<Element>,
+      _ initializedCount: inout Int) throws -> Void
+  ) rethrows {
+    var firstElementAddress: UnsafeMutablePointer<Element>
+    (self, firstElementAddress) =
+      ContiguousArray._allocateUninitialized(_unsafeUninitializedCapacity)
+
+    var initializedCount = 0
+    defer {
+      // Update self.count even if initializer throws an error.
+      _precondition(
+        initializedCount <= _unsafeUninitializedCapacity,
+        "Initialized count set to greater than specified capacity."
+      )
+      self._buffer.count = initializedCount
+    }
+    var buffer = UnsafeMutableBufferPointer<Element>(
+      start: firstElementAddress, count: _unsafeUninitializedCapacity)
+    try initializer(&buffer, &initializedCount)
+  }
+
+  /// Reserves room for the specified number of additional elements, then
+  /// calls the given closure with a buffer covering the uninitialized tail
+  /// of the array's storage.
+  ///
+  /// Inside the closure, set the `initializedCount` parameter to the number
+  /// of elements that are initialized by the closure. The memory in the
+  /// range `buffer[0..<initializedCount]` must be initialized at the end of
+  /// the closure's execution, and the memory in the range
+  /// `buffer[initializedCount...]` must be uninitialized. The array's count
+  /// grows by `initializedCount`, even if the closure throws an error.
+  ///
+  /// Unlike repeated calls to `append`, this performs a single capacity
+  /// check and count update for the whole batch, which makes it suitable
+  /// for producers that decode large numbers of elements at a time.
+  ///
+  /// - Parameters:
+  ///   - _unsafeUninitializedCapacity: The number of additional elements to
+  ///     allocate space for.
+  ///   - initializer: A closure that initializes elements appended to the
+  ///     array and sets the count of initialized elements.
+  ///     - Parameters:
+  ///       - buffer: A buffer covering uninitialized memory with room for
+  ///         the specified number of additional elements.
+  ///       - initializedCount: The count of elements initialized by the
+  ///         closure, which begins as zero. Set `initializedCount` to the
+  ///         number of elements you initialize.
+  @inlinable
+  public mutating func _append(
+    _unsafeUninitializedCapacity: Int,
+    initializingWith initializer: (
+      _ buffer: inout UnsafeMutableBufferPointer<Element>,
+      _ initializedCount: inout Int) throws -> Void
+  ) rethrows {
+    _precondition(
+      _unsafeUninitializedCapacity >= 0, "Capacity to append must be positive")
+    let oldCount = self.count
+    // This makes the buffer unique and exactly as large as requested
+    // (modulo allocator bucket rounding); it does not apply the exponential
+    // growth used by element-at-a-time appends.
+    reserveCapacity(oldCount + _unsafeUninitializedCapacity)
+
+    var initializedCount = 0
+    defer {
+      // Update the count even if initializer throws an error.
+      _precondition(
+        initializedCount <= _unsafeUninitializedCapacity,
+        "Initialized count set to greater than specified capacity."
+      )
+      self._buffer.count = oldCount + initializedCount
+    }
+    var buffer = UnsafeMutableBufferPointer<Element>(
+      start: _buffer.firstElementAddress + oldCount,
+      count: _unsafeUninitializedCapacity)
+    try initializer(&buffer, &initializedCount)
+  }
 
   /// The number of elements in the array.
   @inlinable
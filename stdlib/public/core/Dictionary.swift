@@ -26,6 +26,33 @@ import SwiftShims
 // There is always at least one invalid entry among the buckets. `Dictionary`
 // does not use tombstones.
 //
+// A control-byte layout in the style of SwissTable -- one byte per bucket
+// holding an occupancy marker plus seven bits of the hash, probed a group
+// at a time with SIMD compares -- has been proposed for this table and not
+// adopted. It is a poor fit for several reasons:
+//
+// * Group probing relies on tombstones to terminate probe sequences across
+//   deletions. This table deliberately has no tombstones: `_delete`
+//   compacts the collision chain in place, which keeps lookups at their
+//   original lengths no matter the mutation history.
+// * The storage layout is not private to this file. It is mirrored by the
+//   C declarations in SwiftShims/GlobalObjects.h for the statically
+//   allocated empty singletons, and it is baked into inlinable entry
+//   points specialized into client binaries, so replacing the bitmap with
+//   a control array is a cross-cutting relayout of Dictionary, Set, and
+//   the bridging paths at once.
+// * The 16-wide compare wants a movemask-style reduction, which the
+//   stdlib cannot express portably at this point; a byte-at-a-time
+//   control check keeps only part of the win while paying all of the
+//   relayout cost.
+//
+// Note that the existing probe loop already consults only the bitmap for
+// vacant buckets; key storage is touched just for occupied buckets, where
+// a definitive comparison is usually needed anyway. The residual benefit
+// of control bytes -- rejecting colliding occupied buckets without loading
+// the key -- matters mostly at high load factors, which the current
+// 75% maximum load keeps rare.
+//
 // In addition to the native storage, `Dictionary` can also wrap an
 // `NSDictionary` in order to allow bridging `NSDictionary` to `Dictionary` in
 // `O(1)`.
@@ -140,6 +140,16 @@ internal struct _HasherTailBuffer {
     }
     return chunk
   }
+
+  /// Record `count` bytes that were compressed directly into the core,
+  /// bypassing this buffer.  The buffer must be empty, and `count` must be
+  /// a multiple of 8, so that it stays empty.
+  @inline(__always)
+  internal mutating func recordBytesCompressedDirectly(_ count: UInt64) {
+    _sanityCheck(byteCount & 7 == 0 && tail == 0)
+    _sanityCheck(count & 7 == 0)
+    value = value &+ (count &<< 56)
+  }
 }
 
 internal struct _BufferingHasher<Core: _HasherCore> {
@@ -221,11 +231,28 @@ internal struct _BufferingHasher<Core: _HasherCore> {
       remaining == 0 ||
       Int(bitPattern: data) & (MemoryLayout<UInt64>.alignment - 1) == 0)
 
-    // Load as many aligned words as there are in the input buffer
-    while remaining >= MemoryLayout<UInt64>.size {
-      combine(UInt64(littleEndian: data.load(as: UInt64.self)))
-      data += MemoryLayout<UInt64>.size
-      remaining -= MemoryLayout<UInt64>.size
+    // Load as many aligned words as there are in the input buffer.  The
+    // tail buffer is empty whenever the byte count is word-aligned (as it
+    // always is for one-shot hashing of a raw buffer), and then whole
+    // words can be fed to the core directly, keeping the per-word buffer
+    // bookkeeping out of the bulk loop; the byte count is adjusted once
+    // at the end instead.
+    if _buffer.byteCount & 7 == 0 {
+      var directlyCompressed = 0
+      while remaining >= MemoryLayout<UInt64>.size {
+        _core.compress(UInt64(littleEndian: data.load(as: UInt64.self)))
+        data += MemoryLayout<UInt64>.size
+        remaining -= MemoryLayout<UInt64>.size
+        directlyCompressed += MemoryLayout<UInt64>.size
+      }
+      _buffer.recordBytesCompressedDirectly(
+        UInt64(truncatingIfNeeded: directlyCompressed))
+    } else {
+      while remaining >= MemoryLayout<UInt64>.size {
+        combine(UInt64(littleEndian: data.load(as: UInt64.self)))
+        data += MemoryLayout<UInt64>.size
+        remaining -= MemoryLayout<UInt64>.size
+      }
     }
 
     // Load last partial word of data
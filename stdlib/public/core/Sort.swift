@@ -167,7 +167,10 @@ where Self: RandomAccessCollection, Element: Comparable {
   public mutating func sort() {
     let didSortUnsafeBuffer = _withUnsafeMutableBufferPointerIfSupported {
       buffer -> Void? in
-       buffer.sort()
+      if !buffer._radixSortIfApplicable() {
+        buffer.sort()
+      }
+      return ()
     }
     if didSortUnsafeBuffer == nil {
       _introSort(&self, subRange: startIndex..<endIndex, by: <)
@@ -584,3 +587,167 @@ internal func _heapSort<C: MutableCollection & RandomAccessCollection>(
     elements.formIndex(before: &hi)
   }
 }
+
+//===----------------------------------------------------------------------===//
+// Radix sort for buffers of fixed-width integers and floating-point values
+//===----------------------------------------------------------------------===//
+
+/// Sorts `elements` into ascending unsigned order using a least-significant-
+/// digit radix sort with 8-bit digits.
+///
+/// Each pass counts the digit distribution and then scatters the elements
+/// into a temporary buffer in digit order. A pass whose digit is the same in
+/// every element would copy the buffer unchanged, so it is skipped; for keys
+/// that only populate their low bytes, the sort therefore touches the buffer
+/// only as many times as the key width requires.
+@inlinable
+internal func _radixSort<K: FixedWidthInteger & UnsignedInteger>(
+  _ elements: UnsafeMutableBufferPointer<K>
+) {
+  let count = elements.count
+  let source = elements.baseAddress._unsafelyUnwrappedUnchecked
+  let temporary = UnsafeMutablePointer<K>.allocate(capacity: count)
+  defer { temporary.deallocate() }
+  let counts = UnsafeMutablePointer<Int>.allocate(capacity: 256)
+  defer { counts.deallocate() }
+
+  var src = source
+  var dst = temporary
+  for pass in 0 ..< K.bitWidth / 8 {
+    let shift = pass &* 8
+    counts.initialize(repeating: 0, count: 256)
+    for i in 0..<count {
+      counts[Int(truncatingIfNeeded: src[i] &>> shift) & 0xFF] &+= 1
+    }
+    if counts[Int(truncatingIfNeeded: src[0] &>> shift) & 0xFF] == count {
+      continue
+    }
+
+    // Convert the digit counts into starting offsets for the scatter.
+    var offset = 0
+    for digit in 0..<256 {
+      let digitCount = counts[digit]
+      counts[digit] = offset
+      offset &+= digitCount
+    }
+
+    for i in 0..<count {
+      let key = src[i]
+      let digit = Int(truncatingIfNeeded: key &>> shift) & 0xFF
+      dst[counts[digit]] = key
+      counts[digit] &+= 1
+    }
+    swap(&src, &dst)
+  }
+
+  // An odd number of scatter passes leaves the result in the temporary
+  // buffer.
+  if src != source {
+    source.assign(from: src, count: count)
+  }
+}
+
+/// Sorts a buffer of signed-integer bit patterns.
+///
+/// Flipping the sign bit maps two's complement order onto unsigned order, and
+/// the same flip restores the original patterns afterwards.
+@inlinable
+internal func _radixSortSignedPatterns<K: FixedWidthInteger & UnsignedInteger>(
+  _ keys: UnsafeMutableBufferPointer<K>
+) {
+  let signBit = K(1) &<< (K.bitWidth &- 1)
+  for i in 0..<keys.count { keys[i] ^= signBit }
+  _radixSort(keys)
+  for i in 0..<keys.count { keys[i] ^= signBit }
+}
+
+/// Sorts a buffer of IEEE 754 bit patterns.
+///
+/// Floating-point values are ordered by sign and magnitude: non-negative
+/// patterns compare like unsigned integers and negative patterns compare in
+/// reverse. Setting the sign bit of non-negative patterns and inverting all
+/// bits of negative ones produces unsigned keys whose order matches `<`; the
+/// mapping is a bijection, so it can be undone after the sort.
+///
+/// NaNs end up grouped before `-infinity` or after `+infinity` depending on
+/// their sign bit. The comparison sort leaves NaNs wherever its unspecified
+/// handling of non-ordered elements happens to put them, so any placement is
+/// acceptable for `sort()`.
+@inlinable
+internal func _radixSortFloatingPointPatterns<
+  K: FixedWidthInteger & UnsignedInteger
+>(
+  _ keys: UnsafeMutableBufferPointer<K>
+) {
+  let signBit = K(1) &<< (K.bitWidth &- 1)
+  for i in 0..<keys.count {
+    let bits = keys[i]
+    keys[i] = bits & signBit == 0 ? bits | signBit : ~bits
+  }
+  _radixSort(keys)
+  for i in 0..<keys.count {
+    let key = keys[i]
+    keys[i] = key & signBit == 0 ? ~key : key & ~signBit
+  }
+}
+
+extension UnsafeMutableBufferPointer {
+  /// Rebinds the buffer's memory to the same-sized key type `K` and calls
+  /// `body` on the rebound buffer.
+  @inlinable
+  internal func _withRadixSortKeyBuffer<K>(
+    _ type: K.Type, _ body: (UnsafeMutableBufferPointer<K>) -> Void
+  ) {
+    _sanityCheck(MemoryLayout<K>.stride == MemoryLayout<Element>.stride)
+    baseAddress._unsafelyUnwrappedUnchecked.withMemoryRebound(
+      to: K.self, capacity: count
+    ) { body(UnsafeMutableBufferPointer<K>(start: $0, count: count)) }
+  }
+
+  /// Sorts the buffer with a radix sort when `Element` is one of the standard
+  /// fixed-width integer or binary floating-point types, and returns whether
+  /// it did so.
+  ///
+  /// The metatype comparisons below fold to constants once this method is
+  /// specialized for a concrete `Element`, so a specialized caller carries
+  /// only the matching branch and a direct call to the radix sort.
+  @inlinable
+  internal func _radixSortIfApplicable() -> Bool {
+    // The counting passes only pay for themselves on large buffers; small
+    // ones are better served by the comparison sort.
+    if count < 512 { return false }
+
+    if Element.self == UInt8.self {
+      _withRadixSortKeyBuffer(UInt8.self) { _radixSort($0) }
+    } else if Element.self == UInt16.self {
+      _withRadixSortKeyBuffer(UInt16.self) { _radixSort($0) }
+    } else if Element.self == UInt32.self {
+      _withRadixSortKeyBuffer(UInt32.self) { _radixSort($0) }
+    } else if Element.self == UInt64.self {
+      _withRadixSortKeyBuffer(UInt64.self) { _radixSort($0) }
+    } else if Element.self == UInt.self {
+      _withRadixSortKeyBuffer(UInt.self) { _radixSort($0) }
+    } else if Element.self == Int8.self {
+      _withRadixSortKeyBuffer(UInt8.self) { _radixSortSignedPatterns($0) }
+    } else if Element.self == Int16.self {
+      _withRadixSortKeyBuffer(UInt16.self) { _radixSortSignedPatterns($0) }
+    } else if Element.self == Int32.self {
+      _withRadixSortKeyBuffer(UInt32.self) { _radixSortSignedPatterns($0) }
+    } else if Element.self == Int64.self {
+      _withRadixSortKeyBuffer(UInt64.self) { _radixSortSignedPatterns($0) }
+    } else if Element.self == Int.self {
+      _withRadixSortKeyBuffer(UInt.self) { _radixSortSignedPatterns($0) }
+    } else if Element.self == Float.self {
+      _withRadixSortKeyBuffer(UInt32.self) {
+        _radixSortFloatingPointPatterns($0)
+      }
+    } else if Element.self == Double.self {
+      _withRadixSortKeyBuffer(UInt64.self) {
+        _radixSortFloatingPointPatterns($0)
+      }
+    } else {
+      return false
+    }
+    return true
+  }
+}
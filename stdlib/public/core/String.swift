@@ -674,8 +674,27 @@ extension String {
 }
 
 internal func _isAllASCII(_ input: UnsafeBufferPointer<UInt8>) -> Bool {
-  for byte in input {
-    guard byte <= 0x7F else { return false }
+  guard let start = input.baseAddress else { return true }
+  let count = input.count
+  var i = 0
+
+  // Scan the bulk of the buffer a word at a time, checking a word's worth of
+  // high bits per iteration. Word loads must be aligned, so check the bytes
+  // before the first word boundary (and after the last one) individually.
+  let stride = MemoryLayout<UInt>.stride
+  while i < count && UInt(bitPattern: start + i) % UInt(stride) != 0 {
+    guard start[i] <= 0x7F else { return false }
+    i &+= 1
+  }
+  let asciiMask = UInt(truncatingIfNeeded: 0x8080_8080_8080_8080 as UInt64)
+  while i &+ stride <= count {
+    let word = UnsafeRawPointer(start + i).load(as: UInt.self)
+    guard word & asciiMask == 0 else { return false }
+    i &+= stride
+  }
+  while i < count {
+    guard start[i] <= 0x7F else { return false }
+    i &+= 1
   }
   return true
 }
@@ -736,6 +755,29 @@ extension String {
     return String(_StringGuts(_large: storage))
   }
 
+  /// Creates a string that reads its code units directly from `input`
+  /// without copying, or returns `nil` if the buffer contains non-ASCII
+  /// bytes, which this representation cannot view in place.
+  ///
+  /// The caller guarantees that `input` stays valid and unmodified for the
+  /// rest of the program's execution; the resulting string (and every string
+  /// derived from it) references the memory without retaining or ever
+  /// deallocating it, like a string literal does. Buffers short enough for
+  /// the small-string representation are stored inline instead, so they do
+  /// not pin their memory.
+  public // SPI(Foundation, server frameworks)
+  static func _fromImmortalASCIIBuffer(
+    _ input: UnsafeBufferPointer<UInt8>
+  ) -> String? {
+    guard _isAllASCII(input) else { return nil }
+    if let smol = _SmallUTF8String(input) {
+      return String(_StringGuts(smol))
+    }
+    guard let start = input.baseAddress else { return String() }
+    return String(
+      _StringGuts(_large: _UnmanagedString(start: start, count: input.count)))
+  }
+
   @usableFromInline
   static func _fromWellFormedUTF8(
     _ input: UnsafeBufferPointer<UInt8>, repair: Bool = false
@@ -106,6 +106,21 @@ static void array_copy_operation(OpaqueValue *dest, OpaqueValue *src,
       array_pod_copy(copyKind, dest, src, stride, count);
       return;
     }
+
+    // Assigning into existing values of a bitwise-takable type still admits
+    // a bulk copy once the old destination elements are destroyed. This
+    // entry point is only emitted for non-overlapping buffers, so the
+    // destruction cannot affect the source.
+    if (isBitwiseTakable && destOp == ArrayDest::Assign) {
+      assert(copyKind == ArrayCopy::NoAlias);
+      for (size_t i = 0; i < count; ++i) {
+        auto offset = i * stride;
+        auto *obj = reinterpret_cast<OpaqueValue *>((char *)dest + offset);
+        wtable->destroy(obj, self);
+      }
+      memcpy(dest, src, stride * count);
+      return;
+    }
   }
 
   // Call the witness to do the copy.
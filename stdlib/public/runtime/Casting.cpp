@@ -20,10 +20,12 @@
 #include "ErrorObject.h"
 #include "ExistentialMetadataImpl.h"
 #include "Private.h"
+#include "RuntimeInvocationsTracking.h"
 #include "SwiftHashableSupport.h"
 #include "swift/Basic/LLVM.h"
 #include "swift/Basic/Lazy.h"
 #include "swift/Demangling/Demangler.h"
+#include "swift/Runtime/Concurrent.h"
 #include "swift/Runtime/Config.h"
 #include "swift/Runtime/Debug.h"
 #include "swift/Runtime/Enum.h"
@@ -370,10 +372,11 @@ bool swift::_conformsToProtocol(const OpaqueValue *value,
 
 /// Check whether a type conforms to the given protocols, filling in a
 /// list of conformances.
-static bool _conformsToProtocols(const OpaqueValue *value,
-                                 const Metadata *type,
-                                 const ExistentialTypeMetadata *existentialType,
-                                 const WitnessTable **conformances) {
+static bool
+_conformsToProtocolsUncached(const OpaqueValue *value,
+                             const Metadata *type,
+                             const ExistentialTypeMetadata *existentialType,
+                             const WitnessTable **conformances) {
   if (auto *superclass = existentialType->getSuperclassConstraint()) {
     if (!swift_dynamicCastMetatype(type, superclass))
       return false;
@@ -394,7 +397,104 @@ static bool _conformsToProtocols(const OpaqueValue *value,
       ++conformances;
     }
   }
-  
+
+  return true;
+}
+
+namespace {
+struct ExistentialConformanceKey {
+  const Metadata *Type;
+  const ExistentialTypeMetadata *ExistentialType;
+};
+
+/// A cache entry recording that a type satisfies the constraints of an
+/// existential type, along with the witness tables that go into the
+/// existential container.  We don't cache negative responses so that we
+/// don't have to deal with cache invalidation.
+struct ExistentialConformanceEntry {
+  const Metadata *Type;
+  const ExistentialTypeMetadata *ExistentialType;
+
+  ExistentialConformanceEntry(ExistentialConformanceKey key,
+                              const WitnessTable * const *conformances)
+      : Type(key.Type), ExistentialType(key.ExistentialType) {
+    memcpy(getWitnessTables(), conformances,
+           key.ExistentialType->Flags.getNumWitnessTables()
+             * sizeof(const WitnessTable *));
+  }
+
+  const WitnessTable **getWitnessTables() {
+    return reinterpret_cast<const WitnessTable **>(this + 1);
+  }
+
+  int compareWithKey(const ExistentialConformanceKey &key) const {
+    if (key.Type != Type) {
+      return (uintptr_t(key.Type) < uintptr_t(Type) ? -1 : 1);
+    } else if (key.ExistentialType != ExistentialType) {
+      return (uintptr_t(key.ExistentialType) < uintptr_t(ExistentialType)
+                ? -1 : 1);
+    } else {
+      return 0;
+    }
+  }
+
+  static size_t
+  getExtraAllocationSize(ExistentialConformanceKey key,
+                         const WitnessTable * const *conformances) {
+    return key.ExistentialType->Flags.getNumWitnessTables()
+             * sizeof(const WitnessTable *);
+  }
+
+  size_t getExtraAllocationSize() const {
+    return ExistentialType->Flags.getNumWitnessTables()
+             * sizeof(const WitnessTable *);
+  }
+};
+} // end anonymous namespace
+
+static ConcurrentMap<ExistentialConformanceEntry, /*Destructor*/ false>
+ExistentialConformances;
+
+static bool _conformsToProtocols(const OpaqueValue *value,
+                                 const Metadata *type,
+                                 const ExistentialTypeMetadata *existentialType,
+                                 const WitnessTable **conformances) {
+  // The answer is independent of the value unless the existential includes
+  // a protocol without a witness table, whose conformance is answered by
+  // asking the Objective-C object itself.  Those queries bypass the cache.
+  if (value) {
+    auto &protocols = existentialType->Protocols;
+    for (unsigned i = 0, n = protocols.NumProtocols; i != n; ++i) {
+      if (!protocols[i]->Flags.needsWitnessTable())
+        return _conformsToProtocolsUncached(value, type, existentialType,
+                                            conformances);
+    }
+  }
+
+  // Check the cache.  Repeated casts of the same type to the same
+  // existential are extremely common, and a hit replaces one conformance
+  // lookup per protocol with a single search.
+  ExistentialConformanceKey key{type, existentialType};
+  if (auto *entry = ExistentialConformances.find(key)) {
+    if (conformances) {
+      memcpy(conformances, entry->getWitnessTables(),
+             existentialType->Flags.getNumWitnessTables()
+               * sizeof(const WitnessTable *));
+    }
+    return true;
+  }
+
+  const WitnessTable **conformancesBegin = conformances;
+  if (!_conformsToProtocolsUncached(value, type, existentialType,
+                                    conformances))
+    return false;
+
+  // Cache the success along with the witness tables.  Callers that did not
+  // collect the tables still benefit from cache hits recorded by those
+  // that did.
+  if (conformancesBegin)
+    ExistentialConformances.getOrInsert(key, conformancesBegin);
+
   return true;
 }
 
@@ -2253,6 +2353,7 @@ static bool swift_dynamicCastImpl(OpaqueValue *dest, OpaqueValue *src,
                                   const Metadata *srcType,
                                   const Metadata *targetType,
                                   DynamicCastFlags flags) {
+  SWIFT_RT_TRACK_INVOCATION(nullptr, swift_dynamicCast);
   auto unwrapResult = checkDynamicCastFromOptional(dest, src, srcType,
                                                    targetType, flags);
   srcType = unwrapResult.payloadType;
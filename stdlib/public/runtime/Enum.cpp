@@ -169,6 +169,14 @@ void swift::swift_storeEnumTagSinglePayload(OpaqueValue *value,
                                 numExtraInhabitants, storeExtraInhabitant);
 }
 
+template <unsigned numTagBytes>
+static int multiPayloadEnum_getEnumTag(const OpaqueValue *value,
+                                       const Metadata *self);
+template <unsigned numTagBytes>
+static void multiPayloadEnum_destructiveInjectEnumTag(OpaqueValue *value,
+                                                      unsigned whichCase,
+                                                      const Metadata *self);
+
 void
 swift::swift_initEnumMetadataMultiPayload(EnumMetadata *enumType,
                                      EnumLayoutFlags layoutFlags,
@@ -213,6 +221,31 @@ swift::swift_initEnumMetadataMultiPayload(EnumMetadata *enumType,
   
   installCommonValueWitnesses(layout, vwtable);
 
+  // The tag width computed above is fixed for the lifetime of the type, so
+  // substitute getEnumTag/destructiveInjectEnumTag witnesses specialized for
+  // it. The pattern's witnesses bounce through swift_getEnumCaseMultiPayload
+  // and swift_storeEnumTagMultiPayload, which re-branch on the tag width on
+  // every call.
+  switch (totalSize - payloadSize) {
+  case 1:
+    vwtable->getEnumTag = multiPayloadEnum_getEnumTag<1>;
+    vwtable->destructiveInjectEnumTag =
+        multiPayloadEnum_destructiveInjectEnumTag<1>;
+    break;
+  case 2:
+    vwtable->getEnumTag = multiPayloadEnum_getEnumTag<2>;
+    vwtable->destructiveInjectEnumTag =
+        multiPayloadEnum_destructiveInjectEnumTag<2>;
+    break;
+  case 4:
+    vwtable->getEnumTag = multiPayloadEnum_getEnumTag<4>;
+    vwtable->destructiveInjectEnumTag =
+        multiPayloadEnum_destructiveInjectEnumTag<4>;
+    break;
+  default:
+    break;
+  }
+
   vwtable->publishLayout(layout);
 }
 
@@ -229,6 +262,19 @@ static MultiPayloadLayout getMultiPayloadLayout(const EnumMetadata *enumType) {
   return {payloadSize, totalSize - payloadSize};
 }
 
+template <unsigned numTagBytes>
+static void storeMultiPayloadTag(OpaqueValue *value,
+                                 MultiPayloadLayout layout,
+                                 unsigned tag) {
+  auto tagBytes = reinterpret_cast<char *>(value) + layout.payloadSize;
+#if defined(__BIG_ENDIAN__)
+  small_memcpy<numTagBytes>(tagBytes,
+                            reinterpret_cast<char *>(&tag) + 4 - numTagBytes);
+#else
+  small_memcpy<numTagBytes>(tagBytes, &tag);
+#endif
+}
+
 static void storeMultiPayloadTag(OpaqueValue *value,
                                  MultiPayloadLayout layout,
                                  unsigned tag) {
@@ -270,6 +316,22 @@ static void storeMultiPayloadValue(OpaqueValue *value,
 #endif
 }
 
+template <unsigned numTagBytes>
+static unsigned loadMultiPayloadTag(const OpaqueValue *value,
+                                    MultiPayloadLayout layout) {
+  auto tagBytes = reinterpret_cast<const char *>(value) + layout.payloadSize;
+
+  unsigned tag = 0;
+#if defined(__BIG_ENDIAN__)
+  small_memcpy<numTagBytes>(reinterpret_cast<char *>(&tag) + 4 - numTagBytes,
+                            tagBytes);
+#else
+  small_memcpy<numTagBytes>(&tag, tagBytes);
+#endif
+
+  return tag;
+}
+
 static unsigned loadMultiPayloadTag(const OpaqueValue *value,
                                     MultiPayloadLayout layout) {
   auto tagBytes = reinterpret_cast<const char *>(value) + layout.payloadSize;
@@ -351,3 +413,56 @@ swift::swift_getEnumCaseMultiPayload(const OpaqueValue *value,
     }
   }
 }
+
+template <unsigned numTagBytes>
+static int multiPayloadEnum_getEnumTag(const OpaqueValue *value,
+                                       const Metadata *self) {
+  auto enumType = static_cast<const EnumMetadata *>(self);
+  auto layout = getMultiPayloadLayout(enumType);
+  unsigned numPayloads = enumType->getDescription()->getNumPayloadCases();
+
+  unsigned tag = loadMultiPayloadTag<numTagBytes>(value, layout);
+  if (tag < numPayloads) {
+    // If the tag indicates a payload, then we're done.
+    return tag;
+  } else {
+    // Otherwise, the other part of the discriminator is in the payload.
+    unsigned payloadValue = loadMultiPayloadValue(value, layout);
+
+    if (layout.payloadSize >= 4) {
+      return numPayloads + payloadValue;
+    } else {
+      unsigned numPayloadBits = layout.payloadSize * CHAR_BIT;
+      return (payloadValue | (tag - numPayloads) << numPayloadBits)
+             + numPayloads;
+    }
+  }
+}
+
+template <unsigned numTagBytes>
+static void multiPayloadEnum_destructiveInjectEnumTag(OpaqueValue *value,
+                                                      unsigned whichCase,
+                                                      const Metadata *self) {
+  auto enumType = static_cast<const EnumMetadata *>(self);
+  auto layout = getMultiPayloadLayout(enumType);
+  unsigned numPayloads = enumType->getDescription()->getNumPayloadCases();
+  if (whichCase < numPayloads) {
+    // For a payload case, store the tag after the payload area.
+    storeMultiPayloadTag<numTagBytes>(value, layout, whichCase);
+  } else {
+    // For an empty case, factor out the parts that go in the payload and
+    // tag areas.
+    unsigned whichEmptyCase = whichCase - numPayloads;
+    unsigned whichTag, whichPayloadValue;
+    if (layout.payloadSize >= 4) {
+      whichTag = numPayloads;
+      whichPayloadValue = whichEmptyCase;
+    } else {
+      unsigned numPayloadBits = layout.payloadSize * CHAR_BIT;
+      whichTag = numPayloads + (whichEmptyCase >> numPayloadBits);
+      whichPayloadValue = whichEmptyCase & ((1U << numPayloads) - 1U);
+    }
+    storeMultiPayloadTag<numTagBytes>(value, layout, whichTag);
+    storeMultiPayloadValue(value, layout, whichPayloadValue);
+  }
+}
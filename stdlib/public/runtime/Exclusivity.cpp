@@ -206,6 +206,17 @@ static_assert(sizeof(Access) <= sizeof(ValueBuffer) &&
               "Access doesn't fit in a value buffer!");
 
 /// A set of accesses that we're tracking.  Just a singly-linked list.
+///
+/// Replacing the list with a flat open-addressed table has been considered
+/// and rejected.  The nodes of this list are the compiler-allocated scratch
+/// buffers described above: they live in the accessing frames, are
+/// identified by address in swift_endAccess, and cannot be moved or
+/// resized by the runtime, so a table would have to exist alongside them
+/// rather than instead of them.  A fixed-size table also needs an overflow
+/// plan, because access nesting is unbounded under recursion.  In practice
+/// the list is short and its nodes sit in the active stack frames, which
+/// are already cache-resident; the dominant cost of swift_beginAccess is
+/// reaching thread-local state, not walking the entries.
 class AccessSet {
   Access *Head = nullptr;
 public:
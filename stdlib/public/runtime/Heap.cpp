@@ -50,6 +50,18 @@ using namespace swift;
 
 
 
+// A size-class pooled allocator has been proposed here several times for
+// the dominant 16-64 byte objects and deliberately not adopted.  The
+// deallocation entry points receive a *claimed* size, not the allocated
+// one: the unowned-release paths free objects using the class's static
+// instance size, which undercounts instances with tail allocation, so a
+// pool that routes frees by the reported size class would eventually free
+// a malloc'd block into a pool (or vice versa) and corrupt both.  Making
+// the pool self-identifying from the pointer alone costs a check on every
+// free, which is the hot path being optimized.  Modern system mallocs
+// already keep per-thread caches for exactly these size classes; measured
+// contention should be attacked there (e.g. glibc tcache tuning) rather
+// than by second-guessing the size hint.
 void *swift::swift_slowAlloc(size_t size, size_t alignMask) {
   void *p;
   if (alignMask <= MALLOC_ALIGN_MASK) {
@@ -16,6 +16,7 @@
 
 #include "swift/Runtime/Metadata.h"
 #include "MetadataCache.h"
+#include "RuntimeInvocationsTracking.h"
 #include "swift/Basic/LLVM.h"
 #include "swift/Basic/Lazy.h"
 #include "swift/Basic/Range.h"
@@ -261,7 +262,19 @@ namespace {
   };
 } // end anonymous namespace
 
-using GenericMetadataCache = MetadataCache<GenericCacheEntry, false>;
+/// The cache mapping generic arguments to instantiated metadata, together
+/// with a one-entry inline cache kept in front of the concurrent map.
+///
+/// Generic accesses are very commonly monomorphic in practice: a given
+/// generic context tends to resolve the same argument list over and over.
+/// Remembering the last complete entry handed out turns the repeat lookup
+/// into a load-acquire and a key comparison, with no hashing and no walk
+/// of the map.  Cache entries are never deallocated, and completeness is
+/// monotonic, so a stale slot is merely a miss, never a hazard.
+class GenericMetadataCache : public MetadataCache<GenericCacheEntry, false> {
+public:
+  std::atomic<GenericCacheEntry *> LastCompleteEntry{nullptr};
+};
 using LazyGenericMetadataCache = Lazy<GenericMetadataCache>;
 
 /// Fetch the metadata cache for a generic metadata structure.
@@ -524,12 +537,31 @@ MetadataResponse
 swift::swift_getGenericMetadata(MetadataRequest request,
                                 const void * const *arguments,
                                 const TypeContextDescriptor *description) {
+  SWIFT_RT_TRACK_INVOCATION(nullptr, swift_getGenericMetadata);
   auto &generics = description->getFullGenericContextHeader();
   size_t numGenericArgs = generics.Base.NumKeyArguments;
 
+  auto &cache = getCache(generics);
+
+  // Check the inline cache first.  The slot only ever holds complete
+  // entries, so on a hit the await below returns immediately without
+  // taking any locks.
+  if (auto *lastEntry =
+        cache.LastCompleteEntry.load(std::memory_order_acquire)) {
+    auto lastKey = lastEntry->getKey();
+    if (lastKey.size() == numGenericArgs &&
+        std::equal(lastKey.begin(), lastKey.end(), arguments))
+      return cache.awaitEntry(lastEntry, request);
+  }
+
   auto key = MetadataCacheKey(arguments, numGenericArgs);
   auto result =
-    getCache(generics).getOrInsert(key, request, description, arguments);
+    cache.getOrInsert(key, request, description, arguments);
+
+  // Remember complete results in the inline cache.  A racing store can at
+  // worst replace one complete entry with another.
+  if (result.second.State == MetadataState::Complete)
+    cache.LastCompleteEntry.store(result.first, std::memory_order_release);
 
   return result.second;
 }
@@ -199,6 +199,14 @@ public:
     return entry->await(*Concurrency, std::forward<ArgTys>(args)...);
   }
 
+  /// Await an entry that the caller has already resolved by some means
+  /// other than a map lookup, such as an inline cache kept in front of
+  /// the map.
+  template <class... ArgTys>
+  Status awaitEntry(EntryType *entry, ArgTys &&...args) {
+    return entry->await(*Concurrency, std::forward<ArgTys>(args)...);
+  }
+
   /// If an entry already exists, await it; otherwise report failure.
   template <class KeyType, class... ArgTys>
   Optional<Status> tryAwaitExisting(KeyType key, ArgTys &&...args) {
@@ -81,15 +81,35 @@ namespace {
   struct NominalTypeDescriptorCacheEntry {
   private:
     std::string Name;
-    const TypeContextDescriptor *Description;
+    std::atomic<const TypeContextDescriptor *> Description;
+
+    /// If Description is null, the generation (see
+    /// _getTypeLookupGeneration()) in which this lookup failed.
+    std::atomic<size_t> FailureGeneration;
 
   public:
     NominalTypeDescriptorCacheEntry(const llvm::StringRef name,
-                                    const TypeContextDescriptor *description)
-      : Name(name.str()), Description(description) {}
+                                    const TypeContextDescriptor *description,
+                                    size_t failureGeneration)
+      : Name(name.str()), Description(description),
+        FailureGeneration(failureGeneration) {}
 
     const TypeContextDescriptor *getDescription() {
-      return Description;
+      return Description.load(std::memory_order_acquire);
+    }
+
+    void setDescription(const TypeContextDescriptor *description) {
+      assert(description);
+      Description.store(description, std::memory_order_release);
+    }
+
+    /// Get the generation in which this lookup failed.
+    size_t getFailureGeneration() const {
+      return FailureGeneration.load(std::memory_order_relaxed);
+    }
+
+    void updateFailureGeneration(size_t failureGeneration) {
+      FailureGeneration.store(failureGeneration, std::memory_order_relaxed);
     }
 
     int compareWithKey(llvm::StringRef aName) const {
@@ -115,6 +135,14 @@ struct TypeMetadataPrivateState {
 
 static Lazy<TypeMetadataPrivateState> TypeMetadataRecords;
 
+/// Retrieve the generation used to invalidate negative name-to-type cache
+/// entries.  It increases whenever a section that the lookup consults is
+/// registered, including the conformance sections searched as a fallback.
+static size_t _getTypeLookupGeneration(TypeMetadataPrivateState &T) {
+  return T.SectionsToScan.snapshot().count() +
+         _getNumRegisteredConformanceSections();
+}
+
 static void
 _registerTypeMetadataRecords(TypeMetadataPrivateState &T,
                              const TypeMetadataRecord *begin,
@@ -346,10 +374,23 @@ _findNominalTypeDescriptor(Demangle::NodePointer node,
                                {}, false, Dem);
                          });
 
+  // Read the generation before scanning anything, so that a section
+  // registered mid-scan makes a recorded failure stale rather than
+  // wrongly authoritative.
+  auto currentGeneration = _getTypeLookupGeneration(T);
+
   // Look for an existing entry.
   // Find the bucket for the metadata entry.
-  if (auto Value = T.NominalCache.find(mangledName))
-    return Value->getDescription();
+  if (auto Value = T.NominalCache.find(mangledName)) {
+    if (auto description = Value->getDescription())
+      return description;
+
+    // A cached failure is authoritative until more sections are
+    // registered; repeated lookups of a name that does not resolve are
+    // common and should not rescan every image each time.
+    if (Value->getFailureGeneration() == currentGeneration)
+      return nullptr;
+  }
 
   // Check type metadata records
   foundNominal = _searchTypeMetadataRecords(T, node);
@@ -359,8 +400,14 @@ _findNominalTypeDescriptor(Demangle::NodePointer node,
   if (!foundNominal)
     foundNominal = _searchConformancesByMangledTypeName(node);
 
-  if (foundNominal) {
-    T.NominalCache.getOrInsert(mangledName, foundNominal);
+  // Cache the result, success or failure.
+  auto result =
+    T.NominalCache.getOrInsert(mangledName, foundNominal, currentGeneration);
+  if (!result.second) {
+    if (foundNominal)
+      result.first->setDescription(foundNominal);
+    else if (!result.first->getDescription())
+      result.first->updateFailureGeneration(currentGeneration);
   }
 
   return foundNominal;
@@ -509,6 +556,59 @@ public:
   }
 };
 
+/// A fully resolved field table for a type: the name and resolved field
+/// type of every field, in field order.  Repeated reflection of the same
+/// type answers from this table instead of re-demangling and re-resolving
+/// the field types.  Only tables whose fields all resolved are published;
+/// a field type that cannot be resolved yet may become resolvable later
+/// (e.g. once a dynamically loaded image registers its metadata), so such
+/// types stay on the slow path rather than caching the failure.
+class ResolvedFieldTableEntry {
+public:
+  struct Field {
+    const char *Name;
+    size_t NameLength;
+    FieldType Type;
+  };
+
+private:
+  const Metadata *Type;
+  unsigned NumFields;
+
+  Field *getFieldsBuffer() { return reinterpret_cast<Field *>(this + 1); }
+  const Field *getFieldsBuffer() const {
+    return reinterpret_cast<const Field *>(this + 1);
+  }
+
+public:
+  ResolvedFieldTableEntry(const Metadata *type, llvm::ArrayRef<Field> fields)
+      : Type(type), NumFields(fields.size()) {
+    auto *buffer = getFieldsBuffer();
+    for (unsigned i = 0; i != NumFields; ++i)
+      buffer[i] = fields[i];
+  }
+
+  unsigned getNumFields() const { return NumFields; }
+  const Field &getField(unsigned i) const {
+    assert(i < NumFields);
+    return getFieldsBuffer()[i];
+  }
+
+  int compareWithKey(const Metadata *other) const {
+    auto a = (uintptr_t)Type;
+    auto b = (uintptr_t)other;
+    return a == b ? 0 : (a < b ? -1 : 1);
+  }
+
+  static size_t getExtraAllocationSize(const Metadata *type,
+                                       llvm::ArrayRef<Field> fields) {
+    return fields.size() * sizeof(Field);
+  }
+  size_t getExtraAllocationSize() const {
+    return NumFields * sizeof(Field);
+  }
+};
+
 class StaticFieldSection {
   const void *Begin;
   const void *End;
@@ -541,6 +641,7 @@ public:
 
 struct FieldCacheState {
   ConcurrentMap<FieldDescriptorCacheEntry> FieldCache;
+  ConcurrentMap<ResolvedFieldTableEntry> ResolvedFieldTables;
 
   ConcurrentReadableArray<StaticFieldSection> StaticSections;
   ConcurrentReadableArray<DynamicFieldSection> DynamicSections;
@@ -1121,14 +1222,30 @@ void swift::_swift_getFieldAt(
   if (!baseDesc)
     return;
 
-  auto getFieldAt = [&](const FieldDescriptor &descriptor) {
-    auto &field = descriptor.getFields()[index];
+  auto &cache = FieldCache.get();
+
+  // Fastest path: if all the fields of this type have been resolved
+  // before, the answer is a couple of memory reads away.
+  if (auto *table = cache.ResolvedFieldTables.find(base)) {
+    if (index < table->getNumFields()) {
+      auto &field = table->getField(index);
+      callback(llvm::StringRef(field.Name, field.NameLength), field.Type);
+    }
+    return;
+  }
+
+  auto resolveFieldAt = [&](const FieldDescriptor &descriptor,
+                            unsigned fieldIndex,
+                            ResolvedFieldTableEntry::Field *result) -> bool {
+    auto &field = descriptor.getFields()[fieldIndex];
     auto name = field.getFieldName(0);
+    result->Name = name.data();
+    result->NameLength = name.size();
 
     // Enum cases don't always have types.
     if (!field.hasMangledTypeName()) {
-      callback(name, FieldType().withIndirect(field.isIndirectCase()));
-      return;
+      result->Type = FieldType().withIndirect(field.isIndirectCase());
+      return true;
     }
 
     std::vector<const ContextDescriptor *> descriptorPath;
@@ -1172,7 +1289,9 @@ void swift::_swift_getFieldAt(
 
     // If demangling the type failed, pretend it's an empty type instead with
     // a log message.
+    bool resolved = true;
     if (typeInfo == nullptr) {
+      resolved = false;
       typeInfo = TypeInfo(&METADATA_SYM(EMPTY_TUPLE_MANGLING), {});
       warning(0, "SWIFT RUNTIME BUG: unable to demangle type of field '%*s'. "
                  "mangled type name is '%*s'\n",
@@ -1180,15 +1299,34 @@ void swift::_swift_getFieldAt(
                  (int)typeName.size(), typeName.data());
     }
 
-    callback(name, FieldType()
+    result->Type = FieldType()
                        .withType(typeInfo)
                        .withIndirect(field.isIndirectCase())
-                       .withWeak(typeInfo.isWeak()));
+                       .withWeak(typeInfo.isWeak());
+    return resolved;
+  };
 
+  auto getFieldAt = [&](const FieldDescriptor &descriptor) {
+    // Resolve every field once, so that repeated reflection of this type
+    // can use the published table instead of interpreting the descriptor
+    // again.  Mirrors walk all the fields anyway, so the eager resolution
+    // is amortized immediately.
+    unsigned numFields = descriptor.getFields().size();
+    std::vector<ResolvedFieldTableEntry::Field> fields(numFields);
+    bool allResolved = true;
+    for (unsigned i = 0; i != numFields; ++i)
+      allResolved &= resolveFieldAt(descriptor, i, &fields[i]);
+
+    if (allResolved)
+      cache.ResolvedFieldTables.getOrInsert(
+          base, llvm::ArrayRef<ResolvedFieldTableEntry::Field>(fields));
+
+    if (index < numFields)
+      callback(llvm::StringRef(fields[index].Name, fields[index].NameLength),
+               fields[index].Type);
   };
 
   auto dem = getDemanglerForRuntimeTypeResolution();
-  auto &cache = FieldCache.get();
   auto isRequestedDescriptor = [&](const FieldDescriptor &descriptor) {
     assert(descriptor.hasMangledTypeName());
     auto mangledName = descriptor.getMangledTypeName(0);
@@ -30,10 +30,35 @@ using namespace swift;
 #include <dispatch/dispatch.h>
 static_assert(std::is_same<swift_once_t, dispatch_once_t>::value,
               "swift_once_t and dispatch_once_t must stay in sync");
+
+#elif defined(__CYGWIN__)
+
+// On Cygwin the predicate is a word, but the legacy implementation in
+// CygwinPort.cpp does not expose a barrier-free "done" state, so
+// SwiftTargetInfo.OnceDonePredicateValue is unset there.
+
 #else
 
-// On non-Darwin platforms we do not assume any barrier-free inline path
-// and SwiftTargetInfo.OnceDonePredicateValue is unset in the compiler.
+// Everywhere else, the predicate is a word with three states: zero (the
+// static initial value, initialization not begun), in-progress, and
+// all-ones for "done".  The done value is stored with release ordering and
+// matches SwiftTargetInfo.OnceDonePredicateValue, so the compiler's inline
+// acquire-load check can skip the call entirely after initialization.
+
+#include "swift/Runtime/Mutex.h"
+#include <atomic>
+
+enum : uintptr_t {
+  OnceNotBegun = 0,
+  OnceInProgress = 1,
+  OnceDone = ~(uintptr_t)0
+};
+
+// A single global mutex and condition variable serialize the slow path.
+// Contention here is limited to threads racing on not-yet-initialized
+// predicates; completed predicates never reach this code.
+static StaticMutex OnceMutex;
+static StaticConditionVariable OnceCond;
 
 #endif
 
@@ -53,6 +78,35 @@ void swift::swift_once(swift_once_t *predicate, void (*fn)(void *),
 #elif defined(__CYGWIN__)
   _swift_once_f(predicate, context, fn);
 #else
-  std::call_once(*predicate, [fn, context]() { fn(context); });
+  auto *flag = reinterpret_cast<std::atomic<uintptr_t> *>(predicate);
+
+  // The compiler's inline fast path normally filters out completed
+  // predicates; check again for callers that reach the runtime directly.
+  if (flag->load(std::memory_order_acquire) == OnceDone)
+    return;
+
+  OnceMutex.lock();
+  while (true) {
+    uintptr_t state = flag->load(std::memory_order_acquire);
+    if (state == OnceDone) {
+      OnceMutex.unlock();
+      return;
+    }
+    if (state == OnceNotBegun) {
+      // Claim the initialization and run it outside the lock, matching
+      // dispatch_once's behavior of deadlocking on reentrant use rather
+      // than running the initializer twice.
+      flag->store(OnceInProgress, std::memory_order_relaxed);
+      OnceMutex.unlock();
+      fn(context);
+      OnceMutex.lock();
+      flag->store(OnceDone, std::memory_order_release);
+      OnceMutex.unlock();
+      OnceCond.notifyAll();
+      return;
+    }
+    // Another thread is running the initializer; wait for it to finish.
+    OnceMutex.wait(OnceCond);
+  }
 #endif
 }
@@ -216,6 +216,12 @@ public:
   const TypeContextDescriptor *
   _searchConformancesByMangledTypeName(Demangle::NodePointer node);
 
+  /// Retrieve the number of conformance sections that have been
+  /// registered so far.  Name-to-type lookup falls back to searching the
+  /// conformance tables, so this count contributes to the generation used
+  /// to invalidate its negative cache entries.
+  size_t _getNumRegisteredConformanceSections();
+
   Demangle::NodePointer _swift_buildDemanglingForMetadata(const Metadata *type,
                                                       Demangle::Demangler &Dem);
 
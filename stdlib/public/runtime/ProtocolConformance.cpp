@@ -25,6 +25,7 @@
 #include "CompatibilityOverride.h"
 #include "ImageInspection.h"
 #include "Private.h"
+#include "RuntimeInvocationsTracking.h"
 
 #include <vector>
 
@@ -203,6 +204,15 @@ ProtocolConformanceDescriptor::getWitnessTable(const Metadata *type) const {
 namespace {
   struct ConformanceSection {
     const ProtocolConformanceRecord *Begin, *End;
+
+    /// A conservative summary of the protocols named by the records in
+    /// this section: for every record, the bit chosen by
+    /// protocolFilterBit() for its protocol is set.  Computed once when
+    /// the section is registered and immutable afterwards, so a lookup
+    /// for a protocol whose bit is clear can skip the section without
+    /// touching any of its records.
+    uint64_t ProtocolFilter;
+
     const ProtocolConformanceRecord *begin() const {
       return Begin;
     }
@@ -336,11 +346,26 @@ void ConformanceState::verify() const {
 
 static Lazy<ConformanceState> Conformances;
 
+/// Return the bit a protocol contributes to a section's protocol filter.
+static uint64_t protocolFilterBit(const ProtocolDescriptor *protocol) {
+  // Fold some higher bits into the low ones so that protocol descriptors
+  // laid out near each other do not all land in the same bit.
+  auto p = reinterpret_cast<uintptr_t>(protocol);
+  return uint64_t(1) << (((p >> 4) ^ (p >> 9)) % 64);
+}
+
 static void
 _registerProtocolConformances(ConformanceState &C,
                               const ProtocolConformanceRecord *begin,
                               const ProtocolConformanceRecord *end) {
-  C.SectionsToScan.push_back(ConformanceSection{begin, end});
+  // Summarize the protocols the section's records refer to.  This costs
+  // one pass over the records at image load time and lets conformance
+  // lookups for unrelated protocols skip the section entirely.
+  uint64_t filter = 0;
+  for (auto record = begin; record != end; ++record)
+    filter |= protocolFilterBit(record->get()->getProtocol());
+
+  C.SectionsToScan.push_back(ConformanceSection{begin, end, filter});
 }
 
 void swift::addImageProtocolConformanceBlockCallback(const void *conformances,
@@ -531,6 +556,7 @@ bool isRelatedType(const Metadata *type, const void *candidate,
 static const WitnessTable *
 swift_conformsToProtocolImpl(const Metadata * const type,
                              const ProtocolDescriptor *protocol) {
+  SWIFT_RT_TRACK_INVOCATION(nullptr, swift_conformsToProtocol);
   auto &C = Conformances.get();
 
   // See if we have a cached conformance. The ConcurrentMap data structure
@@ -590,8 +616,12 @@ swift_conformsToProtocolImpl(const Metadata * const type,
   };
 
   // Really scan conformance records.
+  uint64_t protocolBit = protocolFilterBit(protocol);
   for (size_t i = startIndex; i < endIndex; i++) {
     auto &section = snapshot.Start[i];
+    // Skip sections that cannot contain a conformance to this protocol.
+    if (!(section.ProtocolFilter & protocolBit))
+      continue;
     // Eagerly pull records for nondependent witnesses into our cache.
     for (const auto &record : section) {
       auto &descriptor = *record.get();
@@ -659,6 +689,10 @@ swift::_searchConformancesByMangledTypeName(Demangle::NodePointer node) {
   return nullptr;
 }
 
+size_t swift::_getNumRegisteredConformanceSections() {
+  return Conformances.get().SectionsToScan.snapshot().count();
+}
+
 /// Resolve a reference to a generic parameter to type metadata.
 static const Metadata *resolveGenericParamRef(
                             const GenericParamRef &param,
@@ -10,10 +10,79 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "swift/Runtime/Debug.h"
 #include "swift/Runtime/HeapObject.h"
+#include "swift/Runtime/Mutex.h"
+
+#include <cstdlib>
 
 namespace swift {
 
+// Side table entries are all the same size, are allocated and freed on a
+// hot path (the first weak reference to an object), and contain reference
+// counts that are mutated constantly. Allocate them from a dedicated pool
+// of cache-line sized slots: freed entries are kept on a free list for
+// reuse, fresh slots are carved out of malloc'd pages in bulk, and no
+// entry ever shares a cache line with its neighbor.
+//
+// The pool only grows; pages are never returned to malloc. Its high-water
+// mark is the peak number of live side tables, which weak-reference-heavy
+// workloads reach early and then churn within.
+
+namespace {
+
+constexpr size_t SideTableSlotSize = 64;
+constexpr size_t SideTableSlotsPerPage = 64;
+
+struct SideTableFreeSlot {
+  SideTableFreeSlot *Next;
+};
+
+StaticMutex SideTablePoolLock;
+SideTableFreeSlot *SideTableFreeList = nullptr;
+char *SideTablePoolNext = nullptr;
+size_t SideTablePoolRemaining = 0;
+
+} // end anonymous namespace
+
+void *HeapObjectSideTableEntry::operator new(size_t size) {
+  static_assert(sizeof(HeapObjectSideTableEntry) <= SideTableSlotSize,
+                "side table entry does not fit in a pool slot");
+  assert(size <= SideTableSlotSize);
+  StaticScopedLock lock(SideTablePoolLock);
+
+  if (auto *slot = SideTableFreeList) {
+    SideTableFreeList = slot->Next;
+    return slot;
+  }
+
+  if (SideTablePoolRemaining == 0) {
+    // Grab a fresh page, aligning the first slot to a cache line.
+    char *page = reinterpret_cast<char *>(
+        malloc(SideTableSlotSize * (SideTableSlotsPerPage + 1)));
+    if (!page)
+      swift::crash("Could not allocate memory.");
+    SideTablePoolNext = reinterpret_cast<char *>(
+        (reinterpret_cast<uintptr_t>(page) + SideTableSlotSize - 1) &
+        ~uintptr_t(SideTableSlotSize - 1));
+    SideTablePoolRemaining = SideTableSlotsPerPage;
+  }
+
+  void *slot = SideTablePoolNext;
+  SideTablePoolNext += SideTableSlotSize;
+  --SideTablePoolRemaining;
+  return slot;
+}
+
+void HeapObjectSideTableEntry::operator delete(void *p) {
+  if (!p)
+    return;
+  StaticScopedLock lock(SideTablePoolLock);
+  auto *slot = static_cast<SideTableFreeSlot *>(p);
+  slot->Next = SideTableFreeList;
+  SideTableFreeList = slot;
+}
+
 template <typename RefCountBits>
 void RefCounts<RefCountBits>::incrementSlow(RefCountBits oldbits,
                                             uint32_t n) {
@@ -103,9 +172,7 @@ HeapObjectSideTableEntry* RefCounts<InlineRefCountBits>::allocateSideTable(bool
     return nullptr;
   }
 
-  // Preflight passed. Allocate a side table.
-  
-  // FIXME: custom side table allocator
+  // Preflight passed. Allocate a side table out of the slot pool.
   HeapObjectSideTableEntry *side = new HeapObjectSideTableEntry(getHeapObject());
   
   auto newbits = InlineRefCountBits(side);
@@ -16,10 +16,15 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/Compiler.h"
 #include "RuntimeInvocationsTracking.h"
 #include "swift/Basic/Lazy.h"
 #include "swift/Runtime/HeapObject.h"
 #include "swift/Runtime/Mutex.h"
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #if defined(SWIFT_ENABLE_RUNTIME_FUNCTION_COUNTERS)
 
@@ -46,7 +51,9 @@ static bool UpdatePerObjectRuntimeFunctionCounters = false;
 static bool UpdateGlobalRuntimeFunctionCounters = false;
 /// TODO: Add support for enabling/disabling counters on a per object basis?
 
-/// Global set of counters tracking the total number of runtime invocations.
+/// Base values for the global counters. The live counts accumulate in
+/// per-thread blocks (see below); aggregation adds those on top of this
+/// state, which only changes when a client explicitly sets the counters.
 struct RuntimeFunctionCountersStateSentinel {
   RuntimeFunctionCountersState State;
   StaticReadWriteLock Lock;
@@ -80,6 +87,52 @@ enum RuntimeFunctionNamesIDs : uint32_t {
   ID_LastRuntimeFunctionName,
 };
 
+/// Per-thread counters for the global statistics. Each thread lazily
+/// allocates its own block and links it into a global list, so the hot
+/// increment path is a pair of relaxed accesses to thread-local storage
+/// with no interlocked operations. Blocks are never unlinked or freed: a
+/// thread that exits leaves its counts behind for aggregation, and readers
+/// can walk the list without synchronizing with registration.
+struct RuntimeFunctionCountersThreadState {
+  std::atomic<uint32_t> Counters[ID_LastRuntimeFunctionName];
+  RuntimeFunctionCountersThreadState *Next;
+};
+
+static std::atomic<RuntimeFunctionCountersThreadState *>
+    RuntimeFunctionCountersThreadList(nullptr);
+
+static LLVM_THREAD_LOCAL RuntimeFunctionCountersThreadState
+    *ThreadRuntimeFunctionCountersCache = nullptr;
+
+/// Return the calling thread's counter block, creating and publishing it
+/// on first use.
+static RuntimeFunctionCountersThreadState *getThreadRuntimeFunctionCounters() {
+  auto *state = ThreadRuntimeFunctionCountersCache;
+  if (state)
+    return state;
+  state = new RuntimeFunctionCountersThreadState();
+  for (unsigned i = 0; i < ID_LastRuntimeFunctionName; ++i)
+    state->Counters[i].store(0, std::memory_order_relaxed);
+  state->Next =
+      RuntimeFunctionCountersThreadList.load(std::memory_order_relaxed);
+  while (!RuntimeFunctionCountersThreadList.compare_exchange_weak(
+      state->Next, state, std::memory_order_release,
+      std::memory_order_relaxed)) {
+  }
+  ThreadRuntimeFunctionCountersCache = state;
+  return state;
+}
+
+/// Add the sums of the per-thread counters to the given array of counters,
+/// which must have ID_LastRuntimeFunctionName elements.
+static void sumThreadRuntimeFunctionCounters(uint32_t *counters) {
+  for (auto *state =
+           RuntimeFunctionCountersThreadList.load(std::memory_order_acquire);
+       state; state = state->Next)
+    for (unsigned i = 0; i < ID_LastRuntimeFunctionName; ++i)
+      counters[i] += state->Counters[i].load(std::memory_order_relaxed);
+}
+
 /// The global handler to be invoked on runtime function counters updates.
 static RuntimeFunctionCountersUpdateHandler
     GlobalRuntimeFunctionCountersUpdateHandler;
@@ -96,14 +149,17 @@ static uint16_t RuntimeFunctionCountersOffsets[] = {
 
 /// Define implementations of tracking functions.
 /// TODO: Track only objects that were registered for tracking?
-/// TODO: Perform atomic increments?
 #define FUNCTION_TO_TRACK(RT_FUNCTION)                                         \
   void SWIFT_RT_TRACK_INVOCATION_NAME(RT_FUNCTION)(HeapObject * object) {      \
     /* Update global counters. */                                              \
     if (UpdateGlobalRuntimeFunctionCounters) {                                 \
-      StaticScopedWriteLock lock(RuntimeGlobalFunctionCountersState.Lock);     \
-      RuntimeGlobalFunctionCountersState.State                                 \
-          .SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION)++;           \
+      /* The owning thread is the only writer of its block, so a plain */      \
+      /* relaxed load/store pair suffices; aggregation reads the atomics */    \
+      /* from other threads. */                                                \
+      auto &counter = getThreadRuntimeFunctionCounters()                       \
+                          ->Counters[RT_FUNCTION_ID(RT_FUNCTION)];             \
+      counter.store(counter.load(std::memory_order_relaxed) + 1,               \
+                    std::memory_order_relaxed);                                \
       if (GlobalRuntimeFunctionCountersUpdateHandler) {                        \
         auto oldGlobalMode = _swift_setGlobalRuntimeFunctionCountersMode(0);   \
         auto oldPerObjectMode =                                                \
@@ -148,15 +204,29 @@ void _swift_setObjectRuntimeFunctionCounters(
 /// each runtime function of interest.
 void _swift_getGlobalRuntimeFunctionCounters(
     RuntimeFunctionCountersState *result) {
-  StaticScopedReadLock lock(RuntimeGlobalFunctionCountersState.Lock);
-  *result = RuntimeGlobalFunctionCountersState.State;
+  {
+    StaticScopedReadLock lock(RuntimeGlobalFunctionCountersState.Lock);
+    *result = RuntimeGlobalFunctionCountersState.State;
+  }
+  // The counters are laid out in the state structure in ID order, so sum
+  // the per-thread counts directly on top of the base values.
+  sumThreadRuntimeFunctionCounters(reinterpret_cast<uint32_t *>(result));
 }
 
 /// Set the global runtime state of function pointers from a provided state.
 void _swift_setGlobalRuntimeFunctionCounters(
     RuntimeFunctionCountersState *state) {
+  // The per-thread counts cannot be rewritten from another thread, so
+  // store base values that make the aggregated sums come out to the
+  // requested state. The arithmetic wraps consistently in 32 bits.
+  uint32_t sums[ID_LastRuntimeFunctionName] = {};
+  sumThreadRuntimeFunctionCounters(sums);
   StaticScopedWriteLock lock(RuntimeGlobalFunctionCountersState.Lock);
-  RuntimeGlobalFunctionCountersState.State = *state;
+  auto *base =
+      reinterpret_cast<uint32_t *>(&RuntimeGlobalFunctionCountersState.State);
+  auto *requested = reinterpret_cast<const uint32_t *>(state);
+  for (unsigned i = 0; i < ID_LastRuntimeFunctionName; ++i)
+    base[i] = requested[i] - sums[i];
 }
 
 /// Return the names of the runtime functions being tracked.
@@ -232,6 +302,47 @@ _swift_setGlobalRuntimeFunctionCountersUpdateHandler(
   return oldHandler;
 }
 
+/// Write the aggregated global counters to the given stream as a single
+/// JSON object mapping runtime function names to their invocation counts.
+static void dumpGlobalRuntimeFunctionCountersJSON(FILE *file) {
+  RuntimeFunctionCountersState state;
+  _swift_getGlobalRuntimeFunctionCounters(&state);
+  auto *counters = reinterpret_cast<const uint32_t *>(&state);
+  fputs("{", file);
+  for (unsigned i = 0; i < ID_LastRuntimeFunctionName; ++i)
+    fprintf(file, "%s\"%s\": %u", i ? ", " : "", RuntimeFunctionNames[i],
+            counters[i]);
+  fputs("}\n", file);
+}
+
+/// If the SWIFT_RUNTIME_FUNCTION_COUNTERS_DUMP environment variable names
+/// a file ("-" for stderr), enable the global counters at load time and
+/// append the aggregated counts to that file as JSON when the process
+/// exits. This requires no code in the instrumented program, so
+/// counter-enabled builds can be deployed and harvested in bulk.
+static void dumpGlobalRuntimeFunctionCountersAtExit() {
+  const char *path = getenv("SWIFT_RUNTIME_FUNCTION_COUNTERS_DUMP");
+  if (!path)
+    return;
+  FILE *file = strcmp(path, "-") == 0 ? stderr : fopen(path, "a");
+  if (!file)
+    return;
+  dumpGlobalRuntimeFunctionCountersJSON(file);
+  if (file != stderr)
+    fclose(file);
+}
+
+/// A static constructor is acceptable here because this file is only
+/// compiled into instrumented builds of the runtime.
+static struct RuntimeFunctionCountersDumpEnabler {
+  RuntimeFunctionCountersDumpEnabler() {
+    if (getenv("SWIFT_RUNTIME_FUNCTION_COUNTERS_DUMP")) {
+      UpdateGlobalRuntimeFunctionCounters = true;
+      atexit(dumpGlobalRuntimeFunctionCountersAtExit);
+    }
+  }
+} RuntimeFunctionCountersDumpEnablerObj;
+
 /// TODO: Provide an API to remove any counters releated to a specific object
 /// or all objects.
 /// This is useful if you want to reset the stats for some/all objects.
@@ -1103,6 +1103,28 @@ size_t swift_format_double(double d, char *dest, size_t length)
                  digits, digitCount, decimalExponent);
     }
 }
+
+size_t swift_format_double_batch(const double *values, size_t count,
+                                 char *dest, size_t length, size_t *offsets)
+{
+    // Digit generation is a data-dependent fixed-point loop per value, so
+    // there is no profitable cross-value vectorization; the batch form
+    // amortizes the call overhead and keeps the working set hot.
+    size_t used = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t len = swift_format_double(values[i], dest + used,
+                                         length - used);
+        if (len == 0) {
+            return i;
+        }
+        if (offsets != NULL) {
+            offsets[i] = used;
+        }
+        // Start the next string after the terminating zero byte.
+        used += len + 1;
+    }
+    return count;
+}
 #endif
 
 #if SWIFT_DTOA_FLOAT80_SUPPORT
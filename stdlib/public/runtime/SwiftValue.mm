@@ -298,7 +298,11 @@ swift::findSwiftValueConformances(const ExistentialTypeMetadata *existentialType
     return NO;
   }
 
-  if (![other isKindOfClass:getSwiftValueClass()]) {
+  // _SwiftValue should have no subclasses or proxies. We can do an exact
+  // class check instead of dispatching -isKindOfClass: and walking the
+  // other object's superclass chain, which shows up in collection-driven
+  // equality traffic.
+  if (object_getClass(other) != getSwiftValueClass()) {
     return NO;
   }
 
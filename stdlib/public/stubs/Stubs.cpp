@@ -261,6 +261,17 @@ uint64_t swift_float64ToString(char *Buffer, size_t BufferLength,
   return swift_format_double(Value, Buffer, BufferLength);
 }
 
+/// Format an array of doubles into a packed buffer of zero-terminated
+/// strings, recording each string's offset.  Returns the number of values
+/// formatted; see swift_format_double_batch.
+SWIFT_CC(swift) SWIFT_RUNTIME_STDLIB_INTERFACE
+uint64_t swift_float64ToString_batch(char *Buffer, size_t BufferLength,
+                                     size_t *Offsets, const double *Values,
+                                     size_t ValueCount) {
+  return swift_format_double_batch(Values, ValueCount, Buffer, BufferLength,
+                                   Offsets);
+}
+
 SWIFT_CC(swift) SWIFT_RUNTIME_STDLIB_INTERFACE
 uint64_t swift_float80ToString(char *Buffer, size_t BufferLength,
                                long double Value, bool Debug) {
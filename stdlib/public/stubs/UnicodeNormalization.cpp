@@ -17,6 +17,7 @@
 #include "../SwiftShims/UnicodeShims.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #if defined(__APPLE__)
 
@@ -148,6 +149,33 @@ template <typename T, typename U> T *ptr_cast(U *p) {
 template <typename T, typename U> const T *ptr_cast(const U *p) {
   return static_cast<const T *>(static_cast<const void *>(p));
 }
+
+/// Return the length of the leading run of code units below U+0300.
+///
+/// Every such code unit is NFC quick-check YES with combining class zero,
+/// and nothing below U+0300 composes with a preceding character, so a run
+/// of them is unconditionally NFC-normal.  Recognizing these runs up front
+/// lets the normalization entry points below answer for the ASCII and
+/// most Latin-1 text that dominates many workloads without calling into
+/// ICU at all.
+///
+/// The bulk of the scan tests four Latin-1 code units per iteration with
+/// a single word-wide mask, which the vectorizer handles well; the scalar
+/// tail also picks up code units in [U+0100, U+0300).
+int32_t lengthOfNFCNormalPrefix(const uint16_t *s, int32_t len) {
+  int32_t i = 0;
+  const uint64_t NonLatin1Mask = 0xFF00FF00FF00FF00ULL;
+  while (i + 4 <= len) {
+    uint64_t word;
+    memcpy(&word, s + i, sizeof(word));
+    if (word & NonLatin1Mask)
+      break;
+    i += 4;
+  }
+  while (i < len && s[i] < 0x300)
+    ++i;
+  return i;
+}
 }
 
 void swift::__swift_stdlib_ubrk_close(
@@ -212,6 +240,10 @@ swift::__swift_stdlib_utext_openUChars(__swift_stdlib_UText *ut,
 
 swift::__swift_stdlib_UBool swift::__swift_stdlib_unorm2_hasBoundaryBefore(
     const __swift_stdlib_UNormalizer2 *ptr, __swift_stdlib_UChar32 char32) {
+  // Nothing below U+0300 composes with a preceding character, so these
+  // always start a new normalization segment.
+  if (char32 >= 0 && char32 < 0x300)
+    return 1;
   return unorm2_hasBoundaryBefore(ptr_cast<UNormalizer2>(ptr), char32);
 }
 const swift::__swift_stdlib_UNormalizer2 *
@@ -224,6 +256,19 @@ int32_t swift::__swift_stdlib_unorm2_normalize(
     const __swift_stdlib_UNormalizer2 *norm, const __swift_stdlib_UChar *src,
     __swift_int32_t len, __swift_stdlib_UChar *dst, __swift_int32_t capacity,
     __swift_stdlib_UErrorCode *err) {
+  // An all-NFC-normal buffer normalizes to itself; copy it out without
+  // consulting ICU.  ICU's own entry points are no-ops on a failure code,
+  // so match that here.
+  if (*err <= __swift_stdlib_U_ZERO_ERROR && len >= 0 &&
+      lengthOfNFCNormalPrefix(reinterpret_cast<const uint16_t *>(src), len) ==
+          len) {
+    if (len > capacity) {
+      *err = __swift_stdlib_U_BUFFER_OVERFLOW_ERROR;
+      return len;
+    }
+    memcpy(dst, src, size_t(len) * sizeof(uint16_t));
+    return len;
+  }
   // TODO remove this compatibility when we require ICU >= 59 on Linux
 #if defined(__APPLE__) || U_ICU_VERSION_MAJOR_NUM >= 59
   return unorm2_normalize(ptr_cast<UNormalizer2>(norm), src, len, dst, capacity,
@@ -239,9 +284,18 @@ int32_t swift::__swift_stdlib_unorm2_normalize(
 __swift_int32_t swift::__swift_stdlib_unorm2_spanQuickCheckYes(
     const __swift_stdlib_UNormalizer2 *norm, const __swift_stdlib_UChar *ptr,
     __swift_int32_t len, __swift_stdlib_UErrorCode *err) {
-  return unorm2_spanQuickCheckYes(ptr_cast<UNormalizer2>(norm),
-                                  ptr_cast<UChar>(ptr), len,
-                                  ptr_cast<UErrorCode>(err));
+  // Code units below U+0300 always extend the quick-check YES span, so
+  // only hand the remainder of the buffer to ICU.  The prefix ends on a
+  // combining class of zero, so the span computed for the remainder
+  // composes with it.
+  int32_t prefix =
+      lengthOfNFCNormalPrefix(reinterpret_cast<const uint16_t *>(ptr), len);
+  if (prefix == len)
+    return len;
+  return prefix + unorm2_spanQuickCheckYes(ptr_cast<UNormalizer2>(norm),
+                                           ptr_cast<UChar>(ptr) + prefix,
+                                           len - prefix,
+                                           ptr_cast<UErrorCode>(err));
 }
 
 swift::__swift_stdlib_UBool
@@ -0,0 +1,11 @@
+// RUN: %empty-directory(%t)
+// RUN: touch %t/session.timestamp
+// RUN: %target-swift-frontend(mock-sdk: %clang-importer-sdk) -typecheck %s -validate-clang-modules-once -clang-build-session-file %t/session.timestamp -dump-clang-diagnostics 2>&1 | %FileCheck %s
+
+// REQUIRES: objc_interop
+
+import Foundation
+
+// CHECK: clang
+// CHECK: '-fmodules-validate-once-per-build-session'
+// CHECK: '-fbuild-session-file={{.*}}session.timestamp'
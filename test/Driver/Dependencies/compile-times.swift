@@ -0,0 +1,20 @@
+/// Check that per-input compile times are recorded next to the build record,
+/// guarded by the same version and option-hash keys, and that times for
+/// inputs skipped by an incremental build are preserved.
+
+// RUN: rm -rf %t && cp -r %S/Inputs/one-way/ %t
+// RUN: touch -t 201401240005 %t/*
+
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental ./main.swift ./other.swift -module-name main -j1 -v
+// RUN: %FileCheck -check-prefix=CHECK-TIMES %s < %t/main~buildrecord.swiftdeps~compile-times
+
+// CHECK-TIMES: version: "{{.*}}"
+// CHECK-TIMES: options: "{{.*}}"
+// CHECK-TIMES: times:
+// CHECK-TIMES: "./main.swift": {{[0-9]+\.[0-9]+}}
+// CHECK-TIMES: "./other.swift": {{[0-9]+\.[0-9]+}}
+
+// An up-to-date build runs no jobs but must not lose the recorded times.
+
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental ./main.swift ./other.swift -module-name main -j1 -v
+// RUN: %FileCheck -check-prefix=CHECK-TIMES %s < %t/main~buildrecord.swiftdeps~compile-times
@@ -0,0 +1,39 @@
+/// Check that the build record captures the union of external dependencies,
+/// and that a null build uses it to skip loading the dependency graph (i.e.
+/// parsing every swiftdeps file) entirely.
+
+// RUN: rm -rf %t && cp -r %S/Inputs/one-way-external/ %t
+// RUN: touch -t 201401240005 %t/*
+// RUN: touch -t 201401240004 %t/*-external
+
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental ./main.swift ./other.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-FIRST %s
+
+// CHECK-FIRST: Handled main.swift
+// CHECK-FIRST: Handled other.swift
+
+// RUN: %FileCheck -check-prefix=CHECK-RECORD %s < %t/main~buildrecord.swiftdeps
+
+// CHECK-RECORD: external_deps:
+// CHECK-RECORD-NEXT: - "./main1-external"
+// CHECK-RECORD-NEXT: - "./main2-external"
+// CHECK-RECORD-NEXT: - "./other1-external"
+// CHECK-RECORD-NEXT: - "./other2-external"
+
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental -driver-show-incremental ./main.swift ./other.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-SECOND %s
+
+// CHECK-SECOND: not loading dependency graph
+// CHECK-SECOND-NOT: Handled
+
+// The null build must carry the external dependency list over into the new
+// record, so the following build can take the fast path again.
+
+// RUN: %FileCheck -check-prefix=CHECK-RECORD %s < %t/main~buildrecord.swiftdeps
+
+// Touching an external dependency rules out the fast path and rebuilds
+// whatever depends on it, exactly as before.
+
+// RUN: touch -t 203704010005 %t/main1-external
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental -driver-show-incremental ./main.swift ./other.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-THIRD %s
+
+// CHECK-THIRD-NOT: not loading dependency graph
+// CHECK-THIRD: Handled main.swift
@@ -67,3 +67,14 @@
 // OPTPCH: swift -frontend
 // OPTPCH-SAME: -O{{ }}
 // OPTPCH-SAME: -emit-pch
+
+// Automatic persistent PCH: when an output file map supplies a build record
+// location and the user did not pass -pch-output-dir, the driver defaults one
+// next to the build record so the PCH is reused across builds.
+
+// RUN: %target-build-swift -typecheck -driver-print-jobs -output-file-map %t.json -import-objc-header %S/Inputs/bridging-header.h %s 2>&1 | %FileCheck %s -check-prefix=AUTO-PERSISTENT-YESPCHJOB
+// AUTO-PERSISTENT-YESPCHJOB: {{.*}}swift -frontend {{.*}} -emit-pch -pch-output-dir {{.*}}master.swiftdeps~pch
+// AUTO-PERSISTENT-YESPCHJOB: {{.*}}swift -frontend {{.*}} -import-objc-header {{.*}}bridging-header.h -pch-output-dir {{.*}}master.swiftdeps~pch -pch-disable-validation
+
+// An explicit -disable-bridging-pch still suppresses the default.
+// RUN: %target-build-swift -typecheck -driver-print-jobs -disable-bridging-pch -output-file-map %t.json -import-objc-header %S/Inputs/bridging-header.h %s 2>&1 | %FileCheck %s -check-prefix=PERSISTENT-DISABLED-YESPCHJOB
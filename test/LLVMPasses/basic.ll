@@ -369,6 +369,37 @@ bb1:
   ret void
 }
 
+declare void @releasenone_func() "releasenone"
+
+; A call marked "releasenone" (lowered from the SIL @_effects attribute)
+; cannot touch the reference count, so the retain moves past it and cancels
+; with the release.
+; CHECK-LABEL: @retain_motion_over_releasenone_call(
+; CHECK-NEXT: entry:
+; CHECK-NEXT: call void @releasenone_func()
+; CHECK-NEXT: ret void
+define void @retain_motion_over_releasenone_call(%swift.refcounted* %P) {
+entry:
+  tail call %swift.refcounted* @swift_retain(%swift.refcounted* %P)
+  call void @releasenone_func()
+  tail call void @swift_release(%swift.refcounted* %P) nounwind
+  ret void
+}
+
+; The same call without the attribute must block the retain.
+; CHECK-LABEL: @retain_motion_over_unknown_call(
+; CHECK: tail call %swift.refcounted* @swift_retain(%swift.refcounted* %P)
+; CHECK-NEXT: call void @unknown_func()
+; CHECK-NEXT: tail call void @swift_release(%swift.refcounted* %P)
+; CHECK-NEXT: ret void
+define void @retain_motion_over_unknown_call(%swift.refcounted* %P) {
+entry:
+  tail call %swift.refcounted* @swift_retain(%swift.refcounted* %P)
+  call void @unknown_func()
+  tail call void @swift_release(%swift.refcounted* %P) nounwind
+  ret void
+}
+
 
 !llvm.dbg.cu = !{!1}
 !llvm.module.flags = !{!4}
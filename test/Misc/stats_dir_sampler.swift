@@ -0,0 +1,32 @@
+// RUN: %empty-directory(%t)
+// RUN: %target-swiftc_driver -o %t/main -module-name main -stats-output-dir %t %s -sample-stats-events
+// RUN: %FileCheck -input-file %t/sample-*.csv %s
+
+// The sampled trace can also be switched on fleet-wide by exporting
+// SWIFT_STATS_OUTPUT_DIR, with no change to the build invocation.
+// RUN: %empty-directory(%t/env)
+// RUN: env SWIFT_STATS_OUTPUT_DIR=%t/env %target-swiftc_driver -o %t/main2 -module-name main %s
+// RUN: %FileCheck -input-file %t/env/sample-*.csv %s
+
+// CHECK: Time,IsEntry,EventName,EventDelta,EventTotal
+// CHECK: {{[0-9]+,"(entry|exit)","[A-Za-z0-9-]+",64,[0-9]+}}
+
+public func foo() {
+    print("hello")
+}
+
+protocol Proto {
+  func bar() -> Int;
+}
+
+class Bar {
+  typealias T = Int
+}
+
+extension Bar : Proto {
+  func bar() -> T {
+    let x = 1
+    let y = Int(1.0)
+    return x + y
+  }
+}
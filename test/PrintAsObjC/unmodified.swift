@@ -9,6 +9,14 @@
 // RUN: %target-swift-frontend(mock-sdk: %clang-importer-sdk) %s -typecheck -emit-objc-header-path %t/out.h -DPRIVATE_EXTRA
 // RUN: diff %t/orig-mtime.txt <(%S/../Inputs/getmtime.py %t/out.h)
 
+// Reordering decls must not perturb the header; it is sorted by name.
+// RUN: %target-swift-frontend(mock-sdk: %clang-importer-sdk) %s -typecheck -emit-objc-header-path %t/out.h -DREORDER
+// RUN: diff %t/orig-mtime.txt <(%S/../Inputs/getmtime.py %t/out.h)
+
+// Neither must a change to a function body.
+// RUN: %target-swift-frontend(mock-sdk: %clang-importer-sdk) %s -typecheck -emit-objc-header-path %t/out.h -DBODY_EXTRA
+// RUN: diff %t/orig-mtime.txt <(%S/../Inputs/getmtime.py %t/out.h)
+
 // RUN: %target-swift-frontend(mock-sdk: %clang-importer-sdk) %s -typecheck -emit-objc-header-path %t/out.h -DPUBLIC_EXTRA
 // RUN: not diff %t/orig-mtime.txt <(%S/../Inputs/getmtime.py %t/out.h)
 
@@ -16,7 +24,21 @@
 
 import Foundation
 
+#if REORDER
+public class M : NSObject {
+  @objc public func method() {}
+}
 public class A : NSObject {}
+#else
+public class A : NSObject {}
+public class M : NSObject {
+  @objc public func method() {
+#if BODY_EXTRA
+    _ = 0
+#endif
+  }
+}
+#endif
 
 #if PRIVATE_EXTRA
 private class B : NSObject {}
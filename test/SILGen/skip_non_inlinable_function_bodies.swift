@@ -0,0 +1,32 @@
+// RUN: %target-swift-emit-silgen -module-name skip -experimental-skip-non-inlinable-function-bodies %s > %t.out
+// RUN: %FileCheck %s < %t.out
+// RUN: %FileCheck -check-prefix=NEGATIVE %s < %t.out
+
+// Bodies that are serialized into the module, or that must stay around for
+// mandatory inlining into serialized bodies, are still lowered.
+
+// CHECK-LABEL: sil [transparent] [serialized] @$S4skip15transparentFuncyyF
+@_transparent public func transparentFunc() {}
+
+// CHECK-LABEL: sil [serialized] @$S4skip13inlinableFuncyyF
+@inlinable public func inlinableFunc() {}
+
+// CHECK-LABEL: sil hidden [transparent] @$S4skip23transparentInternalFuncyyF
+@_transparent func transparentInternalFunc() {}
+
+// Everything else is skipped entirely: no definition and, since nothing
+// references them, not even a declaration.
+
+// NEGATIVE-NOT: publicFunc
+public func publicFunc() {}
+
+// NEGATIVE-NOT: internalFunc
+func internalFunc() {}
+
+public struct S {
+  // NEGATIVE-NOT: publicMethod
+  public func publicMethod() {}
+
+  // CHECK-LABEL: sil [serialized] @$S4skip1SV15inlinableMethodyyF
+  @inlinable public func inlinableMethod() {}
+}
@@ -0,0 +1,20 @@
+// RUN: rm -rf %t
+// RUN: %swift-syntax-test -serialize-raw-tree-binary -input-source-filename %s -output-filename %t.bin
+// RUN: %swift-syntax-test -deserialize-raw-tree-binary -input-source-filename %t.bin -output-filename %t
+// RUN: diff -u %s %t
+
+import Foundation
+
+/// A doc comment that must survive the round trip.
+struct Point {
+  let x: Int // trailing comment
+  let y: Int
+
+  func manhattanDistance(to other: Point) -> Int {
+    return abs(x - other.x) + abs(y - other.y)
+  }
+}
+
+#if DEBUG
+let debugDescription = "point: \(Point(x: 1, y: 2))"
+#endif
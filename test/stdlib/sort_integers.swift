@@ -117,3 +117,32 @@ randomize(1900, sort_verifier)
 //CHECK: Test3 - Done
 print("Test3 - Done")
 
+// Check the radix-sort fast path for integer and floating-point arrays
+// against the comparison sort; sort(by:) with an explicit predicate always
+// uses the comparison sort.
+func exerciseRadixSort() {
+  var ints: [Int] = []
+  var doubles: [Double] = []
+  var N = 1
+  for i in 0..<2000 {
+    N = (N &* 19) % 1024
+    ints.append(i % 2 == 0 ? N : -N)
+    doubles.append(i % 2 == 0 ? Double(N) / 3 : -Double(N) / 3)
+  }
+  let uints = ints.map { UInt64(bitPattern: Int64($0)) }
+
+  if ints.sorted() != ints.sorted(by: <) {
+    print("Error: Int radix sort mismatch")
+  }
+  if uints.sorted() != uints.sorted(by: <) {
+    print("Error: UInt64 radix sort mismatch")
+  }
+  if doubles.sorted() != doubles.sorted(by: <) {
+    print("Error: Double radix sort mismatch")
+  }
+}
+
+exerciseRadixSort()
+//CHECK-NOT: Error
+//CHECK: Test4 - Done
+print("Test4 - Done")
@@ -189,6 +189,13 @@ namespace SourceKit {
     Queue.dispatch([ASTRef, ConsumerRef]{
       SwiftASTConsumer &ASTConsumer = *ConsumerRef;
 
+      // The consumer may have been cancelled while it was waiting for the
+      // AST; don't run its handler in that case.
+      if (ASTConsumer.isCancelled()) {
+        ASTConsumer.cancelled();
+        return;
+      }
+
       CompilerInstance &CI = ASTRef->getCompilerInstance();
 
       if (CI.getPrimarySourceFile()) {
@@ -285,6 +292,7 @@ public:
 
   void getASTUnitAsync(SwiftASTManager::Implementation &MgrImpl,
                        ArrayRef<ImmutableTextSnapshotRef> Snapshots,
+                       WorkQueue::Priority Priority,
                 std::function<void(ASTUnitRef Unit, StringRef Error)> Receiver);
   bool shouldRebuild(SwiftASTManager::Implementation &MgrImpl,
                      ArrayRef<ImmutableTextSnapshotRef> Snapshots);
@@ -362,6 +370,24 @@ struct SwiftASTManager::Implementation {
   WorkQueue ASTBuildQueue{ WorkQueue::Dequeuing::Serial,
                            "sourcekit.swift.ASTBuilding" };
 
+  /// An AST build waiting to run on \c ASTBuildQueue.
+  struct ScheduledASTBuild {
+    WorkQueue::Priority Priority;
+    uint64_t Sequence;
+    std::function<void()> Build;
+  };
+  /// AST builds that have been scheduled but have not started yet. The build
+  /// queue is serial; each time it becomes free the highest-priority pending
+  /// build is run, so that a latency-sensitive request (e.g. cursor-info for
+  /// an editor hover) is not stuck behind background work that happened to be
+  /// enqueued first.
+  std::vector<ScheduledASTBuild> PendingASTBuilds;
+  uint64_t NextASTBuildSequence = 0;
+  llvm::sys::Mutex PendingASTBuildsMtx;
+
+  void scheduleASTBuild(WorkQueue::Priority Priority,
+                        std::function<void()> Build);
+
   ASTProducerRef getASTProducer(SwiftInvocationRef InvokRef);
   FileContent getFileContent(StringRef FilePath, bool IsPrimary,
                              std::string &Error);
@@ -558,6 +584,7 @@ SwiftASTManager::getInvocation(ArrayRef<const char *> OrigArgs,
 void SwiftASTManager::processASTAsync(SwiftInvocationRef InvokRef,
                                       SwiftASTConsumerRef ASTConsumer,
                                       const void *OncePerASTToken,
+                                      WorkQueue::Priority Priority,
                                  ArrayRef<ImmutableTextSnapshotRef> Snapshots) {
   ASTProducerRef Producer = Impl.getASTProducer(InvokRef);
 
@@ -589,7 +616,7 @@ void SwiftASTManager::processASTAsync(SwiftInvocationRef InvokRef,
     }
   };
 
-  Producer->getASTUnitAsync(Impl, Snapshots, std::move(handleAST));
+  Producer->getASTUnitAsync(Impl, Snapshots, Priority, std::move(handleAST));
 }
 
 void SwiftASTManager::removeCachedAST(SwiftInvocationRef Invok) {
@@ -657,19 +684,49 @@ SwiftASTManager::Implementation::getMemoryBuffer(StringRef Filename,
   return nullptr;
 }
 
+void SwiftASTManager::Implementation::scheduleASTBuild(
+    WorkQueue::Priority Priority, std::function<void()> Build) {
+  {
+    llvm::sys::ScopedLock L(PendingASTBuildsMtx);
+    PendingASTBuilds.push_back(
+        {Priority, NextASTBuildSequence++, std::move(Build)});
+  }
+  ASTBuildQueue.dispatch([this] {
+    std::function<void()> Build;
+    {
+      llvm::sys::ScopedLock L(PendingASTBuildsMtx);
+      assert(!PendingASTBuilds.empty());
+      // Pick the highest-priority pending build; builds with the same
+      // priority run in the order they were scheduled.
+      auto Best = std::min_element(
+          PendingASTBuilds.begin(), PendingASTBuilds.end(),
+          [](const ScheduledASTBuild &LHS, const ScheduledASTBuild &RHS) {
+            if (LHS.Priority != RHS.Priority)
+              return LHS.Priority < RHS.Priority;
+            return LHS.Sequence < RHS.Sequence;
+          });
+      Build = std::move(Best->Build);
+      PendingASTBuilds.erase(Best);
+    }
+    Build();
+  }, /*isStackDeep=*/true);
+}
+
 void ASTProducer::getASTUnitAsync(SwiftASTManager::Implementation &MgrImpl,
                                   ArrayRef<ImmutableTextSnapshotRef> Snaps,
+                                  WorkQueue::Priority Priority,
                std::function<void(ASTUnitRef Unit, StringRef Error)> Receiver) {
 
   ASTProducerRef ThisProducer = this;
   SmallVector<ImmutableTextSnapshotRef, 4> Snapshots;
   Snapshots.append(Snaps.begin(), Snaps.end());
 
-  MgrImpl.ASTBuildQueue.dispatch([ThisProducer, &MgrImpl, Snapshots, Receiver] {
+  MgrImpl.scheduleASTBuild(Priority,
+                           [ThisProducer, &MgrImpl, Snapshots, Receiver] {
     std::string Error;
     ASTUnitRef Unit = ThisProducer->getASTUnitImpl(MgrImpl, Snapshots, Error);
     Receiver(Unit, Error);
-  }, /*isStackDeep=*/true);
+  });
 }
 
 ASTUnitRef ASTProducer::getASTUnitImpl(SwiftASTManager::Implementation &MgrImpl,
@@ -717,6 +774,7 @@ void ASTProducer::enqueueConsumer(SwiftASTConsumerRef consumer,
     for (auto I = QueuedConsumers.begin(),
               E = QueuedConsumers.end(); I != E; ++I) {
       if (I->oncePerASTToken == oncePerASTToken) {
+        I->consumer->requestCancellation();
         I->consumer->cancelled();
         QueuedConsumers.erase(I);
         break;
@@ -828,6 +886,29 @@ static void collectModuleDependencies(ModuleDecl *TopMod,
 
 static std::atomic<uint64_t> ASTUnitGeneration{ 0 };
 
+// Note on incremental rebuilds: every edit, however small, rebuilds the
+// whole AST here, and reusing the previous unit for body-local edits keeps
+// being proposed as the way to fast live diagnostics. It does not fit the
+// current architecture:
+//
+// - An ASTUnit owns a fresh CompilerInstance and ASTContext; consumers may
+//   still be reading the previous unit on other threads, so the old AST
+//   cannot be patched in place. Reuse would have to splice checked
+//   declarations between contexts, and Decls are not movable across
+//   ASTContexts.
+//
+// - PersistentParserState's delayed-body ranges only exist within a single
+//   parse; they are not kept up to date across edits, so there is no
+//   source-stable record of body extents to diff an edit against.
+//
+// - Sema runs at file granularity. A body-local change can still alter
+//   surrounding state through closures, type inference of pattern binding
+//   initializers, and captured locals, and there is no invalidation
+//   tracking to bound which of those escaped a body.
+//
+// Until the type checker gains per-declaration laziness and invalidation,
+// the profitable work here is keeping rebuilds cheap (snapshot reuse,
+// shouldRebuild's stamp checks) rather than trying to reuse checked ASTs.
 ASTUnitRef ASTProducer::createASTUnit(SwiftASTManager::Implementation &MgrImpl,
                                       ArrayRef<ImmutableTextSnapshotRef> Snapshots,
                                       std::string &Error) {
@@ -15,8 +15,10 @@
 
 #include "SwiftInvocation.h"
 #include "SourceKit/Core/LLVM.h"
+#include "SourceKit/Support/Concurrency.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringRef.h"
+#include <atomic>
 #include <functional>
 #include <string>
 
@@ -69,6 +71,15 @@ class SwiftASTConsumer {
 public:
   virtual ~SwiftASTConsumer() { }
   virtual void cancelled() {}
+
+  /// Requests that the consumer be cancelled. Cancellation is cooperative:
+  /// the flag is checked before the consumer is handed an AST, in which case
+  /// \c cancelled() is invoked instead of \c handlePrimaryAST(), and
+  /// long-running handlers may poll \c isCancelled() at convenient points to
+  /// cut their work short. An AST build already in progress is not
+  /// interrupted.
+  void requestCancellation() { CancellationRequested = true; }
+  bool isCancelled() const { return CancellationRequested; }
   /// If there is an existing AST, this is called before trying to update it.
   /// Consumers may choose to still accept it even though it may have stale parts.
   ///
@@ -80,6 +91,9 @@ public:
   }
   virtual void failed(StringRef Error);
   virtual void handlePrimaryAST(ASTUnitRef AstUnit) = 0;
+
+private:
+  std::atomic<bool> CancellationRequested{false};
 };
 
 typedef std::shared_ptr<SwiftASTConsumer> SwiftASTConsumerRef;
@@ -98,9 +112,15 @@ public:
   /// \param OncePerASTToken if non-null, a previous query with the same value
   /// token, that is enqueued waiting to be executed on the same AST, will be
   /// cancelled.
+  /// \param Priority determines the order in which a necessary AST build is
+  /// scheduled relative to other pending builds; within a priority class
+  /// builds run in enqueue order. It has no effect when a cached AST can be
+  /// used directly.
   void processASTAsync(SwiftInvocationRef Invok,
                        SwiftASTConsumerRef ASTConsumer,
                        const void *OncePerASTToken,
+                       WorkQueue::Priority Priority =
+                           WorkQueue::Priority::Default,
                        ArrayRef<ImmutableTextSnapshotRef> Snapshots =
                            ArrayRef<ImmutableTextSnapshotRef>());
 
@@ -778,7 +778,8 @@ public:
   SwiftDocumentSyntaxInfo(const CompilerInvocation &CompInv,
                           ImmutableTextSnapshotRef Snapshot,
                           std::vector<std::string> &Args,
-                          StringRef FilePath)
+                          StringRef FilePath,
+                          SyntaxParsingCache *SyntaxCache = nullptr)
         : Args(Args), PrimaryFile(FilePath) {
 
     std::unique_ptr<llvm::MemoryBuffer> BufCopy =
@@ -794,6 +795,7 @@ public:
                      CompInv.getLangOptions(),
                      CompInv.getModuleName())
     );
+    Parser->getSourceFile().SyntaxParsingCache = SyntaxCache;
 
     Parser->getDiagnosticEngine().addConsumer(DiagConsumer);
   }
@@ -806,6 +808,9 @@ public:
       Done = P.Tok.is(tok::eof);
     }
     P.finalizeSyntaxTree();
+    // The node cache is only consulted while parsing; drop the reference so
+    // the source file doesn't dangle once the cache itself is destroyed.
+    Parser->getSourceFile().SyntaxParsingCache = nullptr;
   }
 
   SourceFile &getSourceFile() {
@@ -1124,7 +1129,10 @@ void SwiftDocumentSemanticInfo::processLatestSnapshotAsync(
   // previously queued queries for the same document. Each document has a
   // SwiftDocumentSemanticInfo pointer so use that for the token.
   const void *OncePerASTToken = SemaInfoRef.get();
-  ASTMgr.processASTAsync(Invok, std::move(Consumer), OncePerASTToken);
+  // Semantic annotation is a background service; let AST builds for
+  // interactive requests (cursor-info, related-idents, etc.) go first.
+  ASTMgr.processASTAsync(Invok, std::move(Consumer), OncePerASTToken,
+                         WorkQueue::Priority::Background);
 }
 
 struct SwiftEditorDocument::Implementation {
@@ -1145,6 +1153,27 @@ struct SwiftEditorDocument::Implementation {
 
   std::shared_ptr<SwiftDocumentSyntaxInfo> SyntaxInfo;
 
+  /// A replacement applied to the document by replaceText.
+  struct DocumentEdit {
+    unsigned Offset;
+    unsigned Length;
+    unsigned ReplacementLength;
+  };
+
+  /// The syntax tree built by the last parse of the latest snapshot, if any.
+  /// It seeds a \c SyntaxParsingCache for the next reparse so that nodes
+  /// outside the edited ranges are reused instead of being re-lexed and
+  /// re-parsed.
+  llvm::Optional<SourceFileSyntax> LastSyntaxTree;
+
+  /// The edits applied since \c LastSyntaxTree was built, in application
+  /// order.
+  std::vector<DocumentEdit> EditsSinceLastSyntaxTree;
+
+  /// Keeps the node cache for the current reparse alive; the parser only
+  /// borrows it via SourceFile::SyntaxParsingCache.
+  std::unique_ptr<SyntaxParsingCache> SyntaxCache;
+
   std::shared_ptr<SwiftDocumentSyntaxInfo> getSyntaxInfo() {
     llvm::sys::ScopedLock L(AccessMtx);
     return SyntaxInfo;
@@ -1805,6 +1834,11 @@ ImmutableTextSnapshotRef SwiftEditorDocument::initializeText(
   Impl.SyntaxMap.Tokens.clear();
   Impl.AffectedRange = {0, static_cast<unsigned>(Buf->getBufferSize())};
 
+  // Any previous syntax tree is for unrelated text now.
+  Impl.LastSyntaxTree = llvm::None;
+  Impl.EditsSinceLastSyntaxTree.clear();
+  Impl.SyntaxCache.reset();
+
   Impl.SemanticInfo =
       new SwiftDocumentSemanticInfo(Impl.FilePath, Impl.LangSupport);
   Impl.SemanticInfo->setCompilerArgs(Args);
@@ -1843,6 +1877,12 @@ ImmutableTextSnapshotRef SwiftEditorDocument::replaceText(
   // will be cleared.
   Impl.AffectedRange = Impl.SyntaxMap.adjustForReplacement(Offset, Length, Str.size());
 
+  // Remember the replacement so the next reparse can reuse syntax nodes that
+  // it doesn't affect.
+  if (Impl.LastSyntaxTree.hasValue())
+    Impl.EditsSinceLastSyntaxTree.push_back(
+        {Offset, Length, static_cast<unsigned>(Str.size())});
+
   return Snapshot;
 }
 
@@ -1877,11 +1917,34 @@ void SwiftEditorDocument::parse(ImmutableTextSnapshotRef Snapshot,
       initCompilerInvocation(CompInv, Args, StringRef(), Error);
   }
   CompInv.getLangOptions().BuildSyntaxTree = BuildSyntexTree;
+
+  // The recorded edits describe how the latest snapshot differs from the one
+  // LastSyntaxTree was built from; for any other snapshot the previous tree
+  // cannot be reused.
+  bool IsLatestSnapshot =
+      Snapshot->getStamp() == Impl.EditableBuffer->getSnapshot()->getStamp();
+
+  std::unique_ptr<SyntaxParsingCache> SyntaxCache;
+  if (BuildSyntexTree && IsLatestSnapshot && Impl.LastSyntaxTree.hasValue()) {
+    SyntaxCache.reset(new SyntaxParsingCache(*Impl.LastSyntaxTree));
+    for (auto &Edit : Impl.EditsSinceLastSyntaxTree)
+      SyntaxCache->addEdit(Edit.Offset, Edit.Offset + Edit.Length,
+                           Edit.ReplacementLength);
+  }
+  Impl.SyntaxCache = std::move(SyntaxCache);
+
   // Access to Impl.SyntaxInfo is guarded by Impl.AccessMtx
   Impl.SyntaxInfo.reset(
-    new SwiftDocumentSyntaxInfo(CompInv, Snapshot, Args, Impl.FilePath));
+    new SwiftDocumentSyntaxInfo(CompInv, Snapshot, Args, Impl.FilePath,
+                                Impl.SyntaxCache.get()));
 
   Impl.SyntaxInfo->parse();
+
+  if (BuildSyntexTree && IsLatestSnapshot)
+    Impl.LastSyntaxTree = Impl.SyntaxInfo->getSourceFile().getSyntaxRoot();
+  else
+    Impl.LastSyntaxTree = llvm::None;
+  Impl.EditsSinceLastSyntaxTree.clear();
 }
 
 void SwiftEditorDocument::readSyntaxInfo(EditorConsumer &Consumer) {
@@ -202,6 +202,57 @@ public:
                                    const swift::CompilerInvocation &Invok);
 };
 
+/// Caches the most recent cursor-info results for a document, so that
+/// repeated requests at the same position (e.g. an editor issuing one hover
+/// per mouse move) are answered without processing the AST again. Entries
+/// are keyed by the document's snapshot stamp and request offset and are
+/// dropped as soon as a result for a newer snapshot is recorded.
+class CursorInfoResultCache {
+  /// An owning copy of the fields of a CursorInfoData.
+  struct OwnedCursorInfo {
+    UIdent Kind;
+    std::string Name;
+    std::string USR;
+    std::string TypeName;
+    std::string TypeUSR;
+    std::string ContainerTypeUSR;
+    std::string DocComment;
+    std::string TypeInterface;
+    std::string GroupName;
+    std::string LocalizationKey;
+    std::string AnnotatedDeclaration;
+    std::string FullyAnnotatedDeclaration;
+    std::string ModuleName;
+    std::string ModuleInterfaceName;
+    llvm::Optional<std::pair<unsigned, unsigned>> DeclarationLoc;
+    std::string Filename;
+    std::vector<std::string> OverrideUSRs;
+    std::vector<std::string> AnnotatedRelatedDeclarations;
+    std::vector<std::string> ModuleGroupArray;
+    bool IsSystem = false;
+    llvm::Optional<unsigned> ParentNameOffset;
+  };
+  struct Entry {
+    uint64_t Stamp;
+    unsigned Offset;
+    OwnedCursorInfo Info;
+  };
+  llvm::StringMap<std::vector<Entry>> EntriesByFile;
+  llvm::sys::Mutex Mtx;
+  static const size_t MaxEntriesPerFile = 16;
+
+public:
+  /// Replays a previously recorded result through \p Receiver. Returns false
+  /// if no result for this position and snapshot stamp has been recorded.
+  bool tryReplay(StringRef Path, uint64_t Stamp, unsigned Offset,
+                 llvm::function_ref<void(const CursorInfoData &)> Receiver);
+
+  /// Records \p Info for the given position and snapshot stamp, dropping
+  /// entries recorded for other snapshots of the file.
+  void record(StringRef Path, uint64_t Stamp, unsigned Offset,
+              const CursorInfoData &Info);
+};
+
 struct SwiftCompletionCache
     : public ThreadSafeRefCountedBase<SwiftCompletionCache> {
   std::unique_ptr<swift::ide::CodeCompletionCache> inMemory;
@@ -269,6 +320,7 @@ class SwiftLangSupport : public LangSupport {
   ThreadSafeRefCntPtr<SwiftPopularAPI> PopularAPI;
   CodeCompletion::SessionCacheMap CCSessions;
   ThreadSafeRefCntPtr<SwiftCustomCompletions> CustomCompletions;
+  CursorInfoResultCache CursorInfoCache;
   SwiftStatistics Stats;
 
 public:
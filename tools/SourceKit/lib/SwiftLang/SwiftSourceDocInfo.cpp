@@ -40,6 +40,7 @@
 
 #include "llvm/Support/MemoryBuffer.h"
 
+#include <algorithm>
 #include <numeric>
 
 using namespace SourceKit;
@@ -1558,6 +1559,98 @@ static void resolveRange(SwiftLangSupport &Lang,
   Lang.getASTManager().processASTAsync(Invok, std::move(Consumer), Once);
 }
 
+bool CursorInfoResultCache::tryReplay(
+    StringRef Path, uint64_t Stamp, unsigned Offset,
+    llvm::function_ref<void(const CursorInfoData &)> Receiver) {
+  OwnedCursorInfo Owned;
+  {
+    llvm::sys::ScopedLock L(Mtx);
+    auto It = EntriesByFile.find(Path);
+    if (It == EntriesByFile.end())
+      return false;
+    auto &Entries = It->second;
+    auto Found = std::find_if(Entries.begin(), Entries.end(),
+                              [&](const Entry &E) {
+                                return E.Stamp == Stamp && E.Offset == Offset;
+                              });
+    if (Found == Entries.end())
+      return false;
+    Owned = Found->Info;
+  }
+
+  CursorInfoData Info;
+  Info.Kind = Owned.Kind;
+  Info.Name = Owned.Name;
+  Info.USR = Owned.USR;
+  Info.TypeName = Owned.TypeName;
+  Info.TypeUSR = Owned.TypeUSR;
+  Info.ContainerTypeUSR = Owned.ContainerTypeUSR;
+  Info.DocComment = Owned.DocComment;
+  Info.TypeInterface = Owned.TypeInterface;
+  Info.GroupName = Owned.GroupName;
+  Info.LocalizationKey = Owned.LocalizationKey;
+  Info.AnnotatedDeclaration = Owned.AnnotatedDeclaration;
+  Info.FullyAnnotatedDeclaration = Owned.FullyAnnotatedDeclaration;
+  Info.ModuleName = Owned.ModuleName;
+  Info.ModuleInterfaceName = Owned.ModuleInterfaceName;
+  Info.DeclarationLoc = Owned.DeclarationLoc;
+  Info.Filename = Owned.Filename;
+  SmallVector<StringRef, 4> Overrides(Owned.OverrideUSRs.begin(),
+                                      Owned.OverrideUSRs.end());
+  Info.OverrideUSRs = Overrides;
+  SmallVector<StringRef, 4> Related(Owned.AnnotatedRelatedDeclarations.begin(),
+                                    Owned.AnnotatedRelatedDeclarations.end());
+  Info.AnnotatedRelatedDeclarations = Related;
+  SmallVector<StringRef, 4> Groups(Owned.ModuleGroupArray.begin(),
+                                   Owned.ModuleGroupArray.end());
+  Info.ModuleGroupArray = Groups;
+  Info.IsSystem = Owned.IsSystem;
+  Info.ParentNameOffset = Owned.ParentNameOffset;
+  Receiver(Info);
+  return true;
+}
+
+void CursorInfoResultCache::record(StringRef Path, uint64_t Stamp,
+                                   unsigned Offset,
+                                   const CursorInfoData &Info) {
+  Entry New;
+  New.Stamp = Stamp;
+  New.Offset = Offset;
+  auto &Owned = New.Info;
+  Owned.Kind = Info.Kind;
+  Owned.Name = Info.Name;
+  Owned.USR = Info.USR;
+  Owned.TypeName = Info.TypeName;
+  Owned.TypeUSR = Info.TypeUSR;
+  Owned.ContainerTypeUSR = Info.ContainerTypeUSR;
+  Owned.DocComment = Info.DocComment;
+  Owned.TypeInterface = Info.TypeInterface;
+  Owned.GroupName = Info.GroupName;
+  Owned.LocalizationKey = Info.LocalizationKey;
+  Owned.AnnotatedDeclaration = Info.AnnotatedDeclaration;
+  Owned.FullyAnnotatedDeclaration = Info.FullyAnnotatedDeclaration;
+  Owned.ModuleName = Info.ModuleName;
+  Owned.ModuleInterfaceName = Info.ModuleInterfaceName;
+  Owned.DeclarationLoc = Info.DeclarationLoc;
+  Owned.Filename = Info.Filename;
+  for (StringRef USR : Info.OverrideUSRs)
+    Owned.OverrideUSRs.push_back(USR);
+  for (StringRef Related : Info.AnnotatedRelatedDeclarations)
+    Owned.AnnotatedRelatedDeclarations.push_back(Related);
+  for (StringRef Group : Info.ModuleGroupArray)
+    Owned.ModuleGroupArray.push_back(Group);
+  Owned.IsSystem = Info.IsSystem;
+  Owned.ParentNameOffset = Info.ParentNameOffset;
+
+  llvm::sys::ScopedLock L(Mtx);
+  auto &Entries = EntriesByFile[Path];
+  if (!Entries.empty() && Entries.front().Stamp != Stamp)
+    Entries.clear();
+  if (Entries.size() >= MaxEntriesPerFile)
+    Entries.erase(Entries.begin());
+  Entries.push_back(std::move(New));
+}
+
 void SwiftLangSupport::getCursorInfo(
     StringRef InputFile, unsigned Offset, unsigned Length, bool Actionables,
     bool CancelOnSubsequentRequest, ArrayRef<const char *> Args,
@@ -1598,6 +1691,29 @@ void SwiftLangSupport::getCursorInfo(
     return;
   }
 
+  // Plain hover-style requests on an open document are cached; replay the
+  // previous answer if the document hasn't changed since it was recorded.
+  uint64_t Stamp = 0;
+  if (!Actionables && Length == 0) {
+    if (auto EditorDoc = EditorDocuments.findByPath(InputFile))
+      Stamp = EditorDoc->getLatestSnapshot()->getStamp();
+  }
+  if (Stamp && CursorInfoCache.tryReplay(InputFile, Stamp, Offset, Receiver))
+    return;
+
+  if (Stamp) {
+    std::string Path = InputFile;
+    auto OrigReceiver = std::move(Receiver);
+    Receiver = [this, Path, Stamp, Offset,
+                OrigReceiver](const CursorInfoData &Info) {
+      // Only successful value results are worth replaying; failures may
+      // succeed against a newer AST.
+      if (!Info.IsCancelled && !Info.USR.empty())
+        CursorInfoCache.record(Path, Stamp, Offset, Info);
+      OrigReceiver(Info);
+    };
+  }
+
   resolveCursor(*this, InputFile, Offset, Length, Actionables, Invok,
                 /*TryExistingAST=*/true, CancelOnSubsequentRequest, Receiver);
 }
@@ -35,11 +35,14 @@
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Support/YAMLTraits.h"
 #include <cstdio>
 using namespace swift;
@@ -150,6 +153,14 @@ Passes(llvm::cl::desc("Passes:"),
 static llvm::cl::opt<bool>
 PrintStats("print-stats", llvm::cl::desc("Print various statistics"));
 
+static llvm::cl::opt<unsigned>
+BenchmarkIterations("benchmark", llvm::cl::init(0), llvm::cl::value_desc("N"),
+                    llvm::cl::desc("Run the selected passes N times on fresh "
+                                   "copies of the input SIL, reporting "
+                                   "per-iteration wall time, instruction "
+                                   "deltas and heap growth instead of "
+                                   "emitting output"));
+
 static llvm::cl::opt<bool>
 VerifyMode("verify",
            llvm::cl::desc("verify diagnostics against expected-"
@@ -265,6 +276,110 @@ static void runCommandLineSelectedPasses(SILModule *Module,
     Module->verify();
 }
 
+/// Run whatever the command line selected -- an optimization group or an
+/// explicit list of passes -- on the instance's SIL module.
+static void runSelectedPasses(CompilerInstance &CI,
+                              const CompilerInvocation &Invocation) {
+  if (OptimizationGroup == OptGroup::Diagnostics) {
+    runSILDiagnosticPasses(*CI.getSILModule());
+  } else if (OptimizationGroup == OptGroup::Performance) {
+    runSILOptPreparePasses(*CI.getSILModule());
+    runSILOptimizationPasses(*CI.getSILModule());
+  } else if (OptimizationGroup == OptGroup::Lowering) {
+    runSILLoweringPasses(*CI.getSILModule());
+  } else {
+    auto *SILMod = CI.getSILModule();
+    {
+      auto T = irgen::createIRGenModule(
+          SILMod, Invocation.getOutputFilenameForAtMostOnePrimary(),
+          Invocation.getMainInputFilenameForDebugInfoForAtMostOnePrimary(),
+          getGlobalLLVMContext());
+      runCommandLineSelectedPasses(SILMod, T.second);
+      irgen::deleteIRGenModule(T);
+    }
+  }
+}
+
+/// Implements -benchmark=N: measure the selected passes in isolation.
+///
+/// SILModule has no copy operation, so the closest we can get to running a
+/// pass repeatedly on "the same input" is to serialize the prepared module to
+/// a temporary SIB snapshot once, deserialize its AST once into a second
+/// compiler instance, and then re-materialize just the SIL into a fresh
+/// module for every iteration, timing only the pass run itself.
+static int benchmarkSelectedPasses(CompilerInstance &CI,
+                                   const CompilerInvocation &Invocation,
+                                   PrintingDiagnosticConsumer &PrintDiags) {
+  llvm::SmallString<128> SnapshotPath;
+  if (llvm::sys::fs::createTemporaryFile("sil-opt-benchmark", "sib",
+                                         SnapshotPath)) {
+    llvm::errs() << "benchmark: failed to create a temporary snapshot file\n";
+    return 1;
+  }
+  llvm::FileRemover SnapshotRemover(SnapshotPath);
+
+  SerializationOptions serializationOpts;
+  serializationOpts.OutputPath = SnapshotPath.c_str();
+  serializationOpts.SerializeAllSIL = true;
+  serializationOpts.IsSIB = true;
+  serialize(CI.getMainModule(), serializationOpts, CI.getSILModule());
+
+  CompilerInvocation BenchInvocation(Invocation);
+  BenchInvocation.getFrontendOptions().InputsAndOutputs.clearInputs();
+  serialization::ExtendedValidationInfo extendedInfo;
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> FileBufOrErr =
+      BenchInvocation.setUpInputForSILTool(SnapshotPath, ModuleName,
+                                           /*alwaysSetModuleToMain*/ false,
+                                           /*bePrimary*/ !PerformWMO,
+                                           extendedInfo);
+  if (!FileBufOrErr) {
+    llvm::errs() << "benchmark: failed to reload the snapshot\n";
+    return 1;
+  }
+
+  CompilerInstance BenchCI;
+  BenchCI.addDiagnosticConsumer(&PrintDiags);
+  if (BenchCI.setup(BenchInvocation))
+    return 1;
+  BenchCI.performSema();
+  if (BenchCI.getASTContext().hadError())
+    return 1;
+
+  llvm::outs() << "#,TIME(us),INSTS_CREATED,INSTS_DELETED,MALLOC_DELTA(B)\n";
+  for (unsigned Iteration = 0; Iteration != BenchmarkIterations; ++Iteration) {
+    // Materialize a fresh copy of the input SIL, outside the timed region.
+    BenchCI.setSILModule(SILModule::createEmptyModule(
+        BenchCI.getMainModule(), BenchCI.getSILOptions(), PerformWMO));
+    std::unique_ptr<SerializedSILLoader> SL = SerializedSILLoader::create(
+        BenchCI.getASTContext(), BenchCI.getSILModule(), nullptr);
+    SL->getAllForModule(BenchCI.getMainModule()->getName(), nullptr);
+    BenchCI.getSILModule()->setSerializeSILAction([]{});
+
+    int StartCreated = SILInstruction::getNumCreatedInstructions();
+    int StartDeleted = SILInstruction::getNumDeletedInstructions();
+    size_t StartMalloc = llvm::sys::Process::GetMallocUsage();
+    llvm::TimeRecord StartTime = llvm::TimeRecord::getCurrentTime();
+
+    runSelectedPasses(BenchCI, BenchInvocation);
+
+    llvm::TimeRecord EndTime = llvm::TimeRecord::getCurrentTime(false);
+    size_t EndMalloc = llvm::sys::Process::GetMallocUsage();
+    int EndCreated = SILInstruction::getNumCreatedInstructions();
+    int EndDeleted = SILInstruction::getNumDeletedInstructions();
+
+    auto WallUSec = uint64_t(1000000.0 * (EndTime.getWallTime() -
+                                          StartTime.getWallTime()));
+    llvm::outs() << (Iteration + 1) << ',' << WallUSec << ','
+                 << (EndCreated - StartCreated) << ','
+                 << (EndDeleted - StartDeleted) << ','
+                 << (int64_t(EndMalloc) - int64_t(StartMalloc)) << '\n';
+
+    if (BenchCI.getASTContext().hadError())
+      return 1;
+  }
+  return 0;
+}
+
 // This function isn't referenced outside its translation unit, but it
 // can't use the "static" keyword because its address is used for
 // getMainExecutable (since some platforms don't support taking the
@@ -427,24 +542,12 @@ int main(int argc, char **argv) {
         std::move(OptRecordFile));
   }
 
-  if (OptimizationGroup == OptGroup::Diagnostics) {
-    runSILDiagnosticPasses(*CI.getSILModule());
-  } else if (OptimizationGroup == OptGroup::Performance) {
-    runSILOptPreparePasses(*CI.getSILModule());
-    runSILOptimizationPasses(*CI.getSILModule());
-  } else if (OptimizationGroup == OptGroup::Lowering) {
-    runSILLoweringPasses(*CI.getSILModule());
-  } else {
-    auto *SILMod = CI.getSILModule();
-    {
-      auto T = irgen::createIRGenModule(
-          SILMod, Invocation.getOutputFilenameForAtMostOnePrimary(),
-          Invocation.getMainInputFilenameForDebugInfoForAtMostOnePrimary(),
-          getGlobalLLVMContext());
-      runCommandLineSelectedPasses(SILMod, T.second);
-      irgen::deleteIRGenModule(T);
-    }
-  }
+  // In benchmark mode the passes run repeatedly on fresh copies of the SIL
+  // and only measurements are emitted, so we are done afterwards.
+  if (BenchmarkIterations > 0)
+    return benchmarkSelectedPasses(CI, Invocation, PrintDiags);
+
+  runSelectedPasses(CI, Invocation);
 
   if (EmitSIB) {
     llvm::SmallString<128> OutputFile;
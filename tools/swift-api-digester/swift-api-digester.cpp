@@ -32,6 +32,7 @@
 #include "clang/Sema/Lookup.h"
 #include "clang/Sema/Sema.h"
 #include "llvm/ADT/TinyPtrVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/FileSystem.h"
@@ -1213,6 +1214,10 @@ static StringRef getPrintedName(SDKContext &Ctx, Type Ty,
   llvm::raw_string_ostream OS(S);
   PrintOptions PO;
   PO.SkipAttributes = true;
+  // The same types recur across an SDK's worth of declarations; render each
+  // one once and reuse the text for the life of the tool.
+  static TypeStringMemoizer MemoizedTypeStrings;
+  PO.TypeMemoizer = &MemoizedTypeStrings;
   if (IsImplicitlyUnwrappedOptional)
     PO.PrintOptionalAsImplicitlyUnwrapped = true;
 
@@ -2291,18 +2296,56 @@ public:
 };
 
 void SameNameNodeMatcher::match() {
-  NodeVector MatchedRight;
+  llvm::SmallPtrSet<NodePtr, 16> MatchedRight;
   NodeVector Removed;
   NodeVector Added;
 
+  // A node can only match one whose printed name or USR it shares, so bucket
+  // the right-hand nodes by both up front. With tens of thousands of
+  // top-level decls in an SDK, comparing every pair dominates the diff.
+  llvm::StringMap<llvm::SmallVector<unsigned, 4>> RightByName;
+  llvm::StringMap<llvm::SmallVector<unsigned, 4>> RightByUsr;
+  for (unsigned I = 0, E = Right.size(); I != E; ++I) {
+    auto *RD = dyn_cast<SDKNodeDecl>(Right[I]);
+    if (!RD)
+      continue;
+    RightByName[RD->getPrintedName()].push_back(I);
+    if (!RD->getUsr().empty())
+      RightByUsr[RD->getUsr()].push_back(I);
+  }
+
   for (auto *LN : Left) {
+    auto *LD = dyn_cast<SDKNodeDecl>(LN);
+    if (!LD) {
+      Removed.push_back(LN);
+      continue;
+    }
+
+    // Collect the indices of right-hand nodes sharing LN's printed name or
+    // USR, restoring their original order.
+    SmallVector<unsigned, 8> CandidateIndices;
+    auto AddBucket = [&](llvm::StringMap<llvm::SmallVector<unsigned, 4>> &Map,
+                         StringRef Key) {
+      if (Key.empty())
+        return;
+      auto Found = Map.find(Key);
+      if (Found != Map.end())
+        CandidateIndices.append(Found->second.begin(), Found->second.end());
+    };
+    AddBucket(RightByName, LD->getPrintedName());
+    AddBucket(RightByUsr, LD->getUsr());
+    llvm::array_pod_sort(CandidateIndices.begin(), CandidateIndices.end());
+    CandidateIndices.erase(
+        std::unique(CandidateIndices.begin(), CandidateIndices.end()),
+        CandidateIndices.end());
 
     // This collects all the candidates that can match with LN.
     std::vector<NameMatchCandidate> Candidates;
-    for (auto *RN : Right) {
+    for (unsigned Idx : CandidateIndices) {
+      auto *RN = Right[Idx];
 
       // If RN has matched before, ignore it.
-      if (contains(MatchedRight, RN))
+      if (MatchedRight.count(RN))
         continue;
 
       // If LN and RN have the same name for some reason, keep track of RN.
@@ -2315,13 +2358,13 @@ void SameNameNodeMatcher::match() {
     if (auto Match = findBestNameMatch(Candidates,
                                     getNameMatchKindPriority(LN->getKind()))) {
       Listener.foundMatch(LN, Match);
-      MatchedRight.push_back(Match);
+      MatchedRight.insert(Match);
     } else {
       Removed.push_back(LN);
     }
   }
   for (auto &R : Right) {
-    if (!contains(MatchedRight, R)) {
+    if (!MatchedRight.count(R)) {
       Added.push_back(R);
     }
   }
@@ -30,7 +30,13 @@
 #include <cstdlib>
 #endif
 
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 static llvm::cl::opt<bool>
 ExpandMode("expand",
@@ -68,6 +74,12 @@ static llvm::cl::opt<bool>
 Classify("classify",
            llvm::cl::desc("Display symbol classification characters"));
 
+static llvm::cl::opt<unsigned>
+NumThreads("j",
+           llvm::cl::desc("Demangle standard input with the given number of "
+                          "threads, streaming results in input order"),
+           llvm::cl::init(1));
+
 static llvm::cl::list<std::string>
 InputNames(llvm::cl::Positional, llvm::cl::desc("[mangled name...]"),
                llvm::cl::ZeroOrMore);
@@ -92,8 +104,8 @@ static void demangle(llvm::raw_ostream &os, llvm::StringRef name,
   }
   swift::Demangle::NodePointer pointer = DCtx.demangleSymbolAsNode(name);
   if (ExpandMode || TreeOnly) {
-    llvm::outs() << "Demangling for " << name << '\n';
-    llvm::outs() << getNodeTreeAsString(pointer);
+    os << "Demangling for " << name << '\n';
+    os << getNodeTreeAsString(pointer);
   }
   if (RemangleMode) {
     std::string remangled;
@@ -122,15 +134,15 @@ static void demangle(llvm::raw_ostream &os, llvm::StringRef name,
         exit(1);
       }
     }
-    if (hadLeadingUnderscore) llvm::outs() << '_';
-    llvm::outs() << remangled;
+    if (hadLeadingUnderscore) os << '_';
+    os << remangled;
     return;
   } else if (RemangleRtMode) {
     std::string remangled = name;
     if (pointer) {
       remangled = swift::Demangle::mangleNodeOld(pointer);
     }
-    llvm::outs() << remangled;
+    os << remangled;
   }
   if (!TreeOnly) {
     if (RemangleNew) {
@@ -139,12 +151,12 @@ static void demangle(llvm::raw_ostream &os, llvm::StringRef name,
         exit(1);
       }
       std::string remangled = swift::Demangle::mangleNode(pointer);
-      llvm::outs() << remangled;
+      os << remangled;
       return;
     }
     std::string string = swift::Demangle::nodeToString(pointer, options);
     if (!CompactMode)
-      llvm::outs() << name << " ---> ";
+      os << name << " ---> ";
 
     if (Classify) {
       std::string Classifications;
@@ -164,13 +176,27 @@ static void demangle(llvm::raw_ostream &os, llvm::StringRef name,
         Classifications += 'C';
       }
       if (!Classifications.empty())
-        llvm::outs() << '{' << Classifications << "} ";
+        os << '{' << Classifications << "} ";
     }
-    llvm::outs() << (string.empty() ? name : llvm::StringRef(string));
+    os << (string.empty() ? name : llvm::StringRef(string));
   }
   DCtx.clear();
 }
 
+static void demangleLine(llvm::raw_ostream &os, llvm::StringRef inputContents,
+                         llvm::Regex &maybeSymbol,
+                         swift::Demangle::Context &DCtx,
+                         const swift::Demangle::DemangleOptions &options) {
+  llvm::SmallVector<llvm::StringRef, 1> matches;
+  while (maybeSymbol.match(inputContents, &matches)) {
+    os << substrBefore(inputContents, matches.front());
+    demangle(os, matches.front(), DCtx, options);
+    inputContents = substrAfter(inputContents, matches.front());
+  }
+
+  os << inputContents << '\n';
+}
+
 static int demangleSTDIN(const swift::Demangle::DemangleOptions &options) {
   // This doesn't handle Unicode symbols, but maybe that's okay.
   // Also accept the future mangling prefix.
@@ -178,17 +204,116 @@ static int demangleSTDIN(const swift::Demangle::DemangleOptions &options) {
 
   swift::Demangle::Context DCtx;
   for (std::string mangled; std::getline(std::cin, mangled);) {
-    llvm::StringRef inputContents(mangled);
+    demangleLine(llvm::outs(), mangled, maybeSymbol, DCtx, options);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/// Demangles standard input by sharding chunks of lines across worker
+/// threads, each with its own demangler context, and streams the rendered
+/// chunks back out in input order. The output is byte-for-byte identical to
+/// the serial path.
+static int
+demangleSTDINParallel(const swift::Demangle::DemangleOptions &options,
+                      unsigned numThreads) {
+  const size_t linesPerChunk = 4096;
+
+  std::mutex lock;
+  std::condition_variable workReady, outputReady, queueSpace;
+  std::deque<std::pair<uint64_t, std::vector<std::string>>> pending;
+  std::map<uint64_t, std::string> finished;
+  bool doneReading = false;
+  bool allDone = false;
 
-    llvm::SmallVector<llvm::StringRef, 1> matches;
-    while (maybeSymbol.match(inputContents, &matches)) {
-      llvm::outs() << substrBefore(inputContents, matches.front());
-      demangle(llvm::outs(), matches.front(), DCtx, options);
-      inputContents = substrAfter(inputContents, matches.front());
+  auto worker = [&] {
+    // The regex and context are not thread-safe, so give each worker its own.
+    llvm::Regex maybeSymbol("(_T|_?\\$[Ss])[_a-zA-Z0-9$.]+");
+    swift::Demangle::Context DCtx;
+
+    while (true) {
+      std::pair<uint64_t, std::vector<std::string>> chunk;
+      {
+        std::unique_lock<std::mutex> guard(lock);
+        workReady.wait(guard, [&] { return !pending.empty() || doneReading; });
+        if (pending.empty())
+          return;
+        chunk = std::move(pending.front());
+        pending.pop_front();
+        queueSpace.notify_one();
+      }
+
+      std::string rendered;
+      llvm::raw_string_ostream os(rendered);
+      for (const std::string &line : chunk.second)
+        demangleLine(os, line, maybeSymbol, DCtx, options);
+      os.flush();
+
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        finished.emplace(chunk.first, std::move(rendered));
+      }
+      outputReady.notify_one();
     }
+  };
+
+  auto writer = [&] {
+    uint64_t next = 0;
+    while (true) {
+      std::string rendered;
+      {
+        std::unique_lock<std::mutex> guard(lock);
+        outputReady.wait(guard,
+                         [&] { return finished.count(next) || allDone; });
+        auto found = finished.find(next);
+        if (found == finished.end())
+          return;
+        rendered = std::move(found->second);
+        finished.erase(found);
+      }
+      llvm::outs() << rendered;
+      ++next;
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (unsigned i = 0; i < numThreads; ++i)
+    workers.emplace_back(worker);
+  std::thread writerThread(writer);
+
+  uint64_t chunkIndex = 0;
+  std::vector<std::string> chunk;
+  auto enqueue = [&] {
+    std::unique_lock<std::mutex> guard(lock);
+    // Bound the queue so a fast reader doesn't buffer the whole input.
+    queueSpace.wait(guard, [&] { return pending.size() < 2 * numThreads; });
+    pending.emplace_back(chunkIndex++, std::move(chunk));
+    chunk.clear();
+    workReady.notify_one();
+  };
+
+  for (std::string mangled; std::getline(std::cin, mangled);) {
+    chunk.push_back(std::move(mangled));
+    if (chunk.size() >= linesPerChunk)
+      enqueue();
+  }
+  if (!chunk.empty())
+    enqueue();
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    doneReading = true;
+  }
+  workReady.notify_all();
+  for (std::thread &t : workers)
+    t.join();
 
-    llvm::outs() << inputContents << '\n';
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    allDone = true;
   }
+  outputReady.notify_one();
+  writerThread.join();
 
   return EXIT_SUCCESS;
 }
@@ -208,6 +333,8 @@ int main(int argc, char **argv) {
 
   if (InputNames.empty()) {
     CompactMode = true;
+    if (NumThreads > 1)
+      return demangleSTDINParallel(options, NumThreads);
     return demangleSTDIN(options);
   } else {
     swift::Demangle::Context DCtx;
@@ -49,6 +49,7 @@
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/PrettyStackTrace.h"
@@ -57,6 +58,8 @@
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/ManagedStatic.h"
+#include <algorithm>
+#include <chrono>
 #include <system_error>
 
 #include <string>
@@ -403,6 +406,14 @@ CodeCompletionComments("code-completion-comments",
                        llvm::cl::cat(Category),
                        llvm::cl::init(false));
 
+static llvm::cl::opt<unsigned>
+CodeCompletionBenchmark("code-completion-benchmark",
+                        llvm::cl::desc("Repeat the completion request this "
+                                       "many times and report latency "
+                                       "statistics instead of results"),
+                        llvm::cl::cat(Category),
+                        llvm::cl::init(0));
+
 static llvm::cl::opt<std::string>
 DebugClientDiscriminator("debug-client-discriminator",
   llvm::cl::desc("A discriminator to prefer in lookups"),
@@ -685,7 +696,8 @@ static int doCodeCompletion(const CompilerInvocation &InitInvok,
                             StringRef CodeCompletionToken,
                             bool CodeCompletionDiagnostics,
                             bool CodeCompletionKeywords,
-                            bool CodeCompletionComments) {
+                            bool CodeCompletionComments,
+                            unsigned BenchmarkIterations) {
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> FileBufOrErr =
     llvm::MemoryBuffer::getFile(SourceFilename);
   if (!FileBufOrErr) {
@@ -721,6 +733,57 @@ static int doCodeCompletion(const CompilerInvocation &InitInvok,
         options::CompletionCachePath);
   }
   ide::CodeCompletionCache CompletionCache(OnDiskCache.get());
+
+  if (BenchmarkIterations > 0) {
+    // Replay the same request repeatedly, sharing the completion cache the
+    // way an IDE session would, and report latencies instead of results.
+    llvm::raw_null_ostream NullOS;
+    std::vector<double> Latencies;
+    Latencies.reserve(BenchmarkIterations);
+    for (unsigned i = 0; i < BenchmarkIterations; ++i) {
+      ide::CodeCompletionContext CompletionContext(CompletionCache);
+      ide::PrintingCodeCompletionConsumer Consumer(
+          NullOS, CodeCompletionKeywords, CodeCompletionComments);
+      std::unique_ptr<CodeCompletionCallbacksFactory> Factory(
+          ide::makeCodeCompletionCallbacksFactory(CompletionContext, Consumer));
+      Invocation.setCodeCompletionFactory(Factory.get());
+      if (!SecondSourceFileName.empty() && i == 0) {
+        Invocation.getFrontendOptions().InputsAndOutputs.addInputFile(
+            SecondSourceFileName);
+      }
+
+      CompilerInstance CI;
+      auto StartTime = std::chrono::steady_clock::now();
+      if (CI.setup(Invocation))
+        return 1;
+      CI.performSema();
+      auto EndTime = std::chrono::steady_clock::now();
+      Latencies.push_back(
+          std::chrono::duration<double, std::milli>(EndTime - StartTime)
+              .count());
+    }
+
+    // The first request fills the per-module result cache; report it
+    // separately as the cold latency.
+    double Cold = Latencies.front();
+    std::vector<double> Warm(Latencies.begin() + 1, Latencies.end());
+    llvm::outs() << "completion benchmark: " << BenchmarkIterations
+                 << " iterations\n";
+    llvm::outs() << llvm::format("cold: %.2f ms\n", Cold);
+    if (!Warm.empty()) {
+      std::sort(Warm.begin(), Warm.end());
+      auto Percentile = [&](unsigned P) -> double {
+        return Warm[(Warm.size() - 1) * P / 100];
+      };
+      llvm::outs() << llvm::format(
+          "warm: min %.2f ms, p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, "
+          "max %.2f ms\n",
+          Warm.front(), Percentile(50), Percentile(90), Percentile(99),
+          Warm.back());
+    }
+    return 0;
+  }
+
   ide::CodeCompletionContext CompletionContext(CompletionCache);
 
   // Create a CodeCompletionConsumer.
@@ -1972,11 +2035,17 @@ static int doPrintModules(const CompilerInvocation &InitInvok,
 
   int ExitCode = 0;
 
+  // Plain printing does not rely on the per-reference printer callbacks, so
+  // it can batch the output and reuse the rendered text of repeated types.
+  PrintOptions AdjustedOptions = Options;
+  TypeStringMemoizer MemoizedTypeStrings;
   std::unique_ptr<ASTPrinter> Printer;
-  if (AnnotatePrint)
+  if (AnnotatePrint) {
     Printer.reset(new AnnotatingPrinter(llvm::outs()));
-  else
-    Printer.reset(new StreamPrinter(llvm::outs()));
+  } else {
+    Printer.reset(new BufferedStreamPrinter(llvm::outs()));
+    AdjustedOptions.TypeMemoizer = &MemoizedTypeStrings;
+  }
 
   for (StringRef ModuleToPrint : ModulesToPrint) {
     if (ModuleToPrint.empty()) {
@@ -2020,7 +2089,7 @@ static int doPrintModules(const CompilerInvocation &InitInvok,
     }
 
     printSubmoduleInterface(M, ModuleName, GroupNames, TraversalOptions,
-                            *Printer, Options, SynthesizeExtensions);
+                            *Printer, AdjustedOptions, SynthesizeExtensions);
   }
 
   return ExitCode;
@@ -3319,7 +3388,8 @@ int main(int argc, char *argv[]) {
                                 options::CodeCompletionToken,
                                 options::CodeCompletionDiagnostics,
                                 options::CodeCompletionKeywords,
-                                options::CodeCompletionComments);
+                                options::CodeCompletionComments,
+                                options::CodeCompletionBenchmark);
     break;
 
   case ActionType::REPLCodeCompletion:
@@ -36,8 +36,11 @@
 #endif
 
 #include <algorithm>
-#include <iostream>
+#include <atomic>
 #include <csignal>
+#include <iostream>
+#include <sstream>
+#include <thread>
 
 using llvm::dyn_cast;
 using llvm::StringRef;
@@ -73,6 +76,15 @@ BinaryFilename("binary-filename", llvm::cl::desc("Filenames of the binary files"
 static llvm::cl::opt<std::string>
 Architecture("arch", llvm::cl::desc("Architecture to inspect in the binary"),
              llvm::cl::Required);
+
+static llvm::cl::opt<unsigned>
+NumThreads("j",
+           llvm::cl::desc("Process the binaries in parallel with the given "
+                          "number of threads (dump-reflection-sections "
+                          "only). Each binary is dumped in its own "
+                          "reflection context and the results are emitted "
+                          "in input order."),
+           llvm::cl::init(1));
 } // end namespace options
 
 template<typename T>
@@ -225,6 +237,59 @@ public:
   }
 };
 
+static int dumpReflectionSectionsParallel(ArrayRef<std::string> binaryFilenames,
+                                          StringRef arch,
+                                          unsigned numThreads,
+                                          std::ostream &OS) {
+  std::vector<std::string> outputs(binaryFilenames.size());
+  std::atomic<size_t> nextImage(0);
+
+  // Each image is parsed and dumped in its own reflection context, so the
+  // images can be processed independently. The sections of each image are
+  // therefore grouped per image in the output rather than per section kind
+  // across all images.
+  auto worker = [&] {
+    while (true) {
+      size_t i = nextImage.fetch_add(1);
+      if (i >= binaryFilenames.size())
+        return;
+
+      auto binaryOwner = unwrap(createBinary(binaryFilenames[i]));
+      Binary *binaryFile = binaryOwner.getBinary();
+
+      std::unique_ptr<ObjectFile> objectOwner;
+      const ObjectFile *objectFile;
+      if (auto o = dyn_cast<ObjectFile>(binaryFile)) {
+        objectFile = o;
+      } else {
+        auto universal = cast<MachOUniversalBinary>(binaryFile);
+        objectOwner = unwrap(universal->getObjectForArch(arch));
+        objectFile = objectOwner.get();
+      }
+
+      std::vector<const ObjectFile *> objectFiles = {objectFile};
+      auto reader = std::make_shared<ObjectMemoryReader>(objectFiles);
+      NativeReflectionContext context(std::move(reader));
+      context.addReflectionInfo(findReflectionInfo(objectFile));
+
+      std::ostringstream imageOS;
+      context.getBuilder().dumpAllSections(imageOS);
+      outputs[i] = imageOS.str();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (unsigned i = 0; i < numThreads; ++i)
+    workers.emplace_back(worker);
+  for (auto &thread : workers)
+    thread.join();
+
+  for (auto &output : outputs)
+    OS << output;
+
+  return EXIT_SUCCESS;
+}
+
 static int doDumpReflectionSections(ArrayRef<std::string> binaryFilenames,
                                     StringRef arch,
                                     ActionType action,
@@ -307,6 +372,14 @@ static int doDumpReflectionSections(ArrayRef<std::string> binaryFilenames,
 int main(int argc, char *argv[]) {
   PROGRAM_START(argc, argv);
   llvm::cl::ParseCommandLineOptions(argc, argv, "Swift Reflection Dump\n");
+  // Type lowering needs every image in a single context, so only the
+  // section dump can be sharded across threads.
+  if (options::Action == ActionType::DumpReflectionSections &&
+      options::NumThreads > 1)
+    return dumpReflectionSectionsParallel(options::BinaryFilename,
+                                          options::Architecture,
+                                          options::NumThreads,
+                                          std::cout);
   return doDumpReflectionSections(options::BinaryFilename,
                                   options::Architecture,
                                   options::Action,
@@ -30,12 +30,15 @@
 #include "swift/Parse/Parser.h"
 #include "swift/Subsystems.h"
 #include "swift/Syntax/Serialization/SyntaxDeserialization.h"
+#include "swift/Syntax/Serialization/SyntaxBinarySerialization.h"
 #include "swift/Syntax/Serialization/SyntaxSerialization.h"
 #include "swift/Syntax/SyntaxData.h"
 #include "swift/Syntax/SyntaxNodes.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/Regex.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
 
 using namespace swift;
@@ -47,10 +50,13 @@ enum class ActionType {
   FullLexRoundTrip,
   FullParseRoundTrip,
   SerializeRawTree,
+  SerializeRawTreeBinary,
   DeserializeRawTree,
+  DeserializeRawTreeBinary,
   ParseOnly,
   ParserGen,
   EOFPos,
+  Benchmark,
   None
 };
 
@@ -83,15 +89,28 @@ Action(llvm::cl::desc("Action (required):"),
                    "serialize-raw-tree",
                    "Parse the source file and serialize the raw tree "
                    "to JSON"),
+        clEnumValN(ActionType::SerializeRawTreeBinary,
+                   "serialize-raw-tree-binary",
+                   "Parse the source file and serialize the raw tree "
+                   "to the compact binary format"),
         clEnumValN(ActionType::DeserializeRawTree,
                    "deserialize-raw-tree",
                    "Parse the JSON file from the serialized raw tree "
                    "to the original"),
+        clEnumValN(ActionType::DeserializeRawTreeBinary,
+                   "deserialize-raw-tree-binary",
+                   "Read a binary serialized raw tree and print the "
+                   "original source"),
         clEnumValN(ActionType::EOFPos,
                    "eof",
                    "Parse the source file, calculate the absolute position"
                    "of the EOF token, and dump the buffer from the start of the"
-                   "file to the EOF token")));
+                   "file to the EOF token"),
+        clEnumValN(ActionType::Benchmark,
+                   "benchmark",
+                   "Repeatedly lex and parse the input files and report "
+                   "throughput for lexing, parsing, and syntax tree "
+                   "construction separately")));
 
 static llvm::cl::opt<std::string>
 InputSourceFilename("input-source-filename",
@@ -185,6 +204,13 @@ Visual("v",
        llvm::cl::desc("Print visually"),
        llvm::cl::cat(Category),
        llvm::cl::init(false));
+
+static llvm::cl::opt<unsigned>
+BenchmarkIterations("iterations",
+                    llvm::cl::desc("Number of passes over the input corpus "
+                                   "for the benchmark action"),
+                    llvm::cl::cat(Category),
+                    llvm::cl::init(10));
 } // end namespace options
 
 namespace {
@@ -711,6 +737,25 @@ int doSerializeRawTree(const char *MainExecutablePath,
   });
 }
 
+int doSerializeRawTreeBinary(const char *MainExecutablePath,
+                             const StringRef InputFile) {
+  return parseFile(MainExecutablePath, InputFile, [](SourceFile *SF) -> int {
+    auto Root = SF->getSyntaxRoot().getRaw();
+
+    if (!options::OutputFilename.empty()) {
+      std::error_code errorCode;
+      llvm::raw_fd_ostream os(options::OutputFilename, errorCode,
+                              llvm::sys::fs::F_None);
+      assert(!errorCode && "Couldn't open output file");
+
+      swift::binary::SyntaxBinarySerializer(os).serialize(*Root);
+    } else {
+      swift::binary::SyntaxBinarySerializer(llvm::outs()).serialize(*Root);
+    }
+    return EXIT_SUCCESS;
+  });
+}
+
 int doDeserializeRawTree(const char *MainExecutablePath,
                          const StringRef InputFile,
                          const StringRef OutputFileName) {
@@ -725,6 +770,27 @@ int doDeserializeRawTree(const char *MainExecutablePath,
   return EXIT_SUCCESS;
 }
 
+int doDeserializeRawTreeBinary(const char *MainExecutablePath,
+                               const StringRef InputFile,
+                               const StringRef OutputFileName) {
+  // The deserialized tree references the buffer, so it must stay alive for
+  // the duration of the print.
+  auto Buffer = llvm::MemoryBuffer::getFile(InputFile);
+  std::error_code errorCode;
+  auto os = llvm::make_unique<llvm::raw_fd_ostream>(
+              OutputFileName, errorCode, llvm::sys::fs::F_None);
+  swift::binary::SyntaxBinaryDeserializer deserializer(
+      llvm::MemoryBufferRef(*(Buffer.get())));
+  auto Tree = deserializer.getSourceFileSyntax();
+  if (!Tree) {
+    llvm::errs() << "malformed binary syntax tree\n";
+    return EXIT_FAILURE;
+  }
+  Tree->print(*os);
+
+  return EXIT_SUCCESS;
+}
+
 int doParseOnly(const char *MainExecutablePath, const StringRef InputFile) {
   return parseFile(MainExecutablePath, InputFile, [](SourceFile *SF) {
     return SF ? EXIT_SUCCESS : EXIT_FAILURE;
@@ -763,6 +829,127 @@ int dumpEOFSourceLoc(const char *MainExecutablePath,
     return EXIT_SUCCESS;
   });
 }
+
+/// Run \p Body and return its elapsed wall time in seconds.
+double measureWallTime(llvm::function_ref<void()> Body) {
+  llvm::TimeRecord Start = llvm::TimeRecord::getCurrentTime();
+  Body();
+  llvm::TimeRecord End = llvm::TimeRecord::getCurrentTime(/*Start=*/false);
+  End -= Start;
+  return End.getWallTime();
+}
+
+/// Lex \p Source to the EOF token, retaining trivia the same way the syntax
+/// parser does, and discard the tokens.
+void benchmarkLexBuffer(StringRef Source) {
+  LangOptions LangOpts;
+  SourceManager SourceMgr;
+  unsigned BufferID = SourceMgr.addMemBufferCopy(Source, "benchmark.swift");
+  Lexer L(LangOpts, SourceMgr, BufferID, /*Diags=*/nullptr,
+          /*InSILMode=*/false, CommentRetentionMode::AttachToNextToken,
+          TriviaRetentionMode::WithTrivia);
+  Token Tok;
+  syntax::Trivia LeadingTrivia, TrailingTrivia;
+  do {
+    L.lex(Tok, LeadingTrivia, TrailingTrivia);
+  } while (Tok.isNot(tok::eof));
+}
+
+/// Parse \p InputFileName once, with or without constructing the syntax tree,
+/// and add the wall time spent inside the parser to \p Seconds. Compiler
+/// instance setup and file I/O stay outside the measured region.
+int benchmarkParseFile(const char *MainExecutablePath,
+                       StringRef InputFileName, bool BuildSyntaxTree,
+                       double &Seconds) {
+  CompilerInvocation Invocation;
+  Invocation.getLangOptions().BuildSyntaxTree = BuildSyntaxTree;
+  // Verification warnings would perturb the timing; the round-trip actions
+  // cover correctness.
+  Invocation.getLangOptions().VerifySyntaxTree = false;
+  Invocation.getFrontendOptions().InputsAndOutputs.addInputFile(InputFileName);
+  Invocation.setMainExecutablePath(
+    llvm::sys::fs::getMainExecutable(MainExecutablePath,
+      reinterpret_cast<void *>(&anchorForGetMainExecutable)));
+  Invocation.setModuleName("Test");
+
+  PrintingDiagnosticConsumer DiagConsumer;
+  CompilerInstance Instance;
+  Instance.addDiagnosticConsumer(&DiagConsumer);
+  if (Instance.setup(Invocation)) {
+    llvm::errs() << "Unable to set up compiler instance for "
+                 << InputFileName << '\n';
+    return EXIT_FAILURE;
+  }
+
+  Seconds += measureWallTime([&] { Instance.performParseOnly(); });
+  return EXIT_SUCCESS;
+}
+
+/// Repeatedly lex and parse the whole corpus, reporting MB/s separately for
+/// lexing, parsing, and syntax tree construction. The tree construction cost
+/// is the difference between parsing with and without \c BuildSyntaxTree.
+int doBenchmark(const char *MainExecutablePath,
+                ArrayRef<std::string> InputFiles) {
+  // Read the corpus up front so file I/O stays out of the lexing measurement.
+  std::vector<std::unique_ptr<llvm::MemoryBuffer>> Buffers;
+  uint64_t CorpusBytes = 0;
+  for (const std::string &Path : InputFiles) {
+    auto Buffer = llvm::MemoryBuffer::getFile(Path);
+    if (!Buffer) {
+      llvm::errs() << "Unable to open " << Path << ": "
+                   << Buffer.getError().message() << '\n';
+      return EXIT_FAILURE;
+    }
+    CorpusBytes += Buffer.get()->getBufferSize();
+    Buffers.push_back(std::move(Buffer.get()));
+  }
+  if (CorpusBytes == 0) {
+    llvm::errs() << "benchmark corpus is empty\n";
+    return EXIT_FAILURE;
+  }
+
+  double LexSeconds = 0;
+  double ParseSeconds = 0;
+  double TreeSeconds = 0;
+  for (unsigned Iteration = 0; Iteration < options::BenchmarkIterations;
+       ++Iteration) {
+    for (auto &Buffer : Buffers) {
+      LexSeconds +=
+          measureWallTime([&] { benchmarkLexBuffer(Buffer->getBuffer()); });
+    }
+    for (const std::string &Path : InputFiles) {
+      if (benchmarkParseFile(MainExecutablePath, Path,
+                             /*BuildSyntaxTree=*/false,
+                             ParseSeconds) == EXIT_FAILURE) {
+        return EXIT_FAILURE;
+      }
+      if (benchmarkParseFile(MainExecutablePath, Path,
+                             /*BuildSyntaxTree=*/true,
+                             TreeSeconds) == EXIT_FAILURE) {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  uint64_t TotalBytes = CorpusBytes * options::BenchmarkIterations;
+  auto PrintThroughput = [&](StringRef Phase, double Seconds) {
+    llvm::outs() << llvm::format("%-26s", Phase.str().c_str());
+    if (Seconds > 0.0) {
+      llvm::outs() << llvm::format("%8.2f MB/s", TotalBytes / Seconds / 1.0e6);
+    } else {
+      llvm::outs() << "     n/a     ";
+    }
+    llvm::outs() << llvm::format("  (%.3f seconds)\n", Seconds);
+  };
+
+  llvm::outs() << InputFiles.size() << " file(s), " << CorpusBytes
+               << " bytes, " << options::BenchmarkIterations
+               << " iteration(s)\n";
+  PrintThroughput("lexing:", LexSeconds);
+  PrintThroughput("parsing:", ParseSeconds);
+  PrintThroughput("syntax tree construction:", TreeSeconds - ParseSeconds);
+  return EXIT_SUCCESS;
+}
 }// end of anonymous namespace
 
 int invokeCommand(const char *MainExecutablePath,
@@ -782,10 +969,19 @@ int invokeCommand(const char *MainExecutablePath,
     case ActionType::SerializeRawTree:
       ExitCode = doSerializeRawTree(MainExecutablePath, InputSourceFilename);
       break;
+    case ActionType::SerializeRawTreeBinary:
+      ExitCode = doSerializeRawTreeBinary(MainExecutablePath,
+                                          InputSourceFilename);
+      break;
     case ActionType::DeserializeRawTree:
       ExitCode = doDeserializeRawTree(MainExecutablePath, InputSourceFilename,
                                       options::OutputFilename);
       break;
+    case ActionType::DeserializeRawTreeBinary:
+      ExitCode = doDeserializeRawTreeBinary(MainExecutablePath,
+                                            InputSourceFilename,
+                                            options::OutputFilename);
+      break;
     case ActionType::ParseOnly:
       ExitCode = doParseOnly(MainExecutablePath, InputSourceFilename);
       break;
@@ -795,6 +991,9 @@ int invokeCommand(const char *MainExecutablePath,
     case ActionType::EOFPos:
       ExitCode = dumpEOFSourceLoc(MainExecutablePath, InputSourceFilename);
       break;
+    case ActionType::Benchmark:
+      llvm_unreachable("The benchmark action runs over the whole corpus and "
+                       "is dispatched before the per-file actions");
     case ActionType::None:
       llvm::errs() << "an action is required\n";
       llvm::cl::PrintHelpMessage();
@@ -834,8 +1033,9 @@ int main(int argc, char *argv[]) {
     return ExitCode;
   }
 
+  std::vector<std::string> InputFiles;
   if (!options::InputSourceFilename.empty()) {
-    ExitCode = invokeCommand(argv[0], options::InputSourceFilename);
+    InputFiles.push_back(options::InputSourceFilename);
   } else {
     assert(!options::InputSourceDirectory.empty());
     std::error_code errorCode;
@@ -846,10 +1046,20 @@ int main(int argc, char *argv[]) {
       auto path = entry.path();
       if (!llvm::sys::fs::is_directory(path) &&
           StringRef(path).endswith(".swift")) {
-        ExitCode = invokeCommand(argv[0], path);
+        InputFiles.push_back(path);
       }
     }
   }
 
+  if (options::Action == ActionType::Benchmark) {
+    // The benchmark aggregates throughput over the whole corpus instead of
+    // running once per file.
+    ExitCode = doBenchmark(argv[0], InputFiles);
+  } else {
+    for (auto &InputFile : InputFiles) {
+      ExitCode = invokeCommand(argv[0], InputFile);
+    }
+  }
+
   return ExitCode;
 }
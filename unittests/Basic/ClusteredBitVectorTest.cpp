@@ -1,4 +1,5 @@
 #include "swift/Basic/ClusteredBitVector.h"
+#include "llvm/ADT/APInt.h"
 #include "gtest/gtest.h"
 
 using namespace swift;
@@ -208,3 +209,43 @@ TEST(ClusteredBitVector, FlipAllBig) {
   EXPECT_EQ(true, vec[7]);
   EXPECT_EQ(1u, vec.count());
 }
+
+TEST(ClusteredBitVector, FromAPInt) {
+  auto bits = llvm::APInt::getSplat(163, llvm::APInt(2, 1));
+  auto vec = ClusteredBitVector::fromAPInt(bits);
+  EXPECT_EQ(163u, vec.size());
+  EXPECT_EQ(true, vec[0]);
+  EXPECT_EQ(false, vec[1]);
+  EXPECT_EQ(true, vec[162]);
+  EXPECT_EQ(82u, vec.count());
+  EXPECT_EQ(bits, vec.asAPInt());
+}
+
+TEST(ClusteredBitVector, XorAssign) {
+  ClusteredBitVector vec;
+  vec.appendClearBits(128);
+  vec.setBit(5);
+  vec.setBit(100);
+
+  ClusteredBitVector other;
+  other.appendClearBits(128);
+  other.setBit(5);
+  other.setBit(101);
+
+  vec ^= other;
+  EXPECT_EQ(2u, vec.count());
+  EXPECT_EQ(false, vec[5]);
+  EXPECT_EQ(true, vec[100]);
+  EXPECT_EQ(true, vec[101]);
+
+  // Xor-ing with an all-clear vector is a no-op.
+  ClusteredBitVector clear;
+  clear.appendClearBits(128);
+  vec ^= clear;
+  EXPECT_EQ(2u, vec.count());
+
+  // Xor-ing into an all-clear vector copies the other side.
+  clear ^= vec;
+  EXPECT_EQ(2u, clear.count());
+  EXPECT_EQ(true, clear[100]);
+}
@@ -23,3 +23,42 @@ TEST(Demangle, DemangleWrappers) {
       demangleSymbolAsString(MangledName));
 }
 
+
+TEST(Demangle, NodeToStringReusingStorage) {
+  Context Ctx;
+  NodePointer Root = Ctx.demangleSymbolAsNode(llvm::StringRef("_TtV1a1b"));
+  std::string Buffer = "previous contents";
+  nodeToString(Root, Buffer);
+  EXPECT_EQ("a.b", Buffer);
+  // A null node clears the buffer.
+  nodeToString(nullptr, Buffer);
+  EXPECT_EQ("", Buffer);
+}
+
+
+TEST(Demangle, SymbolDemanglingCache) {
+  llvm::StringRef Sym("_TtV1a1b");
+  auto Simplified = DemangleOptions::SimplifiedUIDemangleOptions();
+
+  Context Uncached;
+  std::string SimplifiedResult = Uncached.demangleSymbolAsString(Sym,
+                                                                 Simplified);
+
+  Context Ctx;
+  Ctx.setSymbolDemanglingCacheSize(2);
+  EXPECT_EQ("a.b", Ctx.demangleSymbolAsString(Sym));
+  // Cached result.
+  EXPECT_EQ("a.b", Ctx.demangleSymbolAsString(Sym));
+  // Different options must not be answered from the entry cached for the
+  // default options.
+  EXPECT_EQ(SimplifiedResult, Ctx.demangleSymbolAsString(Sym, Simplified));
+  EXPECT_EQ(SimplifiedResult, Ctx.demangleSymbolAsString(Sym, Simplified));
+  // Failed demanglings print as the mangled name, also when cached.
+  EXPECT_EQ("not a symbol",
+            Ctx.demangleSymbolAsString(llvm::StringRef("not a symbol")));
+  EXPECT_EQ("not a symbol",
+            Ctx.demangleSymbolAsString(llvm::StringRef("not a symbol")));
+  // Disabling the cache keeps demangling working.
+  Ctx.setSymbolDemanglingCacheSize(0);
+  EXPECT_EQ("a.b", Ctx.demangleSymbolAsString(Sym));
+}
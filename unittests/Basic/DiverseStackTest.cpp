@@ -229,6 +229,53 @@ TEST(DiverseStack, StableIndexLookup) {
   }
 }
 
+TEST(DiverseStack, RecycleStorage) {
+  RandomValueGenerator RandomGen;
+
+  // Grow a stack well past its inline capacity, drain it, and detach its
+  // heap storage.
+  DiverseStack<ParentType, 16> First;
+  unsigned NumValues = 1024;
+  for (unsigned i = 0; i < NumValues; ++i) {
+    RandomGen.push(First);
+  }
+  while (!First.empty()) {
+    First.pop();
+  }
+  DiverseStackBase::RecycledStorage Recycled = First.recycleStorage();
+  EXPECT_TRUE(bool(Recycled));
+  EXPECT_GT(Recycled.getCapacity(), size_t(16));
+
+  // A stack that never grew beyond its inline buffer has nothing to
+  // recycle.
+  DiverseStack<ParentType, 16> Inline;
+  Inline.push<TwoByteType>(TwoByteType(7));
+  Inline.pop();
+  EXPECT_FALSE(bool(Inline.recycleStorage()));
+
+  // A stack seeded with the recycled storage behaves like any other.
+  size_t AdoptedCapacity = Recycled.getCapacity();
+  DiverseStack<ParentType, 16> Second;
+  Second.adoptRecycledStorage(std::move(Recycled));
+  EXPECT_FALSE(bool(Recycled));
+  EXPECT_TRUE(Second.empty());
+
+  constexpr size_t TwoByteDataSize = 5;
+  uint8_t InputData[TwoByteDataSize] = {5, 9, 1, 2, 10};
+  for (unsigned i = 0; i < TwoByteDataSize; ++i) {
+    Second.push<TwoByteType>(TwoByteType(InputData[i]));
+  }
+  for (int i = TwoByteDataSize - 1; i >= 0; --i) {
+    TwoByteType T = reinterpret_cast<TwoByteType &>(Second.top());
+    Second.pop();
+    EXPECT_EQ(T.Value, InputData[i]);
+  }
+  EXPECT_TRUE(Second.empty());
+
+  // The adopted storage comes back out with the same capacity.
+  EXPECT_EQ(AdoptedCapacity, Second.recycleStorage().getCapacity());
+}
+
 TEST(DiverseStack, PopMany) {
   RandomValueGenerator RandomGen;
   DiverseStack<ParentType, sizeof(unsigned) * 4 * 8> Stack;
@@ -15,8 +15,11 @@
 
 #include "llvm/ADT/SmallString.h"
 
+#include <chrono>
+#include <cstdio>
 #include <string>
 #include <map>
+#include <vector>
 
 using namespace swift;
 
@@ -180,6 +183,45 @@ TEST(PrefixMapTest, Test3) {
   tester.find("wbuqbtaprrpooqteftzdhjdqkemtcl");
 }
 
+// A microbenchmark for the longest-prefix lookup path, which sits under the
+// mangler's substitution machinery. The timing is reported rather than
+// asserted on, so the test cannot be flaky on a loaded machine; use it to
+// compare key-comparison strategies in PrefixMap.
+TEST(PrefixMapTest, BenchmarkFindPrefix) {
+  // Keys shaped like substitution strings: long shared prefixes with short
+  // divergent tails.
+  const char *stems[] = {
+    "s:Ss10CollectionPsE3map",
+    "s:s20ManagedBufferPointerV",
+    "s:s12StaticStringV",
+    "s:Sq12customMirror",
+  };
+  std::vector<std::string> keys;
+  for (const char *stem : stems)
+    for (unsigned i = 0; i != 256; ++i)
+      keys.push_back(std::string(stem) + "_member" + std::to_string(i));
+
+  PrefixMap<char, int> map;
+  int nextValue = 0;
+  for (auto &key : keys)
+    map.insert(asArray(key), nextValue++);
+
+  const unsigned NumIterations = 2000;
+  size_t found = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i != NumIterations; ++i) {
+    for (auto &key : keys)
+      found += bool(map.findPrefix(asArray(key)).first);
+  }
+  auto seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  size_t total = keys.size() * NumIterations;
+  EXPECT_EQ(total, found);
+  printf("findPrefix: %zu lookups, %.3f ms total, %.0f ns/lookup\n",
+         total, seconds * 1e3, seconds * 1e9 / total);
+}
+
 TEST(PrefixMapTest, Test4) {
   Tester tester;
   tester.find("");
@@ -0,0 +1,105 @@
+//===--- ThreadPoolTest.cpp -----------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/ThreadPool.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+using namespace swift;
+
+TEST(ThreadPool, ExecutesAllTasks) {
+  ThreadPool Pool(4);
+  ThreadPool::TaskGroup Group;
+  std::atomic<unsigned> Counter(0);
+  const unsigned NumTasks = 1000;
+  for (unsigned i = 0; i != NumTasks; ++i)
+    Pool.async(Group, [&Counter] { ++Counter; });
+  Group.wait();
+  EXPECT_EQ(NumTasks, Counter.load());
+}
+
+TEST(ThreadPool, NestedTasks) {
+  ThreadPool Pool(4);
+  ThreadPool::TaskGroup Group;
+  std::atomic<unsigned> Counter(0);
+  const unsigned NumOuter = 32, NumInner = 32;
+  for (unsigned i = 0; i != NumOuter; ++i) {
+    Pool.async(Group, [&] {
+      // Tasks may fan out further work into the same group; wait() must
+      // cover the whole tree.
+      for (unsigned j = 0; j != NumInner; ++j)
+        Pool.async(Group, [&Counter] { ++Counter; });
+    });
+  }
+  Group.wait();
+  EXPECT_EQ(NumOuter * NumInner, Counter.load());
+}
+
+TEST(ThreadPool, GroupsAreIndependent) {
+  ThreadPool Pool(2);
+  ThreadPool::TaskGroup First, Second;
+  std::atomic<unsigned> FirstCount(0), SecondCount(0);
+  for (unsigned i = 0; i != 100; ++i) {
+    Pool.async(First, [&FirstCount] { ++FirstCount; });
+    Pool.async(Second, [&SecondCount] { ++SecondCount; });
+  }
+  First.wait();
+  EXPECT_EQ(100u, FirstCount.load());
+  Second.wait();
+  EXPECT_EQ(100u, SecondCount.load());
+}
+
+TEST(ThreadPool, PriorityPreference) {
+  // With a single worker blocked on a gate, tasks enqueued behind the gate
+  // must run in priority order regardless of enqueue order.
+  ThreadPool Pool(1);
+  ThreadPool::TaskGroup Group;
+  std::atomic<bool> Gate(false);
+  std::mutex OrderMtx;
+  std::vector<int> Order;
+  Pool.async(Group, [&Gate] {
+    while (!Gate.load())
+      std::this_thread::yield();
+  });
+  Pool.async(Group,
+             [&] {
+               std::lock_guard<std::mutex> Guard(OrderMtx);
+               Order.push_back(2);
+             },
+             ThreadPool::Priority::Low);
+  Pool.async(Group,
+             [&] {
+               std::lock_guard<std::mutex> Guard(OrderMtx);
+               Order.push_back(1);
+             },
+             ThreadPool::Priority::High);
+  Gate = true;
+  Group.wait();
+  ASSERT_EQ(2u, Order.size());
+  EXPECT_EQ(1, Order[0]);
+  EXPECT_EQ(2, Order[1]);
+}
+
+TEST(ThreadPool, DrainsOnDestruction) {
+  std::atomic<unsigned> Counter(0);
+  const unsigned NumTasks = 200;
+  {
+    ThreadPool Pool(4);
+    for (unsigned i = 0; i != NumTasks; ++i)
+      Pool.async([&Counter] { ++Counter; });
+    // No group, no wait: the destructor must run everything.
+  }
+  EXPECT_EQ(NumTasks, Counter.load());
+}
@@ -0,0 +1,116 @@
+//===--- BasicStructuresBench.cpp - lib/Basic data structure benchmarks ---===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Microbenchmarks for ClusteredBitVector and PrefixMap. Correctness is
+// covered by the tests in unittests/Basic; these exist so changes to the
+// data structures come with numbers.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/ClusteredBitVector.h"
+#include "swift/Basic/PrefixMap.h"
+#include "llvm/ADT/SmallString.h"
+#include "benchmark/benchmark.h"
+
+#include <string>
+#include <vector>
+
+using namespace swift;
+
+static void BM_ClusteredBitVectorAppend(benchmark::State &state) {
+  // Build a vector the way IRGen builds spare-bit masks: alternating runs
+  // of set and clear bits.
+  for (auto _ : state) {
+    ClusteredBitVector vec;
+    for (int64_t i = 0, e = state.range(0); i != e; ++i) {
+      vec.appendSetBits(5);
+      vec.appendClearBits(3);
+    }
+    benchmark::DoNotOptimize(vec.size());
+  }
+}
+BENCHMARK(BM_ClusteredBitVectorAppend)->Range(8, 4096);
+
+static void BM_ClusteredBitVectorSetAndTest(benchmark::State &state) {
+  ClusteredBitVector vec;
+  vec.appendClearBits(state.range(0));
+  for (auto _ : state) {
+    size_t count = 0;
+    for (size_t i = 0, e = vec.size(); i != e; ++i) {
+      if (i & 1)
+        vec.setBit(i);
+      else
+        vec.clearBit(i);
+      count += vec[i];
+    }
+    benchmark::DoNotOptimize(count);
+  }
+}
+BENCHMARK(BM_ClusteredBitVectorSetAndTest)->Range(64, 1 << 16);
+
+static void BM_ClusteredBitVectorCopyAndCount(benchmark::State &state) {
+  // Copying is the operation ClusteredBitVector is designed to make cheap;
+  // track it together with a full population count of the copy.
+  ClusteredBitVector vec;
+  for (int64_t i = 0, e = state.range(0); i != e; ++i) {
+    vec.appendSetBits(5);
+    vec.appendClearBits(3);
+  }
+  for (auto _ : state) {
+    ClusteredBitVector copy = vec;
+    benchmark::DoNotOptimize(copy.count());
+  }
+}
+BENCHMARK(BM_ClusteredBitVectorCopyAndCount)->Range(8, 4096);
+
+static std::vector<std::string> makeMangledKeys(int64_t n) {
+  // Hierarchical keys with heavily shared prefixes, the shape PrefixMap is
+  // used for when mapping mangled names.
+  std::vector<std::string> keys;
+  keys.reserve(n);
+  for (int64_t i = 0; i != n; ++i) {
+    keys.push_back("_T0s8Sequence" + std::to_string(i % 13) + "V6method" +
+                   std::to_string(i) + "yyF");
+  }
+  return keys;
+}
+
+static ArrayRef<char> asArray(const std::string &str) {
+  return ArrayRef<char>(str.data(), str.size());
+}
+
+static void BM_PrefixMapInsert(benchmark::State &state) {
+  auto keys = makeMangledKeys(state.range(0));
+  for (auto _ : state) {
+    PrefixMap<char, unsigned> map;
+    unsigned i = 0;
+    for (auto &key : keys)
+      map.insert(asArray(key), i++);
+    benchmark::DoNotOptimize(map.empty());
+  }
+}
+BENCHMARK(BM_PrefixMapInsert)->Range(8, 4096);
+
+static void BM_PrefixMapFindPrefix(benchmark::State &state) {
+  auto keys = makeMangledKeys(state.range(0));
+  PrefixMap<char, unsigned> map;
+  unsigned i = 0;
+  for (auto &key : keys)
+    map.insert(asArray(key), i++);
+  for (auto _ : state) {
+    unsigned found = 0;
+    for (auto &key : keys)
+      found += bool(map.findPrefix(asArray(key)).first);
+    benchmark::DoNotOptimize(found);
+  }
+}
+BENCHMARK(BM_PrefixMapFindPrefix)->Range(8, 4096);
@@ -0,0 +1,185 @@
+//===--- RuntimeBench.cpp - Runtime entry point benchmarks ---------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Microbenchmarks that call stdlib/public/runtime entry points directly:
+// reference counting, heap allocation, metadata cache lookups, and dynamic
+// casts. Multi-threaded variants (via ->ThreadRange) cover the contended
+// paths -- many threads hammering one object's refcount, or racing on the
+// same metadata cache entry -- that Swift-level benchmarks cannot isolate.
+//
+// The test-object scaffolding mirrors unittests/runtime/Refcounting.cpp;
+// correctness of these entry points is covered there.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Runtime/Casting.h"
+#include "swift/Runtime/HeapObject.h"
+#include "swift/Runtime/Metadata.h"
+#include "benchmark/benchmark.h"
+
+using namespace swift;
+
+struct TestObject : HeapObject {
+  size_t Value;
+};
+
+static SWIFT_CC(swift) void destroyTestObject(SWIFT_CONTEXT HeapObject *object) {
+  swift_deallocObject(object, sizeof(TestObject), alignof(TestObject) - 1);
+}
+
+static const FullMetadata<ClassMetadata> TestClassObjectMetadata = {
+  { { &destroyTestObject }, { &VALUE_WITNESS_SYM(Bo) } },
+  { { nullptr }, ClassFlags::UsesSwiftRefcounting, 0, 0, 0, 0, 0, 0 }
+};
+
+static const FullMetadata<ClassMetadata> OtherClassObjectMetadata = {
+  { { &destroyTestObject }, { &VALUE_WITNESS_SYM(Bo) } },
+  { { nullptr }, ClassFlags::UsesSwiftRefcounting, 0, 0, 0, 0, 0, 0 }
+};
+
+static TestObject *allocTestObject() {
+  return static_cast<TestObject *>(
+      swift_allocObject(&TestClassObjectMetadata, sizeof(TestObject),
+                        alignof(TestObject) - 1));
+}
+
+//===----------------------------------------------------------------------===//
+// Reference counting
+//===----------------------------------------------------------------------===//
+
+// Each thread retains and releases its own object: the uncontended fast
+// path, and the baseline the contended variant below is compared against.
+static void BM_RetainReleaseDistinct(benchmark::State &state) {
+  auto *object = allocTestObject();
+  for (auto _ : state) {
+    swift_retain(object);
+    swift_release(object);
+  }
+  swift_release(object);
+}
+BENCHMARK(BM_RetainReleaseDistinct)->ThreadRange(1, 8);
+
+// All threads retain and release one shared object, keeping its refcount
+// word under constant cache-line contention.
+static void BM_RetainReleaseShared(benchmark::State &state) {
+  static TestObject *shared = nullptr;
+  if (state.thread_index == 0)
+    shared = allocTestObject();
+  for (auto _ : state) {
+    swift_retain(shared);
+    swift_release(shared);
+  }
+  if (state.thread_index == 0) {
+    swift_release(shared);
+    shared = nullptr;
+  }
+}
+BENCHMARK(BM_RetainReleaseShared)->ThreadRange(1, 8);
+
+static void BM_RetainReleaseN(benchmark::State &state) {
+  auto *object = allocTestObject();
+  for (auto _ : state) {
+    swift_retain_n(object, 32);
+    swift_release_n(object, 32);
+  }
+  swift_release(object);
+}
+BENCHMARK(BM_RetainReleaseN);
+
+static void BM_AllocDeallocObject(benchmark::State &state) {
+  for (auto _ : state) {
+    auto *object = allocTestObject();
+    swift_release(object);
+  }
+}
+BENCHMARK(BM_AllocDeallocObject)->ThreadRange(1, 8);
+
+//===----------------------------------------------------------------------===//
+// Metadata cache lookups
+//===----------------------------------------------------------------------===//
+
+// Cache-hit lookups against the uniquing caches in Metadata.cpp. The
+// multi-threaded variants have every thread racing on the same cache
+// entry, the pattern the concurrent cache structures are built for.
+// (swift_getGenericMetadata needs compiler-emitted instantiation patterns,
+// so the shared MetadataCache machinery is exercised through the metatype,
+// tuple, and existential entry points instead.)
+
+static void BM_MetatypeMetadataLookup(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        swift_getMetatypeMetadata(&METADATA_SYM(Bi64_).base));
+  }
+}
+BENCHMARK(BM_MetatypeMetadataLookup)->ThreadRange(1, 8);
+
+static void BM_TupleMetadataLookup(benchmark::State &state) {
+  MetadataRequest request(MetadataState::Complete);
+  for (auto _ : state) {
+    auto response = swift_getTupleTypeMetadata2(
+        request, &METADATA_SYM(Bi64_).base, &METADATA_SYM(Bi32_).base,
+        /*labels*/ nullptr, /*proposedWitnesses*/ nullptr);
+    benchmark::DoNotOptimize(response.Value);
+  }
+}
+BENCHMARK(BM_TupleMetadataLookup)->ThreadRange(1, 8);
+
+static ProtocolDescriptor BenchProtocol{
+  "_TMp12RuntimeBench13BenchProtocol",
+  nullptr,
+  ProtocolDescriptorFlags()
+    .withSwift(true)
+    .withClassConstraint(ProtocolClassConstraint::Any)
+    .withDispatchStrategy(ProtocolDispatchStrategy::Swift)
+};
+
+static void BM_ExistentialMetadataLookup(benchmark::State &state) {
+  const ProtocolDescriptor *protocols[] = {&BenchProtocol};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(swift_getExistentialTypeMetadata(
+        ProtocolClassConstraint::Any, /*superclassConstraint*/ nullptr,
+        /*numProtocols*/ 1, protocols));
+  }
+}
+BENCHMARK(BM_ExistentialMetadataLookup)->ThreadRange(1, 8);
+
+//===----------------------------------------------------------------------===//
+// Dynamic casts
+//===----------------------------------------------------------------------===//
+
+static void BM_DynamicCastClassSuccess(benchmark::State &state) {
+  auto *object = allocTestObject();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        swift_dynamicCastClass(object, &TestClassObjectMetadata));
+  }
+  swift_release(object);
+}
+BENCHMARK(BM_DynamicCastClassSuccess);
+
+static void BM_DynamicCastClassFailure(benchmark::State &state) {
+  auto *object = allocTestObject();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        swift_dynamicCastClass(object, &OtherClassObjectMetadata));
+  }
+  swift_release(object);
+}
+BENCHMARK(BM_DynamicCastClassFailure);
+
+static void BM_DynamicCastMetatype(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(swift_dynamicCastMetatype(
+        &TestClassObjectMetadata, &TestClassObjectMetadata));
+  }
+}
+BENCHMARK(BM_DynamicCastMetatype);
@@ -0,0 +1,188 @@
+//===--- DemangleBenchmark.cpp --------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Microbenchmarks for the demangler, remangler and node printer, replaying
+// the checked-in corpus of real-world manglings. Each benchmark reports
+// wall time and heap allocation counts per pass, so demangler performance
+// regressions show up in per-commit test logs instead of symbolication
+// latency alerts.
+//
+// The corpus defaults to test/Demangle/Inputs/manglings.txt; set the
+// SWIFT_DEMANGLE_BENCHMARK_CORPUS environment variable to replay a
+// different symbol list (one mangled name per line, anything after a
+// " ---> " separator is ignored).
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Demangling/Demangle.h"
+#include "swift/Demangling/Demangler.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace swift::Demangle;
+
+//===----------------------------------------------------------------------===//
+// Allocation counting
+//===----------------------------------------------------------------------===//
+
+// Count every heap allocation made in this binary. This is only suitable
+// for a dedicated benchmark executable like this one.
+static std::atomic<uint64_t> NumAllocations(0);
+
+void *operator new(size_t size) {
+  NumAllocations.fetch_add(1, std::memory_order_relaxed);
+  // The unittests build without exceptions, so allocation failure is fatal.
+  void *ptr = malloc(size);
+  if (!ptr)
+    abort();
+  return ptr;
+}
+
+void *operator new[](size_t size) { return ::operator new(size); }
+
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete[](void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { free(ptr); }
+
+//===----------------------------------------------------------------------===//
+// Corpus replay
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+/// The number of times each benchmark replays the whole corpus.
+const unsigned NumIterations = 10;
+
+std::vector<std::string> loadCorpus() {
+  const char *path = getenv("SWIFT_DEMANGLE_BENCHMARK_CORPUS");
+  if (!path)
+    path = SWIFT_DEMANGLE_BENCHMARK_CORPUS;
+
+  std::vector<std::string> symbols;
+  std::ifstream input(path);
+  for (std::string line; std::getline(input, line);) {
+    // Corpus lines pair each mangling with its expected demangling; only
+    // the mangled name matters here.
+    auto separator = line.find(" ---> ");
+    if (separator != std::string::npos)
+      line.resize(separator);
+    if (line.empty())
+      continue;
+    symbols.push_back(line);
+  }
+  return symbols;
+}
+
+struct Measurement {
+  double Seconds;
+  uint64_t Allocations;
+};
+
+template <typename Body>
+Measurement measure(Body &&body) {
+  auto allocationsBefore = NumAllocations.load(std::memory_order_relaxed);
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto end = std::chrono::steady_clock::now();
+  auto allocationsAfter = NumAllocations.load(std::memory_order_relaxed);
+  return {std::chrono::duration<double>(end - start).count(),
+          allocationsAfter - allocationsBefore};
+}
+
+void report(const char *name, const Measurement &m, size_t symbolCount) {
+  size_t total = symbolCount * NumIterations;
+  printf("%s: %zu symbols, %.3f ms total, %.0f ns/symbol, "
+         "%llu allocations (%.2f/symbol)\n",
+         name, total, m.Seconds * 1e3, m.Seconds * 1e9 / total,
+         (unsigned long long)m.Allocations, double(m.Allocations) / total);
+}
+
+} // end anonymous namespace
+
+TEST(DemangleBenchmark, DemangleCorpus) {
+  auto corpus = loadCorpus();
+  ASSERT_FALSE(corpus.empty()) << "could not load the mangling corpus";
+
+  size_t demangled = 0;
+  Demangler dem;
+  auto m = measure([&] {
+    for (unsigned i = 0; i < NumIterations; ++i) {
+      for (const auto &symbol : corpus) {
+        if (dem.demangleSymbol(symbol))
+          ++demangled;
+        dem.clear();
+      }
+    }
+  });
+  EXPECT_GT(demangled, 0u);
+  report("demangle", m, corpus.size());
+}
+
+TEST(DemangleBenchmark, PrintCorpus) {
+  auto corpus = loadCorpus();
+  ASSERT_FALSE(corpus.empty()) << "could not load the mangling corpus";
+
+  size_t printed = 0;
+  Demangler dem;
+  std::string buffer;
+  auto m = measure([&] {
+    for (unsigned i = 0; i < NumIterations; ++i) {
+      for (const auto &symbol : corpus) {
+        if (NodePointer root = dem.demangleSymbol(symbol)) {
+          nodeToString(root, buffer);
+          printed += !buffer.empty();
+        }
+        dem.clear();
+      }
+    }
+  });
+  EXPECT_GT(printed, 0u);
+  report("demangle+print", m, corpus.size());
+}
+
+TEST(DemangleBenchmark, RemangleCorpus) {
+  auto corpus = loadCorpus();
+  ASSERT_FALSE(corpus.empty()) << "could not load the mangling corpus";
+
+  // Only symbols in the current mangling scheme can be remangled with
+  // mangleNode.
+  std::vector<std::string> remanglable;
+  for (const auto &symbol : corpus)
+    if (isMangledName(symbol))
+      remanglable.push_back(symbol);
+  if (remanglable.empty()) {
+    printf("remangle: no symbols in the current scheme, skipping\n");
+    return;
+  }
+
+  size_t remangled = 0;
+  Demangler dem;
+  auto m = measure([&] {
+    for (unsigned i = 0; i < NumIterations; ++i) {
+      for (const auto &symbol : remanglable) {
+        if (NodePointer root = dem.demangleSymbol(symbol))
+          remangled += !mangleNode(root).empty();
+        dem.clear();
+      }
+    }
+  });
+  EXPECT_GT(remangled, 0u);
+  report("demangle+remangle", m, remanglable.size());
+}
@@ -0,0 +1,255 @@
+#!/usr/bin/python
+#
+# ==-- stats-dir-regression-report - rank deltas between two stats-dirs --==#
+#
+# This source file is part of the Swift.org open source project
+#
+# Copyright (c) 2014-2018 Apple Inc. and the Swift project authors
+# Licensed under Apache License v2.0 with Runtime Library Exception
+#
+# See https://swift.org/LICENSE.txt for license information
+# See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+#
+# ==------------------------------------------------------------------------==#
+#
+# This tool compares two directories generated by `swiftc -stats-output-dir`
+# -- a baseline and a candidate build of the same project -- and emits a
+# regression report ranked by the size of each change. Counters are
+# aggregated across all jobs of the build graph at three attribution levels:
+# the whole build, each module, and each primary input file (frontend jobs
+# only), so a whole-build regression can be chased down to the module and
+# file that introduced it in one pass.
+#
+# Typical CI use:
+#
+#   stats-dir-regression-report.py --markdown \
+#       /path/to/baseline-stats /path/to/candidate-stats
+#
+# The exit status is the number of whole-build stats that regressed past the
+# thresholds, so it can gate a pull request the same way
+# process-stats-dir.py's baseline comparison does.
+
+from __future__ import print_function
+
+import argparse
+import sys
+
+from collections import namedtuple
+from jobstats import load_stats_dir, merge_all_jobstats
+
+
+ReportRow = namedtuple("ReportRow",
+                       ["scope", "name", "old", "new",
+                        "delta", "delta_pct"])
+
+
+def is_timer(name):
+    return name.startswith("time.") or ".time." in name
+
+
+def diff_and_pct(old, new):
+    if old == 0:
+        if new == 0:
+            return (0, 0.0)
+        else:
+            return (new, 100.0)
+    delta = (new - old)
+    delta_pct = round((float(delta) / float(old)) * 100.0, 2)
+    return (delta, delta_pct)
+
+
+def row_direction(row, args):
+    """Return 1, -1 or 0 depending on whether the row regressed, improved,
+    or stayed within the thresholds. Timers must move by both the
+    percentage and the absolute-time threshold to count, matching
+    process-stats-dir.py."""
+    if abs(row.delta_pct) <= args.delta_pct_thresh:
+        return 0
+    if is_timer(row.name) and abs(row.delta) <= args.delta_usec_thresh:
+        return 0
+    return 1 if row.delta > 0 else -1
+
+
+def group_jobs(jobs, keyfunc):
+    """Partition a list of JobStats by keyfunc, dropping jobs for which
+    keyfunc returns None."""
+    groups = {}
+    for j in jobs:
+        k = keyfunc(j)
+        if k is None:
+            continue
+        groups.setdefault(k, []).append(j)
+    return groups
+
+
+def merged_group_stats(jobs, args):
+    m = merge_all_jobstats(jobs, merge_by=args.merge_by)
+    if m is None:
+        return {}
+    return m.stats
+
+
+def compare_groups(old_groups, new_groups, args):
+    """Merge each group on both sides and yield a ReportRow per stat of
+    every group present in the baseline. Stats or whole groups missing
+    from the candidate compare as zero, the same convention
+    process-stats-dir.py uses."""
+    for scope in sorted(old_groups.keys()):
+        old_stats = merged_group_stats(old_groups[scope], args)
+        new_stats = merged_group_stats(new_groups.get(scope, []), args)
+        for name in sorted(old_stats.keys()):
+            old = old_stats[name]
+            new = new_stats.get(name, 0)
+            (delta, delta_pct) = diff_and_pct(old, new)
+            yield ReportRow(scope=scope, name=name,
+                            old=int(old), new=int(new),
+                            delta=int(delta), delta_pct=delta_pct)
+
+
+def ranked(rows, args):
+    """Sort rows by how big a change they represent: absolute time moved
+    for timers, percentage otherwise, largest first."""
+    def magnitude(row):
+        if is_timer(row.name):
+            return abs(row.delta)
+        return abs(row.delta_pct)
+    return sorted(rows, key=magnitude, reverse=True)
+
+
+def format_value(name, v):
+    if is_timer(name):
+        if abs(v) > 1000000:
+            return "{:.1f}s".format(v / 1000000.0)
+        elif abs(v) > 1000:
+            return "{:.1f}ms".format(v / 1000.0)
+        else:
+            return "{:d}us".format(int(v))
+    return "{:,d}".format(int(v))
+
+
+def write_section(out, title, rows, args):
+    changed = [(r, row_direction(r, args)) for r in rows]
+    regressed = ranked([r for (r, d) in changed if d > 0], args)
+    improved = ranked([r for (r, d) in changed if d < 0], args)
+    if args.limit > 0:
+        regressed = regressed[:args.limit]
+        improved = improved[:args.limit]
+
+    if args.markdown:
+        out.write("\n### %s\n" % title)
+        if len(regressed) == 0 and len(improved) == 0:
+            out.write("\nNo changes past thresholds.\n")
+            return
+        out.write("\nscope | stat | old | new | delta | delta_pct\n")
+        out.write("--- | --- | ---: | ---: | ---: | ---:\n")
+        for r in regressed + improved:
+            out.write("%s | %s | %s | %s | %s | %s%%\n" %
+                      (r.scope, r.name,
+                       format_value(r.name, r.old),
+                       format_value(r.name, r.new),
+                       format_value(r.name, r.delta),
+                       r.delta_pct))
+    else:
+        out.write("\n=== %s ===\n" % title)
+        if len(regressed) == 0 and len(improved) == 0:
+            out.write("no changes past thresholds\n")
+            return
+        for (label, elts) in [("regressed", regressed),
+                              ("improved", improved)]:
+            if len(elts) == 0:
+                continue
+            out.write("%s:\n" % label)
+            for (i, r) in enumerate(elts):
+                out.write("%3d. %-32s %-40s %12s -> %-12s (%s, %s%%)\n" %
+                          (i + 1, r.scope, r.name,
+                           format_value(r.name, r.old),
+                           format_value(r.name, r.new),
+                           format_value(r.name, r.delta),
+                           r.delta_pct))
+
+
+def whole_build_key(job):
+    return "(total)"
+
+
+def module_key(job):
+    return job.module
+
+
+def file_key(job):
+    # Only frontend jobs carry a meaningful primary input; driver jobs
+    # aggregate the whole module and would double-count here.
+    if not job.is_frontend_job():
+        return None
+    return "%s/%s" % (job.module, job.jobargs[0])
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare a baseline and a candidate stats directory "
+                    "and report ranked regressions attributed to the whole "
+                    "build, to modules, and to input files")
+    parser.add_argument("--output", default="-",
+                        type=argparse.FileType('wb', 0),
+                        help="Output file for the report")
+    parser.add_argument("--select-module", default=[], action="append",
+                        help="Select specific modules")
+    parser.add_argument("--select-stat", default=[], action="append",
+                        help="Select stats matching a regex")
+    parser.add_argument("--exclude-timers", default=False,
+                        action="store_true",
+                        help="Ignore timer stats")
+    parser.add_argument("--merge-timers", default=False,
+                        action="store_true",
+                        help="Merge timers across modules/targets/etc.")
+    parser.add_argument("--merge-by", default="sum", type=str,
+                        help="Merge identical stats within a scope by "
+                             "'sum' (default), 'min' or 'max'")
+    parser.add_argument("--delta-pct-thresh", type=float, default=0.01,
+                        help="Percentage change required to report a stat")
+    parser.add_argument("--delta-usec-thresh", type=int, default=100000,
+                        help="Absolute time change (usec) also required "
+                             "to report a timer")
+    parser.add_argument("--limit", type=int, default=20,
+                        help="Report at most this many regressed and "
+                             "improved entries per section; 0 for all")
+    parser.add_argument("--markdown", default=False, action="store_true",
+                        help="Write the report as markdown tables")
+    parser.add_argument("baseline_dir",
+                        help="Stats directory of the baseline build")
+    parser.add_argument("candidate_dir",
+                        help="Stats directory of the candidate build")
+    args = parser.parse_args()
+
+    vargs = dict(select_module=args.select_module,
+                 select_stat=args.select_stat,
+                 exclude_timers=args.exclude_timers,
+                 merge_timers=args.merge_timers)
+    old_jobs = load_stats_dir(args.baseline_dir, **vargs)
+    new_jobs = load_stats_dir(args.candidate_dir, **vargs)
+    if len(old_jobs) == 0:
+        print("no stats found in " + args.baseline_dir)
+        return 1
+
+    sections = [
+        ("Whole build", whole_build_key),
+        ("By module", module_key),
+        ("By file", file_key),
+    ]
+
+    regressions = 0
+    for (i, (title, keyfunc)) in enumerate(sections):
+        rows = list(compare_groups(group_jobs(old_jobs, keyfunc),
+                                   group_jobs(new_jobs, keyfunc),
+                                   args))
+        write_section(args.output, title, rows, args)
+        # Only the coarsest level counts toward the exit status; the finer
+        # levels attribute the same deltas, not additional ones.
+        if i == 0:
+            regressions = len([r for r in rows
+                               if row_direction(r, args) > 0])
+    return regressions
+
+
+if __name__ == '__main__':
+    sys.exit(main())